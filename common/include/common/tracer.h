@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include "scopy-common_export.h"
+#include "scopy-common_config.h"
+
+#include <QString>
+#include <QVector>
+
+/*
+ * SCOPY_TRACE_SCOPE(name) records the time spent in the enclosing scope as a span of the
+ * calling thread. Spans nest by time, so phases traced inside each other (connect, per plugin
+ * connect, tool init) show up as a hierarchy in chrome://tracing or Perfetto.
+ * name must outlive the trace: a string literal or a Tracer::intern() result. Keep it a stable
+ * label, dynamic text belongs in the span args (see Tracer::record()).
+ *
+ * Tracing is built only with -DENABLE_TRACING=ON, otherwise the macro expands to nothing.
+ */
+#ifdef ENABLE_TRACING
+#define SCOPY_TRACE_CONCAT_(a, b) a##b
+#define SCOPY_TRACE_CONCAT(a, b) SCOPY_TRACE_CONCAT_(a, b)
+#define SCOPY_TRACE_SCOPE(name) scopy::TraceScope SCOPY_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#else
+#define SCOPY_TRACE_SCOPE(name)                                                                                        \
+	do {                                                                                                           \
+	} while(0)
+#endif
+
+namespace scopy {
+
+/*
+ * Every thread records its spans in its own ring buffer: recording is a store and an atomic
+ * increment, with no lock and no allocation. Buffers are registered once per thread and kept
+ * after the thread exits, so short lived workers (QtConcurrent tasks, CommandQueue commands)
+ * still show up in the export. When a buffer wraps, the oldest spans are dropped.
+ * Span args are kept in a smaller per-thread ring, truncated, so they stay bounded as well.
+ */
+class SCOPY_COMMON_EXPORT Tracer
+{
+public:
+	typedef struct
+	{
+		const char *name;
+		qint64 start;	 // ns since the tracer started
+		qint64 duration; // ns
+		QString args;	 // free text shown with the span, empty if none
+	} Span;
+
+	typedef struct
+	{
+		int id;
+		QString name;
+		QVector<Span> spans;
+	} Thread;
+
+	typedef struct
+	{
+		QString name;
+		int count;
+		double total; // ms
+		double p50;
+		double p95;
+		double max;
+	} Stats;
+
+	static qint64 now();
+	static void record(const char *name, qint64 start, qint64 end);
+	// args is copied, name is not: use it for text that changes from one span to the next
+	static void record(const char *name, qint64 start, qint64 end, const QString &args);
+	// returns a pointer to a copy of name that lives as long as the process
+	static const char *intern(const QString &name);
+
+	static QVector<Thread> snapshot();
+	static QVector<Stats> stats();
+	static QString summary();
+	// Chrome trace event format, opened by chrome://tracing and ui.perfetto.dev
+	static bool writeChromeTrace(const QString &path);
+	static void clear();
+};
+
+class TraceScope
+{
+public:
+	TraceScope(const char *name)
+		: m_name(name)
+		, m_start(Tracer::now())
+	{}
+	~TraceScope() { Tracer::record(m_name, m_start, Tracer::now()); }
+
+private:
+	const char *m_name;
+	qint64 m_start;
+};
+
+} // namespace scopy
+
+#endif // TRACER_H
@@ -20,6 +20,7 @@
  */
 
 #include "debugtimer.h"
+#include "tracer.h"
 #include <QFile>
 #include <QDate>
 #include <QFile>
@@ -53,6 +54,13 @@ bool DebugTimer::singleMode() { return m_singleMode; }
 
 void DebugTimer::log(const QString &msg, const char *function, const char *file, int line)
 {
+#ifdef ENABLE_TRACING
+	// the measured interval also goes to the trace, nested under whatever span is open. msg is often
+	// built at runtime, the span is named after the calling function and carries msg as its args
+	qint64 now = Tracer::now();
+	Tracer::record(function, now - m_timer.nsecsElapsed(), now, msg);
+#endif
+
 	if(f.isOpen()) {
 		QTextStream stream(&f);
 
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2025 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "tracer.h"
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QSaveFile>
+#include <QSet>
+#include <QTextStream>
+#include <QThread>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+Q_LOGGING_CATEGORY(CAT_TRACER, "Tracer")
+
+using namespace scopy;
+
+// spans kept per thread, a power of 2
+#define TRACER_BUFFER_SIZE (1 << 16)
+// span args kept per thread, a power of 2, and the bytes kept of each
+#define TRACER_ARGS_SIZE (1 << 10)
+#define TRACER_ARGS_LENGTH 120
+
+namespace {
+struct RawSpan
+{
+	const char *name;
+	qint64 start;
+	qint64 duration;
+	// 1 + index of the span args in the args ring, 0 if the span has none
+	quint64 args;
+};
+
+struct RawArgs
+{
+	// 1 + index of the args stored here, 0 while they are being written
+	std::atomic<quint64> seq;
+	char text[TRACER_ARGS_LENGTH];
+};
+} // namespace
+
+namespace {
+struct ThreadBuffer
+{
+	int id;
+	QString name;
+	std::vector<RawSpan> spans;
+	std::unique_ptr<RawArgs[]> args;
+	// number of args ever written, only used by the owner thread
+	quint64 argsHead;
+	// number of spans ever written, the ring position is head % TRACER_BUFFER_SIZE
+	std::atomic<quint64> head;
+	// spans before this count were dropped by Tracer::clear()
+	std::atomic<quint64> cleared;
+};
+
+struct Registry
+{
+	std::mutex mutex;
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	QSet<QByteArray> names;
+	const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+Registry &registry()
+{
+	static Registry r;
+	return r;
+}
+
+ThreadBuffer *threadBuffer()
+{
+	thread_local std::shared_ptr<ThreadBuffer> buffer;
+	if(!buffer) {
+		buffer = std::make_shared<ThreadBuffer>();
+		buffer->spans.resize(TRACER_BUFFER_SIZE);
+		buffer->args.reset(new RawArgs[TRACER_ARGS_SIZE]());
+		buffer->argsHead = 0;
+		buffer->head = 0;
+		buffer->cleared = 0;
+
+		Registry &r = registry();
+		std::lock_guard<std::mutex> lock(r.mutex);
+		buffer->id = r.buffers.size();
+		QThread *th = QThread::currentThread();
+		if(QCoreApplication::instance() && th == QCoreApplication::instance()->thread()) {
+			buffer->name = "Main";
+		} else if(th && !th->objectName().isEmpty()) {
+			buffer->name = th->objectName();
+		} else {
+			buffer->name = "Thread " + QString::number(buffer->id);
+		}
+		// the registry keeps the buffer, its spans are exported after the thread exits
+		r.buffers.push_back(buffer);
+	}
+	return buffer.get();
+}
+
+double percentile(const std::vector<qint64> &sorted, double p)
+{
+	size_t idx = std::min<size_t>(sorted.size() - 1, p * sorted.size());
+	return sorted[idx] / 1e6;
+}
+
+QString jsonEscape(const char *str)
+{
+	QString s = QString::fromUtf8(str);
+	s.replace('\\', "\\\\").replace('"', "\\\"").replace('\n', "\\n").replace('\t', "\\t");
+	return s;
+}
+
+void recordSpan(ThreadBuffer *b, const char *name, qint64 start, qint64 end, quint64 args)
+{
+	// only this thread writes the buffer: store the span, then publish it
+	quint64 head = b->head.load(std::memory_order_relaxed);
+	b->spans[head & (TRACER_BUFFER_SIZE - 1)] = {
+		.name = name, .start = start, .duration = end - start, .args = args};
+	b->head.store(head + 1, std::memory_order_release);
+}
+
+QString readArgs(const ThreadBuffer *b, quint64 args)
+{
+	if(args == 0) {
+		return QString();
+	}
+	const RawArgs &a = b->args[(args - 1) & (TRACER_ARGS_SIZE - 1)];
+	if(a.seq.load(std::memory_order_acquire) != args) {
+		return QString();
+	}
+	char text[TRACER_ARGS_LENGTH];
+	memcpy(text, a.text, TRACER_ARGS_LENGTH);
+	std::atomic_thread_fence(std::memory_order_acquire);
+	// the owner reused the slot while it was copied
+	if(a.seq.load(std::memory_order_relaxed) != args) {
+		return QString();
+	}
+	return QString::fromUtf8(text, qstrnlen(text, TRACER_ARGS_LENGTH));
+}
+} // namespace
+
+qint64 Tracer::now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+								     registry().epoch)
+		.count();
+}
+
+void Tracer::record(const char *name, qint64 start, qint64 end) { recordSpan(threadBuffer(), name, start, end, 0); }
+
+void Tracer::record(const char *name, qint64 start, qint64 end, const QString &args)
+{
+	ThreadBuffer *b = threadBuffer();
+	quint64 seq = ++b->argsHead;
+	RawArgs &a = b->args[(seq - 1) & (TRACER_ARGS_SIZE - 1)];
+	// invalidate the slot before reusing it, readers check seq before and after copying the text
+	a.seq.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	QByteArray utf8 = args.toUtf8().left(TRACER_ARGS_LENGTH);
+	memset(a.text, 0, TRACER_ARGS_LENGTH);
+	memcpy(a.text, utf8.constData(), utf8.size());
+	a.seq.store(seq, std::memory_order_release);
+	recordSpan(b, name, start, end, seq);
+}
+
+const char *Tracer::intern(const QString &name)
+{
+	Registry &r = registry();
+	QByteArray utf8 = name.toUtf8();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	auto it = r.names.constFind(utf8);
+	if(it == r.names.constEnd()) {
+		it = r.names.insert(utf8);
+	}
+	// the set never removes entries and QByteArray data does not move on rehash
+	return it->constData();
+}
+
+QVector<Tracer::Thread> Tracer::snapshot()
+{
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	{
+		Registry &r = registry();
+		std::lock_guard<std::mutex> lock(r.mutex);
+		buffers = r.buffers;
+	}
+
+	QVector<Thread> threads;
+	for(const auto &b : buffers) {
+		Thread t{.id = b->id, .name = b->name, .spans = {}};
+		quint64 head = b->head.load(std::memory_order_acquire);
+		quint64 first = (head > TRACER_BUFFER_SIZE) ? head - TRACER_BUFFER_SIZE : 0;
+		quint64 cleared = std::min<quint64>(b->cleared.load(std::memory_order_acquire), head);
+		first = std::max(first, cleared);
+		t.spans.reserve(head - first);
+		for(quint64 i = first; i < head; i++) {
+			const RawSpan &s = b->spans[i & (TRACER_BUFFER_SIZE - 1)];
+			t.spans.append({.name = s.name,
+					.start = s.start,
+					.duration = s.duration,
+					.args = readArgs(b.get(), s.args)});
+		}
+
+		// spans overwritten by the owner while they were copied are not consistent, drop them
+		quint64 after = b->head.load(std::memory_order_acquire);
+		quint64 overwritten = (after > TRACER_BUFFER_SIZE) ? after - TRACER_BUFFER_SIZE : 0;
+		if(overwritten > first) {
+			t.spans.remove(0, std::min<quint64>(overwritten - first, t.spans.size()));
+		}
+		threads.append(t);
+	}
+	return threads;
+}
+
+QVector<Tracer::Stats> Tracer::stats()
+{
+	// spans are grouped by name content, the same literal may have a different address per library
+	QHash<QByteArray, std::vector<qint64>> durations;
+	for(const Thread &t : snapshot()) {
+		for(const Span &s : t.spans) {
+			durations[QByteArray(s.name)].push_back(s.duration);
+		}
+	}
+
+	QVector<Stats> result;
+	for(auto it = durations.begin(); it != durations.end(); ++it) {
+		std::vector<qint64> &d = it.value();
+		std::sort(d.begin(), d.end());
+		qint64 total = 0;
+		for(qint64 v : d) {
+			total += v;
+		}
+		result.append({.name = QString::fromUtf8(it.key()),
+			       .count = (int)d.size(),
+			       .total = total / 1e6,
+			       .p50 = percentile(d, 0.5),
+			       .p95 = percentile(d, 0.95),
+			       .max = d.back() / 1e6});
+	}
+
+	std::sort(result.begin(), result.end(), [](const Stats &a, const Stats &b) { return a.total > b.total; });
+	return result;
+}
+
+QString Tracer::summary()
+{
+	QString table;
+	QTextStream stream(&table);
+	stream << QString("%1 %2 %3 %4 %5 %6\n")
+			  .arg("span", -48)
+			  .arg("count", 8)
+			  .arg("total ms", 12)
+			  .arg("p50 ms", 10)
+			  .arg("p95 ms", 10)
+			  .arg("max ms", 10);
+	for(const Stats &s : stats()) {
+		stream << QString("%1 %2 %3 %4 %5 %6\n")
+				  .arg(s.name.left(48), -48)
+				  .arg(s.count, 8)
+				  .arg(s.total, 12, 'f', 3)
+				  .arg(s.p50, 10, 'f', 3)
+				  .arg(s.p95, 10, 'f', 3)
+				  .arg(s.max, 10, 'f', 3);
+	}
+	return table;
+}
+
+bool Tracer::writeChromeTrace(const QString &path)
+{
+	QSaveFile f(path);
+	if(!f.open(QIODevice::WriteOnly)) {
+		qWarning(CAT_TRACER) << "Can't write trace to" << path;
+		return false;
+	}
+
+	const qint64 pid = QCoreApplication::applicationPid();
+	QTextStream stream(&f);
+	stream << "{\"traceEvents\":[\n";
+	bool first = true;
+	for(const Thread &t : snapshot()) {
+		stream << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+		       << ",\"tid\":" << t.id << ",\"args\":{\"name\":\"" << jsonEscape(t.name.toUtf8().constData()) << "\"}}";
+		first = false;
+		for(const Span &s : t.spans) {
+			// complete events, timestamps in microseconds
+			stream << ",\n{\"name\":\"" << jsonEscape(s.name) << "\",\"ph\":\"X\",\"pid\":" << pid
+			       << ",\"tid\":" << t.id << ",\"ts\":" << QString::number(s.start / 1e3, 'f', 3)
+			       << ",\"dur\":" << QString::number(s.duration / 1e3, 'f', 3);
+			if(!s.args.isEmpty()) {
+				stream << ",\"args\":{\"msg\":\"" << jsonEscape(s.args.toUtf8().constData()) << "\"}";
+			}
+			stream << "}";
+		}
+	}
+	stream << "\n]}\n";
+	stream.flush();
+	return f.commit();
+}
+
+void Tracer::clear()
+{
+	Registry &r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	for(const auto &b : r.buffers) {
+		// the owner thread is the only writer of head, mark the spans recorded so far as dropped instead
+		b->cleared.store(b->head.load(std::memory_order_acquire), std::memory_order_release);
+	}
+}
@@ -102,6 +102,8 @@ protected:
 
 protected:
 	QList<Plugin *> m_plugins;
+	// name and description of every compatible plugin, including the disabled ones
+	QList<QPair<QString, QString>> m_compatiblePlugins;
 	QList<Plugin *> m_connectedPlugins;
 	QSet<QString> m_reloadPluginsSet;
 	DeviceState_t m_state;
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PLUGINCOMPATIBILITYCACHE_H
+#define PLUGINCOMPATIBILITYCACHE_H
+
+#include "scopy-core_export.h"
+
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+
+namespace scopy {
+
+/*
+ * Remembers the result of Plugin::compatible() for a device, so a device that was
+ * already seen does not have to be probed by every plugin again on each scan or
+ * connect. Entries are keyed by category, param and a fingerprint of the device;
+ * for IIO devices the fingerprint is a hash of the context XML, the backend and
+ * the firmware version, so a reflashed or reconfigured board is probed again.
+ * Each entry records the plugin version it was probed with and the whole cache is
+ * dropped when the Scopy build changes.
+ *
+ * The cache is persisted as JSON next to the session files and is safe to use from
+ * the device loader threads.
+ */
+class SCOPY_CORE_EXPORT PluginCompatibilityCache
+{
+public:
+	PluginCompatibilityCache(QString path);
+	~PluginCompatibilityCache();
+
+	// empty if the device can't be fingerprinted - such devices are never cached
+	static QString fingerprint(const QString &param, const QString &category);
+
+	bool lookup(const QString &key, const QString &plugin, const QString &version, bool &compatible);
+	void store(const QString &key, const QString &plugin, const QString &version, bool compatible);
+	void save();
+	void clear();
+
+	static QString key(const QString &param, const QString &category, const QString &fingerprint);
+
+private:
+	void load();
+
+	QString m_path;
+	QJsonObject m_entries;
+	bool m_dirty;
+	QMutex m_mutex;
+};
+
+} // namespace scopy
+
+#endif // PLUGINCOMPATIBILITYCACHE_H
@@ -27,6 +27,7 @@
 #include <QList>
 #include <QObject>
 #include "plugininfo.h"
+#include "plugincompatibilitycache.h"
 #include <pluginbase/plugin.h>
 
 namespace scopy {
@@ -44,6 +45,7 @@ public:
 	QList<Plugin *> getOriginalPlugins() const;
 	QList<Plugin *> getPlugins(QString category = "");
 	QList<Plugin *> getCompatiblePlugins(QString param, QString category = "");
+	void clearCompatibilityCache();
 	QList<PluginInfo> getPluginsInfo() const;
 	QList<PluginInfo> getLoadedPlugins() const;
 	QList<PluginInfo> getUnloadedPlugins() const;
@@ -57,6 +59,7 @@ private:
 	Plugin *loadPlugin(QString file);
 	QList<PluginInfo> m_plugins;
 	QJsonObject m_metadata;
+	PluginCompatibilityCache *m_compatCache;
 
 	void applyMetadata(Plugin *plugin, QJsonObject *metadata);
 	bool pluginInCategory(Plugin *p, QString category);
@@ -38,6 +38,8 @@ public:
 
 public Q_SLOTS:
 	void update(QVector<QPair<QString, QString>> ctxsDescription);
+	// partial update with the result of a single backend, only the uris of that backend can be lost
+	void updateBackend(QString backend, QVector<QPair<QString, QString>> ctxsDescription);
 	void clearCache();
 	void lock(QString, Device *);
 	void unlock(QString, Device *);
@@ -47,6 +49,8 @@ Q_SIGNALS:
 	void lostDevice(QString cat, QString uri);
 
 private:
+	void diff(const QSet<QString> &updatedUris, const QSet<QString> &previous);
+
 	QSet<QString> uris;
 	QSet<QString> lockedUris;
 };
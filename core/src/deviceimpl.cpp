@@ -40,6 +40,7 @@
 #include <style.h>
 
 #include <common/debugtimer.h>
+#include <common/tracer.h>
 #include <common/scopyconfig.h>
 #include <gui/widgets/hoverwidget.h>
 #include <gui/widgets/connectionloadingbar.h>
@@ -63,9 +64,11 @@ DeviceImpl::DeviceImpl(QString param, QString category, QObject *parent)
 
 void DeviceImpl::init()
 {
+	SCOPY_TRACE_SCOPE("DeviceImpl::init");
 	DebugTimer benchmark;
 	m_plugins = PluginRepository::getCompatiblePlugins(m_param, m_category);
 	for(Plugin *p : qAsConst(m_plugins)) {
+		m_compatiblePlugins.append({p->name(), p->description()});
 		QObject *obj = dynamic_cast<QObject *>(p);
 		if(obj) {
 			obj->setParent(this);
@@ -85,6 +88,7 @@ void DeviceImpl::preload()
 
 void DeviceImpl::loadPlugins()
 {
+	SCOPY_TRACE_SCOPE("DeviceImpl::loadPlugins");
 	DebugTimer benchmark;
 	removeDisabledPlugins();
 	preload();
@@ -332,20 +336,20 @@ void DeviceImpl::unbindPing()
 
 void DeviceImpl::loadCompatiblePluginsTab(QWidget *pluginsTab)
 {
-	QList<Plugin *> plugins = PluginRepository::getCompatiblePlugins(m_param, m_category);
+	// the list was built by init(), probing every plugin again is not needed
 	QStringList enabledPlugins = getPluginsName();
-	for(Plugin *p : qAsConst(plugins)) {
+	for(const auto &compatible : qAsConst(m_compatiblePlugins)) {
+		const QString pluginName = compatible.first;
 		PluginEnableWidget *pluginDescription = new PluginEnableWidget(pluginsTab);
-		bool pluginEnabled = enabledPlugins.contains(p->name());
-		pluginDescription->setDescription(p->description());
-		pluginDescription->checkBox()->setText(p->name());
+		bool pluginEnabled = enabledPlugins.contains(pluginName);
+		pluginDescription->setDescription(compatible.second);
+		pluginDescription->checkBox()->setText(pluginName);
 		pluginDescription->checkBox()->setChecked(pluginEnabled);
 		pluginsTab->layout()->addWidget(pluginDescription);
 		if(pluginEnabled) {
-			m_reloadPluginsSet.insert(p->name());
+			m_reloadPluginsSet.insert(pluginName);
 		}
-		connect(pluginDescription->checkBox(), &QCheckBox::toggled, this, [this, p](bool en) {
-			QString pluginName = p->name();
+		connect(pluginDescription->checkBox(), &QCheckBox::toggled, this, [this, pluginName](bool en) {
 			if(en) {
 				m_reloadPluginsSet.insert(pluginName);
 			} else {
@@ -437,6 +441,7 @@ void DeviceImpl::load(QSettings &s)
 
 void DeviceImpl::connectDev()
 {
+	SCOPY_TRACE_SCOPE("DeviceImpl::connectDev");
 	m_state = DEV_CONNECTING;
 	DebugTimer pluginConnBm;
 	DebugTimer connectDevBm;
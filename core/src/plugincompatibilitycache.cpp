@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "plugincompatibilitycache.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QJsonDocument>
+#include <QLoggingCategory>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include <common/scopyconfig.h>
+#include <iioutil/connectionprovider.h>
+
+Q_LOGGING_CATEGORY(CAT_PLUGINCOMPATCACHE, "PluginCompatibilityCache")
+
+using namespace scopy;
+
+PluginCompatibilityCache::PluginCompatibilityCache(QString path)
+	: m_path(path)
+	, m_dirty(false)
+{
+	load();
+}
+
+PluginCompatibilityCache::~PluginCompatibilityCache() { save(); }
+
+QString PluginCompatibilityCache::fingerprint(const QString &param, const QString &category)
+{
+	if(category != "iio") {
+		return "";
+	}
+
+	Connection *conn = ConnectionProvider::open(param);
+	if(!conn) {
+		return "";
+	}
+
+	struct iio_context *ctx = conn->context();
+	const char *xml = iio_context_get_xml(ctx);
+	const char *backend = iio_context_get_name(ctx);
+	const char *fw = iio_context_get_attr_value(ctx, "fw_version");
+
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(xml ? xml : "");
+	hash.addData(backend ? backend : "");
+	hash.addData(fw ? fw : "");
+	ConnectionProvider::close(param);
+
+	return hash.result().toHex();
+}
+
+QString PluginCompatibilityCache::key(const QString &param, const QString &category, const QString &fingerprint)
+{
+	return category + "|" + param + "|" + fingerprint;
+}
+
+bool PluginCompatibilityCache::lookup(const QString &key, const QString &plugin, const QString &version,
+				      bool &compatible)
+{
+	QMutexLocker lock(&m_mutex);
+	QJsonObject entry = m_entries.value(key).toObject().value(plugin).toObject();
+	if(entry.isEmpty() || entry.value("version").toString() != version) {
+		return false;
+	}
+	compatible = entry.value("compatible").toBool();
+	return true;
+}
+
+void PluginCompatibilityCache::store(const QString &key, const QString &plugin, const QString &version,
+				     bool compatible)
+{
+	QMutexLocker lock(&m_mutex);
+	QJsonObject device = m_entries.value(key).toObject();
+	device[plugin] = QJsonObject{{"version", version}, {"compatible", compatible}};
+	m_entries[key] = device;
+	m_dirty = true;
+}
+
+void PluginCompatibilityCache::clear()
+{
+	QMutexLocker lock(&m_mutex);
+	m_entries = QJsonObject();
+	m_dirty = true;
+}
+
+void PluginCompatibilityCache::load()
+{
+	QFile f(m_path);
+	if(!f.open(QIODevice::ReadOnly)) {
+		return;
+	}
+
+	QJsonObject root = QJsonDocument::fromJson(f.readAll()).object();
+	if(root.value("scopy").toString() != scopy::config::fullversion()) {
+		qDebug(CAT_PLUGINCOMPATCACHE) << "Discarding cache written by" << root.value("scopy").toString();
+		return;
+	}
+	m_entries = root.value("devices").toObject();
+}
+
+void PluginCompatibilityCache::save()
+{
+	QMutexLocker lock(&m_mutex);
+	if(!m_dirty) {
+		return;
+	}
+
+	QJsonObject root;
+	root["scopy"] = scopy::config::fullversion();
+	root["devices"] = m_entries;
+
+	QSaveFile f(m_path);
+	if(!f.open(QIODevice::WriteOnly)) {
+		qWarning(CAT_PLUGINCOMPATCACHE) << "Can't write" << m_path;
+		return;
+	}
+	f.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+	if(f.commit()) {
+		m_dirty = false;
+	}
+}
@@ -26,15 +26,21 @@
 #include <QFileInfo>
 #include <QJsonArray>
 #include <QLoggingCategory>
+#include <QtConcurrent>
 #include <pluginfilter.h>
 
 #include <algorithm>
+#include <common/debugtimer.h>
+#include <common/scopyconfig.h>
+#include <common/tracer.h>
+#include <pluginbase/preferences.h>
 
 Q_LOGGING_CATEGORY(CAT_PLUGINMANAGER, "PluginManager")
 using namespace scopy;
 
 PluginManager::PluginManager(QObject *parent)
 	: QObject(parent)
+	, m_compatCache(new PluginCompatibilityCache(scopy::config::settingsFolderPath() + "/plugin_compatibility.json"))
 {}
 
 PluginManager::~PluginManager()
@@ -44,6 +50,7 @@ PluginManager::~PluginManager()
 			p.pluginInstance()->deinit();
 		}
 	}
+	delete m_compatCache;
 }
 
 void PluginManager::add(QStringList pluginFileList)
@@ -123,26 +130,71 @@ QList<Plugin *> PluginManager::getPlugins(QString category)
 
 QList<Plugin *> PluginManager::getCompatiblePlugins(QString param, QString category)
 {
-	QList<Plugin *> comp;
+	SCOPY_TRACE_SCOPE("PluginManager::getCompatiblePlugins");
+	DebugTimer benchmark;
+	QList<Plugin *> candidates;
 	const QList<PluginInfo> loaded = getLoadedPlugins();
 	for(const PluginInfo &pluginInfo : loaded) {
-		Plugin *plugin = pluginInfo.pluginInstance();
-		if(!PluginFilter::pluginInCategory(plugin, category)) {
-			continue;
+		if(PluginFilter::pluginInCategory(pluginInfo.pluginInstance(), category)) {
+			candidates.append(pluginInfo.pluginInstance());
+		}
+	}
+
+	bool useCache = Preferences::get("general_plugin_compatibility_cache").toBool();
+	QString key;
+	if(useCache) {
+		QString fingerprint = PluginCompatibilityCache::fingerprint(param, category);
+		useCache = !fingerprint.isEmpty();
+		key = PluginCompatibilityCache::key(param, category, fingerprint);
+	}
+
+	QVector<bool> compatible(candidates.size(), false);
+	QVector<int> toProbe;
+	for(int i = 0; i < candidates.size(); i++) {
+		bool cached = false;
+		if(!useCache || !m_compatCache->lookup(key, candidates[i]->name(), candidates[i]->version(), cached)) {
+			toProbe.append(i);
 		}
+		compatible[i] = cached;
+	}
+
+	// plugins probe independent devices or attributes, run them concurrently
+	QtConcurrent::blockingMap(toProbe, [&](int i) {
+		SCOPY_TRACE_SCOPE(Tracer::intern(candidates[i]->name() + " compatible"));
+		compatible[i] = candidates[i]->compatible(param, category);
+	});
+
+	if(useCache && !toProbe.isEmpty()) {
+		for(int i : qAsConst(toProbe)) {
+			m_compatCache->store(key, candidates[i]->name(), candidates[i]->version(), compatible[i]);
+		}
+		m_compatCache->save();
+	}
+
+	// exclusion and forced inclusion depend on the plugins accepted before, keep the priority order
+	QList<Plugin *> comp;
+	for(int i = 0; i < candidates.size(); i++) {
+		Plugin *plugin = candidates[i];
 		bool enable = (!PluginFilter::pluginInExclusionList(comp, plugin));
 		bool forcedInclusion = (PluginFilter::pluginForcedInclusionList(comp, plugin));
 
-		if(plugin->compatible(param, category) || forcedInclusion) {
+		if(compatible[i] || forcedInclusion) {
 			Plugin *p = plugin->clone();
 			p->setParam(param, category);
 			p->setEnabled(enable);
 			comp.append(p);
 		}
 	}
+	DEBUGTIMER_LOG(benchmark,
+		       QString("Compatibility for %1: %2 probed, %3 cached")
+			       .arg(param)
+			       .arg(toProbe.size())
+			       .arg(candidates.size() - toProbe.size()));
 	return comp;
 }
 
+void PluginManager::clearCompatibilityCache() { m_compatCache->clear(); }
+
 QList<PluginInfo> PluginManager::getPluginsInfo() const { return m_plugins; }
 
 QList<PluginInfo> PluginManager::getLoadedPlugins() const
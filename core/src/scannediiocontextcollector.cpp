@@ -44,24 +44,49 @@ void ScannedIIOContextCollector::update(QVector<QPair<QString, QString>> ctxsDes
 		updatedUris.insert(pair.second);
 	}
 
-	updatedUris = updatedUris + lockedUris;
+	diff(updatedUris + lockedUris, uris);
+}
+
+void ScannedIIOContextCollector::updateBackend(QString backend, QVector<QPair<QString, QString>> ctxsDescription)
+{
+	QSet<QString> updatedUris;
+	for(const auto &pair : ctxsDescription) {
+		updatedUris.insert(pair.second);
+	}
 
+	// scanned uris are prefixed with the backend name (usb:3.14.5, ip:192.168.2.1)
+	const QString prefix = backend.section('=', 0, 0) + ":";
+	QSet<QString> backendUris;
+	for(const QString &uri : qAsConst(uris)) {
+		if(uri.startsWith(prefix)) {
+			backendUris.insert(uri);
+		}
+	}
+	for(const QString &uri : qAsConst(lockedUris)) {
+		if(uri.startsWith(prefix)) {
+			updatedUris.insert(uri);
+		}
+	}
+
+	diff(updatedUris, backendUris);
+}
+
+void ScannedIIOContextCollector::diff(const QSet<QString> &updatedUris, const QSet<QString> &previous)
+{
 	auto newUris = updatedUris - uris;
-	auto deletedUris = uris - updatedUris;
+	auto deletedUris = previous - updatedUris;
 
 	qDebug(CAT_SCANCTXCOLLECTOR) << "cached uris:" << uris;
 	for(const auto &uri : newUris) {
 		qInfo(CAT_SCANCTXCOLLECTOR) << "new device found: " << uri;
-		//		if(!lockedUris.contains(uri))
 		Q_EMIT foundDevice("iio", uri);
 	}
 
 	for(const auto &uri : deletedUris) {
 		qInfo(CAT_SCANCTXCOLLECTOR) << "to delete device: " << uri;
-		//		if(!lockedUris.contains(uri))
 		Q_EMIT lostDevice("iio", uri);
 	}
-	uris = updatedUris;
+	uris = (uris - deletedUris) + newUris;
 }
 
 void ScannedIIOContextCollector::removeDevice(QString id, Device *d) { uris.remove(d->param()); }
@@ -152,7 +152,7 @@ ScopyMainWindow::ScopyMainWindow(QWidget *parent)
 	ScopySplashscreen::showMessage("Loading homepage");
 	hp = new ScopyHomePage(this);
 	m_sbc = new ScanButtonController(scanCycle, hp->scanControlBtn(), this);
-	connect(hp->scanBtn(), &QPushButton::clicked, this, [=]() { scanTask->run(); });
+	connect(hp->scanBtn(), &QPushButton::clicked, this, [=]() { scanTask->restart(); });
 
 	DeviceAutoConnect::initPreferences();
 	dm = new DeviceManager(this);
@@ -171,6 +171,8 @@ ScopyMainWindow::ScopyMainWindow(QWidget *parent)
 	ts->add("package", pkgWidget);
 	ts->add("scripting", m_scriptingTool);
 
+	connect(scanTask, &IIOScanTask::backendScanFinished, scc, &ScannedIIOContextCollector::updateBackend,
+		Qt::QueuedConnection);
 	connect(scanTask, &IIOScanTask::scanFinished, scc, &ScannedIIOContextCollector::update, Qt::QueuedConnection);
 
 	connect(scc, SIGNAL(foundDevice(QString, QString)), dm, SLOT(createDevice(QString, QString)));
@@ -237,7 +239,7 @@ ScopyMainWindow::ScopyMainWindow(QWidget *parent)
 	prefPage->initSessionDevices();
 
 	if(Preferences::get("general_scan_for_devices").toBool()) {
-		scanTask->run();
+		scanTask->restart();
 	}
 	enableScanner();
 
@@ -504,6 +506,7 @@ void ScopyMainWindow::initPreferences()
 	p->init("general_show_status_bar", true);
 	p->init("general_connect_to_multiple_devices", true);
 	p->init("general_scan_for_devices", true);
+	p->init("general_plugin_compatibility_cache", true);
 	p->init("general_show_warning_on_connection_lost", true);
 	p->init("device_menu_item", true);
 	p->init("pkg_menu_columns", 1);
@@ -643,6 +646,10 @@ void ScopyMainWindow::handlePreferences(QString str, QVariant val)
 		dm->setExclusive(!general_connect_to_multiple_devices);
 	} else if(str == "general_scan_for_devices") {
 		enableScanner();
+	} else if(str == "general_plugin_compatibility_cache") {
+		if(!val.toBool()) {
+			PluginRepository::getPluginManager()->clearCompatibilityCache();
+		}
 	} else if(str == "iio_emu_dir_path") {
 		Q_EMIT p->restartRequired();
 	} else if(str == "packages_path") {
@@ -337,6 +337,12 @@ QWidget *ScopyPreferencesPage::buildGeneralPreferencesPage()
 				     "allowing the application to automatically populate the device list with connected"
 				     "devices. Otherwise, all devices need to be added manually from the Add page.",
 				     generalSection));
+	generalSection->contentLayout()->addWidget(PREFERENCE_CHECK_BOX(
+		p, "general_plugin_compatibility_cache", "Remember compatible plugins for known devices",
+		"Store which plugins are compatible with a device, identified by its context description and "
+		"firmware, so the device is not probed by every plugin again on the next scan or connect. "
+		"Disabling the option clears the stored results.",
+		generalSection));
 	generalSection->contentLayout()->addWidget(PREFERENCE_CHECK_BOX(
 		p, "general_show_warning_on_connection_lost", "Show warning before disconnecting on connection lost",
 		"When enabled, shows a warning in the status bar with a disconnect button when "
@@ -19,6 +19,7 @@
  *
  */
 
+#include "core/plugincompatibilitycache.h"
 #include "core/pluginmanager.h"
 #include "pkg-manager/pkgmanager.h"
 #include "pkg-manager/pkgmanifestfields.h"
@@ -28,6 +29,7 @@
 #include <QJsonParseError>
 #include <QLibrary>
 #include <QList>
+#include <QTemporaryDir>
 #include <QTest>
 
 using namespace scopy;
@@ -45,6 +47,7 @@ private Q_SLOTS:
 	void exclusionExcept();
 	void exclusionExceptUppercase();
 	void exclusionExceptLowercase();
+	void compatibilityCache();
 
 private:
 	void initFileList();
@@ -418,6 +421,37 @@ bool TST_PluginManager::basePkgsExist()
 	return true;
 }
 
+void TST_PluginManager::compatibilityCache()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString path = dir.filePath("plugin_compatibility.json");
+	const QString key = PluginCompatibilityCache::key("ip:127.0.0.1", "iio", "fingerprint");
+	bool compatible = false;
+
+	{
+		PluginCompatibilityCache cache(path);
+		QVERIFY(!cache.lookup(key, "ADCPlugin", "1.0", compatible));
+		cache.store(key, "ADCPlugin", "1.0", true);
+		cache.store(key, "M2kPlugin", "1.0", false);
+		cache.save();
+	}
+
+	PluginCompatibilityCache cache(path);
+	QVERIFY(cache.lookup(key, "ADCPlugin", "1.0", compatible));
+	QVERIFY(compatible);
+	QVERIFY(cache.lookup(key, "M2kPlugin", "1.0", compatible));
+	QVERIFY(!compatible);
+
+	// a new plugin version or a different device fingerprint must be probed again
+	QVERIFY(!cache.lookup(key, "ADCPlugin", "1.1", compatible));
+	QVERIFY(!cache.lookup(PluginCompatibilityCache::key("ip:127.0.0.1", "iio", "other"), "ADCPlugin", "1.0",
+			      compatible));
+
+	cache.clear();
+	QVERIFY(!cache.lookup(key, "ADCPlugin", "1.0", compatible));
+}
+
 QTEST_MAIN(TST_PluginManager)
 
 #include "tst_pluginmanager.moc"
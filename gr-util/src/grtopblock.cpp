@@ -26,6 +26,7 @@
 
 #include <QtConcurrent>
 #include <QFuture>
+#include <common/tracer.h>
 #include <pluginbase/statusbarmanager.h>
 
 Q_LOGGING_CATEGORY(SCOPY_GR_UTIL, "GRManager")
@@ -172,6 +173,7 @@ void GRTopBlock::rebuild()
 {
 	if(m_suspended)
 		return;
+	SCOPY_TRACE_SCOPE("GRTopBlock::rebuild");
 	qInfo(SCOPY_GR_UTIL) << QObject::sender();
 	qInfo(SCOPY_GR_UTIL) << "Request rebuild";
 	bool wasRunning = false;
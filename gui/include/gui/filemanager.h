@@ -24,13 +24,20 @@
 #include "scopy-gui_export.h"
 #include <QString>
 #include <QStringList>
+#include <QThread>
 #include <QVector>
 
 #include <QWidget>
+#include <atomic>
 #include <exception>
+#include <functional>
 #include <iostream>
+#include <memory>
 
 namespace scopy {
+class FileExportTask;
+class SigMFCapture;
+
 class SCOPY_GUI_EXPORT FileManager
 {
 public:
@@ -49,17 +56,23 @@ public:
 	enum FileType
 	{
 		CSV,
-		TXT
+		TXT,
+		// binary capture (.sigmf-data) with a JSON sidecar (.sigmf-meta), see SigMFCapture
+		SIGMF
 	};
 
+	// receives the percentage written so far, returning false cancels the write
+	typedef std::function<bool(int)> ProgressCallback;
+
 	FileManager(QString toolName);
 	~FileManager();
 
 	void open(QString fileName, FileManager::FilePurpose filepurpose = EXPORT);
 
-	void save(QVector<double> data, QString name);
-	void save(QVector<QVector<double>> data, QVector<QVector<QString>> decoder_data, QStringList column_names);
-	void save(QVector<QVector<double>> data, QStringList column_names);
+	void save(const QVector<double> &data, QString name);
+	void save(const QVector<QVector<double>> &data, const QVector<QVector<QString>> &decoder_data,
+		  const QStringList &column_names);
+	void save(const QVector<QVector<double>> &data, const QStringList &column_names);
 
 	QVector<double> read(int index);
 	QVector<QVector<double>> read();
@@ -74,6 +87,14 @@ public:
 	int getNrOfChannels() const;
 
 	void performWrite(bool withScopyHeader = true);
+	bool performWrite(bool withScopyHeader, const ProgressCallback &progress);
+
+	/**
+	 * @brief Creates a task that writes the file on a background thread. Connect to its signals, then
+	 * start() it. The task reports progress and deletes itself when done, the data is shared with (not
+	 * copied from) this FileManager.
+	 */
+	FileExportTask *performWriteAsync(bool withScopyHeader = true, QObject *parent = nullptr);
 	void performDecoderWrite(bool skip_empty_lines = false);
 
 	QStringList getAdditionalInformation() const;
@@ -82,9 +103,15 @@ public:
 	FileFormat getFormat() const;
 	void setFormat(const FileFormat &value);
 
+	void setUnits(const QStringList &units);
+	QStringList getUnits() const;
+
 	void writeToFile(bool overwrite, QMap<QString, QVector<QString>> data);
 
 private:
+	void openSigMF(QString fileName);
+	bool performSigMFWrite(const ProgressCallback &progress);
+
 	QVector<QVector<double>> data;
 	QVector<QVector<QString>> decoder_data;
 	QStringList columnNames;
@@ -98,6 +125,33 @@ private:
 	QString separator;
 	QString toolName;
 	QStringList additionalInformation;
+	QStringList units;
+	// imported SigMF captures stay memory mapped, samples are read per channel straight out of the mapping
+	std::shared_ptr<SigMFCapture> capture;
+};
+
+class SCOPY_GUI_EXPORT FileExportTask : public QThread
+{
+	Q_OBJECT
+public:
+	FileExportTask(const FileManager &fm, bool withScopyHeader, QObject *parent = nullptr);
+	~FileExportTask();
+
+	void cancel();
+	bool succeeded() const;
+
+Q_SIGNALS:
+	void progress(int percent);
+	void exportFinished(bool success);
+
+protected:
+	void run() override;
+
+private:
+	FileManager m_fileManager;
+	bool m_withScopyHeader;
+	std::atomic<bool> m_cancelled;
+	bool m_success;
 };
 
 class SCOPY_GUI_EXPORT ScopyFileHeader
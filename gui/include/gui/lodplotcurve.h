@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LODPLOTCURVE_H
+#define LODPLOTCURVE_H
+
+#include "scopy-gui_export.h"
+#include "minmaxlod.h"
+
+#include <QwtPlotCurve>
+
+namespace scopy {
+
+/*
+ * QwtPlotCurve that draws large buffers through a level-of-detail layer. When
+ * the visible part of the curve holds many more samples than the canvas has
+ * pixel columns, only the min/max envelope of every column is handed to the
+ * painter, taken from a MinMaxLod pyramid. Every peak and glitch still lands
+ * on the same pixel, but the painting cost depends on the canvas width instead
+ * of the buffer size.
+ *
+ * data() is left untouched, so markers, cursors and exports keep seeing every
+ * sample. The pyramid is rebuilt after setSamples()/setRawSamples(); code that
+ * modifies a raw buffer in place must call invalidateLod() before replotting.
+ * The layer only engages for line/step curves with monotonic x data and no
+ * symbols or fitting, everything else is drawn by QwtPlotCurve.
+ */
+class SCOPY_GUI_EXPORT LodPlotCurve : public QwtPlotCurve
+{
+public:
+	explicit LodPlotCurve(const QString &title = QString());
+	~LodPlotCurve();
+
+	bool isLodEnabled() const;
+	void setLodEnabled(bool enabled);
+
+	// the data only grows by appending, so the pyramid can be extended instead of rebuilt
+	bool appendOnly() const;
+	void setAppendOnly(bool appendOnly);
+
+	void invalidateLod();
+
+	void drawSeries(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap, const QRectF &canvasRect,
+			int from, int to) const override;
+
+protected:
+	void dataChanged() override;
+
+private:
+	bool lodApplicable() const;
+
+	template <typename T>
+	bool drawEnvelope(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+			  const QRectF &canvasRect, const T *xData, const T *yData, size_t size) const;
+
+	template <typename T>
+	bool updateLod(const T *xData, const T *yData, size_t size) const;
+
+	bool m_lodEnabled;
+	bool m_appendOnly;
+
+	mutable MinMaxLod m_lod;
+	mutable bool m_dirty;
+	mutable bool m_monotonic;
+	mutable double m_firstX;
+};
+
+} // namespace scopy
+
+#endif // LODPLOTCURVE_H
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MINMAXLOD_H
+#define MINMAXLOD_H
+
+#include "scopy-gui_export.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace scopy {
+
+/*
+ * MinMaxLod keeps a min/max pyramid over a sample buffer: level k summarizes
+ * blocks of BASE_BLOCK << k consecutive samples. query() returns the exact
+ * minimum and maximum of any index range in O(log N + BASE_BLOCK) by combining
+ * the largest aligned blocks that fit the range with the raw samples at its
+ * edges, which is what a curve needs to draw the envelope of a pixel column.
+ *
+ * update() recomputes only the blocks touched by samples from `from` onwards,
+ * so buffers that grow by appending are summarized incrementally.
+ */
+class SCOPY_GUI_EXPORT MinMaxLod
+{
+public:
+	static constexpr size_t BASE_BLOCK = 8;
+
+	MinMaxLod();
+	~MinMaxLod();
+
+	void clear();
+	size_t size() const;
+	int levels() const;
+
+	// (re)summarizes y[from, size), the samples before `from` must be unchanged since the last update
+	template <typename T>
+	void update(const T *y, size_t size, size_t from = 0)
+	{
+		if(from > m_size) {
+			from = m_size;
+		}
+		from -= from % BASE_BLOCK;
+
+		const size_t blocks = (size + BASE_BLOCK - 1) / BASE_BLOCK;
+		if(m_min.empty()) {
+			m_min.emplace_back();
+			m_max.emplace_back();
+		}
+		m_min[0].resize(blocks);
+		m_max[0].resize(blocks);
+
+		for(size_t b = from / BASE_BLOCK; b < blocks; b++) {
+			double lo = std::numeric_limits<double>::infinity();
+			double hi = -std::numeric_limits<double>::infinity();
+			const size_t end = std::min(size, (b + 1) * BASE_BLOCK);
+			for(size_t i = b * BASE_BLOCK; i < end; i++) {
+				accumulate(y[i], lo, hi);
+			}
+			m_min[0][b] = lo;
+			m_max[0][b] = hi;
+		}
+
+		m_size = size;
+		buildUpperLevels(from / BASE_BLOCK);
+	}
+
+	// min and max of y[begin, end). Both stay +/-inf if the range only holds NaNs
+	template <typename T>
+	void query(const T *y, size_t begin, size_t end, double &min, double &max) const
+	{
+		min = std::numeric_limits<double>::infinity();
+		max = -std::numeric_limits<double>::infinity();
+		end = std::min(end, m_size);
+
+		size_t i = begin;
+		while(i < end) {
+			if(i % BASE_BLOCK != 0 || i + BASE_BLOCK > end) {
+				accumulate(y[i], min, max);
+				i++;
+				continue;
+			}
+
+			int level = 0;
+			while(level + 1 < levels() && i % (BASE_BLOCK << (level + 1)) == 0 &&
+			      i + (BASE_BLOCK << (level + 1)) <= end) {
+				level++;
+			}
+
+			const size_t block = i / (BASE_BLOCK << level);
+			min = std::min(min, m_min[level][block]);
+			max = std::max(max, m_max[level][block]);
+			i += BASE_BLOCK << level;
+		}
+	}
+
+private:
+	template <typename T>
+	static inline void accumulate(T value, double &lo, double &hi)
+	{
+		// comparisons against NaN are false, so NaNs (gaps) are skipped
+		if(value < lo) {
+			lo = value;
+		}
+		if(value > hi) {
+			hi = value;
+		}
+	}
+
+	void buildUpperLevels(size_t fromBlock);
+
+	std::vector<std::vector<double>> m_min;
+	std::vector<std::vector<double>> m_max;
+	size_t m_size;
+};
+
+} // namespace scopy
+
+#endif // MINMAXLOD_H
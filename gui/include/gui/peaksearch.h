@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PEAKSEARCH_H
+#define PEAKSEARCH_H
+
+#include "scopy-gui_export.h"
+
+#include <limits>
+#include <vector>
+
+namespace scopy {
+
+/*
+ * PeakSearch finds the K highest local maxima of a curve in a single pass.
+ * Candidates closer than minSeparation bins are merged (the highest one is
+ * kept) and candidates below threshold are dropped before they reach the
+ * bounded min-heap, so the cost is O(N + M log K) instead of sorting every
+ * local maximum. Found peaks can be refined with sub-bin interpolation.
+ *
+ * The class holds no Qt state and does not allocate once its buffers have
+ * grown, so it can be used from acquisition worker threads.
+ */
+class SCOPY_GUI_EXPORT PeakSearch
+{
+public:
+	typedef enum
+	{
+		PI_NONE,
+		// fit a parabola through the 3 bins around the maximum. For data
+		// already in a log scale (dB) this is the gaussian fit of the magnitude
+		PI_PARABOLIC,
+		// fit a parabola through ln(y) - for positive linear magnitude data
+		PI_GAUSSIAN
+	} Interpolation;
+
+	typedef struct
+	{
+		double x;
+		double y;
+		int idx;
+		double offset; // sub-bin offset from idx, in [-0.5, 0.5]
+	} Peak;
+
+	PeakSearch();
+	~PeakSearch();
+
+	int maxPeaks() const;
+	void setMaxPeaks(int maxPeaks);
+
+	double threshold() const;
+	void setThreshold(double threshold);
+
+	int minSeparation() const;
+	void setMinSeparation(int bins);
+
+	Interpolation interpolation() const;
+	void setInterpolation(Interpolation interpolation);
+
+	// searches [start, stop) and returns the peaks sorted by descending y
+	const std::vector<Peak> &search(const float *xData, const float *yData, int start, int stop);
+	const std::vector<Peak> &peaks() const;
+
+	// index of the maximum in [idx - range, idx + range]
+	static int findMaxNear(const float *yData, int size, int idx, int range);
+
+	Peak refine(const float *xData, const float *yData, int size, int idx) const;
+
+private:
+	void pushCandidate(const float *yData, int idx);
+
+	int m_maxPeaks;
+	double m_threshold;
+	int m_minSeparation;
+	Interpolation m_interpolation;
+
+	std::vector<int> m_heap;
+	std::vector<Peak> m_peaks;
+};
+
+} // namespace scopy
+
+#endif // PEAKSEARCH_H
@@ -25,14 +25,17 @@
 #include <scopy-gui_export.h>
 #include "plot_utils.hpp"
 #include "plotaxishandle.h"
+#include "peaksearch.h"
 #include "qboxlayout.h"
 #include "qtextedit.h"
 #include "qwidget.h"
 #include "utils.h"
+#include <QMutex>
 #include <QObject>
 #include <QScrollArea>
 #include <QwtPlotMarker>
 #include <QwtSymbol>
+#include <atomic>
 
 namespace scopy {
 
@@ -77,6 +80,13 @@ public:
 	PlotComponentChannel *ch() const;
 	void setCh(PlotComponentChannel *newCh);
 
+	// searches the peaks of a frame on the thread that acquired it, before the frame is published.
+	// The next computeMarkers() on that frame takes them instead of searching the curve again
+	void searchPeaks(const float *xData, const float *yData, int size);
+
+	double peakThreshold() const;
+	int peakMinSeparation() const;
+
 public Q_SLOTS:
 	void setNrOfMarkers(int);
 	void setMarkerType(PlotMarkerController::MarkerTypes);
@@ -86,6 +96,10 @@ public Q_SLOTS:
 	void setComplex(bool b);
 	void setFixedHandleVisible(bool b);
 	void setFixedMarkerFrequency(int idx, double freq);
+	// a peak has to rise this much above the noise floor, the median of the searched curve
+	void setPeakThreshold(double aboveFloor);
+	// peaks closer than this many bins are merged and the highest one is kept
+	void setPeakMinSeparation(int bins);
 
 Q_SIGNALS:
 	void markerInfoUpdated();
@@ -106,18 +120,30 @@ protected:
 
 	QList<QwtPlotMarker *> m_markers;
 	QList<MarkerInfo> m_markerInfo;
-	QList<PeakInfo> m_peakInfo;
 	QList<PeakInfo> m_sortedPeakInfo;
+	PeakSearch m_peakSearch;
 	QList<PlotAxisHandle *> m_fixedHandles;
 
 	void cacheMarkerInfo();
 	double popCacheMarkerInfo();
+	// fills m_sortedPeakInfo with the peaks searchPeaks() found, searches the curve if there are none
+	void updateSortedPeaks(const float *xData, const float *yData, int size);
 	bool m_handlesVisible;
 
 private:
 	void deinitFixedMarker();
 	void computePeakMarkers();
 	void computeFixedMarkerFrequency();
+	void runPeakSearch(const float *xData, const float *yData, int size);
+	void invalidatePeaks();
+	double noiseFloor(const float *yData, int size);
+
+	// guards m_peakSearch, m_complex and the peak settings - searchPeaks() runs on the acquisition thread
+	QMutex m_peakMutex;
+	bool m_peaksValid;
+	double m_peakThreshold;
+	std::vector<float> m_floorSamples;
+	std::atomic<bool> m_searchOnFrame;
 
 	bool m_enabled;
 
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SIGMFCAPTURE_H
+#define SIGMFCAPTURE_H
+
+#include "scopy-gui_export.h"
+
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+#include <vector>
+
+namespace scopy {
+
+/*
+ * Binary capture in the SigMF layout (https://sigmf.org): <name>.sigmf-data holds the
+ * samples as interleaved little endian float32 (one frame per sample, one value per
+ * channel) and <name>.sigmf-meta is a JSON sidecar with the sample rate, the tool
+ * that produced the capture and the name and unit of every channel.
+ *
+ * Captures are written in chunks, so a progress callback can report (and cancel)
+ * long exports, and are read through a memory mapping of the data file, so opening
+ * a capture costs nothing until samples are actually accessed.
+ */
+class SCOPY_GUI_EXPORT SigMFCapture
+{
+public:
+	typedef struct
+	{
+		double sampleRate;
+		QString tool;
+		QString description;
+		QStringList channelNames;
+		QStringList units;
+		qint64 nrOfSamples;
+	} Metadata;
+
+	// receives the percentage written so far, returning false cancels the write
+	typedef std::function<bool(int)> ProgressCallback;
+
+	SigMFCapture();
+	~SigMFCapture();
+
+	static bool isSigMF(const QString &path);
+	static QString dataPath(const QString &path);
+	static QString metaPath(const QString &path);
+
+	static bool writeMetadata(const QString &path, const Metadata &meta);
+	static bool readMetadata(const QString &path, Metadata &meta);
+
+	// data is indexed as data[sample][channel], the layout used by FileManager
+	static bool write(const QString &path, const Metadata &meta, const QVector<QVector<double>> &data,
+			  ProgressCallback progress = nullptr);
+
+	bool open(const QString &path);
+	void close();
+	bool isOpen() const;
+
+	const Metadata &metadata() const;
+	int nrOfChannels() const;
+	qint64 nrOfSamples() const;
+
+	// the mapped samples of every channel, interleaved. Valid until close()
+	const float *frames() const;
+	float sample(qint64 idx, int channel) const;
+	void channel(int channel, std::vector<float> &out) const;
+	void channel(int channel, QVector<double> &out) const;
+
+private:
+	QFile m_file;
+	const uchar *m_map;
+	Metadata m_meta;
+};
+
+} // namespace scopy
+
+#endif // SIGMFCAPTURE_H
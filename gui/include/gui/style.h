@@ -31,6 +31,8 @@
 #include <../gui/style_attributes.h>
 
 namespace scopy {
+struct StyleTable;
+
 class SCOPY_GUI_EXPORT Style : public QObject
 {
 	Q_OBJECT
@@ -42,7 +44,9 @@ private:
 	QString getThemeFromPkgs(QString theme);
 	QString getStylePath(QString relativePath);
 	void initPaths();
-	void generateStyle();
+	void generateStyle(StyleTable *table);
+	static StyleTable *compileTheme();
+	static QString resolveAttributes(const StyleTable *table, const QString &style, int calls_limit);
 	QString getAllProperties();
 	QFileInfoList getQssList(QString path);
 	static bool isProperty(QString style);
@@ -115,8 +119,8 @@ private:
 	static Style *pinstance_;
 	static QJsonDocument *m_global_json;
 	static QJsonDocument *m_theme_json;
-	static QMap<QString, QString> *m_styleMap;
-	static QMap<QString, QByteArray> *m_replacedProperties;
+	// the current theme compiled into lookup tables, replaced as a whole on theme change
+	static StyleTable *m_table;
 	QString m_globalJsonPath;
 	QString m_themeJsonPath;
 	QString m_qssGlobalFile;
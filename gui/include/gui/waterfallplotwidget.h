@@ -26,47 +26,110 @@
 #include "toolcomponent.h"
 #include "scopy-gui_export.h"
 
-#include <qwt_plot_spectrogram.h>
+#include <qwt_plot_item.h>
 #include <qwt_interval.h>
-#include <qwt_raster_data.h>
 #include <QwtLinearColorMap>
 #include <QElapsedTimer>
+#include <QImage>
 #include <plot_utils.hpp>
 
-#include <deque>
 #include <vector>
 
 namespace scopy {
 
-class SCOPY_GUI_EXPORT WaterfallData : public QwtRasterData
+/*
+ * History of the waterfall rows and the image they are drawn from.
+ *
+ * Rows are stored once, quantized to 16 bits (~0.01 dB steps), in a ring of
+ * maxRows rows. The image is a ring of the same height: every new row is
+ * colormapped through a lookup table into a single scanline, so adding a row
+ * costs O(fft size + image width) no matter how long the history is. The
+ * newest row is at head(), older rows follow it and wrap around.
+ *
+ * Only a new visible frequency range, width, intensity range or row count
+ * invalidates the image - it is then rebuilt from the quantized history the
+ * next time it is requested.
+ */
+class SCOPY_GUI_EXPORT WaterfallData
 {
 public:
 	explicit WaterfallData();
-	~WaterfallData() override;
+	~WaterfallData();
 
 	void addFFTData(const float *data, size_t size);
 	void reset();
 
 	void setXInterval(double minFreq, double maxFreq);
 	void setZInterval(double minDb, double maxDb);
+	QwtInterval interval(Qt::Axis axis) const;
 
 	void setMaxRows(int rows);
 	int maxRows() const;
 	int rowCount() const;
+	size_t fftSize() const;
 
 	void setAntialiasing(bool enabled);
+	bool antialiasing() const;
+
+	void setColorMap(const QwtColorMap &colorMap);
 
-	QwtInterval interval(Qt::Axis axis) const override;
-	double value(double x, double y) const override;
+	// x in Hz, y in rows from the newest one (0) to the oldest (maxRows)
+	double value(double x, double y) const;
+
+	// the ring image for the visible frequency range, one column per pixel
+	const QImage &image(double minX, double maxX, int width);
+	int head() const;
 
 private:
-	std::deque<std::vector<float>> m_data;
+	typedef struct
+	{
+		int first;
+		int last;
+		// < 0: peak of the bins in [first, last], otherwise interpolated between first and last
+		float t;
+	} Column;
+
+	void resizeHistory(int rows);
+	void invalidateImage();
+	void updateLut();
+	void updateColumns();
+	void renderRow(int slot);
+
+	std::vector<quint16> m_history;
 	int m_maxRows;
+	int m_rowCount;
+	int m_head;
 	size_t m_fftSize;
 	bool m_antialiasing;
 
 	QwtInterval m_xInterval;
 	QwtInterval m_zInterval;
+
+	QVector<QRgb> m_colors;
+	std::vector<QRgb> m_lut;
+	std::vector<Column> m_columns;
+
+	QImage m_image;
+	bool m_imageValid;
+	double m_imageMinX;
+	double m_imageMaxX;
+};
+
+// Draws the ring image of a WaterfallData with two blits split at the wrap point
+class SCOPY_GUI_EXPORT WaterfallPlotItem : public QwtPlotItem
+{
+public:
+	explicit WaterfallPlotItem(WaterfallData *data);
+	~WaterfallPlotItem() override;
+
+	WaterfallData *data() const;
+
+	QRectF boundingRect() const override;
+	void draw(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+		  const QRectF &canvasRect) const override;
+
+private:
+	WaterfallData *m_data;
 };
 
 class SCOPY_GUI_EXPORT WaterfallColorMap : public QwtLinearColorMap
@@ -117,7 +180,7 @@ public Q_SLOTS:
 	void setWaterfallEnabled(bool enabled);
 
 private:
-	QwtPlotSpectrogram *m_spectrogram;
+	WaterfallPlotItem *m_waterfall;
 	WaterfallData *m_data;
 	WaterfallTimeFormatter *m_timeFormatter;
 
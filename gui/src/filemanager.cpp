@@ -19,6 +19,7 @@
  */
 
 #include "filemanager.h"
+#include "sigmfcapture.h"
 
 #include <QDateTime>
 #include <QDebug>
@@ -36,6 +37,8 @@ FileManager::FileManager(QString toolName)
 	: hasHeader(false)
 	, sampleRate(0)
 	, nrOfSamples(0)
+	, openedFor(EXPORT)
+	, fileType(CSV)
 	, toolName(toolName)
 {}
 
@@ -60,15 +63,21 @@ void FileManager::open(QString fileName, FileManager::FilePurpose filepurpose)
 		separator = "\t";
 		fileType = TXT;
 		// find sep to read txt files
+	} else if(SigMFCapture::isSigMF(fileName)) {
+		fileType = SIGMF;
 	}
 
 	// clear previous data if the manager was used for other exports
+	capture.reset();
 	data.clear();
 	decoder_data.clear();
 	columnNames.clear();
+	units.clear();
 	this->filename = fileName;
 
-	if(filepurpose == IMPORT) {
+	if(filepurpose == IMPORT && fileType == SIGMF) {
+		openSigMF(fileName);
+	} else if(filepurpose == IMPORT) {
 
 		if(fileName.isEmpty()) {
 			throw FileManagerException("No file selected");
@@ -164,7 +173,30 @@ void FileManager::open(QString fileName, FileManager::FilePurpose filepurpose)
 	}
 }
 
-void FileManager::save(QVector<double> data, QString name)
+void FileManager::openSigMF(QString fileName)
+{
+	// nothing is copied here, read() takes the samples out of the mapping when they are needed
+	auto sigmf = std::make_shared<SigMFCapture>();
+	if(!sigmf->open(fileName)) {
+		throw FileManagerException("File is corrupted!");
+	}
+
+	const SigMFCapture::Metadata &meta = sigmf->metadata();
+
+	format = RAW;
+	hasHeader = false;
+	sampleRate = meta.sampleRate;
+	columnNames = meta.channelNames;
+	units = meta.units;
+	if(!meta.description.isEmpty()) {
+		additionalInformation.push_back(meta.description);
+	}
+
+	nrOfSamples = sigmf->nrOfSamples();
+	capture = sigmf;
+}
+
+void FileManager::save(const QVector<double> &data, QString name)
 {
 	this->columnNames.push_back(name);
 
@@ -177,7 +209,8 @@ void FileManager::save(QVector<double> data, QString name)
 	}
 }
 
-void FileManager::save(QVector<QVector<double>> data, QVector<QVector<QString>> decoder_data, QStringList columnNames)
+void FileManager::save(const QVector<QVector<double>> &data, const QVector<QVector<QString>> &decoder_data,
+		       const QStringList &columnNames)
 {
 	for(auto &column : data) {
 		this->data.push_back(column);
@@ -193,10 +226,13 @@ void FileManager::save(QVector<QVector<double>> data, QVector<QVector<QString>>
 	}
 }
 
-void FileManager::save(QVector<QVector<double>> data, QStringList columnNames)
+void FileManager::save(const QVector<QVector<double>> &data, const QStringList &columnNames)
 {
-	for(auto &column : data) {
-		this->data.push_back(column);
+	if(this->data.isEmpty()) {
+		// share the rows instead of copying them one by one
+		this->data = data;
+	} else {
+		this->data.append(data);
 	}
 
 	for(auto &column_name : columnNames) {
@@ -206,6 +242,12 @@ void FileManager::save(QVector<QVector<double>> data, QStringList columnNames)
 
 QVector<double> FileManager::read(int index)
 {
+	if(capture) {
+		QVector<double> column;
+		capture->channel(index, column);
+		return column;
+	}
+
 	if(index < 0 || index + 1 >= data.size()) {
 		return QVector<double>();
 	}
@@ -222,7 +264,23 @@ QVector<double> FileManager::read(int index)
 	return channel_data;
 }
 
-QVector<QVector<double>> FileManager::read() { return data; }
+QVector<QVector<double>> FileManager::read()
+{
+	if(!capture) {
+		return data;
+	}
+
+	// row major view of a capture, for the importers that work with rows
+	const int nrOfChannels = capture->nrOfChannels();
+	QVector<QVector<double>> rows(capture->nrOfSamples());
+	for(int i = 0; i < rows.size(); ++i) {
+		rows[i].resize(nrOfChannels);
+		for(int j = 0; j < nrOfChannels; ++j) {
+			rows[i][j] = capture->sample(i, j);
+		}
+	}
+	return rows;
+}
 
 void FileManager::setColumnName(int index, QString name)
 {
@@ -254,6 +312,10 @@ double FileManager::getNrOfSamples() const { return nrOfSamples; }
 
 int FileManager::getNrOfChannels() const
 {
+	if(capture) {
+		return capture->nrOfChannels();
+	}
+
 	if(data.size() == 0) {
 		return 0;
 	}
@@ -265,16 +327,25 @@ int FileManager::getNrOfChannels() const
 	}
 }
 
-void FileManager::performWrite(bool withScopyHeader)
+void FileManager::performWrite(bool withScopyHeader) { performWrite(withScopyHeader, nullptr); }
+
+bool FileManager::performWrite(bool withScopyHeader, const ProgressCallback &progress)
 {
 	QString additionalInfo = "";
 	if(openedFor == IMPORT) {
 		qDebug() << "Can't write when opened for import!";
-		return;
+		return false;
+	}
+
+	if(fileType == SIGMF) {
+		return performSigMFWrite(progress);
 	}
 
 	QFile exportFile(filename);
-	exportFile.open(QIODevice::WriteOnly);
+	if(!exportFile.open(QIODevice::WriteOnly)) {
+		qDebug() << "Can't open" << filename << "for writing!";
+		return false;
+	}
 	QTextStream exportStream(&exportFile);
 
 	additionalInfo = (additionalInformation.size() != 0) ? additionalInformation[0] : "";
@@ -304,7 +375,17 @@ void FileManager::performWrite(bool withScopyHeader)
 	}
 	exportStream << "\n";
 
+	int lastPercent = -1;
 	for(int i = 0; i < data.size(); ++i) {
+		const int percent = i * 100 / data.size();
+		if(progress && percent != lastPercent) {
+			lastPercent = percent;
+			if(!progress(percent)) {
+				exportFile.close();
+				return false;
+			}
+		}
+
 		skipFirstSeparator = true;
 		exportStream << QString::number(i) << separator;
 		for(int j = 0; j < data[i].size(); ++j) {
@@ -328,6 +409,31 @@ void FileManager::performWrite(bool withScopyHeader)
 	}
 
 	exportFile.close();
+	if(progress) {
+		progress(100);
+	}
+	return true;
+}
+
+bool FileManager::performSigMFWrite(const ProgressCallback &progress)
+{
+	SigMFCapture::Metadata meta = {
+		.sampleRate = sampleRate,
+		.tool = toolName,
+		.description = additionalInformation.isEmpty() ? "" : additionalInformation[0],
+		.channelNames = columnNames,
+		.units = units,
+		.nrOfSamples = data.size(),
+	};
+
+	return SigMFCapture::write(filename, meta, data, progress);
+}
+
+FileExportTask *FileManager::performWriteAsync(bool withScopyHeader, QObject *parent)
+{
+	FileExportTask *task = new FileExportTask(*this, withScopyHeader, parent);
+	QObject::connect(task, &QThread::finished, task, &QObject::deleteLater);
+	return task;
 }
 
 void FileManager::performDecoderWrite(bool skip_empty_lines)
@@ -396,6 +502,10 @@ FileManager::FileFormat FileManager::getFormat() const { return format; }
 
 void FileManager::setFormat(const FileManager::FileFormat &value) { format = value; }
 
+void FileManager::setUnits(const QStringList &units) { this->units = units; }
+
+QStringList FileManager::getUnits() const { return units; }
+
 void FileManager::writeToFile(bool overwrite, QMap<QString, QVector<QString>> data)
 {
 	QFile file(filename);
@@ -447,6 +557,33 @@ void FileManager::writeToFile(bool overwrite, QMap<QString, QVector<QString>> da
 	}
 }
 
+FileExportTask::FileExportTask(const FileManager &fm, bool withScopyHeader, QObject *parent)
+	: QThread(parent)
+	, m_fileManager(fm)
+	, m_withScopyHeader(withScopyHeader)
+	, m_cancelled(false)
+	, m_success(false)
+{}
+
+FileExportTask::~FileExportTask()
+{
+	cancel();
+	wait();
+}
+
+void FileExportTask::cancel() { m_cancelled = true; }
+
+bool FileExportTask::succeeded() const { return m_success; }
+
+void FileExportTask::run()
+{
+	m_success = m_fileManager.performWrite(m_withScopyHeader, [this](int percent) {
+		Q_EMIT progress(percent);
+		return !m_cancelled;
+	});
+	Q_EMIT exportFinished(m_success);
+}
+
 bool ScopyFileHeader::hasValidHeader(QVector<QVector<QString>> data)
 {
 
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "lodplotcurve.h"
+
+#include <QPainter>
+#include <QwtCPointerData>
+#include <QwtPainter>
+#include <QwtPointArrayData>
+#include <QwtScaleMap>
+#include <QwtSymbol>
+#include <algorithm>
+#include <cmath>
+
+using namespace scopy;
+
+// below this many visible samples per pixel column the curve is drawn as is
+#define LOD_SAMPLES_PER_COLUMN 4
+
+LodPlotCurve::LodPlotCurve(const QString &title)
+	: QwtPlotCurve(title)
+	, m_lodEnabled(true)
+	, m_appendOnly(false)
+	, m_dirty(true)
+	, m_monotonic(false)
+	, m_firstX(0)
+{}
+
+LodPlotCurve::~LodPlotCurve() {}
+
+bool LodPlotCurve::isLodEnabled() const { return m_lodEnabled; }
+
+void LodPlotCurve::setLodEnabled(bool enabled)
+{
+	m_lodEnabled = enabled;
+	itemChanged();
+}
+
+bool LodPlotCurve::appendOnly() const { return m_appendOnly; }
+
+void LodPlotCurve::setAppendOnly(bool appendOnly) { m_appendOnly = appendOnly; }
+
+void LodPlotCurve::invalidateLod() { m_dirty = true; }
+
+void LodPlotCurve::dataChanged()
+{
+	m_dirty = true;
+	QwtPlotCurve::dataChanged();
+}
+
+bool LodPlotCurve::lodApplicable() const
+{
+	if(!m_lodEnabled || testCurveAttribute(QwtPlotCurve::Fitted) || brush().style() != Qt::NoBrush) {
+		return false;
+	}
+	if(symbol() && symbol()->style() != QwtSymbol::NoSymbol) {
+		return false;
+	}
+	return style() == QwtPlotCurve::Lines || style() == QwtPlotCurve::Steps;
+}
+
+void LodPlotCurve::drawSeries(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+			      const QRectF &canvasRect, int from, int to) const
+{
+	const QwtSeriesData<QPointF> *series = data();
+	const int size = series ? series->size() : 0;
+	if(to < 0) {
+		to = size - 1;
+	}
+
+	// partial redraws (QwtPlotDirectPainter) are left to QwtPlotCurve
+	if(lodApplicable() && from == 0 && to == size - 1) {
+		if(auto d = dynamic_cast<const QwtCPointerData<float> *>(series)) {
+			if(drawEnvelope(painter, xMap, yMap, canvasRect, d->xData(), d->yData(), size)) {
+				return;
+			}
+		} else if(auto d = dynamic_cast<const QwtCPointerData<double> *>(series)) {
+			if(drawEnvelope(painter, xMap, yMap, canvasRect, d->xData(), d->yData(), size)) {
+				return;
+			}
+		} else if(auto d = dynamic_cast<const QwtPointArrayData<float> *>(series)) {
+			if(drawEnvelope(painter, xMap, yMap, canvasRect, d->xData().constData(),
+					d->yData().constData(), size)) {
+				return;
+			}
+		} else if(auto d = dynamic_cast<const QwtPointArrayData<double> *>(series)) {
+			if(drawEnvelope(painter, xMap, yMap, canvasRect, d->xData().constData(),
+					d->yData().constData(), size)) {
+				return;
+			}
+		}
+	}
+
+	QwtPlotCurve::drawSeries(painter, xMap, yMap, canvasRect, from, to);
+}
+
+template <typename T>
+bool LodPlotCurve::updateLod(const T *xData, const T *yData, size_t size) const
+{
+	if(!m_dirty && (!m_monotonic || m_lod.size() == size)) {
+		return m_monotonic;
+	}
+
+	size_t from = 0;
+	if(m_appendOnly && m_monotonic && m_lod.size() > 0 && size >= m_lod.size() && xData[0] == m_firstX) {
+		from = m_lod.size();
+	}
+
+	m_dirty = false;
+	m_monotonic = true;
+	for(size_t i = std::max<size_t>(from, 1); i < size; i++) {
+		if(xData[i] < xData[i - 1]) {
+			// XY style data, the pixel columns do not map to index ranges
+			m_monotonic = false;
+			m_lod.clear();
+			return false;
+		}
+	}
+
+	m_lod.update(yData, size, from);
+	m_firstX = size ? xData[0] : 0;
+	return true;
+}
+
+template <typename T>
+bool LodPlotCurve::drawEnvelope(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+				const QRectF &canvasRect, const T *xData, const T *yData, size_t size) const
+{
+	const int columns = std::ceil(canvasRect.width());
+	if(columns <= 0 || size < 2 || !updateLod(xData, yData, size)) {
+		return false;
+	}
+
+	const double left = canvasRect.left();
+	const double xLo = std::min(xMap.invTransform(left), xMap.invTransform(left + columns));
+	const double xHi = std::max(xMap.invTransform(left), xMap.invTransform(left + columns));
+
+	// visible samples, plus one on each side so the curve still reaches the canvas edges
+	size_t first = std::lower_bound(xData, xData + size, xLo) - xData;
+	size_t last = std::upper_bound(xData, xData + size, xHi) - xData;
+	first = (first > 0) ? first - 1 : 0;
+	last = std::min(last + 1, size);
+
+	if(last - first < (size_t)LOD_SAMPLES_PER_COLUMN * columns) {
+		QwtPlotCurve::drawSeries(painter, xMap, yMap, canvasRect, int(first), int(last - 1));
+		return true;
+	}
+
+	const bool inverted = xMap.transform(xLo) > xMap.transform(xHi);
+	QPolygonF polyline;
+	polyline.reserve(4 * columns + 2);
+
+	auto addSample = [&](size_t idx) {
+		if(!std::isnan(yData[idx])) {
+			polyline << QPointF(xMap.transform(xData[idx]), yMap.transform(yData[idx]));
+		}
+	};
+
+	addSample(first);
+	size_t begin = first + 1;
+	for(int col = 0; col < columns; col++) {
+		// walk the columns in increasing x order
+		const double px = inverted ? left + columns - col - 0.5 : left + col + 0.5;
+		const double xEnd = xMap.invTransform(inverted ? px - 0.5 : px + 0.5);
+		size_t end = last - 1;
+		if(col < columns - 1) {
+			end = std::lower_bound(xData + begin, xData + last - 1, xEnd) - xData;
+		}
+		if(end <= begin) {
+			continue;
+		}
+
+		double lo, hi;
+		m_lod.query(yData, begin, end, lo, hi);
+		if(std::isfinite(lo)) {
+			// entry and exit values keep the line continuous, min and max keep every peak
+			const double yFirst = std::isnan(yData[begin]) ? lo : yData[begin];
+			const double yLast = std::isnan(yData[end - 1]) ? hi : yData[end - 1];
+			polyline << QPointF(px, yMap.transform(yFirst)) << QPointF(px, yMap.transform(lo))
+				 << QPointF(px, yMap.transform(hi)) << QPointF(px, yMap.transform(yLast));
+		}
+		begin = end;
+	}
+	addSample(last - 1);
+
+	painter->setPen(pen());
+	painter->setBrush(Qt::NoBrush);
+	QwtPainter::drawPolyline(painter, polyline);
+	return true;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "minmaxlod.h"
+
+#include <algorithm>
+
+using namespace scopy;
+
+MinMaxLod::MinMaxLod()
+	: m_size(0)
+{}
+
+MinMaxLod::~MinMaxLod() {}
+
+void MinMaxLod::clear()
+{
+	m_min.clear();
+	m_max.clear();
+	m_size = 0;
+}
+
+size_t MinMaxLod::size() const { return m_size; }
+
+int MinMaxLod::levels() const { return m_min.size(); }
+
+void MinMaxLod::buildUpperLevels(size_t fromBlock)
+{
+	size_t level = 1;
+	while(m_min[level - 1].size() > 1) {
+		if(m_min.size() <= level) {
+			m_min.emplace_back();
+			m_max.emplace_back();
+		}
+
+		const std::vector<double> &lowerMin = m_min[level - 1];
+		const std::vector<double> &lowerMax = m_max[level - 1];
+		const size_t blocks = (lowerMin.size() + 1) / 2;
+
+		m_min[level].resize(blocks);
+		m_max[level].resize(blocks);
+
+		fromBlock /= 2;
+		for(size_t b = fromBlock; b < blocks; b++) {
+			const size_t l = 2 * b;
+			const size_t r = std::min(l + 1, lowerMin.size() - 1);
+			m_min[level][b] = std::min(lowerMin[l], lowerMin[r]);
+			m_max[level][b] = std::max(lowerMax[l], lowerMax[r]);
+		}
+		level++;
+	}
+
+	// the buffer may have shrunk, drop the levels above the root
+	m_min.resize(level);
+	m_max.resize(level);
+}
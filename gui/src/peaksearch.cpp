@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "peaksearch.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace scopy;
+
+PeakSearch::PeakSearch()
+	: m_maxPeaks(1)
+	, m_threshold(-std::numeric_limits<double>::infinity())
+	, m_minSeparation(0)
+	, m_interpolation(PI_NONE)
+{}
+
+PeakSearch::~PeakSearch() {}
+
+int PeakSearch::maxPeaks() const { return m_maxPeaks; }
+
+void PeakSearch::setMaxPeaks(int maxPeaks)
+{
+	m_maxPeaks = std::max(maxPeaks, 1);
+	m_heap.reserve(m_maxPeaks);
+	m_peaks.reserve(m_maxPeaks);
+}
+
+double PeakSearch::threshold() const { return m_threshold; }
+
+void PeakSearch::setThreshold(double threshold) { m_threshold = threshold; }
+
+int PeakSearch::minSeparation() const { return m_minSeparation; }
+
+void PeakSearch::setMinSeparation(int bins) { m_minSeparation = std::max(bins, 0); }
+
+PeakSearch::Interpolation PeakSearch::interpolation() const { return m_interpolation; }
+
+void PeakSearch::setInterpolation(Interpolation interpolation) { m_interpolation = interpolation; }
+
+const std::vector<PeakSearch::Peak> &PeakSearch::peaks() const { return m_peaks; }
+
+void PeakSearch::pushCandidate(const float *yData, int idx)
+{
+	// min-heap on y - front() is the smallest of the K peaks kept so far
+	auto cmp = [yData](int a, int b) { return yData[a] > yData[b]; };
+
+	if(static_cast<int>(m_heap.size()) < m_maxPeaks) {
+		m_heap.push_back(idx);
+		std::push_heap(m_heap.begin(), m_heap.end(), cmp);
+		return;
+	}
+
+	if(yData[idx] <= yData[m_heap.front()]) {
+		return;
+	}
+
+	std::pop_heap(m_heap.begin(), m_heap.end(), cmp);
+	m_heap.back() = idx;
+	std::push_heap(m_heap.begin(), m_heap.end(), cmp);
+}
+
+const std::vector<PeakSearch::Peak> &PeakSearch::search(const float *xData, const float *yData, int start, int stop)
+{
+	m_heap.clear();
+	m_peaks.clear();
+
+	start = std::max(start, 0);
+	if(!xData || !yData || stop - start < 3) {
+		return m_peaks;
+	}
+
+	const float threshold = std::max(m_threshold, (double)std::numeric_limits<float>::lowest());
+	int pending = -1;
+
+	for(int i = start + 1; i < stop - 1; i++) {
+		const float y = yData[i];
+		if(!(yData[i - 1] < y && y > yData[i + 1]) || y < threshold) {
+			continue;
+		}
+
+		// keep only the highest maximum out of a cluster closer than minSeparation
+		if(pending >= 0 && i - pending < m_minSeparation) {
+			if(y > yData[pending]) {
+				pending = i;
+			}
+			continue;
+		}
+
+		if(pending >= 0) {
+			pushCandidate(yData, pending);
+		}
+		pending = i;
+	}
+
+	if(pending >= 0) {
+		pushCandidate(yData, pending);
+	}
+
+	std::sort_heap(m_heap.begin(), m_heap.end(), [yData](int a, int b) { return yData[a] > yData[b]; });
+
+	for(int idx : m_heap) {
+		m_peaks.push_back(refine(xData, yData, stop, idx));
+	}
+
+	return m_peaks;
+}
+
+int PeakSearch::findMaxNear(const float *yData, int size, int idx, int range)
+{
+	int start = std::max(idx - range, 0);
+	int stop = std::min(idx + range + 1, size);
+	if(start >= stop) {
+		return std::min(std::max(idx, 0), size - 1);
+	}
+
+	return std::max_element(yData + start, yData + stop) - yData;
+}
+
+PeakSearch::Peak PeakSearch::refine(const float *xData, const float *yData, int size, int idx) const
+{
+	Peak p = {.x = xData[idx], .y = yData[idx], .idx = idx, .offset = 0};
+
+	if(m_interpolation == PI_NONE || idx <= 0 || idx >= size - 1) {
+		return p;
+	}
+
+	double a = yData[idx - 1];
+	double b = yData[idx];
+	double c = yData[idx + 1];
+
+	if(m_interpolation == PI_GAUSSIAN) {
+		if(a <= 0 || b <= 0 || c <= 0) {
+			return p;
+		}
+		a = std::log(a);
+		b = std::log(b);
+		c = std::log(c);
+	}
+
+	const double denom = a - 2 * b + c;
+	if(denom >= 0) {
+		// not a strict maximum (flat or inflection) - nothing to refine
+		return p;
+	}
+
+	const double offset = std::clamp(0.5 * (a - c) / denom, -0.5, 0.5);
+	const double y = b - 0.25 * (a - c) * offset;
+	const double binWidth = (offset >= 0) ? xData[idx + 1] - xData[idx] : xData[idx] - xData[idx - 1];
+
+	p.offset = offset;
+	p.x = xData[idx] + offset * binWidth;
+	p.y = (m_interpolation == PI_GAUSSIAN) ? std::exp(y) : y;
+	return p;
+}
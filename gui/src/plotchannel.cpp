@@ -21,6 +21,7 @@
 
 #include "plotchannel.h"
 #include "plotaxis.h"
+#include "lodplotcurve.h"
 #include <QPen>
 #include <QwtText>
 
@@ -41,7 +42,7 @@ PlotChannel::PlotChannel(QString name, QPen pen, PlotAxis *xAxis, PlotAxis *yAxi
 
 void PlotChannel::init()
 {
-	m_curve = new QwtPlotCurve(m_name);
+	m_curve = new LodPlotCurve(m_name);
 	m_curve->setAxes(m_xAxis->axisId(), m_yAxis->axisId());
 	m_curve->setStyle(QwtPlotCurve::Lines);
 	m_curve->setPen(m_pen);
@@ -23,8 +23,17 @@
 #include <plotcomponent.h>
 #include <qwt_text.h>
 
+#include <algorithm>
+
 using namespace scopy;
 
+// FFT noise peaks rarely rise more than this over the median of the bins
+#define PEAK_THRESHOLD_DEFAULT 10.0
+// half the main lobe of the widest window - closer maxima are the leakage of one tone
+#define PEAK_MIN_SEPARATION_DEFAULT 4
+// the noise floor is the median of at most this many bins, picked evenly over the curve
+#define NOISE_FLOOR_SAMPLES 4096
+
 PlotMarkerController::PlotMarkerController(PlotComponentChannel *ch, QObject *parent)
 	: QObject(parent)
 	, m_ch(ch)
@@ -49,6 +58,11 @@ void PlotMarkerController::init()
 	m_enabled = false;
 	m_complex = false;
 	m_handlesVisible = true;
+	m_peaksValid = false;
+	m_searchOnFrame = false;
+	m_peakThreshold = PEAK_THRESHOLD_DEFAULT;
+	m_peakSearch.setMinSeparation(PEAK_MIN_SEPARATION_DEFAULT);
+	m_floorSamples.reserve(NOISE_FLOOR_SAMPLES);
 	setNrOfMarkers(5);
 	setMarkerType(MC_NONE);
 }
@@ -64,6 +78,11 @@ void PlotMarkerController::setNrOfMarkers(int n)
 	m_markers.clear();
 
 	m_nrOfMarkers = n;
+	{
+		QMutexLocker lock(&m_peakMutex);
+		m_peakSearch.setMaxPeaks(n);
+		m_peaksValid = false;
+	}
 	if(m_markerType == MC_NONE) {
 		return;
 	}
@@ -93,6 +112,7 @@ void PlotMarkerController::setNrOfMarkers(int n)
 void PlotMarkerController::setMarkerType(MarkerTypes v)
 {
 	m_markerType = v;
+	invalidatePeaks();
 	setNrOfMarkers(m_nrOfMarkers);
 
 	Q_EMIT markerEnabled(m_enabled && m_markerType != MC_NONE);
@@ -200,7 +220,88 @@ void PlotMarkerController::setPlot(QwtPlot *p)
 	}
 }
 
-void PlotMarkerController::setComplex(bool b) { m_complex = b; }
+void PlotMarkerController::setComplex(bool b)
+{
+	QMutexLocker lock(&m_peakMutex);
+	m_complex = b;
+	m_peaksValid = false;
+}
+
+double PlotMarkerController::peakThreshold() const { return m_peakThreshold; }
+
+void PlotMarkerController::setPeakThreshold(double aboveFloor)
+{
+	QMutexLocker lock(&m_peakMutex);
+	m_peakThreshold = aboveFloor;
+	m_peaksValid = false;
+}
+
+int PlotMarkerController::peakMinSeparation() const { return m_peakSearch.minSeparation(); }
+
+void PlotMarkerController::setPeakMinSeparation(int bins)
+{
+	QMutexLocker lock(&m_peakMutex);
+	m_peakSearch.setMinSeparation(bins);
+	m_peaksValid = false;
+}
+
+void PlotMarkerController::invalidatePeaks()
+{
+	m_searchOnFrame = m_enabled && (m_markerType == MC_PEAK || m_markerType == MC_SINGLETONE ||
+					m_markerType == MC_IMAGE);
+	QMutexLocker lock(&m_peakMutex);
+	m_peaksValid = false;
+}
+
+void PlotMarkerController::searchPeaks(const float *xData, const float *yData, int size)
+{
+	QMutexLocker lock(&m_peakMutex);
+	if(!m_searchOnFrame) {
+		m_peaksValid = false;
+		return;
+	}
+	runPeakSearch(xData, yData, size);
+}
+
+void PlotMarkerController::updateSortedPeaks(const float *xData, const float *yData, int size)
+{
+	QMutexLocker lock(&m_peakMutex);
+	if(!m_peaksValid) {
+		// a setting changed since the frame was searched, or no frame was searched yet
+		runPeakSearch(xData, yData, size);
+	}
+
+	m_sortedPeakInfo.clear();
+	for(const PeakSearch::Peak &p : m_peakSearch.peaks()) {
+		m_sortedPeakInfo.append({.x = p.x, .y = p.y, .idx = p.idx});
+	}
+}
+
+void PlotMarkerController::runPeakSearch(const float *xData, const float *yData, int size)
+{
+	int stop = (m_complex) ? size : size / 2;
+	m_peakSearch.setThreshold(noiseFloor(yData, stop) + m_peakThreshold);
+	m_peakSearch.search(xData, yData, 0, stop);
+	m_peaksValid = true;
+}
+
+double PlotMarkerController::noiseFloor(const float *yData, int size)
+{
+	if(!yData || size <= 0) {
+		return -std::numeric_limits<double>::infinity();
+	}
+
+	// a handful of tones barely moves the median, so it sits on the noise
+	const int step = (size + NOISE_FLOOR_SAMPLES - 1) / NOISE_FLOOR_SAMPLES;
+	m_floorSamples.clear();
+	for(int i = 0; i < size; i += step) {
+		m_floorSamples.push_back(yData[i]);
+	}
+
+	auto mid = m_floorSamples.begin() + m_floorSamples.size() / 2;
+	std::nth_element(m_floorSamples.begin(), mid, m_floorSamples.end());
+	return *mid;
+}
 
 void PlotMarkerController::computePeakMarkers()
 {
@@ -242,6 +343,7 @@ bool PlotMarkerController::enabled() const { return m_enabled; }
 void PlotMarkerController::setEnabled(bool newEnabled)
 {
 	m_enabled = newEnabled;
+	invalidatePeaks();
 	for(int i = 0; i < m_markers.count(); i++) {
 		if(m_enabled) {
 			m_markers[i]->setVisible(true);
@@ -40,6 +40,7 @@
 #include <QwtPlotCanvas>
 #include <qwt_scale_widget.h>
 
+#include <common/tracer.h>
 #include <osc_scale_engine.h>
 #include <pluginbase/preferences.h>
 
@@ -238,7 +239,11 @@ QwtPlot *PlotWidget::plot() const { return m_plot; }
 
 QGridLayout *PlotWidget::layout() { return m_layout; }
 
-void PlotWidget::replot() { m_plot->replot(); }
+void PlotWidget::replot()
+{
+	SCOPY_TRACE_SCOPE("PlotWidget::replot");
+	m_plot->replot();
+}
 
 void PlotWidget::hideAxisLabels()
 {
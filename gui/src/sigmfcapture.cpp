@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "sigmfcapture.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QSaveFile>
+#include <QtEndian>
+#include <algorithm>
+
+#include <common/scopy-common_config.h>
+
+Q_LOGGING_CATEGORY(CAT_SIGMF, "SigMFCapture")
+
+using namespace scopy;
+
+#define SIGMF_DATA_EXT ".sigmf-data"
+#define SIGMF_META_EXT ".sigmf-meta"
+#define SIGMF_VERSION "1.0.0"
+#define SIGMF_DATATYPE "rf32_le"
+// frames converted and written per chunk, bounds the scratch buffer and the progress granularity
+#define SIGMF_CHUNK_FRAMES 65536
+
+SigMFCapture::SigMFCapture()
+	: m_map(nullptr)
+	, m_meta({.sampleRate = 0, .nrOfSamples = 0})
+{}
+
+SigMFCapture::~SigMFCapture() { close(); }
+
+bool SigMFCapture::isSigMF(const QString &path)
+{
+	return path.endsWith(SIGMF_DATA_EXT, Qt::CaseInsensitive) ||
+		path.endsWith(SIGMF_META_EXT, Qt::CaseInsensitive);
+}
+
+static QString basePath(const QString &path)
+{
+	if(SigMFCapture::isSigMF(path)) {
+		return path.left(path.lastIndexOf('.'));
+	}
+	return path;
+}
+
+QString SigMFCapture::dataPath(const QString &path) { return basePath(path) + SIGMF_DATA_EXT; }
+
+QString SigMFCapture::metaPath(const QString &path) { return basePath(path) + SIGMF_META_EXT; }
+
+bool SigMFCapture::writeMetadata(const QString &path, const Metadata &meta)
+{
+	QJsonArray channels;
+	for(int i = 0; i < meta.channelNames.size(); i++) {
+		QJsonObject ch;
+		ch["name"] = meta.channelNames[i];
+		ch["unit"] = (i < meta.units.size()) ? meta.units[i] : "";
+		channels.append(ch);
+	}
+
+	QJsonObject global;
+	global["core:datatype"] = SIGMF_DATATYPE;
+	global["core:version"] = SIGMF_VERSION;
+	global["core:num_channels"] = meta.channelNames.size();
+	global["core:recorder"] = QString("Scopy ") + SCOPY_VERSION_GIT;
+	if(meta.sampleRate > 0) {
+		global["core:sample_rate"] = meta.sampleRate;
+	}
+	if(!meta.description.isEmpty()) {
+		global["core:description"] = meta.description;
+	}
+	global["scopy:tool"] = meta.tool;
+	global["scopy:channels"] = channels;
+
+	QJsonObject capture;
+	capture["core:sample_start"] = 0;
+	capture["core:datetime"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+
+	QJsonObject root;
+	root["global"] = global;
+	root["captures"] = QJsonArray({capture});
+	root["annotations"] = QJsonArray();
+
+	QSaveFile file(metaPath(path));
+	if(!file.open(QIODevice::WriteOnly)) {
+		qWarning(CAT_SIGMF) << "Can't open" << file.fileName() << "for writing";
+		return false;
+	}
+	file.write(QJsonDocument(root).toJson());
+	return file.commit();
+}
+
+bool SigMFCapture::readMetadata(const QString &path, Metadata &meta)
+{
+	QFile file(metaPath(path));
+	if(!file.open(QIODevice::ReadOnly)) {
+		qWarning(CAT_SIGMF) << "Can't open" << file.fileName();
+		return false;
+	}
+
+	QJsonParseError err;
+	QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &err);
+	if(err.error != QJsonParseError::NoError || !doc.isObject()) {
+		qWarning(CAT_SIGMF) << "Invalid metadata in" << file.fileName() << ":" << err.errorString();
+		return false;
+	}
+
+	QJsonObject global = doc.object().value("global").toObject();
+	if(global.value("core:datatype").toString() != SIGMF_DATATYPE) {
+		qWarning(CAT_SIGMF) << "Unsupported datatype" << global.value("core:datatype").toString();
+		return false;
+	}
+
+	meta.sampleRate = global.value("core:sample_rate").toDouble(0);
+	meta.description = global.value("core:description").toString();
+	meta.tool = global.value("scopy:tool").toString();
+	meta.channelNames.clear();
+	meta.units.clear();
+
+	int nrOfChannels = global.value("core:num_channels").toInt(1);
+	QJsonArray channels = global.value("scopy:channels").toArray();
+	for(int i = 0; i < nrOfChannels; i++) {
+		QJsonObject ch = channels.at(i).toObject();
+		meta.channelNames.append(ch.value("name").toString("Channel " + QString::number(i)));
+		meta.units.append(ch.value("unit").toString());
+	}
+
+	qint64 frameSize = nrOfChannels * sizeof(float);
+	meta.nrOfSamples = (frameSize > 0) ? QFileInfo(dataPath(path)).size() / frameSize : 0;
+	return nrOfChannels > 0;
+}
+
+bool SigMFCapture::write(const QString &path, const Metadata &meta, const QVector<QVector<double>> &data,
+			 ProgressCallback progress)
+{
+	const int nrOfChannels = meta.channelNames.size();
+	const qint64 nrOfSamples = data.size();
+
+	QSaveFile file(dataPath(path));
+	if(nrOfChannels == 0 || !file.open(QIODevice::WriteOnly)) {
+		qWarning(CAT_SIGMF) << "Can't write capture to" << file.fileName();
+		return false;
+	}
+
+	std::vector<float> frames(SIGMF_CHUNK_FRAMES * nrOfChannels);
+	int lastPercent = -1;
+
+	for(qint64 start = 0; start < nrOfSamples; start += SIGMF_CHUNK_FRAMES) {
+		const qint64 count = std::min<qint64>(SIGMF_CHUNK_FRAMES, nrOfSamples - start);
+		float *dst = frames.data();
+		for(qint64 i = start; i < start + count; i++) {
+			const QVector<double> &row = data[i];
+			for(int ch = 0; ch < nrOfChannels; ch++) {
+				*dst++ = (ch < row.size()) ? static_cast<float>(row[ch]) : 0.0f;
+			}
+		}
+
+		const qint64 bytes = count * nrOfChannels * sizeof(float);
+		qToLittleEndian<float>(frames.data(), count * nrOfChannels, frames.data());
+		if(file.write(reinterpret_cast<const char *>(frames.data()), bytes) != bytes) {
+			qWarning(CAT_SIGMF) << "Write failed:" << file.errorString();
+			file.cancelWriting();
+			return false;
+		}
+
+		const int percent = (start + count) * 100 / nrOfSamples;
+		if(progress && percent != lastPercent) {
+			lastPercent = percent;
+			if(!progress(percent)) {
+				file.cancelWriting();
+				return false;
+			}
+		}
+	}
+
+	if(!file.commit()) {
+		return false;
+	}
+
+	Metadata written = meta;
+	written.nrOfSamples = nrOfSamples;
+	return writeMetadata(path, written);
+}
+
+bool SigMFCapture::open(const QString &path)
+{
+	close();
+
+	if(!readMetadata(path, m_meta)) {
+		return false;
+	}
+
+	m_file.setFileName(dataPath(path));
+	if(!m_file.open(QIODevice::ReadOnly)) {
+		qWarning(CAT_SIGMF) << "Can't open" << m_file.fileName();
+		return false;
+	}
+
+	if(m_meta.nrOfSamples == 0) {
+		return true;
+	}
+
+	m_map = m_file.map(0, m_meta.nrOfSamples * nrOfChannels() * sizeof(float));
+	if(!m_map) {
+		qWarning(CAT_SIGMF) << "Can't map" << m_file.fileName() << ":" << m_file.errorString();
+		m_file.close();
+		return false;
+	}
+	return true;
+}
+
+void SigMFCapture::close()
+{
+	if(m_map) {
+		m_file.unmap(const_cast<uchar *>(m_map));
+		m_map = nullptr;
+	}
+	if(m_file.isOpen()) {
+		m_file.close();
+	}
+}
+
+bool SigMFCapture::isOpen() const { return m_file.isOpen(); }
+
+const SigMFCapture::Metadata &SigMFCapture::metadata() const { return m_meta; }
+
+int SigMFCapture::nrOfChannels() const { return m_meta.channelNames.size(); }
+
+qint64 SigMFCapture::nrOfSamples() const { return m_map ? m_meta.nrOfSamples : 0; }
+
+const float *SigMFCapture::frames() const { return reinterpret_cast<const float *>(m_map); }
+
+float SigMFCapture::sample(qint64 idx, int channel) const
+{
+	return qFromLittleEndian<float>(m_map + (idx * nrOfChannels() + channel) * sizeof(float));
+}
+
+template <typename T>
+static void readChannel(const SigMFCapture &capture, int channel, T &out)
+{
+	const qint64 nrOfSamples = capture.nrOfSamples();
+	const int stride = capture.nrOfChannels();
+	if(channel < 0 || channel >= stride) {
+		out.clear();
+		return;
+	}
+	out.resize(nrOfSamples);
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+	const float *src = capture.frames() + channel;
+	for(qint64 i = 0; i < nrOfSamples; i++, src += stride) {
+		out[i] = *src;
+	}
+#else
+	for(qint64 i = 0; i < nrOfSamples; i++) {
+		out[i] = capture.sample(i, channel);
+	}
+#endif
+}
+
+void SigMFCapture::channel(int channel, std::vector<float> &out) const { readChannel(*this, channel, out); }
+
+void SigMFCapture::channel(int channel, QVector<double> &out) const { readChannel(*this, channel, out); }
@@ -34,6 +34,7 @@
 #include <QDirIterator>
 #include <QFontDatabase>
 #include <QLoggingCategory>
+#include <QRegularExpression>
 
 #include <common/scopyconfig.h>
 
@@ -41,11 +42,30 @@ Q_LOGGING_CATEGORY(CAT_STYLE, "STYLE");
 
 using namespace scopy;
 
+namespace scopy {
+// The theme and global json compiled into flat tables. Attribute references (&key&) are resolved once,
+// when the theme is set, so a lookup is a hash of the key followed by an index into the value arrays
+struct StyleTable
+{
+	QHash<QByteArray, int> ids;
+	QVector<QString> values;
+	QVector<QColor> colors;
+	QVector<int> dimensions;
+	// property names the theme redirects to another property
+	QHash<QByteArray, QByteArray> properties;
+	// the rendered qss of every file, by file base name. Ordered, the global stylesheet concatenates them
+	QMap<QByteArray, QString> styles;
+};
+} // namespace scopy
+
+static inline QByteArray rawKey(const char *key) { return QByteArray::fromRawData(key, qstrlen(key)); }
+
+static inline int attributeId(const StyleTable *table, const char *key) { return table->ids.value(rawKey(key), -1); }
+
 Style *Style::pinstance_{nullptr};
 QJsonDocument *Style::m_global_json{new QJsonDocument()};
 QJsonDocument *Style::m_theme_json{new QJsonDocument()};
-QMap<QString, QString> *Style::m_styleMap{new QMap<QString, QString>()};
-QMap<QString, QByteArray> *Style::m_replacedProperties{new QMap<QString, QByteArray>()};
+StyleTable *Style::m_table{new StyleTable()};
 QFileInfoList Style::m_pkgThemes{};
 QFileInfoList Style::m_pkgQss{};
 
@@ -61,12 +81,7 @@ Style::Style(QObject *parent)
 	initPaths();
 }
 
-Style::~Style()
-{
-	if(m_replacedProperties) {
-		m_replacedProperties->clear();
-	}
-}
+Style::~Style() {}
 
 Style *Style::GetInstance()
 {
@@ -137,19 +152,26 @@ QString Style::getThemePath(QString theme)
 void Style::setStyle(QWidget *widget, const char *style, QVariant value, bool force)
 {
 	style = replaceProperty(style);
-	if(!m_styleMap->contains(style)) {
+	auto qss = m_table->styles.constFind(rawKey(style));
+	if(qss == m_table->styles.constEnd()) {
 		qCritical(CAT_STYLE) << "Style: Failed to set style: " << widget->objectName().toStdString().c_str()
 				     << " to widget: " << style;
 	}
 
 	// set property stylesheet directly to the widget
 	// this may be used if the property was overwritten or was not recognized
-	if(force) {
-		widget->setStyleSheet(widget->styleSheet() + "\n" + m_styleMap->value(style));
+	if(force && qss != m_table->styles.constEnd()) {
+		widget->setStyleSheet(widget->styleSheet() + "\n" + qss.value());
 	}
 
 	widget->setProperty(style, value);
 
+	// a widget that was not polished yet picks the property up when it is first shown,
+	// polishing it here would only compute a style that is thrown away at show
+	if(!widget->testAttribute(Qt::WA_WState_Polished)) {
+		return;
+	}
+
 	// update widget
 	widget->style()->unpolish(widget);
 	widget->style()->polish(widget);
@@ -197,13 +219,16 @@ bool Style::setTheme(QString themePath, float fontScale)
 
 		m_theme_json = new QJsonDocument(QJsonDocument::fromJson(theme_data));
 
-		// Clear the replaced properties cache when theme changes
-		if(m_replacedProperties) {
-			m_replacedProperties->clear();
-		}
-
 		adjustJsonForScaling(fontScale);
-		generateStyle();
+
+		// build the new tables aside and swap them in once complete
+		StyleTable *table = compileTheme();
+		generateStyle(table);
+		StyleTable *old = m_table;
+		m_table = table;
+		delete old;
+
+		setGlobalStyle();
 		QIcon::setThemeName(getAttribute(json::theme::icon_theme_folder));
 	} else {
 		qCritical(CAT_STYLE) << "Style: Failed set theme: " << themePath.toStdString().c_str();
@@ -259,12 +284,8 @@ void Style::adjustJsonForScaling(float scale)
 
 QString Style::getAttribute(const char *key)
 {
-	QString attr = m_theme_json->object().value(key).toString();
-	if(attr.isEmpty()) {
-		attr = m_global_json->object().value(key).toString();
-	}
-
-	return replaceAttributes(attr);
+	int id = attributeId(m_table, key);
+	return (id < 0) ? QString() : m_table->values[id];
 }
 
 QColor Style::getChannelColor(int index)
@@ -308,76 +329,133 @@ void Style::setBackgroundColor(QWidget *widget, QString color, bool extend_to_ch
 	}
 }
 
-QColor Style::getColor(const char *key) { return QColor(getAttribute(key)); }
+QColor Style::getColor(const char *key)
+{
+	int id = attributeId(m_table, key);
+	return (id < 0) ? QColor() : m_table->colors[id];
+}
 
 int Style::getDimension(const char *key)
 {
-	QString attr = getAttribute(key);
-	int number = attr.toInt();
-
-	// this is for attributes with a string suffix. like "10px"
-	if(number == 0) {
-		QRegularExpression regex("(\\d+)");
-		QRegularExpressionMatch match = regex.match(attr);
+	int id = attributeId(m_table, key);
+	return (id < 0) ? 0 : m_table->dimensions[id];
+}
 
-		if(match.hasMatch()) {
-			QString numberStr = match.captured(1);
-			number = numberStr.toInt();
-		}
+const char *Style::replaceProperty(const char *prop)
+{
+	auto it = m_table->properties.constFind(rawKey(prop));
+	if(it != m_table->properties.constEnd()) {
+		return it.value().constData();
 	}
 
-	return number;
+	return prop;
 }
 
-const char *Style::replaceProperty(const char *prop)
+QString Style::replaceAttributes(QString style, int calls_limit)
 {
-	QString propStr(prop);
+	return resolveAttributes(m_table, style, calls_limit);
+}
 
-	// Check if we already have this property cached
-	if(m_replacedProperties->contains(propStr)) {
-		return m_replacedProperties->value(propStr).constData();
+QString Style::resolveAttributes(const StyleTable *table, const QString &style, int calls_limit)
+{
+	if(!style.contains('&')) {
+		return style;
 	}
 
-	// Check if this property needs replacement
-	for(const QString &key : m_theme_json->object().keys()) {
-		if(prop == key) {
-			QJsonValue value = m_theme_json->object().value(key);
-			// Store the replaced value in our map to avoid memory leak
-			(*m_replacedProperties)[propStr] = value.toString().toLocal8Bit();
-			return m_replacedProperties->value(propStr).constData();
+	// single pass over the string, every &key& found in the table is replaced by its value
+	QString result;
+	result.reserve(style.size());
+	int pos = 0;
+	while(pos < style.size()) {
+		int start = style.indexOf('&', pos);
+		int end = (start < 0) ? -1 : style.indexOf('&', start + 1);
+		if(end < 0) {
+			result += style.midRef(pos);
+			break;
 		}
+
+		result += style.midRef(pos, start - pos);
+		int id = table->ids.value(style.midRef(start + 1, end - start - 1).toLatin1(), -1);
+		if(id < 0) {
+			// not a key, keep the first '&' and look for a key starting at the second one
+			result += '&';
+			pos = start + 1;
+			continue;
+		}
+
+		result += table->values[id];
+		pos = end + 1;
 	}
 
-	return prop;
+	// values may hold references themselves
+	if(result.contains('&') && result != style && calls_limit > 0) {
+		return resolveAttributes(table, result, calls_limit - 1);
+	}
+	if(result.contains('&')) {
+		qCritical(CAT_STYLE) << "Style: Failed to replace attribute: "
+				     << result.split('&')[1].toStdString().c_str();
+	}
+
+	return result;
 }
 
-QString Style::replaceAttributes(QString style, int calls_limit)
+StyleTable *Style::compileTheme()
 {
-	if(style.contains('&') && calls_limit > 0) {
-		for(const QString &key : m_theme_json->object().keys()) {
-			QString value = m_theme_json->object().value(key).toString();
-			style.replace("&" + key + "&", value);
-		}
-		for(const QString &key : m_global_json->object().keys()) {
-			QString value = m_global_json->object().value(key).toString();
-			style.replace("&" + key + "&", value);
+	StyleTable *table = new StyleTable();
+	const QJsonObject theme = m_theme_json->object();
+	const QJsonObject global = m_global_json->object();
+
+	// the theme overrides the global attributes, unless its value is empty
+	for(const QJsonObject &obj : {global, theme}) {
+		for(auto it = obj.constBegin(); it != obj.constEnd(); ++it) {
+			QByteArray key = it.key().toLatin1();
+			int id = table->ids.value(key, -1);
+			if(id < 0) {
+				id = table->values.size();
+				table->ids.insert(key, id);
+				table->values.append(QString());
+			}
+			QString value = it.value().toString();
+			if(!value.isEmpty()) {
+				table->values[id] = value;
+			}
 		}
+	}
 
-		style = replaceAttributes(style, --calls_limit);
+	for(auto it = theme.constBegin(); it != theme.constEnd(); ++it) {
+		table->properties.insert(it.key().toLatin1(), it.value().toString().toLocal8Bit());
 	}
-	if(style.contains('&')) {
-		qCritical(CAT_STYLE) << "Style: Failed to replace attribute: "
-				     << style.split('&')[1].toStdString().c_str();
+
+	// values may reference other attributes, resolve them in place. Later lookups see resolved values
+	for(QString &value : table->values) {
+		value = resolveAttributes(table, value, 10);
 	}
 
-	return style;
+	static const QRegularExpression number("(\\d+)");
+	table->colors.reserve(table->values.size());
+	table->dimensions.reserve(table->values.size());
+	for(const QString &value : qAsConst(table->values)) {
+		table->colors.append(QColor::isValidColor(value) ? QColor(value) : QColor());
+
+		// this is for attributes with a string suffix. like "10px"
+		int dimension = value.toInt();
+		if(dimension == 0) {
+			QRegularExpressionMatch match = number.match(value);
+			if(match.hasMatch()) {
+				dimension = match.captured(1).toInt();
+			}
+		}
+		table->dimensions.append(dimension);
+	}
+
+	return table;
 }
 
 void Style::setPkgsThemes(QFileInfoList infoList) { m_pkgThemes = infoList; }
 
 void Style::setPkgsQss(QFileInfoList infoList) { m_pkgQss = infoList; }
 
-void Style::generateStyle()
+void Style::generateStyle(StyleTable *table)
 {
 	QFileInfoList qssList = getQssList(m_qssFolderPath);
 	qssList.append(m_pkgQss);
@@ -385,18 +463,17 @@ void Style::generateStyle()
 		QFile file(fInfo.filePath());
 		if(file.open(QIODevice::ReadOnly)) {
 			QString data = QString(file.readAll());
-			m_styleMap->insert(fInfo.baseName(), replaceAttributes(data));
+			table->styles.insert(fInfo.baseName().toLatin1(), resolveAttributes(table, data, 10));
 		}
 	}
-	setGlobalStyle();
 }
 
 QString Style::getAllProperties()
 {
 	QString style;
-	for(auto it = m_styleMap->keyValueBegin(); it != m_styleMap->keyValueEnd(); ++it) {
-		if(isProperty(it->first)) {
-			style += it->second + "\n";
+	for(auto it = m_table->styles.constBegin(); it != m_table->styles.constEnd(); ++it) {
+		if(isProperty(it.key())) {
+			style += it.value() + "\n";
 		}
 	}
 
@@ -417,13 +494,16 @@ QFileInfoList Style::getQssList(QString path)
 void Style::setGlobalStyle(QWidget *widget)
 {
 	if(widget) {
-		widget->setStyleSheet(m_styleMap->value(m_qssGlobalFile));
+		widget->setStyleSheet(m_table->styles.value(m_qssGlobalFile.toLatin1()));
 	} else {
-		qApp->setStyleSheet(getAllProperties() + m_styleMap->value(m_qssGlobalFile));
+		qApp->setStyleSheet(getAllProperties() + m_table->styles.value(m_qssGlobalFile.toLatin1()));
 	}
 }
 
-void Style::setM2KStylesheet(QWidget *widget) { widget->setStyleSheet(m_styleMap->value(m_m2kqssFile)); }
+void Style::setM2KStylesheet(QWidget *widget)
+{
+	widget->setStyleSheet(m_table->styles.value(m_m2kqssFile.toLatin1()));
+}
 
 QString Style::scaleNumberInString(QString string, float factor)
 {
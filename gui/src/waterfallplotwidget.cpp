@@ -28,7 +28,10 @@
 #include <pluginbase/preferences.h>
 #include <plot_utils.hpp>
 
+#include <QPainter>
 #include <qwt_scale_widget.h>
+#include <qwt_text.h>
+#include <algorithm>
 #include <cfloat>
 #include <vector>
 
@@ -38,54 +41,85 @@ using namespace scopy;
 // WaterfallData
 // =============================================================================
 
+// quantization of the history: 16 bit steps over [-256, 256) dB, 0 is also used for NaN
+#define WATERFALL_Q_MIN -256.0
+#define WATERFALL_Q_STEP (512.0 / 65536)
+#define WATERFALL_Q_LEVELS 65536
+
+static quint16 quantize(float v)
+{
+	if(!(v == v)) {
+		return 0;
+	}
+	const double q = std::round((v - WATERFALL_Q_MIN) / WATERFALL_Q_STEP);
+	return static_cast<quint16>(std::clamp(q, 0.0, WATERFALL_Q_LEVELS - 1.0));
+}
+
+static double dequantize(quint16 q) { return WATERFALL_Q_MIN + q * WATERFALL_Q_STEP; }
+
 WaterfallData::WaterfallData()
-	: QwtRasterData()
-	, m_maxRows(0)
+	: m_maxRows(0)
+	, m_rowCount(0)
+	, m_head(0)
 	, m_fftSize(0)
 	, m_antialiasing(true)
 	, m_xInterval(0.0, 1.0)
 	, m_zInterval(-120.0, 0.0)
-{}
+	, m_imageValid(false)
+	, m_imageMinX(0)
+	, m_imageMaxX(0)
+{
+	setColorMap(WaterfallColorMap());
+}
 
 WaterfallData::~WaterfallData() {}
 
 void WaterfallData::addFFTData(const float *data, size_t size)
 {
-	if(!data || size == 0)
+	if(!data || size == 0 || m_maxRows <= 0)
 		return;
 
-	if(m_fftSize == 0)
-		m_fftSize = size;
-
 	if(size != m_fftSize) {
-		m_data.clear();
 		m_fftSize = size;
+		m_history.assign(m_maxRows * m_fftSize, 0);
+		m_rowCount = 0;
+		m_head = 0;
+		invalidateImage();
 	}
 
-	m_data.push_back(std::vector<float>(data, data + size));
-
-	while(static_cast<int>(m_data.size()) > m_maxRows)
-		m_data.pop_front();
-}
+	// the ring grows towards lower slots, so the rows from head on are ordered newest to oldest
+	m_head = (m_head + m_maxRows - 1) % m_maxRows;
+	m_rowCount = std::min(m_rowCount + 1, m_maxRows);
 
-void WaterfallData::reset() { m_data.clear(); }
-
-void WaterfallData::setXInterval(double minFreq, double maxFreq) { m_xInterval = QwtInterval(minFreq, maxFreq); }
+	quint16 *row = m_history.data() + m_head * m_fftSize;
+	for(size_t i = 0; i < size; i++) {
+		row[i] = quantize(data[i]);
+	}
 
-void WaterfallData::setZInterval(double minDb, double maxDb) { m_zInterval = QwtInterval(minDb, maxDb); }
+	if(m_imageValid) {
+		renderRow(m_head);
+	}
+}
 
-void WaterfallData::setMaxRows(int rows)
+void WaterfallData::reset()
 {
-	if(rows <= 0)
-		return;
-	m_maxRows = rows;
+	m_rowCount = 0;
+	m_head = 0;
+	invalidateImage();
 }
 
-int WaterfallData::maxRows() const { return m_maxRows; }
-
-int WaterfallData::rowCount() const { return static_cast<int>(m_data.size()); }
+void WaterfallData::setXInterval(double minFreq, double maxFreq)
+{
+	m_xInterval = QwtInterval(minFreq, maxFreq);
+	invalidateImage();
+}
 
-void WaterfallData::setAntialiasing(bool enabled) { m_antialiasing = enabled; }
+void WaterfallData::setZInterval(double minDb, double maxDb)
+{
+	m_zInterval = QwtInterval(minDb, maxDb);
+	updateLut();
+	invalidateImage();
+}
 
 QwtInterval WaterfallData::interval(Qt::Axis axis) const
 {
@@ -101,45 +135,229 @@ QwtInterval WaterfallData::interval(Qt::Axis axis) const
 	}
 }
 
-double WaterfallData::value(double x, double y) const
+void WaterfallData::setMaxRows(int rows)
 {
-	// yes, this actually happens if plot width or height is 0
-	if(!std::isfinite(x) || !std::isfinite(y))
-		return -DBL_MAX;
+	if(rows <= 0 || rows == m_maxRows)
+		return;
+	resizeHistory(rows);
+}
 
-	if(m_data.empty() || m_fftSize == 0)
-		return -DBL_MAX;
+int WaterfallData::maxRows() const { return m_maxRows; }
 
-	const int nRows = static_cast<int>(m_data.size());
+int WaterfallData::rowCount() const { return m_rowCount; }
 
-	const double dataRowF = (m_maxRows - 1.0 - y) - (m_maxRows - nRows);
+size_t WaterfallData::fftSize() const { return m_fftSize; }
+
+void WaterfallData::setAntialiasing(bool enabled)
+{
+	m_antialiasing = enabled;
+	invalidateImage();
+}
 
-	if(dataRowF < 0.0 || dataRowF >= static_cast<double>(nRows))
+bool WaterfallData::antialiasing() const { return m_antialiasing; }
+
+void WaterfallData::setColorMap(const QwtColorMap &colorMap)
+{
+	m_colors.resize(256);
+	const QwtInterval range(0, 255);
+	for(int i = 0; i < 256; i++) {
+		m_colors[i] = colorMap.rgb(range, i);
+	}
+	updateLut();
+	invalidateImage();
+}
+
+double WaterfallData::value(double x, double y) const
+{
+	if(!std::isfinite(x) || !std::isfinite(y) || m_rowCount == 0 || m_fftSize == 0)
 		return -DBL_MAX;
 
+	const int age = static_cast<int>(y);
 	const double xRange = m_xInterval.maxValue() - m_xInterval.minValue();
-	if(xRange <= 0.0)
+	if(y < 0.0 || age >= m_rowCount || xRange <= 0.0)
 		return -DBL_MAX;
 
 	const double binF = (x - m_xInterval.minValue()) / xRange * static_cast<double>(m_fftSize - 1);
-
 	if(binF < 0.0 || binF >= static_cast<double>(m_fftSize))
 		return -DBL_MAX;
 
-	const int b0 = static_cast<int>(binF);
-	const int r0 = static_cast<int>(dataRowF);
+	const int slot = (m_head + age) % m_maxRows;
+	return dequantize(m_history[slot * m_fftSize + static_cast<int>(binF)]);
+}
+
+const QImage &WaterfallData::image(double minX, double maxX, int width)
+{
+	if(width <= 0 || m_maxRows <= 0) {
+		static const QImage empty;
+		return empty;
+	}
+
+	if(m_imageValid && m_image.width() == width && m_imageMinX == minX && m_imageMaxX == maxX) {
+		return m_image;
+	}
+
+	// new geometry, zoom or intensity range - the only O(history x width) path
+	m_imageMinX = minX;
+	m_imageMaxX = maxX;
+	if(m_image.width() != width || m_image.height() != m_maxRows) {
+		m_image = QImage(width, m_maxRows, QImage::Format_ARGB32_Premultiplied);
+	}
+	m_image.fill(Qt::transparent);
+	updateColumns();
+	for(int age = 0; age < m_rowCount; age++) {
+		renderRow((m_head + age) % m_maxRows);
+	}
+	m_imageValid = true;
+	return m_image;
+}
+
+int WaterfallData::head() const { return m_head; }
+
+void WaterfallData::resizeHistory(int rows)
+{
+	// keep the newest rows, rewritten from slot 0 so the ring starts over unwrapped
+	std::vector<quint16> history(rows * m_fftSize, 0);
+	const int kept = std::min(m_rowCount, rows);
+	for(int age = 0; age < kept; age++) {
+		const quint16 *src = m_history.data() + ((m_head + age) % m_maxRows) * m_fftSize;
+		std::copy(src, src + m_fftSize, history.data() + age * m_fftSize);
+	}
+
+	m_history.swap(history);
+	m_maxRows = rows;
+	m_rowCount = kept;
+	m_head = 0;
+	invalidateImage();
+}
+
+void WaterfallData::invalidateImage() { m_imageValid = false; }
+
+void WaterfallData::updateLut()
+{
+	// quantized level -> color, so rendering a pixel is a single table lookup
+	m_lut.resize(WATERFALL_Q_LEVELS);
+	const double min = m_zInterval.minValue();
+	const double width = m_zInterval.width();
+	for(int q = 0; q < WATERFALL_Q_LEVELS; q++) {
+		const double ratio = (width > 0.0) ? (dequantize(q) - min) / width : 0.0;
+		m_lut[q] = m_colors[static_cast<int>(std::clamp(ratio, 0.0, 1.0) * 255.0 + 0.5)];
+	}
+}
+
+void WaterfallData::updateColumns()
+{
+	const int width = m_image.width();
+	m_columns.resize(width);
+
+	const double xRange = m_xInterval.maxValue() - m_xInterval.minValue();
+	const double last = static_cast<double>(m_fftSize) - 1.0;
+	const double colWidth = (m_imageMaxX - m_imageMinX) / width;
+
+	for(int c = 0; c < width; c++) {
+		Column &col = m_columns[c];
+		col = {.first = -1, .last = -1, .t = 0.0f};
+		if(m_fftSize == 0 || xRange <= 0.0) {
+			continue;
+		}
+
+		double p0 = (m_imageMinX + c * colWidth - m_xInterval.minValue()) / xRange * last;
+		double p1 = (m_imageMinX + (c + 1) * colWidth - m_xInterval.minValue()) / xRange * last;
+		if(p0 > p1) {
+			std::swap(p0, p1);
+		}
+		if(p1 < 0.0 || p0 > last) {
+			continue;
+		}
+
+		if(p1 - p0 > 1.0) {
+			// more than one bin per pixel - keep the peak so narrow tones do not vanish
+			col.first = std::max(0, static_cast<int>(std::ceil(p0)));
+			col.last = std::min(static_cast<int>(last), static_cast<int>(std::floor(p1)));
+			col.t = -1.0f;
+			continue;
+		}
 
-	if(!m_antialiasing)
-		return m_data[r0][b0];
+		const double center = std::clamp((p0 + p1) / 2.0, 0.0, last);
+		if(m_antialiasing) {
+			col.first = static_cast<int>(center);
+			col.t = center - col.first;
+		} else {
+			col.first = static_cast<int>(std::round(center));
+		}
+		col.last = std::min(col.first + 1, static_cast<int>(last));
+	}
+}
 
-	const int r1 = std::min(r0 + 1, nRows - 1);
-	const double ty = dataRowF - r0;
+void WaterfallData::renderRow(int slot)
+{
+	const quint16 *row = m_history.data() + slot * m_fftSize;
+	QRgb *line = reinterpret_cast<QRgb *>(m_image.scanLine(slot));
+	const int width = static_cast<int>(m_columns.size());
+
+	for(int c = 0; c < width; c++) {
+		const Column &col = m_columns[c];
+		if(col.first < 0) {
+			line[c] = 0;
+		} else if(col.t < 0.0f) {
+			line[c] = m_lut[*std::max_element(row + col.first, row + col.last + 1)];
+		} else {
+			const float q = row[col.first] + col.t * (row[col.last] - row[col.first]);
+			line[c] = m_lut[static_cast<int>(q + 0.5f)];
+		}
+	}
+}
 
-	const int b1 = std::min(b0 + 1, static_cast<int>(m_fftSize) - 1);
-	const double tx = binF - b0;
+// =============================================================================
+// WaterfallPlotItem
+// =============================================================================
 
-	return (1.0 - ty) * ((1.0 - tx) * m_data[r0][b0] + tx * m_data[r0][b1]) +
-		ty * ((1.0 - tx) * m_data[r1][b0] + tx * m_data[r1][b1]);
+WaterfallPlotItem::WaterfallPlotItem(WaterfallData *data)
+	: QwtPlotItem(QwtText("Waterfall"))
+	, m_data(data)
+{
+	setItemAttribute(QwtPlotItem::AutoScale, true);
+	setZ(8.0);
+}
+
+WaterfallPlotItem::~WaterfallPlotItem() { delete m_data; }
+
+WaterfallData *WaterfallPlotItem::data() const { return m_data; }
+
+QRectF WaterfallPlotItem::boundingRect() const
+{
+	const QwtInterval x = m_data->interval(Qt::XAxis);
+	return QRectF(x.minValue(), 0.0, x.width(), m_data->maxRows());
+}
+
+void WaterfallPlotItem::draw(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+			     const QRectF &canvasRect) const
+{
+	Q_UNUSED(canvasRect);
+	// one image column per pixel of the visible frequency range
+	const bool inverted = xMap.p1() > xMap.p2();
+	const double left = inverted ? xMap.p2() : xMap.p1();
+	const double right = inverted ? xMap.p1() : xMap.p2();
+	const int width = static_cast<int>(std::ceil(right - left));
+	const QImage &image = m_data->image(inverted ? xMap.s2() : xMap.s1(), inverted ? xMap.s1() : xMap.s2(), width);
+	const int rows = m_data->maxRows();
+	if(image.isNull() || rows <= 0) {
+		return;
+	}
+
+	const double top = yMap.transform(0.0);
+	const double rowHeight = (yMap.transform(rows) - top) / rows;
+	const int head = m_data->head();
+	const int tail = rows - head;
+
+	// slots [head, rows) hold the newest rows, [0, head) the oldest ones
+	painter->save();
+	painter->setRenderHint(QPainter::SmoothPixmapTransform, m_data->antialiasing());
+	painter->drawImage(QRectF(left, top, width, tail * rowHeight), image, QRectF(0, head, width, tail));
+	if(head > 0) {
+		painter->drawImage(QRectF(left, top + tail * rowHeight, width, head * rowHeight), image,
+				   QRectF(0, 0, width, head));
+	}
+	painter->restore();
 }
 
 // =============================================================================
@@ -178,11 +396,8 @@ WaterfallPlotWidget::WaterfallPlotWidget(QWidget *parent)
 	m_data->setXInterval(xAxis()->min(), xAxis()->max());
 	m_data->setZInterval(-120.0, 0.0);
 
-	m_spectrogram = new QwtPlotSpectrogram();
-	m_spectrogram->setData(m_data);
-	m_spectrogram->setDisplayMode(QwtPlotSpectrogram::ImageMode, true);
-	m_spectrogram->setColorMap(new WaterfallColorMap());
-	m_spectrogram->attach(plot());
+	m_waterfall = new WaterfallPlotItem(m_data);
+	m_waterfall->attach(plot());
 
 	yAxis()->setInterval(m_data->maxRows(), 0);
 
@@ -225,9 +440,9 @@ void WaterfallPlotWidget::addFFTData(const float *data, size_t size)
 		}
 	}
 
+	// colormaps this row into one scanline of the ring, the rest of the image is reused
 	m_data->addFFTData(data, size);
-	m_spectrogram->invalidateCache();
-	m_spectrogram->itemChanged();
+	m_waterfall->itemChanged();
 	Q_EMIT newData();
 }
 
@@ -236,23 +451,20 @@ void WaterfallPlotWidget::clearData()
 	m_data->reset();
 	m_rowTimer.invalidate();
 	m_rowCount = 0;
-	m_spectrogram->invalidateCache();
-	m_spectrogram->itemChanged();
+	m_waterfall->itemChanged();
 	replot();
 }
 
 void WaterfallPlotWidget::setFrequencyRange(double startHz, double stopHz)
 {
 	m_data->setXInterval(startHz, stopHz);
-	m_spectrogram->invalidateCache();
-	m_spectrogram->itemChanged();
+	m_waterfall->itemChanged();
 }
 
 void WaterfallPlotWidget::setIntensityRange(double minDb, double maxDb)
 {
 	m_data->setZInterval(minDb, maxDb);
-	m_spectrogram->invalidateCache();
-	m_spectrogram->itemChanged();
+	m_waterfall->itemChanged();
 }
 
 void WaterfallPlotWidget::updateYAxis()
@@ -272,8 +484,7 @@ void WaterfallPlotWidget::setNumRows(int rows)
 void WaterfallPlotWidget::setAntialiasing(bool enabled)
 {
 	m_data->setAntialiasing(enabled);
-	m_spectrogram->invalidateCache();
-	m_spectrogram->itemChanged();
+	m_waterfall->itemChanged();
 }
 
 void WaterfallPlotWidget::setChannel(ChannelData *ch)
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QImage>
+#include <QPainter>
+#include <QTest>
+#include <QwtScaleMap>
+
+#include <cmath>
+#include <gui/lodplotcurve.h>
+#include <gui/minmaxlod.h>
+#include <random>
+#include <vector>
+
+using namespace scopy;
+
+class TST_MinMaxLod : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void query();
+	void incrementalUpdate();
+	void replot_data();
+	void replot();
+};
+
+static std::vector<float> noise(size_t size, unsigned seed)
+{
+	std::mt19937 gen(seed);
+	std::normal_distribution<float> dist(0, 1);
+	std::vector<float> y(size);
+	for(float &v : y) {
+		v = dist(gen);
+	}
+	return y;
+}
+
+static void bruteForce(const std::vector<float> &y, size_t begin, size_t end, double &min, double &max)
+{
+	min = *std::min_element(y.begin() + begin, y.begin() + end);
+	max = *std::max_element(y.begin() + begin, y.begin() + end);
+}
+
+void TST_MinMaxLod::query()
+{
+	std::vector<float> y = noise(100003, 1);
+	y[4242] = 100; // a single sample glitch must never be lost
+	MinMaxLod lod;
+	lod.update(y.data(), y.size());
+
+	std::mt19937 gen(2);
+	std::uniform_int_distribution<size_t> dist(0, y.size() - 1);
+	for(int i = 0; i < 1000; i++) {
+		size_t a = dist(gen), b = dist(gen);
+		size_t begin = std::min(a, b), end = std::max(a, b) + 1;
+		double min, max, expectedMin, expectedMax;
+		lod.query(y.data(), begin, end, min, max);
+		bruteForce(y, begin, end, expectedMin, expectedMax);
+		QCOMPARE(min, expectedMin);
+		QCOMPARE(max, expectedMax);
+	}
+
+	double min, max;
+	lod.query(y.data(), 0, y.size(), min, max);
+	QCOMPARE(max, 100.0);
+}
+
+void TST_MinMaxLod::incrementalUpdate()
+{
+	std::vector<float> y = noise(50000, 3);
+	MinMaxLod incremental, full;
+
+	for(size_t size = 1000; size <= y.size(); size += 997) {
+		incremental.update(y.data(), size, incremental.size());
+	}
+	incremental.update(y.data(), y.size(), incremental.size());
+	full.update(y.data(), y.size());
+
+	QCOMPARE(incremental.levels(), full.levels());
+	for(size_t begin = 0; begin < y.size(); begin += 1234) {
+		double a, b, c, d;
+		incremental.query(y.data(), begin, y.size(), a, b);
+		full.query(y.data(), begin, y.size(), c, d);
+		QCOMPARE(a, c);
+		QCOMPARE(b, d);
+	}
+}
+
+void TST_MinMaxLod::replot_data()
+{
+	QTest::addColumn<int>("size");
+	QTest::addColumn<bool>("lod");
+
+	for(int size : {10000, 100000, 1000000, 4000000}) {
+		QTest::addRow("%d samples, qwt", size) << size << false;
+		QTest::addRow("%d samples, lod", size) << size << true;
+	}
+}
+
+void TST_MinMaxLod::replot()
+{
+	QFETCH(int, size);
+	QFETCH(bool, lod);
+
+	std::vector<float> x(size);
+	for(int i = 0; i < size; i++) {
+		x[i] = i;
+	}
+	std::vector<float> y = noise(size, 4);
+
+	LodPlotCurve curve;
+	curve.setLodEnabled(lod);
+	curve.setRawSamples(x.data(), y.data(), size);
+
+	QImage image(1500, 400, QImage::Format_ARGB32_Premultiplied);
+	QRectF canvas(image.rect());
+	QwtScaleMap xMap, yMap;
+	xMap.setPaintInterval(canvas.left(), canvas.right());
+	xMap.setScaleInterval(0, size - 1);
+	yMap.setPaintInterval(canvas.bottom(), canvas.top());
+	yMap.setScaleInterval(-5, 5);
+
+	QBENCHMARK
+	{
+		// every capture is a new buffer, so the pyramid rebuild is part of the measurement
+		curve.invalidateLod();
+		image.fill(Qt::black);
+		QPainter painter(&image);
+		curve.draw(&painter, xMap, yMap, canvas);
+	}
+}
+
+QTEST_MAIN(TST_MinMaxLod)
+
+#include "tst_minmaxlod.moc"
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QTest>
+
+#include <cmath>
+#include <gui/peaksearch.h>
+#include <vector>
+
+using namespace scopy;
+
+class TST_PeakSearch : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void topK();
+	void minSeparation();
+	void parabolicInterpolation();
+
+private:
+	void buildSpectrum(std::vector<float> &x, std::vector<float> &y, const std::vector<double> &tones);
+};
+
+void TST_PeakSearch::buildSpectrum(std::vector<float> &x, std::vector<float> &y, const std::vector<double> &tones)
+{
+	const int size = 4096;
+	x.resize(size);
+	y.resize(size);
+	for(int i = 0; i < size; i++) {
+		double mag = 1e-6;
+		for(int t = 0; t < (int)tones.size(); t++) {
+			double d = i - tones[t];
+			mag += std::exp(-d * d / 4.0) / (t + 1);
+		}
+		x[i] = i * 10.0;
+		y[i] = 20 * std::log10(mag);
+	}
+}
+
+void TST_PeakSearch::topK()
+{
+	std::vector<float> x, y;
+	buildSpectrum(x, y, {1000, 300, 2500, 3900});
+
+	PeakSearch ps;
+	ps.setMaxPeaks(3);
+	auto peaks = ps.search(x.data(), y.data(), 0, x.size());
+
+	QCOMPARE((int)peaks.size(), 3);
+	QCOMPARE(peaks[0].idx, 1000);
+	QCOMPARE(peaks[1].idx, 300);
+	QCOMPARE(peaks[2].idx, 2500);
+}
+
+void TST_PeakSearch::minSeparation()
+{
+	std::vector<float> x, y;
+	buildSpectrum(x, y, {1000, 1006});
+
+	PeakSearch ps;
+	ps.setMaxPeaks(2);
+	QCOMPARE((int)ps.search(x.data(), y.data(), 0, x.size()).size(), 2);
+
+	ps.setMinSeparation(10);
+	auto peaks = ps.search(x.data(), y.data(), 0, x.size());
+	QCOMPARE((int)peaks.size(), 1);
+	QCOMPARE(peaks[0].idx, 1000);
+
+	ps.setMinSeparation(0);
+	ps.setThreshold(-3);
+	QCOMPARE((int)ps.search(x.data(), y.data(), 0, x.size()).size(), 1);
+}
+
+void TST_PeakSearch::parabolicInterpolation()
+{
+	std::vector<float> x, y;
+	buildSpectrum(x, y, {1234.3});
+
+	PeakSearch ps;
+	ps.setInterpolation(PeakSearch::PI_PARABOLIC);
+	auto peaks = ps.search(x.data(), y.data(), 0, x.size());
+
+	QCOMPARE((int)peaks.size(), 1);
+	QCOMPARE(peaks[0].idx, 1234);
+	QVERIFY(std::abs(peaks[0].x - 12343.0) < 1.0);
+	QVERIFY(std::abs(peaks[0].y) < 0.01);
+}
+
+QTEST_MAIN(TST_PeakSearch)
+
+#include "tst_peaksearch.moc"
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <gui/filemanager.h>
+#include <gui/sigmfcapture.h>
+#include <vector>
+
+using namespace scopy;
+
+class TST_SigMFCapture : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void roundTrip();
+	void fileManagerImport();
+};
+
+static QVector<QVector<double>> buildCapture(int samples, int channels)
+{
+	QVector<QVector<double>> data(samples, QVector<double>(channels));
+	for(int i = 0; i < samples; i++) {
+		for(int ch = 0; ch < channels; ch++) {
+			data[i][ch] = (ch + 1) * 0.5 * i - ch;
+		}
+	}
+	return data;
+}
+
+void TST_SigMFCapture::roundTrip()
+{
+	QTemporaryDir dir;
+	QString path = dir.filePath("capture.sigmf-data");
+	QVector<QVector<double>> data = buildCapture(100000, 3);
+	SigMFCapture::Metadata meta = {
+		.sampleRate = 1e6,
+		.tool = "Test",
+		.channelNames = {"CH1", "CH2", "CH3"},
+		.units = {"V", "V", "A"},
+	};
+
+	int lastProgress = -1;
+	QVERIFY(SigMFCapture::write(path, meta, data, [&](int percent) {
+		lastProgress = percent;
+		return true;
+	}));
+	QCOMPARE(lastProgress, 100);
+	QVERIFY(QFile::exists(SigMFCapture::metaPath(path)));
+
+	SigMFCapture capture;
+	QVERIFY(capture.open(SigMFCapture::metaPath(path)));
+	QCOMPARE(capture.nrOfSamples(), qint64(100000));
+	QCOMPARE(capture.nrOfChannels(), 3);
+	QCOMPARE(capture.metadata().sampleRate, 1e6);
+	QCOMPARE(capture.metadata().units[2], QString("A"));
+
+	std::vector<float> ch2;
+	capture.channel(1, ch2);
+	QCOMPARE(ch2.size(), size_t(100000));
+	QCOMPARE(ch2[1234], float(data[1234][1]));
+	QCOMPARE(capture.sample(99999, 2), float(data[99999][2]));
+}
+
+void TST_SigMFCapture::fileManagerImport()
+{
+	QTemporaryDir dir;
+	QString path = dir.filePath("export.sigmf-data");
+	QVector<QVector<double>> data = buildCapture(1000, 2);
+
+	FileManager out("Test");
+	out.open(path, FileManager::EXPORT);
+	out.save(data, {"CH1", "CH2"});
+	out.setSampleRate(1000);
+	QVERIFY(out.performWrite(true, nullptr));
+
+	FileManager in("Test");
+	in.open(path, FileManager::IMPORT);
+	QCOMPARE(in.getNrOfSamples(), 1000.0);
+	QCOMPARE(in.getNrOfChannels(), 2);
+	QCOMPARE(in.getSampleRate(), 1000.0);
+	QCOMPARE(in.getColumnName(1), QString("CH2"));
+	QCOMPARE(in.read()[500][1], data[500][1]);
+	QCOMPARE(in.read(1).size(), 1000);
+	QCOMPARE(in.read(1)[500], data[500][1]);
+}
+
+QTEST_MAIN(TST_SigMFCapture)
+
+#include "tst_sigmfcapture.moc"
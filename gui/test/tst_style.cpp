@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QApplication>
+#include <QLabel>
+#include <QPushButton>
+#include <QTest>
+#include <QVBoxLayout>
+
+#include <gui/style.h>
+
+using namespace scopy;
+
+class TST_Style : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void initTestCase();
+	void attributes();
+	void attributeLookup();
+	void styledPage();
+
+private:
+	bool m_themeLoaded = false;
+};
+
+void TST_Style::initTestCase() { m_themeLoaded = Style::GetInstance()->init(); }
+
+void TST_Style::attributes()
+{
+	if(!m_themeLoaded) {
+		QSKIP("Style files not found");
+	}
+
+	// every reference is resolved when the theme is compiled
+	QString background = Style::getAttribute(json::theme::background_primary);
+	QVERIFY(!background.isEmpty());
+	QVERIFY(!background.contains('&'));
+	QCOMPARE(Style::getColor(json::theme::background_primary), QColor(background));
+	QVERIFY(Style::getDimension(json::global::unit_1) > 0);
+	QVERIFY(!Style::getChannelColorList().isEmpty());
+
+	QVERIFY(Style::getAttribute("not_an_attribute").isEmpty());
+	QVERIFY(!Style::getColor("not_an_attribute").isValid());
+	QCOMPARE(Style::getDimension("not_an_attribute"), 0);
+}
+
+void TST_Style::attributeLookup()
+{
+	QBENCHMARK
+	{
+		for(int i = 0; i < 1000; i++) {
+			Style::getAttribute(json::theme::background_primary);
+			Style::getColor(json::theme::content_default);
+			Style::getDimension(json::global::unit_1);
+		}
+	}
+}
+
+void TST_Style::styledPage()
+{
+	// a tool page: 1000 styled widgets created, then shown at once
+	QBENCHMARK
+	{
+		QWidget page;
+		QVBoxLayout *lay = new QVBoxLayout(&page);
+		for(int i = 0; i < 500; i++) {
+			QPushButton *btn = new QPushButton("Apply", &page);
+			Style::setStyle(btn, style::properties::button::basicButton);
+			lay->addWidget(btn);
+
+			QLabel *label = new QLabel("Attribute", &page);
+			Style::setStyle(label, style::properties::label::menuMedium);
+			lay->addWidget(label);
+		}
+		page.show();
+		QApplication::processEvents();
+	}
+}
+
+QTEST_MAIN(TST_Style)
+
+#include "tst_style.moc"
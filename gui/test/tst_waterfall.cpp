@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QImage>
+#include <QTest>
+
+#include <cfloat>
+#include <gui/waterfallplotwidget.h>
+#include <vector>
+
+using namespace scopy;
+
+class TST_Waterfall : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void ring();
+	void image();
+	void peak();
+	void addRow();
+	void rebuild();
+};
+
+static const QRgb WHITE = qRgb(255, 255, 255);
+static const QRgb BLACK = qRgb(0, 0, 0);
+
+void TST_Waterfall::ring()
+{
+	WaterfallData data;
+	data.setMaxRows(4);
+	data.setXInterval(0, 7);
+
+	std::vector<float> row(8);
+	for(int k = 0; k < 6; k++) {
+		std::fill(row.begin(), row.end(), -10.0f * k);
+		data.addFFTData(row.data(), row.size());
+	}
+
+	QCOMPARE(data.rowCount(), 4);
+	QVERIFY(std::abs(data.value(3, 0) - -50.0) < 0.01);
+	QVERIFY(std::abs(data.value(3, 3.5) - -20.0) < 0.01);
+	QCOMPARE(data.value(3, 4), -DBL_MAX);
+	QCOMPARE(data.value(8, 0), -DBL_MAX);
+
+	// fewer rows keep the newest ones
+	data.setMaxRows(2);
+	QCOMPARE(data.rowCount(), 2);
+	QVERIFY(std::abs(data.value(3, 1) - -40.0) < 0.01);
+
+	// a new FFT size starts the history over
+	row.resize(16);
+	data.addFFTData(row.data(), row.size());
+	QCOMPARE(data.rowCount(), 1);
+	QCOMPARE(data.fftSize(), size_t(16));
+}
+
+void TST_Waterfall::image()
+{
+	WaterfallData data;
+	data.setMaxRows(4);
+	data.setXInterval(0, 7);
+	data.setZInterval(-100, 0);
+
+	std::vector<float> low(8, -100.0f);
+	std::vector<float> high(8, 0.0f);
+	data.addFFTData(low.data(), low.size());
+	data.addFFTData(high.data(), high.size());
+
+	const QImage &img = data.image(0, 7, 8);
+	QCOMPARE(img.size(), QSize(8, 4));
+
+	// newest row at head, the older ones after it, rows never acquired are transparent
+	const int head = data.head();
+	QCOMPARE(img.pixel(3, head), WHITE);
+	QCOMPARE(img.pixel(3, (head + 1) % 4), BLACK);
+	QCOMPARE(qAlpha(img.pixel(3, (head + 2) % 4)), 0);
+
+	// a frequency range past the data leaves the columns empty
+	const QImage &zoomed = data.image(0, 14, 8);
+	QCOMPARE(zoomed.pixel(0, head), WHITE);
+	QCOMPARE(qAlpha(zoomed.pixel(7, head)), 0);
+}
+
+void TST_Waterfall::peak()
+{
+	// 8k bins on 100 pixels - a single bin tone has to survive the decimation
+	const int size = 8192;
+	WaterfallData data;
+	data.setMaxRows(10);
+	data.setXInterval(0, size - 1);
+	data.setZInterval(-100, 0);
+
+	std::vector<float> row(size, -100.0f);
+	row[4321] = 0.0f;
+	data.addFFTData(row.data(), row.size());
+
+	const QImage &img = data.image(0, size - 1, 100);
+	int white = 0;
+	for(int c = 0; c < img.width(); c++) {
+		white += (img.pixel(c, data.head()) == WHITE);
+	}
+	QCOMPARE(white, 1);
+}
+
+void TST_Waterfall::addRow()
+{
+	// 8k point FFTs drawn 1600 pixels wide, one iteration is a second at 100 rows/s
+	const int size = 8192;
+	WaterfallData data;
+	data.setMaxRows(512);
+	data.setXInterval(0, size - 1);
+
+	std::vector<float> row(size);
+	for(int i = 0; i < size; i++) {
+		row[i] = -100.0f + (i % 97);
+	}
+	for(int k = 0; k < 512; k++) {
+		data.addFFTData(row.data(), row.size());
+	}
+	data.image(0, size - 1, 1600);
+
+	QBENCHMARK
+	{
+		for(int k = 0; k < 100; k++) {
+			data.addFFTData(row.data(), row.size());
+			data.image(0, size - 1, 1600);
+		}
+	}
+}
+
+void TST_Waterfall::rebuild()
+{
+	// zooming or resizing redraws the whole history once
+	const int size = 8192;
+	WaterfallData data;
+	data.setMaxRows(512);
+	data.setXInterval(0, size - 1);
+
+	std::vector<float> row(size, -60.0f);
+	for(int k = 0; k < 512; k++) {
+		data.addFFTData(row.data(), row.size());
+	}
+
+	double maxX = size - 1;
+	QBENCHMARK { data.image(0, maxX--, 1600); }
+}
+
+QTEST_MAIN(TST_Waterfall)
+
+#include "tst_waterfall.moc"
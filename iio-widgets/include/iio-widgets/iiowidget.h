@@ -40,7 +40,6 @@ class DataStrategyInterface;
 class SCOPY_IIO_WIDGETS_EXPORT IIOWidget : public QWidget
 {
 	Q_OBJECT
-	QWIDGET_PAINT_EVENT_HELPER
 	QWIDGET_LAZY_INIT(initialize)
 public:
 	typedef enum
@@ -50,8 +49,43 @@ public:
 		Error
 	} State;
 
+	typedef struct
+	{
+		int created;
+		int materialized;
+		qint64 residentMemoryKb; // -1 where it cannot be measured
+	} Stats;
+
 	IIOWidget(GuiStrategyInterface *uiStrategy, DataStrategyInterface *dataStrategy, QWidget *parent = nullptr);
 
+	/**
+	 * @brief Creates a placeholder IIOWidget. The UI strategy, progress bar and their signal wiring are only
+	 * built by uiFactory when the widget is first painted (its section is expanded or it is scrolled into
+	 * view) or when the UI strategy is requested through getUiStrategy().
+	 */
+	IIOWidget(std::function<GuiStrategyInterface *(QWidget *)> uiFactory, DataStrategyInterface *dataStrategy,
+		  QWidget *parent = nullptr);
+
+	/**
+	 * @brief Builds the UI of a placeholder IIOWidget and performs its first read. Does nothing if the UI
+	 * was already built.
+	 */
+	void materialize();
+	bool isMaterialized() const;
+
+	/**
+	 * @brief Number of IIOWidgets created and materialized since the application started, together with the
+	 * current resident memory of the process.
+	 */
+	static Stats stats();
+
+	/**
+	 * @brief Human readable summary of the IIOWidgets created and memory used since the given snapshot.
+	 */
+	static QString loadReport(const Stats &since);
+
+	void paintEvent(QPaintEvent *e) override;
+
 	/**
 	 * @brief Performs a synchronous data read.
 	 * @return Returns a QPair where the first value is a QString with the data read (e.g. the sample rate)
@@ -82,11 +116,23 @@ public:
 	void writeAsync(QString data);
 
 	/**
-	 * @brief Returns the UI of the IIOWidget
+	 * @brief Returns the UI of the IIOWidget. On a placeholder this builds the UI, use withUiStrategy() to
+	 * configure a widget without materializing it.
 	 * @return GuiStrategyInterface
 	 * */
 	GuiStrategyInterface *getUiStrategy();
 
+	/**
+	 * @brief Calls func with the UI strategy once it is built, right away if it already is. The call is
+	 * dropped if context is destroyed before the placeholder materializes.
+	 */
+	void withUiStrategy(QObject *context, std::function<void(GuiStrategyInterface *)> func);
+
+	/**
+	 * @brief Sets the info message of the UI strategy, once it is built.
+	 */
+	void setInfoMessage(QString infoMessage);
+
 	/**
 	 * @brief Returns the data save/load strategy
 	 * @return DataStretegyInterface
@@ -134,6 +180,7 @@ public:
 
 Q_SIGNALS:
 	void progressBarVisible(bool);
+	void materialized();
 
 	/**
 	 * @brief Emits the current state of the IIOWidget system and a string containing a more
@@ -153,6 +200,7 @@ protected Q_SLOTS:
 
 protected:
 	void initialize();
+	void initUi(GuiStrategyInterface *uiStrategy);
 
 	void setLastOperationTimestamp(QDateTime timestamp);
 	void setLastOperationState(IIOWidget::State state);
@@ -171,6 +219,15 @@ protected:
 	std::function<QString(QString)> m_UItoDS;
 	std::function<QString(QString)> m_DStoUI;
 	std::function<QString(QString)> m_RangetoUI;
+
+	/* Deferred materialization */
+	std::function<GuiStrategyInterface *(QWidget *)> m_uiFactory;
+	bool m_progressBarVisible;
+	bool m_hasPendingData;
+	QString m_pendingData;
+	QString m_pendingOptionalData;
+
+	static Stats s_stats;
 };
 } // namespace scopy
 
@@ -193,8 +193,22 @@ public:
 	IIOWidgetBuilder &group(IIOWidgetGroup *group);
 
 private:
+	/**
+	 * @brief Everything createUIS needs, copied out of the builder so the ui strategy can also be created
+	 * later by a lazily materialized IIOWidget, after the builder is gone.
+	 */
+	typedef struct
+	{
+		IIOWidgetBuilder::UIS strategy;
+		IIOWidgetFactoryRecipe recipe;
+		bool isCompact;
+		bool hasTitle;
+		QString title;
+		QString infoMessage;
+	} UISettings;
+
 	DataStrategyInterface *createDS();
-	GuiStrategyInterface *createUIS();
+	static GuiStrategyInterface *createUIS(const UISettings &settings, QWidget *parent);
 
 	Connection *m_connection;
 	bool m_isCompact;
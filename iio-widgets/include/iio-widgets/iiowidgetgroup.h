@@ -23,12 +23,24 @@
 #define SCOPY_IIOWIDGETGROUP_H
 
 #include <QObject>
+#include <QHash>
 #include <QMap>
+#include <QMutex>
+#include <QPointer>
+#include <QRegularExpression>
+#include <QSet>
 #include <QStringList>
 #include "iiowidget.h"
 #include "scopy-iio-widgets_export.h"
 
 namespace scopy {
+/**
+ * @brief Keeps the IIOWidgets of a plugin indexed by generateKey() and the dependencies between their attributes.
+ * A dependency declares that writing the source attribute may change the value of the dependent attribute (e.g.
+ * writing sampling_frequency changes rx_path_rates). After a successful write, only the transitive dependents of
+ * the written attribute are read back instead of every widget of the plugin. Keys of a dependency may contain '*'
+ * wildcards, which do not match across '/' (e.g. "ad9361-phy/voltage*_in/hardwaregain").
+ */
 class SCOPY_IIO_WIDGETS_EXPORT IIOWidgetGroup : public QObject
 {
 	Q_OBJECT
@@ -49,8 +61,78 @@ public:
 
 	static QString generateKey(const IIOWidgetFactoryRecipe &recipe);
 
+	void addDependency(const QString &source, const QString &dependent);
+	void addDependencies(const QString &source, const QStringList &dependents);
+
+	/**
+	 * @brief Loads dependencies from an XML file with the following layout:
+	 * <dependencies>
+	 *	<attribute key="ad9361-phy/voltage0_in/sampling_frequency">
+	 *		<dependent key="ad9361-phy/rx_path_rates"/>
+	 *	</attribute>
+	 * </dependencies>
+	 * @return false if the file cannot be read or is malformed. Dependencies parsed before the error are kept.
+	 */
+	bool loadDependencies(const QString &path);
+	void clearDependencies();
+
+	/**
+	 * @brief Returns the keys of the widgets in this group that have to be read back after key was written,
+	 * following the dependencies transitively. The written key itself is not included, its data strategy reads
+	 * it back after the write. The keys are sorted, so the attributes of a device are next to each other.
+	 */
+	QStringList dependents(const QString &key) const;
+
+Q_SIGNALS:
+	/**
+	 * @brief Emitted after a pass issued its reads, on the thread of the group. The reads of the synchronous
+	 * data strategies are done by then. A pass covers every request made before it started, so a caller can
+	 * stop its busy indicator on the first refreshed() after its request.
+	 */
+	void refreshed();
+
+public Q_SLOTS:
+	/**
+	 * @brief Reads the dependents of key. Can be called from any thread, the reads are issued from the event
+	 * loop of the group and requests made before they are issued are merged, so each widget is read once.
+	 */
+	void refresh(const QString &key);
+
+	/**
+	 * @brief Reads every widget of the group once, device by device. Can be called from any thread.
+	 */
+	void refreshAll();
+
+	/**
+	 * @brief Reads only the given widgets, e.g. the widgets of one tool when the plugin shares a group between
+	 * its tools. They are merged with the other pending requests and read in the same pass, device by device,
+	 * each one once. The widgets do not have to be in the group. Can be called from any thread.
+	 */
+	void refreshWidgets(const QList<IIOWidget *> &widgets);
+
+private Q_SLOTS:
+	void onWidgetStatus(QDateTime timestamp, QString oldData, QString newData, int returnCode, bool isReadOp);
+	void readPending();
+
 private:
+	typedef struct
+	{
+		QRegularExpression source;
+		QString dependent;
+	} Dependency;
+
+	QStringList matchKeys(const QString &pattern) const;
+	void scheduleRead();
+
 	QMap<QString, IIOWidget *> m_widgets;
+	QHash<QObject *, QString> m_strategyKeys;
+	QList<Dependency> m_dependencies;
+
+	QMutex m_pendingMutex;
+	QSet<QString> m_pendingSources;
+	QList<QPointer<IIOWidget>> m_pendingWidgets;
+	bool m_pendingAll;
+	bool m_readScheduled;
 };
 } // namespace scopy
 
@@ -20,30 +20,102 @@
 
 #include "iiowidget.h"
 #include <QDateTime>
+#include <QFile>
+#include <QPainter>
+#include <QStyleOption>
+#include <QTimer>
 #include <style.h>
 #include <pluginbase/preferences.h>
 
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
 using namespace scopy;
 
 Q_LOGGING_CATEGORY(CAT_IIOWIDGET, "iioWidget")
 
+// height reserved by a placeholder IIOWidget so that layouts and scroll areas keep roughly their final size
+#define PLACEHOLDER_HEIGHT 50
+
+IIOWidget::Stats IIOWidget::s_stats = {.created = 0, .materialized = 0, .residentMemoryKb = -1};
+
+static qint64 readResidentMemoryKb()
+{
+#ifdef Q_OS_LINUX
+	QFile statm("/proc/self/statm");
+	if(!statm.open(QIODevice::ReadOnly)) {
+		return -1;
+	}
+	QList<QByteArray> fields = statm.readAll().split(' ');
+	if(fields.size() < 2) {
+		return -1;
+	}
+	return fields[1].toLongLong() * sysconf(_SC_PAGESIZE) / 1024;
+#else
+	return -1;
+#endif
+}
+
 IIOWidget::IIOWidget(GuiStrategyInterface *uiStrategy, DataStrategyInterface *dataStrategy, QWidget *parent)
+	: IIOWidget(std::function<GuiStrategyInterface *(QWidget *)>(nullptr), dataStrategy, parent)
+{
+	initUi(uiStrategy);
+
+	// The data will be populated here
+	bool useLazyLoading = Preferences::GetInstance()->get("iiowidgets_use_lazy_loading").toBool();
+	if(!useLazyLoading) { // force skip lazy load
+		LAZY_LOAD(initialize);
+	}
+}
+
+IIOWidget::IIOWidget(std::function<GuiStrategyInterface *(QWidget *)> uiFactory, DataStrategyInterface *dataStrategy,
+		     QWidget *parent)
 	: QWidget(parent)
-	, m_uiStrategy(uiStrategy)
+	, m_uiStrategy(nullptr)
 	, m_dataStrategy(dataStrategy)
-	, m_progressBar(new SmallProgressBar(this))
+	, m_progressBar(nullptr)
 	, m_lastOpTimestamp(nullptr)
 	, m_lastOpState(nullptr)
 	, m_lastReturnCode(0)
 	, m_UItoDS(nullptr)
 	, m_DStoUI(nullptr)
 	, m_RangetoUI(nullptr)
+	, m_uiFactory(uiFactory)
+	, m_progressBarVisible(true)
+	, m_hasPendingData(false)
 {
 	setLayout(new QVBoxLayout(this));
 	layout()->setContentsMargins(0, 0, 0, 0);
 	layout()->setSpacing(0);
 	setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
 
+	QObject *dataStrategyObject = dynamic_cast<QObject *>(m_dataStrategy);
+	dataStrategyObject->setParent(this);
+
+	connect(dataStrategyObject, SIGNAL(emitStatus(QDateTime, QString, QString, int, bool)), this,
+		SLOT(emitDataStatus(QDateTime, QString, QString, int, bool)));
+
+	// forward data from data strategy to ui strategy
+	connect(dataStrategyObject, SIGNAL(sendData(QString, QString)), this, SLOT(convertDStoUI(QString, QString)));
+
+	// intercept the sendData from dataStrategy to collect information
+	connect(dataStrategyObject, SIGNAL(sendData(QString, QString)), this, SLOT(storeReadInfo(QString, QString)));
+
+	s_stats.created++;
+	if(m_uiFactory) {
+		setMinimumHeight(PLACEHOLDER_HEIGHT);
+	}
+}
+
+void IIOWidget::initUi(GuiStrategyInterface *uiStrategy)
+{
+	m_uiStrategy = uiStrategy;
+	m_progressBar = new SmallProgressBar(this);
+	if(!m_progressBarVisible) { // showProgressBar(false) was called on the placeholder
+		m_progressBar->setVisible(false);
+	}
+
 	QWidget *ui = m_uiStrategy->ui();
 	if(ui) {
 		layout()->addWidget(ui);
@@ -54,31 +126,80 @@ IIOWidget::IIOWidget(GuiStrategyInterface *uiStrategy, DataStrategyInterface *da
 	QObject *dataStrategyObject = dynamic_cast<QObject *>(m_dataStrategy);
 
 	uiStrategyObject->setParent(this);
-	dataStrategyObject->setParent(this);
 
 	connect(m_progressBar, &SmallProgressBar::progressFinished, this,
 		[this]() { this->convertUItoDS(m_lastData); });
 
 	connect(uiStrategyObject, SIGNAL(emitData(QString)), this, SLOT(startTimer(QString)));
 
-	connect(dataStrategyObject, SIGNAL(emitStatus(QDateTime, QString, QString, int, bool)), this,
-		SLOT(emitDataStatus(QDateTime, QString, QString, int, bool)));
-
 	// forward data request from ui strategy to data strategy
 	connect(uiStrategyObject, SIGNAL(requestData()), dataStrategyObject, SLOT(readAsync()));
 
-	// forward data from data strategy to ui strategy
-	connect(dataStrategyObject, SIGNAL(sendData(QString, QString)), this, SLOT(convertDStoUI(QString, QString)));
+	connect(this, SIGNAL(progressBarVisible(bool)), m_progressBar, SLOT(setVisible(bool)));
 
-	// intercept the sendData from dataStrategy to collect information
-	connect(dataStrategyObject, SIGNAL(sendData(QString, QString)), this, SLOT(storeReadInfo(QString, QString)));
+	s_stats.materialized++;
+}
 
-	connect(this, SIGNAL(progressBarVisible(bool)), m_progressBar, SLOT(setVisible(bool)));
+void IIOWidget::materialize()
+{
+	if(m_uiStrategy) {
+		return;
+	}
 
-	// The data will be populated here
-	bool useLazyLoading = Preferences::GetInstance()->get("iiowidgets_use_lazy_loading").toBool();
-	if(!useLazyLoading) { // force skip lazy load
-		LAZY_LOAD(initialize);
+	GuiStrategyInterface *uiStrategy = m_uiFactory(this);
+	m_uiFactory = nullptr;
+	setMinimumHeight(0);
+	initUi(uiStrategy);
+
+	if(m_hasPendingData) {
+		// a read already finished while the widget was a placeholder
+		m_hasPendingData = false;
+		convertDStoUI(m_pendingData, m_pendingOptionalData);
+		m_pendingData.clear();
+		m_pendingOptionalData.clear();
+	} else {
+		m_dataStrategy->readAsync();
+	}
+	m_lazy_load_initialized = true;
+
+	Q_EMIT materialized();
+}
+
+bool IIOWidget::isMaterialized() const { return m_uiStrategy != nullptr; }
+
+IIOWidget::Stats IIOWidget::stats()
+{
+	Stats stats = s_stats;
+	stats.residentMemoryKb = readResidentMemoryKb();
+	return stats;
+}
+
+QString IIOWidget::loadReport(const Stats &since)
+{
+	Stats now = stats();
+	int created = now.created - since.created;
+	int materialized = now.materialized - since.materialized;
+	QString report = QString("%1 IIOWidgets created, %2 materialized, %3 deferred")
+				 .arg(created)
+				 .arg(materialized)
+				 .arg(created - materialized);
+	if(now.residentMemoryKb >= 0 && since.residentMemoryKb >= 0) {
+		report += QString(", %1 kB resident memory").arg(now.residentMemoryKb - since.residentMemoryKb);
+	}
+	return report;
+}
+
+void IIOWidget::paintEvent(QPaintEvent *e)
+{
+	QStyleOption opt;
+	opt.init(this);
+	QPainter p(this);
+	style()->drawPrimitive(QStyle::PE_Widget, &opt, &p, this);
+
+	// Only widgets that are actually exposed get painted: a collapsed section or a scroll area viewport
+	// clips everything else. The UI is built outside the paint event.
+	if(!m_uiStrategy) {
+		QTimer::singleShot(0, this, &IIOWidget::materialize);
 	}
 }
 
@@ -94,7 +215,9 @@ void IIOWidget::saveData(QString data)
 {
 	setLastOperationState(IIOWidget::Busy);
 	setLastOperationTimestamp(QDateTime::currentDateTime());
-	m_progressBar->setBarColor(Style::getAttribute(json::theme::content_busy));
+	if(m_progressBar) {
+		m_progressBar->setBarColor(Style::getAttribute(json::theme::content_busy));
+	}
 	setToolTip("Operation in progress.");
 
 	qDebug(CAT_IIOWIDGET) << "Sending data" << data << "to data strategy.";
@@ -113,6 +236,13 @@ void IIOWidget::emitDataStatus(QDateTime timestamp, QString oldData, QString new
 	}
 	setLastOperationTimestamp(timestamp);
 	QString timestampFormat = timestamp.toString("hh:mm:ss");
+	if(!m_progressBar) {
+		// writes issued on a placeholder widget (e.g. from a group or a script) have no bar to report on
+		QString statusString = (status < 0) ? "Write failed." : "Operation finished successfully.";
+		setToolTip("[" + timestampFormat + "] " + statusString);
+		setLastOperationState((status < 0) ? IIOWidget::Error : IIOWidget::Correct);
+		return;
+	}
 	if(status < 0) {
 		m_progressBar->setBarColor(Style::getAttribute(json::theme::content_error));
 		QString statusString = "Tried to write \"" + m_lastData +
@@ -137,7 +267,27 @@ void IIOWidget::emitDataStatus(QDateTime timestamp, QString oldData, QString new
 	timer->start(4000);
 }
 
-GuiStrategyInterface *IIOWidget::getUiStrategy() { return m_uiStrategy; }
+GuiStrategyInterface *IIOWidget::getUiStrategy()
+{
+	// callers may connect to or configure the ui strategy, so it has to exist from now on
+	materialize();
+	return m_uiStrategy;
+}
+
+void IIOWidget::withUiStrategy(QObject *context, std::function<void(GuiStrategyInterface *)> func)
+{
+	if(m_uiStrategy) {
+		func(m_uiStrategy);
+		return;
+	}
+	// materialized() is emitted only once
+	connect(this, &IIOWidget::materialized, context, [this, func]() { func(m_uiStrategy); });
+}
+
+void IIOWidget::setInfoMessage(QString infoMessage)
+{
+	withUiStrategy(this, [infoMessage](GuiStrategyInterface *ui) { ui->setInfoMessage(infoMessage); });
+}
 
 DataStrategyInterface *IIOWidget::getDataStrategy() { return m_dataStrategy; }
 
@@ -157,7 +307,11 @@ void IIOWidget::setDataToUIConversion(std::function<QString(QString)> func) { m_
 
 void IIOWidget::setRangeToUIConversion(std::function<QString(QString)> func) { m_RangetoUI = func; }
 
-void IIOWidget::showProgressBar(bool show) { Q_EMIT progressBarVisible(show); }
+void IIOWidget::showProgressBar(bool show)
+{
+	m_progressBarVisible = show;
+	Q_EMIT progressBarVisible(show);
+}
 
 void IIOWidget::startTimer(QString data)
 {
@@ -184,6 +338,13 @@ void IIOWidget::convertUItoDS(QString data)
 
 void IIOWidget::convertDStoUI(QString data, QString optionalData)
 {
+	if(!m_uiStrategy) { // keep the raw values, they are converted once the ui exists
+		m_pendingData = data;
+		m_pendingOptionalData = optionalData;
+		m_hasPendingData = true;
+		return;
+	}
+
 	if(m_DStoUI) { // only the data should be converted
 		data = m_DStoUI(data);
 	}
@@ -205,7 +366,14 @@ void IIOWidget::convertDStoUI(QString data, QString optionalData)
 	m_uiStrategy->receiveData(data, optionalData);
 }
 
-void IIOWidget::initialize() { m_dataStrategy->readAsync(); }
+void IIOWidget::initialize()
+{
+	// a placeholder performs its first read when it is materialized
+	if(!m_uiStrategy) {
+		return;
+	}
+	m_dataStrategy->readAsync();
+}
 
 void IIOWidget::setLastOperationTimestamp(QDateTime timestamp)
 {
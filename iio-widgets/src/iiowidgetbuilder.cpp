@@ -107,9 +107,26 @@ IIOWidget *IIOWidgetBuilder::buildSingle()
 	};
 
 	ds = createDS();
-	ui = createUIS();
 
-	IIOWidget *widget = new IIOWidget(ui, ds, m_widgetParent);
+	UISettings uiSettings = {
+		.strategy = m_uiStrategy,
+		.recipe = m_generatedRecipe,
+		.isCompact = m_isCompact,
+		.hasTitle = m_hasTitle,
+		.title = m_title,
+		.infoMessage = m_infoMessage,
+	};
+
+	IIOWidget *widget = nullptr;
+	if(Preferences::get("iiowidgets_use_lazy_loading").toBool()) {
+		// the ui (and the read of the _available attribute it may need) is only built once the widget
+		// is exposed, large forms only pay for what is on screen
+		widget = new IIOWidget([uiSettings](QWidget *parent) { return createUIS(uiSettings, parent); }, ds,
+				       m_widgetParent);
+	} else {
+		ui = createUIS(uiSettings, m_widgetParent);
+		widget = new IIOWidget(ui, ds, m_widgetParent);
+	}
 	widget->setRecipe(m_generatedRecipe);
 	if(m_group) {
 		m_group->add(widget);
@@ -394,25 +411,29 @@ DataStrategyInterface *IIOWidgetBuilder::createDS()
 	return ds;
 }
 
-GuiStrategyInterface *IIOWidgetBuilder::createUIS()
+GuiStrategyInterface *IIOWidgetBuilder::createUIS(const UISettings &settings, QWidget *parent)
 {
 	// once here, it should be guaranteed that we can create a UIS
 	GuiStrategyInterface *ui = nullptr;
 
-	// we do this so the m_uiStrategy will not be altered by the function
-	UIS strategy = m_uiStrategy;
+	// the settings are shared with a possibly deferred call, work on copies
+	UIS strategy = settings.strategy;
+	iio_device *device = settings.recipe.device;
+	iio_channel *channel = settings.recipe.channel;
+	const QString &optionsAttribute = settings.recipe.iioDataOptions;
+	const QString &optionsValues = settings.recipe.constDataOptions;
 
 	// figure out what strategy fits here
 	if(strategy == UIS::NoUIStrategy) {
-		if(!m_optionsAttribute.isEmpty()) {
+		if(!optionsAttribute.isEmpty()) {
 			// read values from iio and interpret them
 			char buffer[ATTR_BUFFER_SIZE] = {0};
 			ssize_t res = -1;
-			if(m_channel) {
-				res = iio_channel_attr_read(m_channel, m_optionsAttribute.toStdString().c_str(), buffer,
+			if(channel) {
+				res = iio_channel_attr_read(channel, optionsAttribute.toStdString().c_str(), buffer,
 							    ATTR_BUFFER_SIZE);
-			} else if(m_device) {
-				res = iio_device_attr_read(m_device, m_optionsAttribute.toStdString().c_str(), buffer,
+			} else if(device) {
+				res = iio_device_attr_read(device, optionsAttribute.toStdString().c_str(), buffer,
 							   ATTR_BUFFER_SIZE);
 			} else { // context
 				// editable as context attrs are read only and cannot be changed
@@ -420,7 +441,7 @@ GuiStrategyInterface *IIOWidgetBuilder::createUIS()
 			}
 
 			if(res < 0) {
-				qWarning(CAT_ATTRBUILDER) << "Could not read options from" << m_optionsAttribute;
+				qWarning(CAT_ATTRBUILDER) << "Could not read options from" << optionsAttribute;
 				strategy = UIS::EditableUi;
 			} else {
 				if(QString(buffer).startsWith('[') && strategy == UIS::NoUIStrategy) {
@@ -429,9 +450,9 @@ GuiStrategyInterface *IIOWidgetBuilder::createUIS()
 					strategy = UIS::ComboUi;
 				}
 			}
-		} else if(!m_optionsValues.isEmpty()) {
+		} else if(!optionsValues.isEmpty()) {
 			// const values
-			if(m_optionsValues.startsWith('[')) {
+			if(optionsValues.startsWith('[')) {
 				strategy = UIS::RangeUi;
 			} else {
 				strategy = UIS::ComboUi;
@@ -443,31 +464,31 @@ GuiStrategyInterface *IIOWidgetBuilder::createUIS()
 
 	switch(strategy) {
 	case UIS::EditableUi:
-		ui = new EditableGuiStrategy(m_generatedRecipe, m_isCompact, m_widgetParent);
+		ui = new EditableGuiStrategy(settings.recipe, settings.isCompact, parent);
 
 		break;
 	case UIS::SwitchUi:
 	case UIS::ComboUi:
-		ui = new ComboAttrUi(m_generatedRecipe, m_isCompact, m_widgetParent);
+		ui = new ComboAttrUi(settings.recipe, settings.isCompact, parent);
 		break;
 	case UIS::RangeUi:
-		ui = new RangeAttrUi(m_generatedRecipe, m_isCompact, m_widgetParent);
+		ui = new RangeAttrUi(settings.recipe, settings.isCompact, parent);
 		break;
 	case UIS::CheckBoxUi:
-		ui = new CheckBoxAttrUi(m_generatedRecipe, m_isCompact, m_widgetParent);
+		ui = new CheckBoxAttrUi(settings.recipe, settings.isCompact, parent);
 		break;
 	case UIS::TemperatureUi:
-		ui = new TemperatureGuiStrategy(m_generatedRecipe, m_isCompact, m_widgetParent);
+		ui = new TemperatureGuiStrategy(settings.recipe, settings.isCompact, parent);
 		break;
 	default:
 		break;
 	}
 
-	if(m_hasTitle && ui != nullptr) {
-		ui->setCustomTitle(m_title);
+	if(settings.hasTitle && ui != nullptr) {
+		ui->setCustomTitle(settings.title);
 	}
-	if(!m_infoMessage.isEmpty()) {
-		ui->setInfoMessage(m_infoMessage);
+	if(!settings.infoMessage.isEmpty()) {
+		ui->setInfoMessage(settings.infoMessage);
 	}
 
 	return ui;
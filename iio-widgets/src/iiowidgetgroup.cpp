@@ -20,7 +20,11 @@
  */
 
 #include "iiowidgetgroup.h"
+#include <QFile>
 #include <QLoggingCategory>
+#include <QMutexLocker>
+#include <QXmlStreamReader>
+#include <algorithm>
 #include <iio.h>
 
 Q_LOGGING_CATEGORY(CAT_IIOWIDGETGROUP, "IIOWidgetGroup")
@@ -29,6 +33,8 @@ using namespace scopy;
 
 IIOWidgetGroup::IIOWidgetGroup(QObject *parent)
 	: QObject(parent)
+	, m_pendingAll(false)
+	, m_readScheduled(false)
 {}
 
 IIOWidgetGroup::~IIOWidgetGroup() {}
@@ -47,6 +53,15 @@ void IIOWidgetGroup::add(IIOWidget *widget)
 	}
 
 	m_widgets.insert(key, widget);
+
+	QObject *dataStrategyObject = dynamic_cast<QObject *>(widget->getDataStrategy());
+	if(dataStrategyObject) {
+		m_strategyKeys.insert(dataStrategyObject, key);
+		connect(dataStrategyObject, SIGNAL(emitStatus(QDateTime, QString, QString, int, bool)), this,
+			SLOT(onWidgetStatus(QDateTime, QString, QString, int, bool)));
+		connect(dataStrategyObject, &QObject::destroyed, this,
+			[this](QObject *obj) { m_strategyKeys.remove(obj); });
+	}
 }
 
 void IIOWidgetGroup::add(QList<IIOWidget *> widgets)
@@ -60,13 +75,28 @@ IIOWidget *IIOWidgetGroup::get(const QString &key) const { return m_widgets.valu
 
 QMap<QString, IIOWidget *> IIOWidgetGroup::getAll() const { return m_widgets; }
 
-void IIOWidgetGroup::remove(const QString &key) { m_widgets.remove(key); }
+void IIOWidgetGroup::remove(const QString &key)
+{
+	IIOWidget *widget = m_widgets.take(key);
+	if(widget) {
+		QObject *dataStrategyObject = dynamic_cast<QObject *>(widget->getDataStrategy());
+		m_strategyKeys.remove(dataStrategyObject);
+		disconnect(dataStrategyObject, nullptr, this, nullptr);
+	}
+}
 
 bool IIOWidgetGroup::contains(const QString &key) const { return m_widgets.contains(key); }
 
 QStringList IIOWidgetGroup::keys() const { return m_widgets.keys(); }
 
-void IIOWidgetGroup::clear() { m_widgets.clear(); }
+void IIOWidgetGroup::clear()
+{
+	for(QObject *dataStrategyObject : m_strategyKeys.keys()) {
+		disconnect(dataStrategyObject, nullptr, this, nullptr);
+	}
+	m_strategyKeys.clear();
+	m_widgets.clear();
+}
 
 QString IIOWidgetGroup::generateKey(const IIOWidgetFactoryRecipe &recipe)
 {
@@ -105,4 +135,199 @@ QString IIOWidgetGroup::generateKey(const IIOWidgetFactoryRecipe &recipe)
 	return deviceName + "/" + channelId + "/" + attribute;
 }
 
+void IIOWidgetGroup::addDependency(const QString &source, const QString &dependent)
+{
+	QRegularExpression re(QRegularExpression::wildcardToRegularExpression(source));
+	if(!re.isValid() || dependent.isEmpty()) {
+		qWarning(CAT_IIOWIDGETGROUP) << "Invalid dependency" << source << "->" << dependent;
+		return;
+	}
+	m_dependencies.append({.source = re, .dependent = dependent});
+}
+
+void IIOWidgetGroup::addDependencies(const QString &source, const QStringList &dependents)
+{
+	for(const QString &dependent : dependents) {
+		addDependency(source, dependent);
+	}
+}
+
+bool IIOWidgetGroup::loadDependencies(const QString &path)
+{
+	QFile file(path);
+	if(!file.open(QIODevice::ReadOnly)) {
+		qWarning(CAT_IIOWIDGETGROUP) << "Cannot open dependency file" << path;
+		return false;
+	}
+
+	QXmlStreamReader xml(&file);
+	QString source;
+	while(!xml.atEnd()) {
+		xml.readNext();
+		if(xml.isStartElement() && xml.name() == QLatin1String("attribute")) {
+			source = xml.attributes().value("key").toString();
+		} else if(xml.isEndElement() && xml.name() == QLatin1String("attribute")) {
+			source.clear();
+		} else if(xml.isStartElement() && xml.name() == QLatin1String("dependent") && !source.isEmpty()) {
+			addDependency(source, xml.attributes().value("key").toString());
+		}
+	}
+
+	if(xml.hasError()) {
+		qWarning(CAT_IIOWIDGETGROUP) << "Malformed dependency file" << path << ":" << xml.errorString();
+		return false;
+	}
+	return true;
+}
+
+void IIOWidgetGroup::clearDependencies() { m_dependencies.clear(); }
+
+QStringList IIOWidgetGroup::matchKeys(const QString &pattern) const
+{
+	if(!pattern.contains('*')) {
+		return {pattern};
+	}
+
+	QRegularExpression re(QRegularExpression::wildcardToRegularExpression(pattern));
+	QStringList result;
+	for(auto it = m_widgets.cbegin(); it != m_widgets.cend(); ++it) {
+		if(re.match(it.key()).hasMatch()) {
+			result.append(it.key());
+		}
+	}
+	return result;
+}
+
+QStringList IIOWidgetGroup::dependents(const QString &key) const
+{
+	// breadth first over the dependency edges. Attributes without a widget in this group are still followed,
+	// so a chain through an attribute that is not displayed is not broken
+	QSet<QString> visited = {key};
+	QStringList queue = {key};
+	QStringList result;
+
+	while(!queue.isEmpty()) {
+		const QString current = queue.takeFirst();
+		for(const Dependency &dependency : m_dependencies) {
+			if(!dependency.source.match(current).hasMatch()) {
+				continue;
+			}
+			for(const QString &dependent : matchKeys(dependency.dependent)) {
+				if(visited.contains(dependent)) {
+					continue;
+				}
+				visited.insert(dependent);
+				queue.append(dependent);
+				if(m_widgets.contains(dependent)) {
+					result.append(dependent);
+				}
+			}
+		}
+	}
+
+	result.sort();
+	return result;
+}
+
+void IIOWidgetGroup::refresh(const QString &key)
+{
+	QMutexLocker locker(&m_pendingMutex);
+	m_pendingSources.insert(key);
+	scheduleRead();
+}
+
+void IIOWidgetGroup::refreshAll()
+{
+	QMutexLocker locker(&m_pendingMutex);
+	m_pendingAll = true;
+	scheduleRead();
+}
+
+void IIOWidgetGroup::refreshWidgets(const QList<IIOWidget *> &widgets)
+{
+	QMutexLocker locker(&m_pendingMutex);
+	for(IIOWidget *widget : widgets) {
+		m_pendingWidgets.append(widget);
+	}
+	scheduleRead();
+}
+
+void IIOWidgetGroup::scheduleRead()
+{
+	if(m_readScheduled) {
+		return;
+	}
+	m_readScheduled = true;
+	QMetaObject::invokeMethod(this, &IIOWidgetGroup::readPending, Qt::QueuedConnection);
+}
+
+void IIOWidgetGroup::readPending()
+{
+	QSet<QString> sources;
+	QList<QPointer<IIOWidget>> widgets;
+	bool all;
+	{
+		QMutexLocker locker(&m_pendingMutex);
+		sources.swap(m_pendingSources);
+		widgets.swap(m_pendingWidgets);
+		all = m_pendingAll;
+		m_pendingAll = false;
+		m_readScheduled = false;
+	}
+
+	QList<QPair<QString, IIOWidget *>> reads;
+	QSet<IIOWidget *> queued;
+	auto queue = [&reads, &queued](const QString &key, IIOWidget *widget) {
+		if(widget && !queued.contains(widget)) {
+			queued.insert(widget);
+			reads.append({key, widget});
+		}
+	};
+
+	if(all) {
+		for(auto it = m_widgets.cbegin(); it != m_widgets.cend(); ++it) {
+			queue(it.key(), it.value());
+		}
+	} else {
+		for(const QString &source : sources) {
+			for(const QString &key : dependents(source)) {
+				queue(key, m_widgets.value(key, nullptr));
+			}
+		}
+	}
+	for(const QPointer<IIOWidget> &widget : widgets) {
+		if(widget) {
+			queue(generateKey(widget->getRecipe()), widget);
+		}
+	}
+
+	// the keys start with the device name, reading them in order keeps the commands of a device together
+	std::stable_sort(reads.begin(), reads.end(),
+			 [](const QPair<QString, IIOWidget *> &a, const QPair<QString, IIOWidget *> &b) {
+				 return a.first < b.first;
+			 });
+	for(const auto &read : reads) {
+		read.second->readAsync();
+	}
+
+	Q_EMIT refreshed();
+}
+
+void IIOWidgetGroup::onWidgetStatus(QDateTime timestamp, QString oldData, QString newData, int returnCode,
+				    bool isReadOp)
+{
+	Q_UNUSED(timestamp)
+	Q_UNUSED(oldData)
+	Q_UNUSED(newData)
+
+	if(isReadOp || returnCode < 0 || m_dependencies.isEmpty()) {
+		return;
+	}
+
+	auto it = m_strategyKeys.constFind(sender());
+	if(it != m_strategyKeys.cend()) {
+		refresh(it.value());
+	}
+}
+
 #include "moc_iiowidgetgroup.cpp"
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iio-widgets/iiowidget.h>
+#include <iio-widgets/datastrategy/datastrategyinterface.h>
+#include <iio-widgets/guistrategy/guistrategyinterface.h>
+
+#include <QTest>
+
+using namespace scopy;
+
+class MockDataStrategy : public QObject, public DataStrategyInterface
+{
+	Q_OBJECT
+	Q_INTERFACES(scopy::DataStrategyInterface)
+public:
+	QString data() override { return QString(); }
+	QString optionalData() override { return QString(); }
+
+public Q_SLOTS:
+	int write(QString) override { return 0; }
+	QPair<QString, QString> read() override { return {}; }
+	void writeAsync(QString) override {}
+	void readAsync() override {}
+
+Q_SIGNALS:
+	void sendData(QString data, QString dataOptions) override;
+	void aboutToWrite(QString oldData, QString newData) override;
+	void emitStatus(QDateTime timestamp, QString oldData, QString newData, int returnCode, bool isReadOp) override;
+};
+
+// records what the widget configures on its ui
+class MockGuiStrategy : public QObject, public GuiStrategyInterface
+{
+	Q_OBJECT
+	Q_INTERFACES(scopy::GuiStrategyInterface)
+public:
+	QString infoMessage;
+
+	QWidget *ui() override { return nullptr; }
+	bool isValid() override { return true; }
+	void setCustomTitle(QString) override {}
+	void setInfoMessage(QString message) override { infoMessage = message; }
+
+public Q_SLOTS:
+	void receiveData(QString, QString) override {}
+
+Q_SIGNALS:
+	void displayedNewData(QString data, QString optionalData) override;
+	void emitData(QString data) override;
+	void requestData() override;
+};
+
+class TST_IIOWidget : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void deferredInfoMessage();
+	void deferredContextDestroyed();
+	void materializedRunsNow();
+
+private:
+	IIOWidget *createPlaceholder(MockGuiStrategy **ui);
+};
+
+IIOWidget *TST_IIOWidget::createPlaceholder(MockGuiStrategy **ui)
+{
+	*ui = nullptr;
+	return new IIOWidget(
+		[ui](QWidget *) {
+			*ui = new MockGuiStrategy();
+			return *ui;
+		},
+		new MockDataStrategy());
+}
+
+void TST_IIOWidget::deferredInfoMessage()
+{
+	MockGuiStrategy *ui;
+	IIOWidget *widget = createPlaceholder(&ui);
+	IIOWidget::Stats before = IIOWidget::stats();
+
+	widget->setInfoMessage("not available");
+	QVERIFY(!widget->isMaterialized());
+	QCOMPARE(IIOWidget::stats().materialized, before.materialized);
+
+	widget->materialize();
+	QVERIFY(ui);
+	QCOMPARE(ui->infoMessage, QString("not available"));
+	QCOMPARE(IIOWidget::stats().materialized, before.materialized + 1);
+
+	delete widget;
+}
+
+void TST_IIOWidget::deferredContextDestroyed()
+{
+	MockGuiStrategy *ui;
+	IIOWidget *widget = createPlaceholder(&ui);
+	QObject *context = new QObject();
+	int calls = 0;
+
+	widget->withUiStrategy(context, [&calls](GuiStrategyInterface *) { calls++; });
+	delete context;
+	widget->materialize();
+	QCOMPARE(calls, 0);
+
+	delete widget;
+}
+
+void TST_IIOWidget::materializedRunsNow()
+{
+	MockGuiStrategy *ui;
+	IIOWidget *widget = createPlaceholder(&ui);
+	widget->materialize();
+
+	GuiStrategyInterface *received = nullptr;
+	widget->withUiStrategy(widget, [&received](GuiStrategyInterface *s) { received = s; });
+	QCOMPARE(received, static_cast<GuiStrategyInterface *>(ui));
+
+	widget->setInfoMessage("now");
+	QCOMPARE(ui->infoMessage, QString("now"));
+
+	delete widget;
+}
+
+QTEST_MAIN(TST_IIOWidget)
+#include "tst_iiowidget.moc"
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iio-widgets/iiowidgetgroup.h>
+#include <iio-widgets/datastrategy/datastrategyinterface.h>
+
+#include <QSignalSpy>
+#include <QTemporaryFile>
+#include <QTest>
+#include <cstring>
+
+using namespace scopy;
+
+// counts the reads instead of talking to a device
+class MockDataStrategy : public QObject, public DataStrategyInterface
+{
+	Q_OBJECT
+	Q_INTERFACES(scopy::DataStrategyInterface)
+public:
+	MockDataStrategy(QStringList *reads)
+		: m_reads(reads)
+	{}
+
+	QString key;
+
+	QString data() override { return QString(); }
+	QString optionalData() override { return QString(); }
+
+public Q_SLOTS:
+	int write(QString) override { return 0; }
+	QPair<QString, QString> read() override { return {}; }
+	void writeAsync(QString data) override { Q_EMIT emitStatus(QDateTime::currentDateTime(), "", data, 0, false); }
+	void readAsync() override { m_reads->append(key); }
+
+Q_SIGNALS:
+	void sendData(QString data, QString dataOptions) override;
+	void aboutToWrite(QString oldData, QString newData) override;
+	void emitStatus(QDateTime timestamp, QString oldData, QString newData, int returnCode, bool isReadOp) override;
+
+private:
+	QStringList *m_reads;
+};
+
+// two AD9361 like devices with enough channels to make a full refresh expensive
+static const char *CONTEXT_XML = "<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+				 "<context name=\"xml\">"
+				 "<device id=\"iio:device0\" name=\"ad9361-phy\">"
+				 "<channel id=\"voltage0\" type=\"input\"/>"
+				 "<channel id=\"voltage1\" type=\"input\"/>"
+				 "<channel id=\"voltage0\" type=\"output\"/>"
+				 "<channel id=\"altvoltage0\" type=\"output\"/>"
+				 "</device>"
+				 "<device id=\"iio:device1\" name=\"cf-ad9361-lpc\"/>"
+				 "</context>";
+
+class TST_IIOWidgetGroup : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void initTestCase();
+	void cleanupTestCase();
+	void init();
+	void cleanup();
+	void dependents();
+	void writeReadsDependents();
+	void ignoredStatus();
+	void refreshAll();
+	void refreshWidgets();
+	void loadDependencies();
+
+private:
+	IIOWidget *addWidget(iio_device *dev, iio_channel *chn, const QString &attr);
+	void write(const QString &key);
+
+	iio_context *m_ctx = nullptr;
+	IIOWidgetGroup *m_group = nullptr;
+	QStringList m_reads;
+};
+
+IIOWidget *TST_IIOWidgetGroup::addWidget(iio_device *dev, iio_channel *chn, const QString &attr)
+{
+	MockDataStrategy *ds = new MockDataStrategy(&m_reads);
+	// the ui is never built, the widgets are not shown
+	IIOWidget *widget = new IIOWidget([](QWidget *) { return nullptr; }, ds);
+	widget->setRecipe({.context = m_ctx, .device = dev, .channel = chn, .data = attr});
+	ds->key = IIOWidgetGroup::generateKey(widget->getRecipe());
+	m_group->add(widget);
+	return widget;
+}
+
+void TST_IIOWidgetGroup::write(const QString &key)
+{
+	m_group->get(key)->writeAsync("1");
+	QCoreApplication::processEvents();
+}
+
+void TST_IIOWidgetGroup::initTestCase()
+{
+	m_ctx = iio_create_xml_context_mem(CONTEXT_XML, strlen(CONTEXT_XML));
+	QVERIFY(m_ctx);
+}
+
+void TST_IIOWidgetGroup::cleanupTestCase() { iio_context_destroy(m_ctx); }
+
+void TST_IIOWidgetGroup::init()
+{
+	m_group = new IIOWidgetGroup();
+	m_reads.clear();
+
+	iio_device *phy = iio_context_find_device(m_ctx, "ad9361-phy");
+	iio_device *lpc = iio_context_find_device(m_ctx, "cf-ad9361-lpc");
+	for(const QString &attr : {"ensm_mode", "calib_mode", "trx_rate_governor", "rx_path_rates", "tx_path_rates",
+				   "xo_correction"}) {
+		addWidget(phy, nullptr, attr);
+	}
+	for(unsigned int i = 0; i < iio_device_get_channels_count(phy); i++) {
+		iio_channel *chn = iio_device_get_channel(phy, i);
+		for(const QString &attr : {"sampling_frequency", "rf_bandwidth", "hardwaregain", "rssi",
+					   "gain_control_mode", "frequency"}) {
+			addWidget(phy, chn, attr);
+		}
+	}
+	// filler for the attributes a full refresh reads for nothing
+	for(int i = 0; i < 200; i++) {
+		addWidget(lpc, nullptr, QString("attr%1").arg(i, 3, 10, QChar('0')));
+	}
+
+	m_group->addDependency("ad9361-phy/voltage0_in/sampling_frequency", "ad9361-phy/rx_path_rates");
+	m_group->addDependency("ad9361-phy/rx_path_rates", "ad9361-phy/tx_path_rates");
+	m_group->addDependency("ad9361-phy/voltage0_in/sampling_frequency",
+			       "ad9361-phy/voltage0_out/sampling_frequency");
+	m_group->addDependency("ad9361-phy/ensm_mode", "ad9361-phy/voltage*_in/hardwaregain");
+	m_group->addDependency("ad9361-phy/ensm_mode", "ad9361-phy/voltage*_in/rssi");
+	// cycles must not be followed forever
+	m_group->addDependency("ad9361-phy/voltage*_out/sampling_frequency",
+			       "ad9361-phy/voltage0_in/sampling_frequency");
+}
+
+void TST_IIOWidgetGroup::cleanup()
+{
+	qDeleteAll(m_group->getAll());
+	delete m_group;
+}
+
+void TST_IIOWidgetGroup::dependents()
+{
+	QCOMPARE(m_group->dependents("ad9361-phy/voltage0_in/sampling_frequency"),
+		 QStringList({"ad9361-phy/rx_path_rates", "ad9361-phy/tx_path_rates",
+			      "ad9361-phy/voltage0_out/sampling_frequency"}));
+	QCOMPARE(m_group->dependents("ad9361-phy/ensm_mode"),
+		 QStringList({"ad9361-phy/voltage0_in/hardwaregain", "ad9361-phy/voltage0_in/rssi",
+			      "ad9361-phy/voltage1_in/hardwaregain", "ad9361-phy/voltage1_in/rssi"}));
+	QVERIFY(m_group->dependents("ad9361-phy/calib_mode").isEmpty());
+	QVERIFY(m_group->dependents("unknown/attr").isEmpty());
+}
+
+void TST_IIOWidgetGroup::writeReadsDependents()
+{
+	write("ad9361-phy/ensm_mode");
+	QCOMPARE(m_reads,
+		 QStringList({"ad9361-phy/voltage0_in/hardwaregain", "ad9361-phy/voltage0_in/rssi",
+			      "ad9361-phy/voltage1_in/hardwaregain", "ad9361-phy/voltage1_in/rssi"}));
+
+	// writes made before the reads are issued share them
+	m_reads.clear();
+	m_group->get("ad9361-phy/voltage0_in/sampling_frequency")->writeAsync("1");
+	m_group->get("ad9361-phy/voltage0_out/sampling_frequency")->writeAsync("1");
+	QCoreApplication::processEvents();
+	QCOMPARE(m_reads,
+		 QStringList({"ad9361-phy/rx_path_rates", "ad9361-phy/tx_path_rates",
+			      "ad9361-phy/voltage0_in/sampling_frequency",
+			      "ad9361-phy/voltage0_out/sampling_frequency"}));
+
+	m_reads.clear();
+	write("ad9361-phy/calib_mode");
+	QVERIFY(m_reads.isEmpty());
+}
+
+void TST_IIOWidgetGroup::ignoredStatus()
+{
+	IIOWidget *widget = m_group->get("ad9361-phy/ensm_mode");
+	MockDataStrategy *ds = dynamic_cast<MockDataStrategy *>(widget->getDataStrategy());
+	Q_EMIT ds->emitStatus(QDateTime::currentDateTime(), "", "", -22, false);
+	Q_EMIT ds->emitStatus(QDateTime::currentDateTime(), "", "", 0, true);
+	QCoreApplication::processEvents();
+	QVERIFY(m_reads.isEmpty());
+
+	// removed widgets no longer trigger reads
+	m_group->remove("ad9361-phy/ensm_mode");
+	widget->writeAsync("1");
+	QCoreApplication::processEvents();
+	QVERIFY(m_reads.isEmpty());
+	delete widget;
+}
+
+void TST_IIOWidgetGroup::refreshAll()
+{
+	m_group->refreshAll();
+	m_group->refreshAll();
+	m_group->refresh("ad9361-phy/ensm_mode");
+	QVERIFY(m_reads.isEmpty());
+	QCoreApplication::processEvents();
+
+	// every widget once, the widgets of a device next to each other
+	QCOMPARE(m_reads, m_group->keys());
+	QStringList devices;
+	for(const QString &key : qAsConst(m_reads)) {
+		const QString device = key.section('/', 0, 0);
+		if(devices.isEmpty() || devices.last() != device) {
+			QVERIFY(!devices.contains(device));
+			devices.append(device);
+		}
+	}
+	QCOMPARE(devices.size(), 2);
+
+	m_reads.clear();
+	QCoreApplication::processEvents();
+	QVERIFY(m_reads.isEmpty());
+}
+
+void TST_IIOWidgetGroup::refreshWidgets()
+{
+	QSignalSpy refreshed(m_group, &IIOWidgetGroup::refreshed);
+	// a widget of another tool, with a key the group already holds
+	MockDataStrategy *ds = new MockDataStrategy(&m_reads);
+	IIOWidget *outside = new IIOWidget([](QWidget *) { return nullptr; }, ds);
+	outside->setRecipe(m_group->get("ad9361-phy/calib_mode")->getRecipe());
+	ds->key = "outside";
+
+	m_group->refreshWidgets({m_group->get("ad9361-phy/xo_correction"), outside,
+				 m_group->get("ad9361-phy/voltage0_in/hardwaregain")});
+	m_group->refreshWidgets({m_group->get("ad9361-phy/xo_correction")});
+	m_group->refresh("ad9361-phy/ensm_mode");
+	QVERIFY(m_reads.isEmpty());
+	QCoreApplication::processEvents();
+
+	// only the given widgets and the dependents, each once, in one pass
+	QCOMPARE(m_reads,
+		 QStringList({"outside", "ad9361-phy/voltage0_in/hardwaregain", "ad9361-phy/voltage0_in/rssi",
+			      "ad9361-phy/voltage1_in/hardwaregain", "ad9361-phy/voltage1_in/rssi",
+			      "ad9361-phy/xo_correction"}));
+	QCOMPARE(refreshed.count(), 1);
+
+	// widgets deleted before the pass are skipped
+	m_reads.clear();
+	m_group->refreshWidgets({outside});
+	delete outside;
+	QCoreApplication::processEvents();
+	QVERIFY(m_reads.isEmpty());
+	QCOMPARE(refreshed.count(), 2);
+}
+
+void TST_IIOWidgetGroup::loadDependencies()
+{
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.write("<dependencies>"
+		   "<attribute key=\"ad9361-phy/xo_correction\">"
+		   "<dependent key=\"ad9361-phy/altvoltage0_out/frequency\"/>"
+		   "<dependent key=\"ad9361-phy/*_path_rates\"/>"
+		   "</attribute>"
+		   "</dependencies>");
+	file.close();
+
+	m_group->clearDependencies();
+	QVERIFY(m_group->loadDependencies(file.fileName()));
+	QCOMPARE(m_group->dependents("ad9361-phy/xo_correction"),
+		 QStringList({"ad9361-phy/altvoltage0_out/frequency", "ad9361-phy/rx_path_rates",
+			      "ad9361-phy/tx_path_rates"}));
+	QVERIFY(m_group->dependents("ad9361-phy/ensm_mode").isEmpty());
+
+	QVERIFY(!m_group->loadDependencies(file.fileName() + ".missing"));
+
+	QTemporaryFile malformed;
+	QVERIFY(malformed.open());
+	malformed.write("<dependencies><attribute key=\"a\">");
+	malformed.close();
+	QVERIFY(!m_group->loadDependencies(malformed.fileName()));
+}
+
+QTEST_MAIN(TST_IIOWidgetGroup)
+#include "tst_iiowidgetgroup.moc"
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CHANNELMONITOR_H
+#define CHANNELMONITOR_H
+
+#include "scopy-iioutil_export.h"
+#include "commandqueue.h"
+
+#include <QMap>
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include <functional>
+#include <memory>
+
+#include <iio.h>
+
+namespace scopy {
+/**
+ * @brief The ChannelMonitor class
+ * Periodically polls the processed value of a set of iio channels without blocking the calling
+ * thread. Every poll enqueues one command per device on the connection's CommandQueue, so the
+ * reads are serialized with the rest of the traffic on the context, and the command reads the
+ * raw value of all the device's channels in one go. Scale and offset are static, they are read
+ * with the first poll only, so a poll costs one attribute read per channel.
+ *
+ * The values are converted on the worker thread and published in a single snapshot once every
+ * device answered. A poll requested while the previous one is still in flight (slow network
+ * contexts) is skipped instead of piling up commands.
+ */
+class SCOPY_IIOUTIL_EXPORT ChannelMonitor : public QObject
+{
+	Q_OBJECT
+public:
+	// reads a channel attribute, same contract as iio_channel_attr_read
+	typedef std::function<ssize_t(iio_channel *ch, const char *attr, char *dst, size_t len)> ReadFunction;
+	// applied to the scaled value, e.g. to undo a resistor divider in front of the ADC
+	typedef std::function<double(double)> Transform;
+
+	typedef struct
+	{
+		double value; // (raw + offset) * scale, passed through the transform
+		double raw;
+		bool valid;
+	} Reading;
+
+	typedef struct
+	{
+		qint64 timestamp; // ms since epoch, when the poll finished
+		QMap<QString, Reading> readings;
+	} Snapshot;
+
+	explicit ChannelMonitor(CommandQueue *commandQueue, QObject *parent = nullptr);
+	~ChannelMonitor();
+
+	// an empty scaleAttr or offsetAttr means a scale of 1 or an offset of 0. A channel without
+	// the offset attribute is read with an offset of 0
+	void addChannel(const QString &id, iio_channel *ch, Transform transform = nullptr,
+			const QString &rawAttr = "raw", const QString &scaleAttr = "scale",
+			const QString &offsetAttr = "offset");
+	void removeChannel(const QString &id);
+	void clear();
+	QStringList channels() const;
+
+	// scale and offset are read again with the next poll, e.g. after a range change
+	void invalidateScales();
+
+	int interval() const;
+	void setInterval(int ms);
+	void start();
+	void stop();
+	bool isRunning() const;
+	bool isPolling() const;
+
+	const Snapshot &snapshot() const;
+
+	// replaces iio_channel_attr_read - used to test with mock channels
+	void setReadFunction(ReadFunction readFunction);
+
+public Q_SLOTS:
+	void poll();
+
+Q_SIGNALS:
+	void updated(const scopy::ChannelMonitor::Snapshot &snapshot);
+
+private:
+	typedef struct
+	{
+		QString id;
+		iio_channel *ch;
+		QByteArray rawAttr;
+		QByteArray scaleAttr;
+		QByteArray offsetAttr;
+		Transform transform;
+		bool scaleCached;
+		double scale;
+		double offset;
+	} Entry;
+
+	class Batch;
+	void onBatchFinished(const QVector<Entry> &entries, const QVector<Reading> &readings, int generation);
+
+	CommandQueue *m_commandQueue;
+	QTimer *m_timer;
+	QVector<Entry> m_entries;
+	ReadFunction m_readFunction;
+	Snapshot m_snapshot;
+	int m_pendingBatches;
+	int m_generation;
+};
+} // namespace scopy
+
+Q_DECLARE_METATYPE(scopy::ChannelMonitor::Snapshot)
+
+#endif // CHANNELMONITOR_H
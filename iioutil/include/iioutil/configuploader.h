@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CONFIGUPLOADER_H
+#define CONFIGUPLOADER_H
+
+#include "scopy-iioutil_export.h"
+#include "commandqueue.h"
+
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+#include <functional>
+#include <memory>
+
+#include <iio.h>
+
+namespace scopy {
+/**
+ * @brief The ConfigUploader class
+ * Uploads configuration blobs (filter coefficients, profiles, stream images) to device
+ * attributes through the connection's CommandQueue, so large uploads over network contexts do
+ * not block the GUI thread and are serialized with the rest of the traffic on the context.
+ *
+ * Files are memory mapped and written straight from the mapping. The content is hashed while
+ * it is read and the device attribute is read back after every successful upload; an upload
+ * of the same content to the same attribute is skipped as long as the read back value did not
+ * change since, i.e. the device was not reconfigured by someone else. Attributes that can't be
+ * read back are always written.
+ *
+ * cancel() drops every upload that did not start writing yet. An attribute write cannot be
+ * split, so a write in progress always completes.
+ */
+class SCOPY_IIOUTIL_EXPORT ConfigUploader : public QObject
+{
+	Q_OBJECT
+public:
+	typedef enum
+	{
+		UPLOAD_OK,
+		UPLOAD_SKIPPED, // the device already holds the same content
+		UPLOAD_FAILED,
+		UPLOAD_CANCELED
+	} Status;
+
+	typedef struct
+	{
+		QString attribute;
+		QString source; // the file path, empty for uploadData()
+		Status status;
+		ssize_t errorCode;
+		QByteArray hash;
+		qint64 size;
+	} Result;
+
+	// same contracts as iio_device_attr_write_raw and iio_device_attr_read
+	typedef std::function<ssize_t(iio_device *dev, const char *attr, const void *src, size_t len)> WriteFunction;
+	typedef std::function<ssize_t(iio_device *dev, const char *attr, char *dst, size_t len)> ReadFunction;
+
+	explicit ConfigUploader(CommandQueue *commandQueue, QObject *parent = nullptr);
+	~ConfigUploader();
+
+	void upload(iio_device *dev, const QString &attr, const QString &path);
+	void uploadData(iio_device *dev, const QString &attr, const QByteArray &data);
+	void cancel();
+
+	// the next upload of this attribute is written even if the content did not change
+	void forget(iio_device *dev, const QString &attr);
+
+	// context timeout used for the write, restored afterwards. 0 leaves the timeout alone
+	void setTimeout(int uploadMs, int restoreMs);
+
+	// replace the iio calls - used to test with mock devices
+	void setWriteFunction(WriteFunction writeFunction);
+	void setReadFunction(ReadFunction readFunction);
+
+Q_SIGNALS:
+	void uploadProgress(QString attribute, int percent);
+	void uploadFinished(const scopy::ConfigUploader::Result &result);
+
+private:
+	class Upload;
+	struct State;
+	void enqueue(iio_device *dev, const QString &attr, const QString &path, const QByteArray &data);
+
+	CommandQueue *m_commandQueue;
+	std::shared_ptr<State> m_state;
+	WriteFunction m_writeFunction;
+	ReadFunction m_readFunction;
+	int m_uploadTimeout;
+	int m_restoreTimeout;
+};
+} // namespace scopy
+
+Q_DECLARE_METATYPE(scopy::ConfigUploader::Result)
+
+#endif // CONFIGUPLOADER_H
@@ -24,32 +24,81 @@
 
 #include "scopy-iioutil_export.h"
 
+#include <QMap>
+#include <QMutex>
 #include <QThread>
+#include <QVector>
+#include <functional>
 
 namespace scopy {
 /**
  * @brief The IIOScanTask class
  * IIOScanTask - scans for IIO context and emits a scanFinished signal
+ *
+ * The scan params are split per backend ("usb:ip:" scans usb and ip) and every backend is
+ * scanned concurrently, with its own timeout. backendScanFinished is emitted as soon as a
+ * backend is done, so fast backends are not held back by slow ones (mDNS, serial, usb
+ * enumeration). scanFinished is emitted once every backend finished or timed out, with the
+ * contexts deduplicated by uri. A backend that failed or timed out reports the contexts
+ * it found in the previous scan.
  */
 class SCOPY_IIOUTIL_EXPORT IIOScanTask : public QThread
 {
 	Q_OBJECT
 public:
+	// scans a single backend, returns the number of contexts found or a negative error code
+	typedef std::function<int(QVector<QPair<QString, QString>> *ctxs, QString backend)> ScanFunction;
+
 	IIOScanTask(QObject *parent);
 	~IIOScanTask();
 
 	virtual void run() override;
 	void setScanParams(QString s);
+
+	int backendTimeout(QString backend) const;
+	void setBackendTimeout(QString backend, int ms);
+
+	// replaces iio_scan for every backend - used to test with mock backends
+	void setScanFunction(ScanFunction scanFunction);
+
+	// stops waiting for the scan in progress, results still in flight are dropped
+	void cancel();
+	// cancels the scan in progress, if any, and starts a new one
+	void restart();
+	void clearCache();
+
 	static int scan(QVector<QPair<QString, QString>> *ctxs, QString scanParams);
+	static int scanBackend(QVector<QPair<QString, QString>> *ctxs, QString backend);
+	static QStringList splitBackends(QString scanParams);
 	static QMap<QString, QString> getSerialPortsName();
 
 Q_SIGNALS:
+	void backendScanFinished(QString backend, QVector<QPair<QString, QString>> ctxs);
 	void scanFinished(QVector<QPair<QString, QString>> ctxs);
 
 protected:
+	typedef struct
+	{
+		QString backend;
+		int ret;
+		QVector<QPair<QString, QString>> ctxs;
+	} BackendResult;
+
+	// scans every backend in parallel, onResult is called from the calling thread as each
+	// backend finishes (ret = -ETIMEDOUT for the ones that did not finish in time)
+	static int scanParallel(const QStringList &backends, const ScanFunction &scanFunction,
+				const std::function<int(const QString &)> &timeout,
+				const std::function<bool()> &canceled,
+				const std::function<void(const BackendResult &)> &onResult);
 	static QString parseDescription(const QString &d);
 	QString scanParams = "";
 	bool enabled;
+
+private:
+	mutable QMutex m_mutex;
+	QMap<QString, int> m_timeouts;
+	QMap<QString, QVector<QPair<QString, QString>>> m_cache;
+	ScanFunction m_scanFunction;
 };
 } // namespace scopy
 #endif // IIOSCANTASK_H
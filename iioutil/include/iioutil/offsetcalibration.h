@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef OFFSETCALIBRATION_H
+#define OFFSETCALIBRATION_H
+
+#include "scopy-iioutil_export.h"
+
+#include <QString>
+#include <QVector>
+#include <functional>
+
+namespace scopy {
+/**
+ * @brief The OffsetCalibration class
+ * Closed loop nulling of a measured offset by adjusting a control value (e.g. a DAC that shifts
+ * the input of an ADC). Every step is a secant update: the slope of the measurement against the
+ * control is estimated from the last two steps, starting from Settings::gain, so a linear system
+ * is nulled in two or three steps whatever its real gain. The loop stops as soon as the residual
+ * is within tolerance or the next correction is below the resolution of the control, and the
+ * best control value seen is applied last.
+ *
+ * The class holds no iio state, the control is applied and the offset measured through the
+ * callbacks (see ScaledChannel for averaged reads of an iio channel).
+ */
+class SCOPY_IIOUTIL_EXPORT OffsetCalibration
+{
+public:
+	// apply the control value, false on failure
+	typedef std::function<bool(double control)> Actuator;
+	// measure the offset to null, false on failure
+	typedef std::function<bool(double &measurement)> Sensor;
+
+	typedef struct
+	{
+		int maxIterations;
+		double tolerance;  // |measurement| considered nulled
+		double gain;	   // initial estimate of d(measurement) / d(control)
+		double resolution; // smallest meaningful change of the control (e.g. one DAC code)
+		double minControl;
+		double maxControl;
+		int settleMs; // wait between applying the control and measuring
+	} Settings;
+
+	typedef struct
+	{
+		double control;
+		double measurement;
+	} Step;
+
+	typedef struct
+	{
+		// the residual is within tolerance, or as close to it as the resolution of the control allows
+		bool converged;
+		double control;
+		double residual;
+		QVector<Step> history; // the initial measurement and every step taken, in order
+		QString error;
+	} Result;
+
+	explicit OffsetCalibration(const Settings &settings);
+	~OffsetCalibration();
+
+	const Settings &settings() const;
+
+	/**
+	 * @brief Nulls the offset starting from the control value currently applied
+	 * @return The control value left applied, its residual and the convergence history
+	 */
+	Result run(double control, const Actuator &apply, const Sensor &measure) const;
+
+private:
+	Settings m_settings;
+};
+} // namespace scopy
+#endif // OFFSETCALIBRATION_H
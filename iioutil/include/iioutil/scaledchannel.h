@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCALEDCHANNEL_H
+#define SCALEDCHANNEL_H
+
+#include "scopy-iioutil_export.h"
+
+#include <iio.h>
+
+namespace scopy {
+/**
+ * @brief The ScaledChannel class
+ * Reads and writes an iio channel in its processed unit, (raw + offset) * scale. The scale and
+ * offset attributes do not change while the channel is used, they are read once on construction
+ * instead of on every access.
+ *
+ * readMean() averages a buffered capture of the channel, which takes a few milliseconds for
+ * thousands of samples, and falls back to averaging raw reads for channels that are not scan
+ * elements or whose device cannot stream.
+ */
+class SCOPY_IIOUTIL_EXPORT ScaledChannel
+{
+public:
+	explicit ScaledChannel(iio_channel *ch = nullptr);
+	~ScaledChannel();
+
+	iio_channel *channel() const;
+	bool isValid() const;
+	double scale() const;
+	double offset() const;
+
+	bool read(double &value) const;
+	bool readMean(int samples, double &value) const;
+	bool write(double value) const;
+
+private:
+	bool readBufferMean(int samples, double &rawMean) const;
+
+	iio_channel *m_ch;
+	double m_scale;
+	double m_offset;
+	bool m_valid;
+};
+} // namespace scopy
+#endif // SCALEDCHANNEL_H
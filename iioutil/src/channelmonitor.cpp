@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "channelmonitor.h"
+
+#include <QDateTime>
+#include <QLoggingCategory>
+#include <algorithm>
+
+Q_LOGGING_CATEGORY(CAT_CHANNELMONITOR, "ChannelMonitor")
+
+using namespace scopy;
+
+// raw, scale and offset are short numbers
+#define ATTR_MAX_SIZE 64
+#define DEFAULT_INTERVAL_MS 1000
+
+// reads the channels of one device, scale and offset only for the entries that did not cache them
+class ChannelMonitor::Batch : public Command
+{
+public:
+	Batch(const QVector<Entry> &entries, const ReadFunction &readFunction, int generation)
+		: m_entries(entries)
+		, m_readings(entries.size(), Reading{.value = 0, .raw = 0, .valid = false})
+		, m_readFunction(readFunction)
+		, m_generation(generation)
+	{
+		m_cmdResult = new CommandResult();
+	}
+
+	virtual void execute() override
+	{
+		Q_EMIT started(this);
+		ssize_t ret = 0;
+		for(int i = 0; i < m_entries.size(); i++) {
+			Entry &e = m_entries[i];
+			if(!e.scaleCached) {
+				e.scale = 1.0;
+				e.offset = 0.0;
+				if(!e.scaleAttr.isEmpty() && !readDouble(e.ch, e.scaleAttr, e.scale, ret)) {
+					continue;
+				}
+				// most channels have no offset attribute, that is not an error
+				ssize_t offsetRet = 0;
+				if(!e.offsetAttr.isEmpty() && !readDouble(e.ch, e.offsetAttr, e.offset, offsetRet)) {
+					e.offset = 0.0;
+				}
+				e.scaleCached = true;
+			}
+
+			Reading &r = m_readings[i];
+			if(!readDouble(e.ch, e.rawAttr, r.raw, ret)) {
+				continue;
+			}
+			r.value = (r.raw + e.offset) * e.scale;
+			if(e.transform) {
+				r.value = e.transform(r.value);
+			}
+			r.valid = true;
+		}
+		m_cmdResult->errorCode = ret;
+		Q_EMIT finished(this);
+	}
+
+	const QVector<Entry> &entries() const { return m_entries; }
+	const QVector<Reading> &readings() const { return m_readings; }
+	int generation() const { return m_generation; }
+
+private:
+	bool readDouble(iio_channel *ch, const QByteArray &attr, double &value, ssize_t &ret) const
+	{
+		char buf[ATTR_MAX_SIZE];
+		ssize_t r = m_readFunction(ch, attr.constData(), buf, sizeof(buf));
+		bool ok = false;
+		if(r >= 0) {
+			value = QByteArray(buf, qstrnlen(buf, sizeof(buf))).trimmed().toDouble(&ok);
+			r = ok ? r : -EINVAL;
+		}
+		if(!ok) {
+			qDebug(CAT_CHANNELMONITOR) << "Cannot read" << attr << "of" << iio_channel_get_id(ch)
+						   << ", ret=" << r;
+			ret = r;
+		}
+		return ok;
+	}
+
+	QVector<Entry> m_entries;
+	QVector<Reading> m_readings;
+	ReadFunction m_readFunction;
+	int m_generation;
+};
+
+ChannelMonitor::ChannelMonitor(CommandQueue *commandQueue, QObject *parent)
+	: QObject(parent)
+	, m_commandQueue(commandQueue)
+	, m_timer(new QTimer(this))
+	, m_readFunction(iio_channel_attr_read)
+	, m_snapshot({.timestamp = 0, .readings = {}})
+	, m_pendingBatches(0)
+	, m_generation(0)
+{
+	qRegisterMetaType<scopy::ChannelMonitor::Snapshot>();
+	m_timer->setInterval(DEFAULT_INTERVAL_MS);
+	connect(m_timer, &QTimer::timeout, this, &ChannelMonitor::poll);
+}
+
+ChannelMonitor::~ChannelMonitor() {}
+
+void ChannelMonitor::addChannel(const QString &id, iio_channel *ch, Transform transform, const QString &rawAttr,
+				const QString &scaleAttr, const QString &offsetAttr)
+{
+	if(!ch) {
+		return;
+	}
+	removeChannel(id);
+	m_entries.append({.id = id,
+			  .ch = ch,
+			  .rawAttr = rawAttr.toLatin1(),
+			  .scaleAttr = scaleAttr.toLatin1(),
+			  .offsetAttr = offsetAttr.toLatin1(),
+			  .transform = transform,
+			  .scaleCached = false,
+			  .scale = 1.0,
+			  .offset = 0.0});
+}
+
+void ChannelMonitor::removeChannel(const QString &id)
+{
+	for(int i = 0; i < m_entries.size(); i++) {
+		if(m_entries[i].id == id) {
+			m_entries.remove(i);
+			break;
+		}
+	}
+	m_snapshot.readings.remove(id);
+}
+
+void ChannelMonitor::clear()
+{
+	m_entries.clear();
+	m_snapshot.readings.clear();
+}
+
+QStringList ChannelMonitor::channels() const
+{
+	QStringList ids;
+	for(const Entry &e : m_entries) {
+		ids.append(e.id);
+	}
+	return ids;
+}
+
+void ChannelMonitor::invalidateScales()
+{
+	// scales read by the batches still in flight are stale as well
+	m_generation++;
+	for(Entry &e : m_entries) {
+		e.scaleCached = false;
+	}
+}
+
+int ChannelMonitor::interval() const { return m_timer->interval(); }
+
+void ChannelMonitor::setInterval(int ms) { m_timer->setInterval(ms); }
+
+void ChannelMonitor::start()
+{
+	m_timer->start();
+	poll();
+}
+
+void ChannelMonitor::stop() { m_timer->stop(); }
+
+bool ChannelMonitor::isRunning() const { return m_timer->isActive(); }
+
+bool ChannelMonitor::isPolling() const { return m_pendingBatches > 0; }
+
+const ChannelMonitor::Snapshot &ChannelMonitor::snapshot() const { return m_snapshot; }
+
+void ChannelMonitor::setReadFunction(ReadFunction readFunction) { m_readFunction = readFunction; }
+
+void ChannelMonitor::poll()
+{
+	if(m_pendingBatches > 0) {
+		qDebug(CAT_CHANNELMONITOR) << "Previous poll still in flight, skipping";
+		return;
+	}
+	if(!m_commandQueue || m_entries.isEmpty()) {
+		return;
+	}
+
+	QMap<const iio_device *, QVector<Entry>> batches;
+	for(const Entry &e : qAsConst(m_entries)) {
+		batches[iio_channel_get_device(e.ch)].append(e);
+	}
+
+	m_pendingBatches = batches.size();
+	for(const QVector<Entry> &entries : qAsConst(batches)) {
+		Batch *batch = new Batch(entries, m_readFunction, m_generation);
+		connect(
+			batch, &scopy::Command::finished, this,
+			[this](scopy::Command *cmd) {
+				Batch *batch = dynamic_cast<Batch *>(cmd);
+				if(!batch) {
+					return;
+				}
+				onBatchFinished(batch->entries(), batch->readings(), batch->generation());
+			},
+			Qt::QueuedConnection);
+		m_commandQueue->enqueue(batch);
+	}
+}
+
+void ChannelMonitor::onBatchFinished(const QVector<Entry> &entries, const QVector<Reading> &readings, int generation)
+{
+	for(int i = 0; i < entries.size(); i++) {
+		const Entry &polled = entries[i];
+		auto it = std::find_if(m_entries.begin(), m_entries.end(), [&polled](const Entry &e) {
+			return e.id == polled.id && e.ch == polled.ch;
+		});
+		if(it == m_entries.end()) {
+			// removed while the poll was in flight
+			continue;
+		}
+		if(polled.scaleCached && !it->scaleCached && generation == m_generation) {
+			it->scaleCached = true;
+			it->scale = polled.scale;
+			it->offset = polled.offset;
+		}
+		m_snapshot.readings[polled.id] = readings[i];
+	}
+
+	m_pendingBatches--;
+	if(m_pendingBatches == 0) {
+		m_snapshot.timestamp = QDateTime::currentMSecsSinceEpoch();
+		Q_EMIT updated(m_snapshot);
+	}
+}
+
+#include "moc_channelmonitor.cpp"
@@ -24,6 +24,8 @@
 #include <QDebug>
 #include <QtConcurrent/QtConcurrent>
 
+#include <common/tracer.h>
+
 #include <functional>
 
 using namespace std;
@@ -90,6 +92,7 @@ void CommandQueue::runCmd()
 		connect(m_commandQueue.at(0), &Command::finished, this, &CommandQueue::resolveNext);
 		QtConcurrent::run(QThreadPool::globalInstance(), std::bind([=]() {
 					  std::unique_lock<std::mutex> lock(m_commandMutex);
+					  SCOPY_TRACE_SCOPE(m_commandQueue.at(0)->metaObject()->className());
 					  qDebug(CAT_COMMANDQUEUE) << "execute start " << m_commandQueue.at(0);
 					  m_commandQueue.at(0)->execute();
 					  qDebug(CAT_COMMANDQUEUE) << "execute stop " << m_commandQueue.at(0);
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "configuploader.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QMap>
+#include <QMutex>
+#include <QPair>
+#include <algorithm>
+#include <atomic>
+
+Q_LOGGING_CATEGORY(CAT_CONFIGUPLOADER, "ConfigUploader")
+
+using namespace scopy;
+
+// content hashed per step, also the granularity of the progress and of cancel()
+#define UPLOAD_CHUNK_SIZE (256 * 1024)
+// hashing is the first half of the progress, the write the second one
+#define HASH_PROGRESS 50
+// read back values are short summaries of the loaded configuration
+#define READBACK_MAX_SIZE 4096
+
+struct ConfigUploader::State
+{
+	typedef QPair<iio_device *, QByteArray> Key;
+	typedef struct
+	{
+		QByteArray hash;
+		bool readable;
+		QByteArray readback;
+	} Record;
+
+	QMutex mutex;
+	// null once the uploader is destroyed, the uploads still queued outlive it
+	ConfigUploader *owner = nullptr;
+	QMap<Key, Record> records;
+	std::atomic<quint64> nextId{0};
+	std::atomic<quint64> canceledBefore{0};
+
+	void progress(const QString &attr, int percent)
+	{
+		QMutexLocker lock(&mutex);
+		if(owner) {
+			Q_EMIT owner->uploadProgress(attr, percent);
+		}
+	}
+};
+
+class ConfigUploader::Upload : public Command
+{
+public:
+	Upload(const ConfigUploader *uploader, iio_device *dev, const QString &attr, const QString &path,
+	       const QByteArray &data)
+		: m_state(uploader->m_state)
+		, m_id(m_state->nextId++)
+		, m_dev(dev)
+		, m_attr(attr.toLatin1())
+		, m_path(path)
+		, m_data(data)
+		, m_writeFunction(uploader->m_writeFunction)
+		, m_readFunction(uploader->m_readFunction)
+		, m_uploadTimeout(uploader->m_uploadTimeout)
+		, m_restoreTimeout(uploader->m_restoreTimeout)
+		, m_result({.attribute = attr,
+			    .source = path,
+			    .status = UPLOAD_FAILED,
+			    .errorCode = 0,
+			    .hash = QByteArray(),
+			    .size = 0})
+	{
+		m_cmdResult = new CommandResult();
+	}
+
+	virtual void execute() override
+	{
+		Q_EMIT started(this);
+		m_result.errorCode = run();
+		m_cmdResult->errorCode = m_result.errorCode;
+		Q_EMIT finished(this);
+	}
+
+	const Result &result() const { return m_result; }
+
+private:
+	bool canceled() const { return m_id < m_state->canceledBefore; }
+
+	ssize_t run()
+	{
+		QFile file;
+		const char *data = m_data.constData();
+		qint64 size = m_data.size();
+		if(!m_path.isEmpty()) {
+			file.setFileName(m_path);
+			if(!file.open(QIODevice::ReadOnly)) {
+				qWarning(CAT_CONFIGUPLOADER) << "Cannot open" << m_path << ":" << file.errorString();
+				return -ENOENT;
+			}
+			size = file.size();
+			data = reinterpret_cast<const char *>(size > 0 ? file.map(0, size) : nullptr);
+			if(!data) {
+				// empty or not mappable (pipes, some network filesystems)
+				m_data = file.readAll();
+				data = m_data.constData();
+				size = m_data.size();
+			}
+		}
+		m_result.size = size;
+
+		QCryptographicHash hash(QCryptographicHash::Sha256);
+		for(qint64 pos = 0; pos < size; pos += UPLOAD_CHUNK_SIZE) {
+			if(canceled()) {
+				m_result.status = UPLOAD_CANCELED;
+				return -ECANCELED;
+			}
+			const qint64 len = std::min<qint64>(UPLOAD_CHUNK_SIZE, size - pos);
+			hash.addData(data + pos, len);
+			m_state->progress(m_result.attribute, (pos + len) * HASH_PROGRESS / size);
+		}
+		m_result.hash = hash.result().toHex();
+
+		const State::Key key(m_dev, m_attr);
+		State::Record record;
+		bool known = false;
+		{
+			QMutexLocker lock(&m_state->mutex);
+			known = m_state->records.contains(key);
+			record = m_state->records.value(key);
+		}
+		if(known && record.hash == m_result.hash) {
+			QByteArray readback;
+			// a write-only attribute can't confirm the device still holds the content, it is always written
+			const bool readable = readBack(readback);
+			if(readable && record.readable && readback == record.readback) {
+				qDebug(CAT_CONFIGUPLOADER) << "Skipping" << m_attr << ", the content did not change";
+				m_result.status = UPLOAD_SKIPPED;
+				m_state->progress(m_result.attribute, 100);
+				return 0;
+			}
+		}
+
+		if(canceled()) {
+			m_result.status = UPLOAD_CANCELED;
+			return -ECANCELED;
+		}
+
+		iio_context *ctx = const_cast<iio_context *>(iio_device_get_context(m_dev));
+		if(m_uploadTimeout > 0) {
+			iio_context_set_timeout(ctx, m_uploadTimeout);
+		}
+		ssize_t ret = m_writeFunction(m_dev, m_attr.constData(), data, size);
+		if(m_uploadTimeout > 0) {
+			iio_context_set_timeout(ctx, m_restoreTimeout);
+		}
+
+		if(ret < 0) {
+			qWarning(CAT_CONFIGUPLOADER) << "Cannot write" << m_attr << ", ret=" << ret;
+			// the device holds something unknown now
+			QMutexLocker lock(&m_state->mutex);
+			m_state->records.remove(key);
+			return ret;
+		}
+
+		record.hash = m_result.hash;
+		record.readable = readBack(record.readback);
+		{
+			QMutexLocker lock(&m_state->mutex);
+			m_state->records[key] = record;
+		}
+		m_result.status = UPLOAD_OK;
+		m_state->progress(m_result.attribute, 100);
+		return ret;
+	}
+
+	bool readBack(QByteArray &value) const
+	{
+		char buf[READBACK_MAX_SIZE];
+		ssize_t ret = m_readFunction(m_dev, m_attr.constData(), buf, sizeof(buf));
+		if(ret < 0) {
+			value.clear();
+			return false;
+		}
+		value = QByteArray(buf, qstrnlen(buf, sizeof(buf)));
+		return true;
+	}
+
+	std::shared_ptr<State> m_state;
+	quint64 m_id;
+	iio_device *m_dev;
+	QByteArray m_attr;
+	QString m_path;
+	QByteArray m_data;
+	WriteFunction m_writeFunction;
+	ReadFunction m_readFunction;
+	int m_uploadTimeout;
+	int m_restoreTimeout;
+	Result m_result;
+};
+
+ConfigUploader::ConfigUploader(CommandQueue *commandQueue, QObject *parent)
+	: QObject(parent)
+	, m_commandQueue(commandQueue)
+	, m_state(std::make_shared<State>())
+	, m_writeFunction(iio_device_attr_write_raw)
+	, m_readFunction(iio_device_attr_read)
+	, m_uploadTimeout(0)
+	, m_restoreTimeout(0)
+{
+	qRegisterMetaType<scopy::ConfigUploader::Result>();
+	m_state->owner = this;
+}
+
+ConfigUploader::~ConfigUploader()
+{
+	cancel();
+	QMutexLocker lock(&m_state->mutex);
+	m_state->owner = nullptr;
+}
+
+void ConfigUploader::upload(iio_device *dev, const QString &attr, const QString &path)
+{
+	enqueue(dev, attr, path, QByteArray());
+}
+
+void ConfigUploader::uploadData(iio_device *dev, const QString &attr, const QByteArray &data)
+{
+	enqueue(dev, attr, QString(), data);
+}
+
+void ConfigUploader::enqueue(iio_device *dev, const QString &attr, const QString &path, const QByteArray &data)
+{
+	if(!m_commandQueue || !dev) {
+		qWarning(CAT_CONFIGUPLOADER) << "Cannot upload" << attr << ", no device or command queue";
+		Q_EMIT uploadFinished({.attribute = attr,
+				       .source = path,
+				       .status = UPLOAD_FAILED,
+				       .errorCode = -ENODEV,
+				       .hash = QByteArray(),
+				       .size = 0});
+		return;
+	}
+
+	Upload *upload = new Upload(this, dev, attr, path, data);
+	connect(
+		upload, &scopy::Command::finished, this,
+		[this](scopy::Command *cmd) {
+			Upload *upload = dynamic_cast<Upload *>(cmd);
+			if(!upload) {
+				return;
+			}
+			Q_EMIT uploadFinished(upload->result());
+		},
+		Qt::QueuedConnection);
+	m_commandQueue->enqueue(upload);
+}
+
+void ConfigUploader::cancel() { m_state->canceledBefore = m_state->nextId.load(); }
+
+void ConfigUploader::forget(iio_device *dev, const QString &attr)
+{
+	QMutexLocker lock(&m_state->mutex);
+	m_state->records.remove(State::Key(dev, attr.toLatin1()));
+}
+
+void ConfigUploader::setTimeout(int uploadMs, int restoreMs)
+{
+	m_uploadTimeout = uploadMs;
+	m_restoreTimeout = restoreMs;
+}
+
+void ConfigUploader::setWriteFunction(WriteFunction writeFunction) { m_writeFunction = writeFunction; }
+
+void ConfigUploader::setReadFunction(ReadFunction readFunction) { m_readFunction = readFunction; }
+
+#include "moc_configuploader.cpp"
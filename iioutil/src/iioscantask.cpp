@@ -25,33 +25,238 @@
 
 #include <QElapsedTimer>
 #include <QLoggingCategory>
+#include <QMutexLocker>
+#include <QSet>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrent>
+#include <algorithm>
 
 #include <libserialport.h>
 
+// per backend, a backend still scanning after this long is reported as timed out
+#define IIO_SCAN_TIMEOUT 5000
+#define IIO_SCAN_POLL_INTERVAL 5
+#define IIO_SCAN_MAX_THREADS 16
+
 using namespace scopy;
 IIOScanTask::IIOScanTask(QObject *parent)
 	: QThread(parent)
+	, m_scanFunction(&IIOScanTask::scanBackend)
 {}
 
-IIOScanTask::~IIOScanTask() {}
+IIOScanTask::~IIOScanTask()
+{
+	cancel();
+	wait();
+}
 
 Q_LOGGING_CATEGORY(CAT_IIOSCANCTX, "IIOScanTask");
 
+static QThreadPool *scanPool()
+{
+	// libiio scans can't be interrupted, a timed out scan keeps its thread until it returns.
+	// A pool of its own keeps those off the global pool and is intentionally never destroyed,
+	// so exiting doesn't wait for them. The scans mostly wait on I/O, not on the CPU
+	static QThreadPool *pool = [] {
+		QThreadPool *p = new QThreadPool();
+		p->setMaxThreadCount(IIO_SCAN_MAX_THREADS);
+		return p;
+	}();
+	return pool;
+}
+
 void IIOScanTask::run()
 {
-	QVector<QPair<QString, QString>> ctxs;
-	int ret = IIOScanTask::scan(&ctxs, scanParams);
+	QStringList backends = splitBackends(scanParams);
+	QMap<QString, QVector<QPair<QString, QString>>> results;
+	ScanFunction scanFunction;
+	{
+		QMutexLocker lock(&m_mutex);
+		scanFunction = m_scanFunction;
+	}
+
+	scanParallel(
+		backends, scanFunction, [this](const QString &backend) { return backendTimeout(backend); },
+		[this]() { return isInterruptionRequested(); },
+		[this, &results](const BackendResult &r) {
+			QMutexLocker lock(&m_mutex);
+			if(r.ret < 0) {
+				results[r.backend] = m_cache.value(r.backend);
+				return;
+			}
+			m_cache[r.backend] = r.ctxs;
+			results[r.backend] = r.ctxs;
+			lock.unlock();
+			Q_EMIT backendScanFinished(r.backend, r.ctxs);
+		});
+
 	if(isInterruptionRequested())
 		return;
-	if(ret >= 0)
-		Q_EMIT scanFinished(ctxs);
+
+	QVector<QPair<QString, QString>> ctxs;
+	QSet<QString> uris;
+	for(const QString &backend : qAsConst(backends)) {
+		for(const auto &ctx : results.value(backend)) {
+			if(!uris.contains(ctx.second)) {
+				uris.insert(ctx.second);
+				ctxs.append(ctx);
+			}
+		}
+	}
+	Q_EMIT scanFinished(ctxs);
 }
 
 void IIOScanTask::setScanParams(QString s) { scanParams = s; }
 
+int IIOScanTask::backendTimeout(QString backend) const
+{
+	QMutexLocker lock(&m_mutex);
+	return m_timeouts.value(backend.section('=', 0, 0), IIO_SCAN_TIMEOUT);
+}
+
+void IIOScanTask::setBackendTimeout(QString backend, int ms)
+{
+	QMutexLocker lock(&m_mutex);
+	m_timeouts[backend] = ms;
+}
+
+void IIOScanTask::setScanFunction(ScanFunction scanFunction)
+{
+	QMutexLocker lock(&m_mutex);
+	if(scanFunction) {
+		m_scanFunction = scanFunction;
+	} else {
+		m_scanFunction = &IIOScanTask::scanBackend;
+	}
+}
+
+void IIOScanTask::cancel() { requestInterruption(); }
+
+void IIOScanTask::restart()
+{
+	if(isRunning()) {
+		cancel();
+		wait();
+	}
+	start();
+}
+
+void IIOScanTask::clearCache()
+{
+	QMutexLocker lock(&m_mutex);
+	m_cache.clear();
+}
+
+int IIOScanTask::scanParallel(const QStringList &backends, const ScanFunction &scanFunction,
+			      const std::function<int(const QString &)> &timeout, const std::function<bool()> &canceled,
+			      const std::function<void(const BackendResult &)> &onResult)
+{
+	QElapsedTimer et;
+	et.start();
+
+	QList<QFuture<BackendResult>> pending;
+	QList<QString> pendingBackends;
+	QList<qint64> deadlines;
+	for(const QString &backend : backends) {
+		pending.append(QtConcurrent::run(scanPool(), [scanFunction, backend]() {
+			BackendResult r;
+			r.backend = backend;
+			r.ret = scanFunction(&r.ctxs, backend);
+			return r;
+		}));
+		pendingBackends.append(backend);
+		deadlines.append(timeout(backend));
+	}
+
+	int ret = backends.isEmpty() ? 0 : -ENODEV;
+	while(!pending.isEmpty()) {
+		if(canceled()) {
+			qDebug(CAT_IIOSCANCTX) << "scan canceled, dropping" << pendingBackends;
+			return -ECANCELED;
+		}
+
+		for(int i = pending.size() - 1; i >= 0; i--) {
+			BackendResult r;
+			if(pending[i].isFinished()) {
+				r = pending[i].result();
+				qDebug(CAT_IIOSCANCTX) << r.backend << "scanned in" << et.elapsed() << "ms";
+			} else if(et.elapsed() > deadlines[i]) {
+				qWarning(CAT_IIOSCANCTX) << pendingBackends[i] << "scan timed out after" << deadlines[i]
+							 << "ms";
+				r = {.backend = pendingBackends[i], .ret = -ETIMEDOUT, .ctxs = {}};
+			} else {
+				continue;
+			}
+
+			pending.removeAt(i);
+			pendingBackends.removeAt(i);
+			deadlines.removeAt(i);
+			if(r.ret >= 0) {
+				ret = std::max(ret, 0) + r.ret;
+			} else if(ret < 0) {
+				ret = r.ret;
+			}
+			onResult(r);
+		}
+
+		if(!pending.isEmpty()) {
+			QThread::msleep(IIO_SCAN_POLL_INTERVAL);
+		}
+	}
+	return ret;
+}
+
 int IIOScanTask::scan(QVector<QPair<QString, QString>> *ctxs, QString scanParams)
 {
-	qDebug(CAT_IIOSCANCTX) << "start scanning";
+	QSet<QString> uris;
+	return scanParallel(
+		splitBackends(scanParams), &IIOScanTask::scanBackend, [](const QString &) { return IIO_SCAN_TIMEOUT; },
+		[]() { return false; },
+		[ctxs, &uris](const BackendResult &r) {
+			for(const auto &ctx : r.ctxs) {
+				if(!uris.contains(ctx.second)) {
+					uris.insert(ctx.second);
+					ctxs->append(ctx);
+				}
+			}
+		});
+}
+
+QStringList IIOScanTask::splitBackends(QString scanParams)
+{
+	QStringList known = {"local", "ip", "usb", "serial", "xml"};
+	for(unsigned int i = 0; i < iio_get_backends_count(); i++) {
+		known.append(iio_get_backend(i));
+	}
+
+	if(scanParams.isEmpty()) {
+		QStringList backends;
+		for(unsigned int i = 0; i < iio_get_backends_count(); i++) {
+			QString backend(iio_get_backend(i));
+			// not scannable
+			if(backend != "xml" && backend != "serial") {
+				backends.append(backend);
+			}
+		}
+		return backends;
+	}
+
+	QStringList backends;
+	for(const QString &token : scanParams.split(':', Qt::SkipEmptyParts)) {
+		if(backends.isEmpty() || known.contains(token.section('=', 0, 0))) {
+			backends.append(token);
+		} else {
+			// options of the previous backend, e.g. usb=0456:b673
+			backends.last() += ":" + token;
+		}
+	}
+	backends.removeDuplicates();
+	return backends;
+}
+
+int IIOScanTask::scanBackend(QVector<QPair<QString, QString>> *ctxs, QString backend)
+{
+	qDebug(CAT_IIOSCANCTX) << "start scanning" << backend;
 	struct iio_scan_context *scan_ctx = NULL;
 	struct iio_context_info **info;
 	int num_contexts;
@@ -60,10 +265,10 @@ int IIOScanTask::scan(QVector<QPair<QString, QString>> *ctxs, QString scanParams
 
 	QElapsedTimer et;
 	et.start();
-	if(scanParams.isEmpty()) {
+	if(backend.isEmpty()) {
 		scan_ctx = iio_create_scan_context(NULL, 0);
 	} else {
-		scan_ctx = iio_create_scan_context(scanParams.toStdString().c_str(), 0);
+		scan_ctx = iio_create_scan_context(backend.toStdString().c_str(), 0);
 	}
 
 	if(!scan_ctx) {
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "offsetcalibration.h"
+
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+
+using namespace scopy;
+
+OffsetCalibration::OffsetCalibration(const Settings &settings)
+	: m_settings(settings)
+{}
+
+OffsetCalibration::~OffsetCalibration() {}
+
+const OffsetCalibration::Settings &OffsetCalibration::settings() const { return m_settings; }
+
+OffsetCalibration::Result OffsetCalibration::run(double control, const Actuator &apply, const Sensor &measure) const
+{
+	Result result = {.converged = false, .control = control, .residual = 0, .history = {}, .error = ""};
+	double measurement = 0;
+
+	if(!measure(measurement)) {
+		result.error = "Failed to measure the offset";
+		return result;
+	}
+	result.history.append({.control = control, .measurement = measurement});
+
+	Step best = result.history.last();
+	double applied = control;
+	bool resolved = false;
+	double gain = (m_settings.gain != 0) ? m_settings.gain : 1.0;
+
+	for(int i = 0; i < m_settings.maxIterations; i++) {
+		if(std::abs(measurement) <= m_settings.tolerance) {
+			break;
+		}
+
+		const double target = control - measurement / gain;
+		const double next = std::clamp(target, m_settings.minControl, m_settings.maxControl);
+		if(std::abs(next - control) < m_settings.resolution / 2) {
+			// the correction is below what the control can resolve, unless the control is at a limit
+			resolved = (next == target);
+			break;
+		}
+
+		double nextMeasurement = 0;
+		if(!apply(next)) {
+			result.error = "Failed to apply the control value";
+			break;
+		}
+		applied = next;
+		if(m_settings.settleMs > 0) {
+			QThread::msleep(m_settings.settleMs);
+		}
+		if(!measure(nextMeasurement)) {
+			result.error = "Failed to measure the offset";
+			break;
+		}
+		result.history.append({.control = next, .measurement = nextMeasurement});
+
+		// steps a few codes apart are dominated by noise, keep the previous slope for them. A slope
+		// with the wrong sign would diverge, it can only come from noise as well
+		const double slope = (nextMeasurement - measurement) / (next - control);
+		if(std::abs(next - control) > 2 * m_settings.resolution && std::isfinite(slope) && slope * gain > 0) {
+			gain = slope;
+		}
+
+		control = next;
+		measurement = nextMeasurement;
+		if(std::abs(measurement) < std::abs(best.measurement)) {
+			best = result.history.last();
+		}
+	}
+
+	if(result.error.isEmpty() && applied != best.control) {
+		if(apply(best.control)) {
+			applied = best.control;
+		} else {
+			result.error = "Failed to apply the control value";
+		}
+	}
+
+	result.control = applied;
+	result.residual = (applied == best.control) ? best.measurement : measurement;
+	result.converged = result.error.isEmpty() && (std::abs(result.residual) <= m_settings.tolerance || resolved);
+	return result;
+}
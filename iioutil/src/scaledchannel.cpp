@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "scaledchannel.h"
+
+#include <QLoggingCategory>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+Q_LOGGING_CATEGORY(CAT_SCALEDCHANNEL, "ScaledChannel")
+
+using namespace scopy;
+
+// raw reads are one round trip each, averaging more of them costs more than it gains
+#define RAW_MEAN_MAX_READS 16
+
+// iio_channel_convert() leaves the value in the first length / 8 bytes of its output
+template <typename S, typename U>
+static double storedValue(const void *data, bool isSigned)
+{
+	if(isSigned) {
+		S v;
+		memcpy(&v, data, sizeof(v));
+		return v;
+	}
+	U v;
+	memcpy(&v, data, sizeof(v));
+	return v;
+}
+
+ScaledChannel::ScaledChannel(iio_channel *ch)
+	: m_ch(ch)
+	, m_scale(1.0)
+	, m_offset(0.0)
+	, m_valid(false)
+{
+	if(!m_ch) {
+		return;
+	}
+
+	int ret = iio_channel_attr_read_double(m_ch, "scale", &m_scale);
+	if(ret < 0) {
+		qWarning(CAT_SCALEDCHANNEL) << "Cannot read scale of" << iio_channel_get_id(m_ch) << ", ret=" << ret;
+		return;
+	}
+	if(iio_channel_find_attr(m_ch, "offset")) {
+		iio_channel_attr_read_double(m_ch, "offset", &m_offset);
+	}
+	m_valid = true;
+}
+
+ScaledChannel::~ScaledChannel() {}
+
+iio_channel *ScaledChannel::channel() const { return m_ch; }
+
+bool ScaledChannel::isValid() const { return m_valid; }
+
+double ScaledChannel::scale() const { return m_scale; }
+
+double ScaledChannel::offset() const { return m_offset; }
+
+bool ScaledChannel::read(double &value) const
+{
+	if(!m_valid) {
+		return false;
+	}
+
+	long long raw = 0;
+	int ret = iio_channel_attr_read_longlong(m_ch, "raw", &raw);
+	if(ret < 0) {
+		qWarning(CAT_SCALEDCHANNEL) << "Cannot read raw of" << iio_channel_get_id(m_ch) << ", ret=" << ret;
+		return false;
+	}
+
+	value = (raw + m_offset) * m_scale;
+	return true;
+}
+
+bool ScaledChannel::readMean(int samples, double &value) const
+{
+	if(!m_valid) {
+		return false;
+	}
+
+	double rawMean = 0;
+	if(samples > 1 && iio_channel_is_scan_element(m_ch) && readBufferMean(samples, rawMean)) {
+		value = (rawMean + m_offset) * m_scale;
+		return true;
+	}
+
+	const int reads = std::clamp(samples, 1, RAW_MEAN_MAX_READS);
+	double sum = 0;
+	for(int i = 0; i < reads; i++) {
+		double v = 0;
+		if(!read(v)) {
+			return false;
+		}
+		sum += v;
+	}
+	value = sum / reads;
+	return true;
+}
+
+bool ScaledChannel::write(double value) const
+{
+	if(!m_valid || m_scale == 0.0) {
+		return false;
+	}
+
+	long long raw = std::llround(value / m_scale - m_offset);
+	int ret = iio_channel_attr_write_longlong(m_ch, "raw", raw);
+	if(ret < 0) {
+		qWarning(CAT_SCALEDCHANNEL) << "Cannot write raw of" << iio_channel_get_id(m_ch) << ", ret=" << ret;
+		return false;
+	}
+	return true;
+}
+
+bool ScaledChannel::readBufferMean(int samples, double &rawMean) const
+{
+	iio_device *dev = const_cast<iio_device *>(iio_channel_get_device(m_ch));
+	const bool wasEnabled = iio_channel_is_enabled(m_ch);
+	iio_channel_enable(m_ch);
+
+	iio_buffer *buf = iio_device_create_buffer(dev, samples, false);
+	if(!buf) {
+		// e.g. the device is already streaming to another tool
+		if(!wasEnabled) {
+			iio_channel_disable(m_ch);
+		}
+		return false;
+	}
+
+	const iio_data_format *fmt = iio_channel_get_data_format(m_ch);
+	const ptrdiff_t step = iio_buffer_step(buf);
+	double sum = 0;
+	int count = 0;
+
+	if(iio_buffer_refill(buf) > 0) {
+		const char *end = static_cast<const char *>(iio_buffer_end(buf));
+		for(const char *p = static_cast<const char *>(iio_buffer_first(buf, m_ch)); p < end; p += step) {
+			// converts to host endianness, shifts and sign extends the value to its storage size
+			uint64_t converted = 0;
+			iio_channel_convert(m_ch, &converted, p);
+
+			double v = 0;
+			switch(fmt->length) {
+			case 8:
+				v = storedValue<int8_t, uint8_t>(&converted, fmt->is_signed);
+				break;
+			case 16:
+				v = storedValue<int16_t, uint16_t>(&converted, fmt->is_signed);
+				break;
+			case 32:
+				v = storedValue<int32_t, uint32_t>(&converted, fmt->is_signed);
+				break;
+			default:
+				v = storedValue<int64_t, uint64_t>(&converted, fmt->is_signed);
+				break;
+			}
+			sum += v;
+			count++;
+		}
+	}
+
+	iio_buffer_destroy(buf);
+	if(!wasEnabled) {
+		iio_channel_disable(m_ch);
+	}
+
+	if(count == 0) {
+		return false;
+	}
+	rawMean = sum / count;
+	return true;
+}
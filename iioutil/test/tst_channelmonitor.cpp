@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iioutil/channelmonitor.h>
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QSignalSpy>
+#include <QTest>
+#include <atomic>
+#include <cstring>
+
+using namespace scopy;
+
+// a voltage monitor and an ADC, the attribute values are served by the mock read function
+static const char *CONTEXT_XML = "<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+				 "<context name=\"xml\">"
+				 "<device id=\"iio:device0\" name=\"ltc2308\">"
+				 "<channel id=\"voltage0\" type=\"input\"/>"
+				 "<channel id=\"voltage1\" type=\"input\"/>"
+				 "<channel id=\"voltage2\" type=\"input\"/>"
+				 "<channel id=\"voltage3\" type=\"input\"/>"
+				 "</device>"
+				 "<device id=\"iio:device1\" name=\"ad7768-1\">"
+				 "<channel id=\"voltage0\" type=\"input\"/>"
+				 "</device>"
+				 "</context>";
+
+class TST_ChannelMonitor : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void initTestCase();
+	void cleanupTestCase();
+	void init();
+	void cleanup();
+	void conversion();
+	void attributeTraffic();
+	void nonBlocking();
+	void skipOverlapping();
+	void failures();
+
+private:
+	// serves m_attrs after m_latency ms, like a network context would
+	ChannelMonitor::ReadFunction mock();
+	void setAttr(const QString &key, const QString &value);
+	iio_channel *channel(const char *dev, const char *id);
+	void addChannels();
+	bool pollAndWait();
+
+	iio_context *m_ctx = nullptr;
+	CommandQueue *m_queue = nullptr;
+	ChannelMonitor *m_monitor = nullptr;
+
+	QMutex m_mutex;
+	QMap<QString, QString> m_attrs;
+	QStringList m_reads;
+	std::atomic<int> m_latency{0};
+};
+
+ChannelMonitor::ReadFunction TST_ChannelMonitor::mock()
+{
+	return [this](iio_channel *ch, const char *attr, char *dst, size_t len) -> ssize_t {
+		QThread::msleep(m_latency);
+		const iio_device *dev = iio_channel_get_device(ch);
+		const QString key = QString("%1/%2/%3").arg(iio_device_get_name(dev), iio_channel_get_id(ch), attr);
+
+		QMutexLocker lock(&m_mutex);
+		m_reads.append(key);
+		if(!m_attrs.contains(key)) {
+			return -ENOENT;
+		}
+		const QByteArray value = m_attrs.value(key).toLatin1();
+		if(value == "EIO") {
+			return -EIO;
+		}
+		qstrncpy(dst, value.constData(), len);
+		return value.size() + 1;
+	};
+}
+
+void TST_ChannelMonitor::setAttr(const QString &key, const QString &value)
+{
+	QMutexLocker lock(&m_mutex);
+	m_attrs[key] = value;
+}
+
+iio_channel *TST_ChannelMonitor::channel(const char *dev, const char *id)
+{
+	return iio_device_find_channel(iio_context_find_device(m_ctx, dev), id, false);
+}
+
+void TST_ChannelMonitor::addChannels()
+{
+	for(const char *id : {"voltage0", "voltage1", "voltage2", "voltage3"}) {
+		m_monitor->addChannel(QString("ltc2308/") + id, channel("ltc2308", id));
+	}
+	m_monitor->addChannel("ad7768-1/voltage0", channel("ad7768-1", "voltage0"));
+}
+
+bool TST_ChannelMonitor::pollAndWait()
+{
+	QSignalSpy updated(m_monitor, &ChannelMonitor::updated);
+	m_monitor->poll();
+	return updated.wait(5000) && updated.count() == 1;
+}
+
+void TST_ChannelMonitor::initTestCase()
+{
+	m_ctx = iio_create_xml_context_mem(CONTEXT_XML, strlen(CONTEXT_XML));
+	QVERIFY(m_ctx);
+}
+
+void TST_ChannelMonitor::cleanupTestCase() { iio_context_destroy(m_ctx); }
+
+void TST_ChannelMonitor::init()
+{
+	m_queue = new CommandQueue();
+	m_monitor = new ChannelMonitor(m_queue);
+	m_monitor->setReadFunction(mock());
+	m_latency = 0;
+	m_reads.clear();
+	m_attrs.clear();
+	for(const char *dev : {"ltc2308", "ad7768-1"}) {
+		for(const char *id : {"voltage0", "voltage1", "voltage2", "voltage3"}) {
+			setAttr(QString("%1/%2/raw").arg(dev, id), "100");
+			setAttr(QString("%1/%2/scale").arg(dev, id), "0.5");
+		}
+	}
+}
+
+void TST_ChannelMonitor::cleanup()
+{
+	delete m_monitor;
+	m_queue->wait();
+	QCoreApplication::processEvents();
+	delete m_queue;
+}
+
+void TST_ChannelMonitor::conversion()
+{
+	setAttr("ltc2308/voltage0/raw", "1000");
+	setAttr("ltc2308/voltage0/offset", "-10");
+	setAttr("ltc2308/voltage1/raw", " 200\n");
+	setAttr("ltc2308/voltage1/scale", "2");
+	m_monitor->addChannel("vin", channel("ltc2308", "voltage0"));
+	m_monitor->addChannel("vsupply", channel("ltc2308", "voltage1"), [](double mV) { return mV * 3; });
+	m_monitor->addChannel("noscale", channel("ltc2308", "voltage2"), nullptr, "raw", "", "");
+	m_monitor->addChannel("adc", channel("ad7768-1", "voltage0"));
+
+	// both devices answer before the snapshot is published
+	QVERIFY(pollAndWait());
+	const ChannelMonitor::Snapshot &s = m_monitor->snapshot();
+	QCOMPARE(s.readings.size(), 4);
+	QVERIFY(s.timestamp > 0);
+	QVERIFY(s.readings["vin"].valid);
+	QCOMPARE(s.readings["vin"].raw, 1000.0);
+	QCOMPARE(s.readings["vin"].value, 495.0);
+	QCOMPARE(s.readings["vsupply"].value, 1200.0);
+	QCOMPARE(s.readings["noscale"].value, 100.0);
+	QCOMPARE(s.readings["adc"].value, 50.0);
+
+	m_monitor->removeChannel("adc");
+	QCOMPARE(m_monitor->channels(), QStringList({"vin", "vsupply", "noscale"}));
+	QVERIFY(!m_monitor->snapshot().readings.contains("adc"));
+}
+
+void TST_ChannelMonitor::attributeTraffic()
+{
+	addChannels();
+	const int channels = m_monitor->channels().size();
+
+	// raw, scale and offset the first time
+	QVERIFY(pollAndWait());
+	QCOMPARE(m_reads.size(), channels * 3);
+
+	// polling raw and scale for every channel costs 2 reads per channel, the cached scale halves it
+	for(int i = 0; i < 3; i++) {
+		m_reads.clear();
+		QVERIFY(pollAndWait());
+		QCOMPARE(m_reads.size(), channels);
+		for(const QString &read : qAsConst(m_reads)) {
+			QVERIFY(read.endsWith("/raw"));
+		}
+	}
+
+	setAttr("ltc2308/voltage3/scale", "0.25");
+	m_monitor->invalidateScales();
+	m_reads.clear();
+	QVERIFY(pollAndWait());
+	QCOMPARE(m_reads.size(), channels * 3);
+	QCOMPARE(m_monitor->snapshot().readings["ltc2308/voltage3"].value, 25.0);
+}
+
+void TST_ChannelMonitor::nonBlocking()
+{
+	addChannels();
+	m_latency = 50;
+
+	// 15 reads of 50ms, the caller does not wait for any of them
+	QSignalSpy updated(m_monitor, &ChannelMonitor::updated);
+	QElapsedTimer et;
+	et.start();
+	m_monitor->poll();
+	QVERIFY(et.elapsed() < m_latency);
+	QVERIFY(m_monitor->isPolling());
+
+	QVERIFY(updated.wait(5000));
+	QVERIFY(!m_monitor->isPolling());
+	QCOMPARE(m_monitor->snapshot().readings.size(), 5);
+}
+
+void TST_ChannelMonitor::skipOverlapping()
+{
+	addChannels();
+	QVERIFY(pollAndWait());
+	m_reads.clear();
+	m_latency = 50;
+
+	// a timer faster than the context must not pile up commands
+	QSignalSpy updated(m_monitor, &ChannelMonitor::updated);
+	m_monitor->setInterval(10);
+	m_monitor->start();
+	QVERIFY(updated.wait(5000));
+	m_monitor->stop();
+	QVERIFY(!m_monitor->isRunning());
+	QTRY_VERIFY_WITH_TIMEOUT(!m_monitor->isPolling(), 5000);
+
+	// every poll that ran read each channel once
+	QCOMPARE(m_reads.size() % 5, 0);
+	QCOMPARE(m_reads.size() / 5, updated.count());
+	// 250ms per poll, a poll per tick would have been ~25 polls
+	QVERIFY(updated.count() <= 3);
+}
+
+void TST_ChannelMonitor::failures()
+{
+	addChannels();
+	setAttr("ltc2308/voltage1/raw", "EIO");
+	setAttr("ltc2308/voltage2/raw", "not a number");
+	setAttr("ad7768-1/voltage0/scale", "EIO");
+
+	QVERIFY(pollAndWait());
+	const ChannelMonitor::Snapshot &s = m_monitor->snapshot();
+	QVERIFY(s.readings["ltc2308/voltage0"].valid);
+	QVERIFY(!s.readings["ltc2308/voltage1"].valid);
+	QVERIFY(!s.readings["ltc2308/voltage2"].valid);
+	QVERIFY(s.readings["ltc2308/voltage3"].valid);
+	QVERIFY(!s.readings["ad7768-1/voltage0"].valid);
+
+	// the scale that failed is read again, the cached ones are not
+	setAttr("ad7768-1/voltage0/scale", "2");
+	m_reads.clear();
+	QVERIFY(pollAndWait());
+	QCOMPARE(m_reads.count("ad7768-1/voltage0/scale"), 1);
+	QCOMPARE(m_reads.count("ltc2308/voltage0/scale"), 0);
+	QCOMPARE(m_monitor->snapshot().readings["ad7768-1/voltage0"].value, 200.0);
+}
+
+QTEST_MAIN(TST_ChannelMonitor)
+#include "tst_channelmonitor.moc"
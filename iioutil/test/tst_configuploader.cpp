@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iioutil/configuploader.h>
+
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QSignalSpy>
+#include <QTemporaryFile>
+#include <QTest>
+#include <atomic>
+#include <cstring>
+
+using namespace scopy;
+
+static const char *CONTEXT_XML = "<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+				 "<context name=\"xml\">"
+				 "<device id=\"iio:device0\" name=\"adrv9009-phy\"/>"
+				 "</context>";
+
+class TST_ConfigUploader : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void initTestCase();
+	void cleanupTestCase();
+	void init();
+	void cleanup();
+	void uploadFile();
+	void skipUnchanged();
+	void failures();
+	void cancel();
+	void progress();
+
+private:
+	// stores the written blobs, reads back a short summary of them like the drivers do
+	void installMock();
+	QString writeFile(const QByteArray &content);
+	ConfigUploader::Result uploadAndWait(const QString &attr, const QString &path);
+
+	iio_context *m_ctx = nullptr;
+	iio_device *m_dev = nullptr;
+	CommandQueue *m_queue = nullptr;
+	ConfigUploader *m_uploader = nullptr;
+	QList<QTemporaryFile *> m_files;
+
+	QMutex m_mutex;
+	QMap<QString, QByteArray> m_blobs;
+	int m_writes = 0;
+	std::atomic<int> m_latency{0};
+	std::atomic<int> m_writeError{0};
+	std::atomic<bool> m_writing{false};
+	std::atomic<bool> m_writeOnly{false};
+};
+
+void TST_ConfigUploader::installMock()
+{
+	m_uploader->setWriteFunction([this](iio_device *, const char *attr, const void *src, size_t len) -> ssize_t {
+		m_writing = true;
+		QThread::msleep(m_latency);
+		m_writing = false;
+		if(m_writeError) {
+			return m_writeError;
+		}
+		QMutexLocker lock(&m_mutex);
+		m_blobs[attr] = QByteArray(static_cast<const char *>(src), len);
+		m_writes++;
+		return len;
+	});
+	m_uploader->setReadFunction([this](iio_device *, const char *attr, char *dst, size_t len) -> ssize_t {
+		QMutexLocker lock(&m_mutex);
+		if(m_writeOnly) {
+			return -EACCES;
+		}
+		if(!m_blobs.contains(attr)) {
+			return -ENOENT;
+		}
+		const QByteArray &blob = m_blobs[attr];
+		const QByteArray summary = QString("%1 bytes, crc %2").arg(blob.size()).arg(qChecksum(blob)).toLatin1();
+		qstrncpy(dst, summary.constData(), len);
+		return summary.size() + 1;
+	});
+}
+
+QString TST_ConfigUploader::writeFile(const QByteArray &content)
+{
+	QTemporaryFile *file = new QTemporaryFile();
+	file->open();
+	file->write(content);
+	file->flush();
+	m_files.append(file);
+	return file->fileName();
+}
+
+ConfigUploader::Result TST_ConfigUploader::uploadAndWait(const QString &attr, const QString &path)
+{
+	QSignalSpy finished(m_uploader, &ConfigUploader::uploadFinished);
+	m_uploader->upload(m_dev, attr, path);
+	if(!finished.wait(5000)) {
+		return {.attribute = attr,
+			.source = path,
+			.status = ConfigUploader::UPLOAD_FAILED,
+			.errorCode = -ETIMEDOUT,
+			.hash = QByteArray(),
+			.size = 0};
+	}
+	return finished[0][0].value<ConfigUploader::Result>();
+}
+
+void TST_ConfigUploader::initTestCase()
+{
+	m_ctx = iio_create_xml_context_mem(CONTEXT_XML, strlen(CONTEXT_XML));
+	QVERIFY(m_ctx);
+	m_dev = iio_context_find_device(m_ctx, "adrv9009-phy");
+	QVERIFY(m_dev);
+}
+
+void TST_ConfigUploader::cleanupTestCase() { iio_context_destroy(m_ctx); }
+
+void TST_ConfigUploader::init()
+{
+	m_queue = new CommandQueue();
+	m_uploader = new ConfigUploader(m_queue);
+	installMock();
+	m_blobs.clear();
+	m_writes = 0;
+	m_latency = 0;
+	m_writeError = 0;
+	m_writeOnly = false;
+}
+
+void TST_ConfigUploader::cleanup()
+{
+	delete m_uploader;
+	m_queue->wait();
+	QCoreApplication::processEvents();
+	delete m_queue;
+	qDeleteAll(m_files);
+	m_files.clear();
+}
+
+void TST_ConfigUploader::uploadFile()
+{
+	QByteArray content;
+	for(int i = 0; i < 20000; i++) {
+		content += QString("%1,%2\n").arg(i).arg(-i).toLatin1();
+	}
+	const QString path = writeFile(content);
+	m_latency = 200;
+
+	// the caller does not wait for the transfer
+	QSignalSpy finished(m_uploader, &ConfigUploader::uploadFinished);
+	QElapsedTimer et;
+	et.start();
+	m_uploader->upload(m_dev, "profile_config", path);
+	QVERIFY(et.elapsed() < m_latency);
+
+	QVERIFY(finished.wait(5000));
+	ConfigUploader::Result result = finished[0][0].value<ConfigUploader::Result>();
+	QCOMPARE(result.status, ConfigUploader::UPLOAD_OK);
+	QCOMPARE(result.attribute, QString("profile_config"));
+	QCOMPARE(result.source, path);
+	QCOMPARE(result.size, qint64(content.size()));
+	QCOMPARE(result.hash, QCryptographicHash::hash(content, QCryptographicHash::Sha256).toHex());
+	QCOMPARE(m_blobs["profile_config"], content);
+
+	// in memory data is uploaded the same way
+	QSignalSpy finishedData(m_uploader, &ConfigUploader::uploadFinished);
+	m_uploader->uploadData(m_dev, "stream_config", "stream");
+	QVERIFY(finishedData.wait(5000));
+	QCOMPARE(finishedData[0][0].value<ConfigUploader::Result>().status, ConfigUploader::UPLOAD_OK);
+	QCOMPARE(m_blobs["stream_config"], QByteArray("stream"));
+}
+
+void TST_ConfigUploader::skipUnchanged()
+{
+	const QString profileA = writeFile("profile A");
+	const QString profileB = writeFile("profile B, longer");
+
+	QCOMPARE(uploadAndWait("profile_config", profileA).status, ConfigUploader::UPLOAD_OK);
+	QCOMPARE(m_writes, 1);
+
+	// the device already holds it
+	QCOMPARE(uploadAndWait("profile_config", profileA).status, ConfigUploader::UPLOAD_SKIPPED);
+	QCOMPARE(m_writes, 1);
+
+	// the same content on another attribute is a different configuration
+	QCOMPARE(uploadAndWait("pfilt_config", profileA).status, ConfigUploader::UPLOAD_OK);
+	QCOMPARE(m_writes, 2);
+
+	QCOMPARE(uploadAndWait("profile_config", profileB).status, ConfigUploader::UPLOAD_OK);
+	QCOMPARE(uploadAndWait("profile_config", profileA).status, ConfigUploader::UPLOAD_OK);
+	QCOMPARE(m_writes, 4);
+
+	// reconfigured by someone else, the read back value changed
+	{
+		QMutexLocker lock(&m_mutex);
+		m_blobs["profile_config"] = "loaded by another client";
+	}
+	QCOMPARE(uploadAndWait("profile_config", profileA).status, ConfigUploader::UPLOAD_OK);
+	QCOMPARE(m_writes, 5);
+
+	m_uploader->forget(m_dev, "profile_config");
+	QCOMPARE(uploadAndWait("profile_config", profileA).status, ConfigUploader::UPLOAD_OK);
+	QCOMPARE(m_writes, 6);
+
+	// nothing confirms what a write-only attribute holds, the hash alone doesn't skip
+	m_writeOnly = true;
+	QCOMPARE(uploadAndWait("stream_config", profileA).status, ConfigUploader::UPLOAD_OK);
+	QCOMPARE(uploadAndWait("stream_config", profileA).status, ConfigUploader::UPLOAD_OK);
+	QCOMPARE(m_writes, 8);
+}
+
+void TST_ConfigUploader::failures()
+{
+	ConfigUploader::Result result = uploadAndWait("profile_config", "/nonexistent/profile.txt");
+	QCOMPARE(result.status, ConfigUploader::UPLOAD_FAILED);
+	QCOMPARE(result.errorCode, -ENOENT);
+
+	const QString profile = writeFile("profile");
+	m_writeError = -EIO;
+	result = uploadAndWait("profile_config", profile);
+	QCOMPARE(result.status, ConfigUploader::UPLOAD_FAILED);
+	QCOMPARE(result.errorCode, -EIO);
+
+	// a failed upload is never skipped
+	m_writeError = 0;
+	QCOMPARE(uploadAndWait("profile_config", profile).status, ConfigUploader::UPLOAD_OK);
+	m_writeError = -EIO;
+	QCOMPARE(uploadAndWait("profile_config", profile).status, ConfigUploader::UPLOAD_SKIPPED);
+	QCOMPARE(uploadAndWait("profile_config", writeFile("other")).status, ConfigUploader::UPLOAD_FAILED);
+	m_writeError = 0;
+	QCOMPARE(uploadAndWait("profile_config", profile).status, ConfigUploader::UPLOAD_OK);
+
+	ConfigUploader noQueue(nullptr);
+	QSignalSpy finished(&noQueue, &ConfigUploader::uploadFinished);
+	noQueue.upload(m_dev, "profile_config", profile);
+	QCOMPARE(finished.count(), 1);
+	QCOMPARE(finished[0][0].value<ConfigUploader::Result>().status, ConfigUploader::UPLOAD_FAILED);
+}
+
+void TST_ConfigUploader::cancel()
+{
+	const QString profileA = writeFile("profile A");
+	const QString profileB = writeFile("profile B");
+	m_latency = 300;
+
+	QSignalSpy finished(m_uploader, &ConfigUploader::uploadFinished);
+	m_uploader->upload(m_dev, "profile_config", profileA);
+	m_uploader->upload(m_dev, "profile_config", profileB);
+	QTRY_VERIFY_WITH_TIMEOUT(m_writing, 5000);
+	m_uploader->cancel();
+
+	// the write in progress completes, the queued upload never reaches the device
+	QTRY_COMPARE_WITH_TIMEOUT(finished.count(), 2, 5000);
+	QCOMPARE(finished[0][0].value<ConfigUploader::Result>().status, ConfigUploader::UPLOAD_OK);
+	QCOMPARE(finished[1][0].value<ConfigUploader::Result>().status, ConfigUploader::UPLOAD_CANCELED);
+	QCOMPARE(m_writes, 1);
+	QCOMPARE(m_blobs["profile_config"], QByteArray("profile A"));
+
+	// uploads requested after cancel() are not affected
+	m_latency = 0;
+	QCOMPARE(uploadAndWait("profile_config", profileB).status, ConfigUploader::UPLOAD_OK);
+}
+
+void TST_ConfigUploader::progress()
+{
+	// 4 hash chunks and the write
+	const QString path = writeFile(QByteArray(1024 * 1024, 'x'));
+	QSignalSpy progress(m_uploader, &ConfigUploader::uploadProgress);
+	QCOMPARE(uploadAndWait("profile_config", path).status, ConfigUploader::UPLOAD_OK);
+	QCoreApplication::processEvents();
+
+	QCOMPARE(progress.count(), 5);
+	int last = 0;
+	for(const QList<QVariant> &args : qAsConst(progress)) {
+		QCOMPARE(args[0].toString(), QString("profile_config"));
+		QVERIFY(args[1].toInt() > last);
+		last = args[1].toInt();
+	}
+	QCOMPARE(last, 100);
+}
+
+QTEST_MAIN(TST_ConfigUploader)
+#include "tst_configuploader.moc"
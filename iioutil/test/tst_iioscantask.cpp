@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iioutil/iioscantask.h>
+
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QTest>
+#include <atomic>
+
+using namespace scopy;
+
+typedef QVector<QPair<QString, QString>> ContextList;
+
+class TST_IIOScanTask : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void initTestCase();
+	void splitBackends();
+	void parallel();
+	void timeout();
+	void cancel();
+
+private:
+	// mock backends, every one answers a single context after its delay
+	IIOScanTask::ScanFunction mock();
+
+	std::atomic<int> m_ipDelay{0};
+	std::atomic<int> m_usbDelay{0};
+};
+
+IIOScanTask::ScanFunction TST_IIOScanTask::mock()
+{
+	return [this](ContextList *ctxs, QString backend) {
+		if(backend == "ip") {
+			QThread::msleep(m_ipDelay);
+			ctxs->append({"pluto", "ip:192.168.2.1"});
+		} else if(backend == "usb") {
+			QThread::msleep(m_usbDelay);
+			ctxs->append({"m2k", "usb:1.2.3"});
+		} else if(backend == "local") {
+			// the same board, also seen by usb
+			QThread::msleep(m_usbDelay);
+			ctxs->append({"m2k", "usb:1.2.3"});
+		} else {
+			return -ENOSYS;
+		}
+		return (int)ctxs->size();
+	};
+}
+
+void TST_IIOScanTask::initTestCase() { qRegisterMetaType<ContextList>(); }
+
+void TST_IIOScanTask::splitBackends()
+{
+	QCOMPARE(IIOScanTask::splitBackends("usb"), QStringList({"usb"}));
+	QCOMPARE(IIOScanTask::splitBackends("usb:ip:"), QStringList({"usb", "ip"}));
+	QCOMPARE(IIOScanTask::splitBackends("usb=0456:b673:ip:usb:"), QStringList({"usb=0456:b673", "ip", "usb"}));
+}
+
+void TST_IIOScanTask::parallel()
+{
+	IIOScanTask task(nullptr);
+	task.setScanParams("ip:usb:local:");
+	task.setScanFunction(mock());
+	m_ipDelay = 500;
+	m_usbDelay = 300;
+
+	QSignalSpy partial(&task, &IIOScanTask::backendScanFinished);
+	QSignalSpy finished(&task, &IIOScanTask::scanFinished);
+	QElapsedTimer et;
+	et.start();
+	task.start();
+
+	// usb and local stream in before the slow ip backend is done
+	QTRY_COMPARE_WITH_TIMEOUT(partial.count(), 2, 2000);
+	QVERIFY(finished.isEmpty());
+	QVERIFY(partial[0][0].toString() != "ip");
+	QVERIFY(partial[1][0].toString() != "ip");
+
+	QTRY_COMPARE_WITH_TIMEOUT(finished.count(), 1, 2000);
+	QVERIFY(task.wait(1000));
+	// the backends ran concurrently, sequentially this would take 1100ms
+	QVERIFY(et.elapsed() < 1000);
+
+	ContextList ctxs = finished[0][0].value<ContextList>();
+	QCOMPARE(ctxs.size(), 2);
+	QCOMPARE(ctxs[0].second, QString("ip:192.168.2.1"));
+	QCOMPARE(ctxs[1].second, QString("usb:1.2.3"));
+}
+
+void TST_IIOScanTask::timeout()
+{
+	IIOScanTask task(nullptr);
+	task.setScanParams("ip:usb:");
+	task.setScanFunction(mock());
+	task.setBackendTimeout("ip", 200);
+	m_ipDelay = 0;
+	m_usbDelay = 0;
+
+	QSignalSpy partial(&task, &IIOScanTask::backendScanFinished);
+	QSignalSpy finished(&task, &IIOScanTask::scanFinished);
+	task.start();
+	QTRY_COMPARE_WITH_TIMEOUT(finished.count(), 1, 2000);
+	QVERIFY(task.wait(1000));
+
+	// ip is now too slow, its contexts come from the previous scan
+	m_ipDelay = 1000;
+	partial.clear();
+	finished.clear();
+	QElapsedTimer et;
+	et.start();
+	task.start();
+	QTRY_COMPARE_WITH_TIMEOUT(finished.count(), 1, 2000);
+	QVERIFY(et.elapsed() < 800);
+	QCOMPARE(partial.count(), 1);
+	QCOMPARE(partial[0][0].toString(), QString("usb"));
+	QCOMPARE(finished[0][0].value<ContextList>().size(), 2);
+
+	QVERIFY(task.wait(1000));
+	task.clearCache();
+	finished.clear();
+	task.start();
+	QTRY_COMPARE_WITH_TIMEOUT(finished.count(), 1, 2000);
+	QCOMPARE(finished[0][0].value<ContextList>().size(), 1);
+	QVERIFY(task.wait(1000));
+}
+
+void TST_IIOScanTask::cancel()
+{
+	IIOScanTask task(nullptr);
+	task.setScanParams("ip:");
+	task.setScanFunction(mock());
+	m_ipDelay = 1000;
+
+	QSignalSpy finished(&task, &IIOScanTask::scanFinished);
+	QElapsedTimer et;
+	et.start();
+	task.start();
+	QTest::qWait(50);
+
+	// a new scan drops the one in flight without waiting for the backend
+	m_ipDelay = 0;
+	task.restart();
+	QTRY_COMPARE_WITH_TIMEOUT(finished.count(), 1, 2000);
+	QVERIFY(task.wait(1000));
+	QVERIFY(et.elapsed() < 800);
+
+	QTest::qWait(100);
+	QCOMPARE(finished.count(), 1);
+}
+
+QTEST_MAIN(TST_IIOScanTask)
+#include "tst_iioscantask.moc"
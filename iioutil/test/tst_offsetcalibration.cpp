@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iioutil/offsetcalibration.h>
+
+#include <QTest>
+#include <cmath>
+#include <random>
+
+using namespace scopy;
+
+// the control resolution and noise of the CN0540 shift DAC and ADC, in mV
+#define DAC_LSB (5000.0 / 65536)
+#define ADC_NOISE 0.5
+#define CAPTURE_SAMPLES 1024
+
+// modelled costs of the old loop: a 10 ms settle per step and 1 ms per attribute round trip,
+// the buffered capture of CAPTURE_SAMPLES at 256 ksps adds 4 ms to its round trip
+#define SETTLE_MS 10.0
+#define ROUND_TRIP_MS 1.0
+#define CAPTURE_MS (ROUND_TRIP_MS + CAPTURE_SAMPLES / 256.0)
+
+// an offset that depends linearly on a quantized control, observed with gaussian noise
+class SensorModel
+{
+public:
+	SensorModel(double gain, double null, unsigned int seed)
+		: m_gain(gain)
+		, m_null(null)
+		, m_rng(seed)
+		, m_noise(0, ADC_NOISE)
+	{}
+
+	bool apply(double control)
+	{
+		m_control = std::round(control / DAC_LSB) * DAC_LSB;
+		m_elapsedMs += ROUND_TRIP_MS + SETTLE_MS;
+		return true;
+	}
+
+	bool measure(int samples, double &value)
+	{
+		double sum = 0;
+		for(int i = 0; i < samples; i++) {
+			sum += offset() + m_noise(m_rng);
+		}
+		value = sum / samples;
+		m_elapsedMs += (samples > 1) ? CAPTURE_MS : ROUND_TRIP_MS;
+		return true;
+	}
+
+	double offset() const { return m_gain * (m_control - m_null); }
+	double control() const { return m_control; }
+	double elapsedMs() const { return m_elapsedMs; }
+
+private:
+	double m_gain;
+	double m_null;
+	double m_control = 2500.0;
+	double m_elapsedMs = 0;
+	std::mt19937 m_rng;
+	std::normal_distribution<double> m_noise;
+};
+
+class TST_OffsetCalibration : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void linear();
+	void limits();
+	void failures();
+	void againstFixedLoop();
+
+private:
+	static OffsetCalibration::Settings settings();
+};
+
+OffsetCalibration::Settings TST_OffsetCalibration::settings()
+{
+	return {.maxIterations = 20,
+		.tolerance = 0.05,
+		.gain = 1.0,
+		.resolution = DAC_LSB,
+		.minControl = 0,
+		.maxControl = 5000,
+		.settleMs = 0};
+}
+
+void TST_OffsetCalibration::linear()
+{
+	OffsetCalibration calibration(settings());
+	for(double gain : {0.3, 0.8, 1.0, 1.3, 2.5}) {
+		SensorModel model(gain, 1234.5, 0);
+		OffsetCalibration::Result result = calibration.run(
+			model.control(), [&model](double control) { return model.apply(control); },
+			[&model](double &value) {
+				value = model.offset();
+				return true;
+			});
+
+		QVERIFY(result.converged);
+		QVERIFY(result.error.isEmpty());
+		// the first step learns the slope, the second one lands on the null
+		QVERIFY(result.history.size() <= 4);
+		QCOMPARE(result.history.first().control, 2500.0);
+		QVERIFY(std::abs(result.control - model.control()) <= DAC_LSB / 2);
+		QVERIFY(std::abs(model.offset()) <= gain * DAC_LSB);
+		QCOMPARE(result.residual, model.offset());
+	}
+}
+
+void TST_OffsetCalibration::limits()
+{
+	// the null is out of the control range, the loop stops at the limit instead of running all iterations
+	OffsetCalibration calibration(settings());
+	SensorModel model(1.0, 6000, 0);
+	int applied = 0;
+	OffsetCalibration::Result result = calibration.run(
+		model.control(),
+		[&](double control) {
+			applied++;
+			return model.apply(control);
+		},
+		[&model](double &value) {
+			value = model.offset();
+			return true;
+		});
+
+	QVERIFY(!result.converged);
+	QCOMPARE(result.control, 5000.0);
+	QVERIFY(applied <= 3);
+}
+
+void TST_OffsetCalibration::failures()
+{
+	OffsetCalibration calibration(settings());
+
+	OffsetCalibration::Result result = calibration.run(
+		0, [](double) { return true; }, [](double &) { return false; });
+	QVERIFY(!result.converged);
+	QVERIFY(!result.error.isEmpty());
+	QVERIFY(result.history.isEmpty());
+
+	result = calibration.run(
+		0, [](double) { return false; },
+		[](double &value) {
+			value = -10;
+			return true;
+		});
+	QVERIFY(!result.converged);
+	QVERIFY(!result.error.isEmpty());
+	QCOMPARE(result.control, 0.0);
+	QCOMPARE(result.history.size(), 1);
+}
+
+void TST_OffsetCalibration::againstFixedLoop()
+{
+	const int seeds = 20;
+	for(double gain : {0.6, 1.0, 1.6}) {
+		double fixedResidual = 0, fixedMs = 0;
+		double residual = 0, elapsedMs = 0;
+
+		for(int seed = 0; seed < seeds; seed++) {
+			// the loop CN0540 used to run: 20 steps of single reads, dac -= adc
+			SensorModel fixed(gain, 1234.5, seed);
+			for(int i = 0; i < 20; i++) {
+				double adc = 0;
+				fixed.measure(1, adc);
+				fixed.apply(fixed.control() - adc);
+			}
+			fixedResidual += std::abs(fixed.offset());
+			fixedMs += fixed.elapsedMs();
+
+			SensorModel model(gain, 1234.5, seed);
+			OffsetCalibration calibration(settings());
+			OffsetCalibration::Result result = calibration.run(
+				model.control(), [&model](double control) { return model.apply(control); },
+				[&model](double &value) { return model.measure(CAPTURE_SAMPLES, value); });
+			QVERIFY(result.converged);
+			residual += std::abs(model.offset());
+			elapsedMs += model.elapsedMs();
+		}
+
+		qInfo() << "gain" << gain << "fixed loop:" << fixedMs / seeds << "ms, residual" << fixedResidual / seeds
+			<< "mV, calibration:" << elapsedMs / seeds << "ms, residual" << residual / seeds << "mV";
+		QVERIFY(elapsedMs < 0.5 * fixedMs);
+		QVERIFY(residual < 0.5 * fixedResidual);
+	}
+}
+
+QTEST_MAIN(TST_OffsetCalibration)
+#include "tst_offsetcalibration.moc"
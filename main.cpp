@@ -34,6 +34,8 @@
 #include <core/crashreport.h>
 #include <gui/utils.h>
 #include <gui/docking/docksettings.h>
+#include <common/scopyconfig.h>
+#include <common/tracer.h>
 
 using namespace scopy;
 
@@ -152,6 +154,10 @@ int main(int argc, char *argv[])
 		return retHandler;
 	}
 	int ret = a.exec();
+#ifdef ENABLE_TRACING
+	Tracer::writeChromeTrace(scopy::config::settingsFolderPath() + "/" + SCOPY_TRACE_FILE);
+	qInfo(CAT_RUNTIME_ENVIRONMENT_INFO).noquote() << "Trace summary:\n" << Tracer::summary();
+#endif
 	restarter.restart(ret);
 	printf("Scopy finished gracefully\n");
 	CmdLineHandler::closeLogFile();
@@ -43,9 +43,6 @@ public:
 	AD936X(iio_context *ctx, IIOWidgetGroup *group = nullptr, QWidget *parent = nullptr);
 	~AD936X();
 
-Q_SIGNALS:
-	void readRequested();
-
 private:
 	iio_context *m_ctx = nullptr;
 	IIOWidgetGroup *m_group = nullptr;
@@ -44,9 +44,6 @@ public:
 	QWidget *generateTxDeviceWidget(iio_device *dev, QString title, QWidget *parent);
 	QWidget *generateTxChannelWidget(iio_channel *chn, QString title, QWidget *parent);
 
-Q_SIGNALS:
-	void readRequested();
-
 private:
 	IIOWidgetGroup *m_group = nullptr;
 };
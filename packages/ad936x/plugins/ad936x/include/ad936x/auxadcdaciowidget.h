@@ -39,9 +39,6 @@ public:
 	explicit AuxAdcDacIoWidget(iio_device *device, IIOWidgetGroup *group, QWidget *parent = nullptr);
 	~AuxAdcDacIoWidget();
 
-Q_SIGNALS:
-	void readRequested();
-
 private:
 	QVBoxLayout *m_layout;
 	iio_device *m_device = nullptr;
@@ -41,7 +41,6 @@ public:
 
 Q_SIGNALS:
 	void bistToneUpdated();
-	void readRequested();
 
 private:
 	QVBoxLayout *m_layout;
@@ -37,9 +37,6 @@ public:
 	explicit ElnaWidget(iio_device *device, IIOWidgetGroup *group, QWidget *parent = nullptr);
 	~ElnaWidget();
 
-Q_SIGNALS:
-	void readRequested();
-
 private:
 	QVBoxLayout *m_layout;
 	iio_device *m_device = nullptr;
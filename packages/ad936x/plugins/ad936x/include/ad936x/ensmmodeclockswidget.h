@@ -37,9 +37,6 @@ public:
 	explicit EnsmModeClocksWidget(iio_device *device, IIOWidgetGroup *group, QWidget *parent = nullptr);
 	~EnsmModeClocksWidget();
 
-Q_SIGNALS:
-	void readRequested();
-
 private:
 	QVBoxLayout *m_layout;
 	iio_device *m_device = nullptr;
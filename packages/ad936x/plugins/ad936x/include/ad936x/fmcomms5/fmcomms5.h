@@ -42,9 +42,6 @@ public:
 	explicit FMCOMMS5(iio_context *ctx, IIOWidgetGroup *group = nullptr, QWidget *parent = nullptr);
 	~FMCOMMS5();
 
-Q_SIGNALS:
-	void readRequested();
-
 private:
 	iio_context *m_ctx = nullptr;
 	IIOWidgetGroup *m_group = nullptr;
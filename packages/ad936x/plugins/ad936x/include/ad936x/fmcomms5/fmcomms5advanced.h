@@ -50,9 +50,6 @@ public:
 
 	void switchSubtab(const QString &name);
 
-Q_SIGNALS:
-	void readRequested();
-
 private:
 	void init();
 
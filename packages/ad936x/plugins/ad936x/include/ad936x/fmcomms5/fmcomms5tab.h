@@ -39,9 +39,6 @@ public:
 	explicit Fmcomms5Tab(iio_context *ctx, IIOWidgetGroup *group = nullptr, QWidget *parent = nullptr);
 	~Fmcomms5Tab();
 
-Q_SIGNALS:
-	void readRequested();
-
 private:
 	iio_context *m_ctx;
 	IIOWidgetGroup *m_group = nullptr;
@@ -37,9 +37,6 @@ public:
 	explicit GainWidget(iio_device *device, IIOWidgetGroup *group, QWidget *parent = nullptr);
 	~GainWidget();
 
-Q_SIGNALS:
-	void readRequested();
-
 private:
 	QVBoxLayout *m_layout;
 	iio_device *m_device = nullptr;
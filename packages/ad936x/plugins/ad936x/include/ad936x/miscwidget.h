@@ -36,9 +36,6 @@ public:
 	explicit MiscWidget(iio_device *device, IIOWidgetGroup *group, QWidget *parent = nullptr);
 	~MiscWidget();
 
-Q_SIGNALS:
-	void readRequested();
-
 private:
 	QVBoxLayout *m_layout;
 	iio_device *m_device = nullptr;
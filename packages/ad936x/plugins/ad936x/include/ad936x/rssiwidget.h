@@ -37,9 +37,6 @@ public:
 	explicit RssiWidget(iio_device *device, IIOWidgetGroup *group, QWidget *parent = nullptr);
 	~RssiWidget();
 
-Q_SIGNALS:
-	void readRequested();
-
 private:
 	QVBoxLayout *m_layout;
 	iio_device *m_device = nullptr;
@@ -36,9 +36,6 @@ public:
 	explicit TxMonitorWidget(iio_device *device, IIOWidgetGroup *group, QWidget *parent = nullptr);
 	~TxMonitorWidget();
 
-Q_SIGNALS:
-	void readRequested();
-
 private:
 	QVBoxLayout *m_layout;
 	iio_device *m_device = nullptr;
@@ -29,8 +29,6 @@
 #include <QList>
 #include <style.h>
 #include <menuonoffswitch.h>
-#include <QFutureWatcher>
-#include <QtConcurrent>
 #include <QLoggingCategory>
 
 #include <guistrategy/comboguistrategy.h>
@@ -60,21 +58,10 @@ AD936X::AD936X(iio_context *ctx, IIOWidgetGroup *group, QWidget *parent)
 	m_refreshButton = new AnimatedRefreshBtn(false, this);
 	m_tool->addWidgetToTopContainerHelper(m_refreshButton, TTA_RIGHT);
 
+	connect(m_group, &IIOWidgetGroup::refreshed, m_refreshButton, &AnimatedRefreshBtn::stopAnimation);
 	connect(m_refreshButton, &QPushButton::clicked, this, [this]() {
 		m_refreshButton->startAnimation();
-
-		QFutureWatcher<void> *watcher = new QFutureWatcher<void>(this);
-		connect(
-			watcher, &QFutureWatcher<void>::finished, this,
-			[this, watcher]() {
-				m_refreshButton->stopAnimation();
-				watcher->deleteLater();
-			},
-			Qt::QueuedConnection);
-
-		QFuture<void> future = QtConcurrent::run([this]() { Q_EMIT readRequested(); });
-
-		watcher->setFuture(future);
+		m_group->refreshWidgets(findChildren<IIOWidget *>());
 	});
 
 	QStackedWidget *centralWidget = new QStackedWidget(this);
@@ -111,7 +98,6 @@ AD936X::AD936X(iio_context *ctx, IIOWidgetGroup *group, QWidget *parent)
 		}
 
 		m_helper = new AD936xHelper(m_group);
-		connect(this, &AD936X::readRequested, m_helper, &AD936xHelper::readRequested);
 
 		///  first widget the global settings can be created with iiowigets only
 		controlWidgetLayout->addWidget(m_helper->generateGlobalSettingsWidget(
@@ -218,7 +204,6 @@ QWidget *AD936X::generateRxChainWidget(iio_device *dev, QString title, QWidget *
 	rfBandwidth->setUItoDataConversion([](QString data) { return QString::number(data.toDouble() * 1e6, 'f', 0); });
 
 	layout->addWidget(rfBandwidth, 0, 0, 2, 1);
-	connect(this, &AD936X::readRequested, rfBandwidth, &IIOWidget::readAsync);
 
 	// voltage0:  sampling_frequency
 	IIOWidget *samplingFrequency = IIOWidgetBuilder(widget)
@@ -238,7 +223,6 @@ QWidget *AD936X::generateRxChainWidget(iio_device *dev, QString title, QWidget *
 		[](QString data) { return QString::number(data.toDouble() * 1e6, 'f', 0); });
 
 	layout->addWidget(samplingFrequency, 0, 1, 2, 1);
-	connect(this, &AD936X::readRequested, samplingFrequency, &IIOWidget::readAsync);
 
 	// voltage 0 : rf_port_select
 	IIOWidget *rfPortSelect = IIOWidgetBuilder(widget)
@@ -250,7 +234,6 @@ QWidget *AD936X::generateRxChainWidget(iio_device *dev, QString title, QWidget *
 					  .group(m_group)
 					  .buildSingle();
 	layout->addWidget(rfPortSelect, 0, 2, 2, 1);
-	connect(this, &AD936X::readRequested, rfPortSelect, &IIOWidget::readAsync);
 
 	// quadrature_tracking_en
 	IIOWidget *quadratureTrackingEn = IIOWidgetBuilder(this)
@@ -262,7 +245,6 @@ QWidget *AD936X::generateRxChainWidget(iio_device *dev, QString title, QWidget *
 						  .buildSingle();
 	layout->addWidget(quadratureTrackingEn, 0, 5);
 	quadratureTrackingEn->showProgressBar(false);
-	connect(this, &AD936X::readRequested, quadratureTrackingEn, &IIOWidget::readAsync);
 
 	// rf_dc_offset_tracking_en
 	IIOWidget *rcDcOffsetTrackingEn = IIOWidgetBuilder(widget)
@@ -274,7 +256,6 @@ QWidget *AD936X::generateRxChainWidget(iio_device *dev, QString title, QWidget *
 						  .buildSingle();
 	layout->addWidget(rcDcOffsetTrackingEn, 1, 5);
 	rcDcOffsetTrackingEn->showProgressBar(false);
-	connect(this, &AD936X::readRequested, rcDcOffsetTrackingEn, &IIOWidget::readAsync);
 
 	// bb_dc_offset_tracking_en
 	IIOWidget *bbDcOffsetTrackingEn = IIOWidgetBuilder(widget)
@@ -286,7 +267,6 @@ QWidget *AD936X::generateRxChainWidget(iio_device *dev, QString title, QWidget *
 						  .buildSingle();
 	layout->addWidget(bbDcOffsetTrackingEn, 2, 5);
 	bbDcOffsetTrackingEn->showProgressBar(false);
-	connect(this, &AD936X::readRequested, bbDcOffsetTrackingEn, &IIOWidget::readAsync);
 
 	mainLayout->addLayout(layout);
 
@@ -345,7 +325,6 @@ QWidget *AD936X::generateTxChainWidget(iio_device *dev, QString title, QWidget *
 	rfBandwidth->setUItoDataConversion([](QString data) { return QString::number(data.toDouble() * 1e6, 'f', 0); });
 
 	lay->addWidget(rfBandwidth, 0, 0, 2, 1);
-	connect(this, &AD936X::readRequested, rfBandwidth, &IIOWidget::readAsync);
 
 	// voltage0:  sampling_frequency
 	IIOWidget *samplingFrequency = IIOWidgetBuilder(widget)
@@ -364,7 +343,6 @@ QWidget *AD936X::generateTxChainWidget(iio_device *dev, QString title, QWidget *
 		[](QString data) { return QString::number(data.toDouble() * 1e6, 'f', 0); });
 
 	lay->addWidget(samplingFrequency, 0, 1, 2, 1);
-	connect(this, &AD936X::readRequested, samplingFrequency, &IIOWidget::readAsync);
 
 	// voltage0:  rf_port_select
 	IIOWidget *rfPortSelect = IIOWidgetBuilder(widget)
@@ -376,7 +354,6 @@ QWidget *AD936X::generateTxChainWidget(iio_device *dev, QString title, QWidget *
 					  .group(m_group)
 					  .buildSingle();
 	lay->addWidget(rfPortSelect, 0, 2, 2, 1);
-	connect(this, &AD936X::readRequested, rfPortSelect, &IIOWidget::readAsync);
 
 	layout->addLayout(lay);
 
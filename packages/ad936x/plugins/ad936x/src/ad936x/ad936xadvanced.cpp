@@ -21,8 +21,6 @@
 
 #include "ad936x/ad963xadvanced.h"
 
-#include <QFutureWatcher>
-#include <QtConcurrent>
 #include <iiowidgetbuilder.h>
 #include <menuonoffswitch.h>
 #include <style.h>
@@ -54,21 +52,10 @@ AD936XAdvanced::AD936XAdvanced(iio_context *ctx, IIOWidgetGroup *group, QWidget
 	m_refreshButton = new AnimatedRefreshBtn(false, this);
 	m_tool->addWidgetToTopContainerHelper(m_refreshButton, TTA_RIGHT);
 
+	connect(m_group, &IIOWidgetGroup::refreshed, m_refreshButton, &AnimatedRefreshBtn::stopAnimation);
 	connect(m_refreshButton, &QPushButton::clicked, this, [this]() {
 		m_refreshButton->startAnimation();
-
-		QFutureWatcher<void> *watcher = new QFutureWatcher<void>(this);
-		connect(
-			watcher, &QFutureWatcher<void>::finished, this,
-			[this, watcher]() {
-				m_refreshButton->stopAnimation();
-				watcher->deleteLater();
-			},
-			Qt::QueuedConnection);
-
-		QFuture<void> future = QtConcurrent::run([this]() { Q_EMIT readRequested(); });
-
-		watcher->setFuture(future);
+		m_group->refreshWidgets(findChildren<IIOWidget *>());
 	});
 
 	// main widget body
@@ -190,45 +177,37 @@ void AD936XAdvanced::init()
 	// ENSM Mode Clocks
 	m_ensmModeClocks = new EnsmModeClocksWidget(m_plutoDevice, m_group, m_centralWidget);
 	m_centralWidget->addWidget(m_ensmModeClocks);
-	connect(this, &AD936XAdvanced::readRequested, m_ensmModeClocks, &EnsmModeClocksWidget::readRequested);
 	connect(m_ensmModeClocksBtn, &QPushButton::clicked, this,
 		[=, this]() { m_centralWidget->setCurrentWidget(m_ensmModeClocks); });
 	// eLNA
 	m_elna = new ElnaWidget(m_plutoDevice, m_group, m_centralWidget);
-	connect(this, &AD936XAdvanced::readRequested, m_elna, &ElnaWidget::readRequested);
 	m_centralWidget->addWidget(m_elna);
 	connect(m_eLnaBtn, &QPushButton::clicked, this, [=, this]() { m_centralWidget->setCurrentWidget(m_elna); });
 	// RSSI
 	m_rssi = new RssiWidget(m_plutoDevice, m_group, m_centralWidget);
-	connect(this, &AD936XAdvanced::readRequested, m_rssi, &RssiWidget::readRequested);
 	m_centralWidget->addWidget(m_rssi);
 	connect(m_rssiBtn, &QPushButton::clicked, this, [=, this]() { m_centralWidget->setCurrentWidget(m_rssi); });
 	// GAIN
 	m_gainWidget = new GainWidget(m_plutoDevice, m_group, m_centralWidget);
-	connect(this, &AD936XAdvanced::readRequested, m_gainWidget, &GainWidget::readRequested);
 	m_centralWidget->addWidget(m_gainWidget);
 	connect(m_gainBtn, &QPushButton::clicked, this,
 		[=, this]() { m_centralWidget->setCurrentWidget(m_gainWidget); });
 	// TX MONITOR
 	m_txMonitor = new TxMonitorWidget(m_plutoDevice, m_group, m_centralWidget);
-	connect(this, &AD936XAdvanced::readRequested, m_txMonitor, &TxMonitorWidget::readRequested);
 	m_centralWidget->addWidget(m_txMonitor);
 	connect(m_txMonitorBtn, &QPushButton::clicked, this,
 		[=, this]() { m_centralWidget->setCurrentWidget(m_txMonitor); });
 	// AUX ADC/DAC/IIO
 	m_auxAdcDacIo = new AuxAdcDacIoWidget(m_plutoDevice, m_group, m_centralWidget);
-	connect(this, &AD936XAdvanced::readRequested, m_auxAdcDacIo, &AuxAdcDacIoWidget::readRequested);
 	m_centralWidget->addWidget(m_auxAdcDacIo);
 	connect(m_auxAdcDacIioBtn, &QPushButton::clicked, this,
 		[=, this]() { m_centralWidget->setCurrentWidget(m_auxAdcDacIo); });
 	// MISC
 	m_misc = new MiscWidget(m_plutoDevice, m_group, m_centralWidget);
-	connect(this, &AD936XAdvanced::readRequested, m_misc, &MiscWidget::readRequested);
 	m_centralWidget->addWidget(m_misc);
 	connect(m_miscBtn, &QPushButton::clicked, this, [=, this]() { m_centralWidget->setCurrentWidget(m_misc); });
 	// BIST
 	m_bist = new BistWidget(m_plutoDevice, m_group, m_centralWidget);
-	connect(this, &AD936XAdvanced::readRequested, m_bist, &BistWidget::readRequested);
 	m_centralWidget->addWidget(m_bist);
 	connect(m_bistBtn, &QPushButton::clicked, this, [=, this]() { m_centralWidget->setCurrentWidget(m_bist); });
 
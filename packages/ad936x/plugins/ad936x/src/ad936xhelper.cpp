@@ -66,8 +66,6 @@ QWidget *AD936xHelper::generateGlobalSettingsWidget(iio_device *dev, QString tit
 
 	hlayout->addWidget(ensmMode);
 
-	connect(this, &AD936xHelper::readRequested, ensmMode, &IIOWidget::readAsync);
-
 	////calib_mode
 	IIOWidget *calibMode = IIOWidgetBuilder(globalSettingsWidget)
 				       .device(dev)
@@ -78,7 +76,6 @@ QWidget *AD936xHelper::generateGlobalSettingsWidget(iio_device *dev, QString tit
 				       .group(m_group)
 				       .buildSingle();
 	hlayout->addWidget(calibMode);
-	connect(this, &AD936xHelper::readRequested, calibMode, &IIOWidget::readAsync);
 
 	Style::setStyle(calibMode, style::properties::widget::basicBackground, true, true);
 
@@ -92,7 +89,6 @@ QWidget *AD936xHelper::generateGlobalSettingsWidget(iio_device *dev, QString tit
 					     .group(m_group)
 					     .buildSingle();
 	hlayout->addWidget(trxRateGovernor);
-	connect(this, &AD936xHelper::readRequested, trxRateGovernor, &IIOWidget::readAsync);
 
 	FirFilterQWidget *firFilter = new FirFilterQWidget(dev, nullptr, globalSettingsWidget);
 	hlayout->addWidget(firFilter);
@@ -108,7 +104,6 @@ QWidget *AD936xHelper::generateGlobalSettingsWidget(iio_device *dev, QString tit
 					 .buildSingle();
 	layout->addWidget(rxPathRates);
 	rxPathRates->setEnabled(false);
-	connect(this, &AD936xHelper::readRequested, rxPathRates, &IIOWidget::readAsync);
 
 	// tx_path_rates
 	IIOWidget *txPathRates = IIOWidgetBuilder(globalSettingsWidget)
@@ -119,7 +114,6 @@ QWidget *AD936xHelper::generateGlobalSettingsWidget(iio_device *dev, QString tit
 					 .buildSingle();
 	layout->addWidget(txPathRates);
 	txPathRates->setEnabled(false);
-	connect(this, &AD936xHelper::readRequested, txPathRates, &IIOWidget::readAsync);
 
 	connect(firFilter, &FirFilterQWidget::filterChanged, this, [=, this]() {
 		rxPathRates->read();
@@ -136,7 +130,6 @@ QWidget *AD936xHelper::generateGlobalSettingsWidget(iio_device *dev, QString tit
 					  .group(m_group)
 					  .buildSingle();
 	layout->addWidget(xoCorrection);
-	connect(this, &AD936xHelper::readRequested, xoCorrection, &IIOWidget::readAsync);
 
 	layout->addItem(new QSpacerItem(1, 1, QSizePolicy::Preferred, QSizePolicy::Expanding));
 
@@ -175,8 +168,6 @@ QWidget *AD936xHelper::generateRxDeviceWidget(iio_device *dev, QString title, QW
 	altVoltage0Frequency->setUItoDataConversion(
 		[](QString data) { return QString::number(data.toDouble() * 1e6, 'f', 0); });
 
-	connect(this, &AD936xHelper::readRequested, altVoltage0Frequency, &IIOWidget::readAsync);
-
 	MenuOnOffSwitch *useExternalRxLo = new MenuOnOffSwitch("External Rx LO", widget, false);
 	useExternalRxLo->onOffswitch()->setChecked(true);
 
@@ -219,7 +210,6 @@ QWidget *AD936xHelper::generateRxChannelWidget(iio_channel *chn, QString title,
 					  .group(m_group)
 					  .buildSingle();
 	layout->addWidget(hardwaregain);
-	connect(this, &AD936xHelper::readRequested, hardwaregain, &IIOWidget::readAsync);
 
 	hardwaregain->setDataToUIConversion([this](QString data) {
 		// data has dB as string in the value
@@ -255,7 +245,6 @@ QWidget *AD936xHelper::generateRxChannelWidget(iio_channel *chn, QString title,
 					     .group(m_group)
 					     .buildSingle();
 	layout->addWidget(gainControlMode);
-	connect(this, &AD936xHelper::readRequested, gainControlMode, &IIOWidget::readAsync);
 
 	connect(dynamic_cast<ComboAttrUi *>(gainControlMode->getUiStrategy()), &ComboAttrUi::displayedNewData, this,
 		[this, hardwaregain, rssi](QString data, QString optionalData) {
@@ -303,8 +292,6 @@ QWidget *AD936xHelper::generateTxDeviceWidget(iio_device *dev, QString title, QW
 	altVoltage1Frequency->setUItoDataConversion(
 		[](QString data) { return QString::number(data.toDouble() * 1e6, 'f', 0); });
 
-	connect(this, &AD936xHelper::readRequested, altVoltage1Frequency, &IIOWidget::readAsync);
-
 	MenuOnOffSwitch *useExternalTxLo = new MenuOnOffSwitch("External Tx LO", widget, false);
 	useExternalTxLo->onOffswitch()->setChecked(true);
 
@@ -347,7 +334,6 @@ QWidget *AD936xHelper::generateTxChannelWidget(iio_channel *chn, QString title,
 					   .group(m_group)
 					   .buildSingle();
 	layout->addWidget(txAttenuation);
-	connect(this, &AD936xHelper::readRequested, txAttenuation, &IIOWidget::readAsync);
 
 	txAttenuation->setDataToUIConversion([this](QString data) {
 		// data has dB as string in the value
@@ -363,7 +349,6 @@ QWidget *AD936xHelper::generateTxChannelWidget(iio_channel *chn, QString title,
 				  .buildSingle();
 	layout->addWidget(rssi);
 	rssi->setEnabled(false);
-	connect(this, &AD936xHelper::readRequested, rssi, &IIOWidget::readAsync);
 
 	return txWidget;
 }
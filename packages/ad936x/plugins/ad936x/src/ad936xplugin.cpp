@@ -43,6 +43,25 @@
 Q_LOGGING_CATEGORY(CAT_AD936XPLUGIN, "Ad936xPlugin")
 using namespace scopy::ad936x;
 
+// attributes the AD9361 driver recomputes when another attribute is written, only these are read back after a write
+static void addPhyDependencies(scopy::IIOWidgetGroup *group, const QString &phy)
+{
+	const QStringList rates = {phy + "/rx_path_rates", phy + "/tx_path_rates"};
+	const QStringList gains = {phy + "/voltage*_in/hardwaregain", phy + "/voltage*_in/rssi"};
+
+	// the RX and TX sampling frequencies are the same clock, the available rf bandwidths follow it
+	group->addDependencies(phy + "/voltage*/sampling_frequency", rates);
+	group->addDependencies(phy + "/voltage*/sampling_frequency",
+			       {phy + "/voltage*/sampling_frequency", phy + "/voltage*/rf_bandwidth"});
+	group->addDependencies(phy + "/trx_rate_governor", rates);
+	group->addDependencies(phy + "/xo_correction", rates);
+	group->addDependency(phy + "/xo_correction", phy + "/altvoltage*_out/frequency");
+
+	group->addDependencies(phy + "/ensm_mode", gains);
+	group->addDependencies(phy + "/voltage*_in/gain_control_mode", gains);
+	group->addDependencies(phy + "/altvoltage0_out/frequency", gains);
+}
+
 bool Ad936xPlugin::compatible(QString m_param, QString category)
 {
 
@@ -120,6 +139,11 @@ bool Ad936xPlugin::onConnect()
 	// Check if FMCOMMS5 device is present (indicated by ad9361-phy-B device)
 	m_isFmcomms5 = iio_context_find_device(conn->context(), "ad9361-phy-B") != nullptr;
 
+	addPhyDependencies(m_widgetGroup, "ad9361-phy");
+	if(m_isFmcomms5) {
+		addPhyDependencies(m_widgetGroup, "ad9361-phy-B");
+	}
+
 	if(m_isFmcomms5) {
 		FMCOMMS5 *fmcomms5 = new FMCOMMS5(conn->context(), m_widgetGroup);
 		m_toolList[0]->setTool(fmcomms5);
@@ -123,13 +123,6 @@ QWidget *AuxAdcDacIoWidget::tempSensorWidget(QWidget *parent)
 	tempSensePeriodicMeasurement->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
 	tempSensePeriodicMeasurement->showProgressBar(false);
 
-	connect(this, &AuxAdcDacIoWidget::readRequested, this, [=, this]() {
-		tempSenseMeasurementInterval->readAsync();
-		tempSenseOffset->readAsync();
-		tempSenseDecimation->readAsync();
-		tempSensePeriodicMeasurement->readAsync();
-	});
-
 	return widget;
 }
 
@@ -175,11 +168,6 @@ QWidget *AuxAdcDacIoWidget::auxAdcWidget(QWidget *parent)
 			.buildSingle();
 	widgetLayout->addWidget(auxAdcDecimation);
 
-	connect(this, &AuxAdcDacIoWidget::readRequested, this, [=, this]() {
-		auxAdcRate->readAsync();
-		auxAdcDecimation->readAsync();
-	});
-
 	return widget;
 }
 
@@ -206,8 +194,6 @@ QWidget *AuxAdcDacIoWidget::auxDacWidget(QWidget *parent)
 	auxDacManualMode->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
 	auxDacManualMode->showProgressBar(false);
 
-	connect(this, &AuxAdcDacIoWidget::readRequested, this, [=, this]() { auxDacManualMode->readAsync(); });
-
 	// getAuxAdcDac
 	QHBoxLayout *auxDacLayout = new QHBoxLayout();
 
@@ -301,15 +287,6 @@ QWidget *AuxAdcDacIoWidget::getAuxDac(QString dacx, QWidget *parent)
 				     .buildSingle();
 	layout->addWidget(txDelay, 4, 1);
 
-	connect(this, &AuxAdcDacIoWidget::readRequested, this, [=, this]() {
-		dacDefaultValue->readAsync();
-		dacActiveInAlert->readAsync();
-		dacActiveInRx->readAsync();
-		dacActiveInTx->readAsync();
-		rxDelay->readAsync();
-		txDelay->readAsync();
-	});
-
 	return auxDacWidget;
 }
 
@@ -346,11 +323,6 @@ QWidget *AuxAdcDacIoWidget::controlsOutWidget(QWidget *parent)
 					  .buildSingle();
 	controlsOutWidgetLayout->addWidget(ctrlOutsMask);
 
-	connect(this, &AuxAdcDacIoWidget::readRequested, this, [=, this]() {
-		ctrlOutsIndex->readAsync();
-		ctrlOutsMask->readAsync();
-	});
-
 	return controlsOutWidget;
 }
 
@@ -426,8 +398,6 @@ QWidget *AuxAdcDacIoWidget::gposWidget(QWidget *parent)
 	widgetLayout->addWidget(gpoWidget("2", parent), 5, 0);
 	widgetLayout->addWidget(gpoWidget("3", parent), 5, 1);
 
-	connect(this, &AuxAdcDacIoWidget::readRequested, this, [=, this]() { gpoManualMode->readAsync(); });
-
 	return widget;
 }
 
@@ -508,14 +478,6 @@ QWidget *AuxAdcDacIoWidget::gpoWidget(QString gpox, QWidget *parent)
 
 	gpoSection->contentLayout()->addWidget(gpoContent);
 
-	connect(this, &AuxAdcDacIoWidget::readRequested, this, [=, this]() {
-		inactiveState->readAsync();
-		stateRx->readAsync();
-		stateTx->readAsync();
-		rxDelay->readAsync();
-		txDelay->readAsync();
-	});
-
 	return gpoContainer;
 }
 
@@ -176,10 +176,6 @@ BistWidget::BistWidget(iio_device *device, IIOWidgetGroup *group, QWidget *paren
 
 	m_layout->addItem(new QSpacerItem(1, 1, QSizePolicy::Preferred, QSizePolicy::Expanding));
 
-	connect(this, &BistWidget::readRequested, this, [=, this]() {
-		bistPrbs->readAsync();
-		loopback->readAsync();
-	});
 }
 
 scopy::ad936x::BistWidget::~BistWidget() {}
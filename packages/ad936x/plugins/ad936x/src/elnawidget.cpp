@@ -161,14 +161,6 @@ ElnaWidget::ElnaWidget(iio_device *device, IIOWidgetGroup *group, QWidget *paren
 
 	m_layout->addItem(new QSpacerItem(1, 1, QSizePolicy::Preferred, QSizePolicy::Expanding));
 
-	connect(this, &ElnaWidget::readRequested, this, [=, this]() {
-		gain->readAsync();
-		bypassLoss->readAsync();
-		settlingDelay->readAsync();
-		rx1GPO0Control->readAsync();
-		rx2GPO0Control->readAsync();
-		gaintableAllIndex->readAsync();
-	});
 }
 
 ElnaWidget::~ElnaWidget() {}
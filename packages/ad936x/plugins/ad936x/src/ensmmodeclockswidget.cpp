@@ -154,12 +154,9 @@ QWidget *EnsmModeClocksWidget::generateEnsmModeWidget(QWidget *parent)
 	useFddVcoTable->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
 	useFddVcoTable->showProgressBar(false);
 
-	bool isuseFddVcoTableEnabled = true;
 	if(iio_device_find_debug_attr(m_device, useFddVcoTableAttr.toStdString().c_str()) == nullptr) {
 		useFddVcoTable->setEnabled(false);
-		isuseFddVcoTableEnabled = false;
-		useFddVcoTable->getUiStrategy()->setInfoMessage(
-			"This attribute is not available for your current device!");
+		useFddVcoTable->setInfoMessage("This attribute is not available for your current device!");
 	}
 
 	// adi,tdd-skip-vco-cal-enable
@@ -193,18 +190,6 @@ QWidget *EnsmModeClocksWidget::generateEnsmModeWidget(QWidget *parent)
 	ensmHBoxLayout->addSpacerItem(new QSpacerItem(1, 1, QSizePolicy::Expanding, QSizePolicy::Preferred));
 	ensmModeWidgetLayout->addLayout(ensmHBoxLayout);
 
-	connect(this, &EnsmModeClocksWidget::readRequested, this, [=, this]() {
-		fddMode->readAsync();
-		ensmEnablePinPulseMode->readAsync();
-		ensmEnableTxnrx->readAsync();
-		useDualSynth->readAsync();
-		if(isuseFddVcoTableEnabled) {
-			useFddVcoTable->readAsync();
-		}
-		skipVcoCal->readAsync();
-		updateTxGainInAlert->readAsync();
-	});
-
 	return ensmModeWidget;
 }
 
@@ -296,12 +281,6 @@ QWidget *EnsmModeClocksWidget::generateModeWidget(QWidget *parent)
 	rx1Rx2Phase->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
 	rx1Rx2Phase->showProgressBar(false);
 
-	connect(this, &EnsmModeClocksWidget::readRequested, this, [=, this]() {
-		rxPortInput->readAsync();
-		txPortInput->readAsync();
-		rx1Rx2Phase->readAsync();
-	});
-
 	return modeWidget;
 }
 
@@ -336,12 +315,9 @@ QWidget *EnsmModeClocksWidget::generateClocksWidget(QWidget *parent)
 	layout->addWidget(xoDisableUseExtRefclk, 1, 0);
 	xoDisableUseExtRefclk->showProgressBar(false);
 
-	bool isxoDisableUseExtRefclkEnabled = true;
 	if(iio_device_find_debug_attr(m_device, xoDisableUseExtRefclkAttr.toStdString().c_str()) == nullptr) {
 		xoDisableUseExtRefclk->setEnabled(false);
-		isxoDisableUseExtRefclkEnabled = false;
-		xoDisableUseExtRefclk->getUiStrategy()->setInfoMessage(
-			"This attribute is not available for your current device!");
+		xoDisableUseExtRefclk->setInfoMessage("This attribute is not available for your current device!");
 	}
 
 	// adi,external-rx-lo-enable
@@ -452,18 +428,5 @@ QWidget *EnsmModeClocksWidget::generateClocksWidget(QWidget *parent)
 					     .buildSingle();
 	layout->addWidget(txFastLockDelay, 5, 1);
 
-	connect(this, &EnsmModeClocksWidget::readRequested, this, [=, this]() {
-		if(isxoDisableUseExtRefclkEnabled) {
-			xoDisableUseExtRefclk->readAsync();
-		}
-		externalRxLo->readAsync();
-		clkOutputMode->readAsync();
-		externalTxLo->readAsync();
-		rxFastlockPincontrol->readAsync();
-		rxFastLockDelay->readAsync();
-		txFastlockPincontrol->readAsync();
-		txFastLockDelay->readAsync();
-	});
-
 	return widget;
 }
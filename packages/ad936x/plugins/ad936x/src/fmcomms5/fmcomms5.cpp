@@ -29,8 +29,6 @@
 #include <QList>
 #include <style.h>
 #include <menuonoffswitch.h>
-#include <QFutureWatcher>
-#include <QtConcurrent>
 #include <QLoggingCategory>
 #include <guistrategy/comboguistrategy.h>
 
@@ -58,21 +56,10 @@ FMCOMMS5::FMCOMMS5(iio_context *ctx, IIOWidgetGroup *group, QWidget *parent)
 	m_refreshButton = new AnimatedRefreshBtn(false, this);
 	m_tool->addWidgetToTopContainerHelper(m_refreshButton, TTA_RIGHT);
 
+	connect(m_group, &IIOWidgetGroup::refreshed, m_refreshButton, &AnimatedRefreshBtn::stopAnimation);
 	connect(m_refreshButton, &QPushButton::clicked, this, [this]() {
 		m_refreshButton->startAnimation();
-
-		QFutureWatcher<void> *watcher = new QFutureWatcher<void>(this);
-		connect(
-			watcher, &QFutureWatcher<void>::finished, this,
-			[this, watcher]() {
-				m_refreshButton->stopAnimation();
-				watcher->deleteLater();
-			},
-			Qt::QueuedConnection);
-
-		QFuture<void> future = QtConcurrent::run([this]() { Q_EMIT readRequested(); });
-
-		watcher->setFuture(future);
+		m_group->refreshWidgets(findChildren<IIOWidget *>());
 	});
 
 	QStackedWidget *centralWidget = new QStackedWidget(this);
@@ -100,7 +87,6 @@ FMCOMMS5::FMCOMMS5(iio_context *ctx, IIOWidgetGroup *group, QWidget *parent)
 		iio_device *mainDevice = iio_context_find_device(m_ctx, "ad9361-phy");
 
 		m_helper = new AD936xHelper(m_group);
-		connect(this, &FMCOMMS5::readRequested, m_helper, &AD936xHelper::readRequested);
 
 		///  first widget the global settings can be created with iiowigets only
 		controlWidgetLayout->addWidget(
@@ -227,7 +213,6 @@ QWidget *FMCOMMS5::generateRxChainWidget(iio_device *dev, QString title, QWidget
 	rfBandwidth->setUItoDataConversion([](QString data) { return QString::number(data.toDouble() * 1e6, 'f', 0); });
 
 	layout->addWidget(rfBandwidth, 0, 0, 2, 1);
-	connect(this, &FMCOMMS5::readRequested, rfBandwidth, &IIOWidget::readAsync);
 
 	// voltage0:  sampling_frequency
 	IIOWidget *samplingFrequency = IIOWidgetBuilder(widget)
@@ -246,7 +231,6 @@ QWidget *FMCOMMS5::generateRxChainWidget(iio_device *dev, QString title, QWidget
 		[](QString data) { return QString::number(data.toDouble() * 1e6, 'f', 0); });
 
 	layout->addWidget(samplingFrequency, 0, 1, 2, 1);
-	connect(this, &FMCOMMS5::readRequested, samplingFrequency, &IIOWidget::readAsync);
 
 	// voltage 0 : rf_port_select
 	IIOWidget *rfPortSelect = IIOWidgetBuilder(widget)
@@ -258,7 +242,6 @@ QWidget *FMCOMMS5::generateRxChainWidget(iio_device *dev, QString title, QWidget
 					  .group(m_group)
 					  .buildSingle();
 	layout->addWidget(rfPortSelect, 0, 2, 2, 1);
-	connect(this, &FMCOMMS5::readRequested, rfPortSelect, &IIOWidget::readAsync);
 
 	// quadrature_tracking_en
 	IIOWidget *quadratureTrackingEn = IIOWidgetBuilder(this)
@@ -270,7 +253,6 @@ QWidget *FMCOMMS5::generateRxChainWidget(iio_device *dev, QString title, QWidget
 						  .buildSingle();
 	layout->addWidget(quadratureTrackingEn, 0, 5);
 	quadratureTrackingEn->showProgressBar(false);
-	connect(this, &FMCOMMS5::readRequested, quadratureTrackingEn, &IIOWidget::readAsync);
 
 	// rf_dc_offset_tracking_en
 	IIOWidget *rcDcOffsetTrackingEn = IIOWidgetBuilder(widget)
@@ -282,7 +264,6 @@ QWidget *FMCOMMS5::generateRxChainWidget(iio_device *dev, QString title, QWidget
 						  .buildSingle();
 	layout->addWidget(rcDcOffsetTrackingEn, 1, 5);
 	rcDcOffsetTrackingEn->showProgressBar(false);
-	connect(this, &FMCOMMS5::readRequested, rcDcOffsetTrackingEn, &IIOWidget::readAsync);
 
 	// bb_dc_offset_tracking_en
 	IIOWidget *bbDcOffsetTrackingEn = IIOWidgetBuilder(widget)
@@ -294,7 +275,6 @@ QWidget *FMCOMMS5::generateRxChainWidget(iio_device *dev, QString title, QWidget
 						  .buildSingle();
 	layout->addWidget(bbDcOffsetTrackingEn, 2, 5);
 	bbDcOffsetTrackingEn->showProgressBar(false);
-	connect(this, &FMCOMMS5::readRequested, bbDcOffsetTrackingEn, &IIOWidget::readAsync);
 
 	mainLayout->addLayout(layout);
 
@@ -370,7 +350,6 @@ QWidget *FMCOMMS5::generateTxChainWidget(iio_device *dev, QString title, QWidget
 	rfBandwidth->setUItoDataConversion([](QString data) { return QString::number(data.toDouble() * 1e6, 'f', 0); });
 
 	lay->addWidget(rfBandwidth, 0, 0, 2, 1);
-	connect(this, &FMCOMMS5::readRequested, rfBandwidth, &IIOWidget::readAsync);
 
 	// voltage0:  sampling_frequency
 	IIOWidget *samplingFrequency = IIOWidgetBuilder(widget)
@@ -389,7 +368,6 @@ QWidget *FMCOMMS5::generateTxChainWidget(iio_device *dev, QString title, QWidget
 		[](QString data) { return QString::number(data.toDouble() * 1e6, 'f', 0); });
 
 	lay->addWidget(samplingFrequency, 0, 1, 2, 1);
-	connect(this, &FMCOMMS5::readRequested, samplingFrequency, &IIOWidget::readAsync);
 
 	// voltage0:  rf_port_select
 	IIOWidget *rfPortSelect = IIOWidgetBuilder(widget)
@@ -401,7 +379,6 @@ QWidget *FMCOMMS5::generateTxChainWidget(iio_device *dev, QString title, QWidget
 					  .group(m_group)
 					  .buildSingle();
 	lay->addWidget(rfPortSelect, 0, 2, 2, 1);
-	connect(this, &FMCOMMS5::readRequested, rfPortSelect, &IIOWidget::readAsync);
 
 	layout->addLayout(lay);
 
@@ -218,16 +218,6 @@ QWidget *GainWidget::modeWidget(QWidget *parent)
 	modeWidgetLayout->addWidget(rxFirOut, 3, 1);
 	rxFirOut->showProgressBar(false);
 
-	connect(this, &GainWidget::readRequested, this, [=, this]() {
-		rx1Mode->readAsync();
-		rx2Mode->readAsync();
-		tableMode->readAsync();
-		decpowMeasurement->readAsync();
-		lowPowerThresh->readAsync();
-		attackDelay->readAsync();
-		rxFirOut->readAsync();
-	});
-
 	return modeWidget;
 }
 
@@ -339,14 +329,6 @@ QWidget *GainWidget::mgcWidget(QWidget *parent)
 		return IIOWidgetUtils::comboDataToUiConversionFunction(data, mgcSplitTableCtrlOptions);
 	});
 
-	connect(this, &GainWidget::readRequested, this, [=, this]() {
-		mgcRx1Ctrl->readAsync();
-		mgcRx2Ctrl->readAsync();
-		mgcIncGain->readAsync();
-		mgcDecGain->readAsync();
-		mgcSplitTableCtrl->readAsync();
-	});
-
 	return mgcWidget;
 }
 
@@ -501,19 +483,6 @@ QWidget *GainWidget::agcThresholdGainChangesWidget(QWidget *parent)
 						.buildSingle();
 	agcTresholdGainChangesWidgetLayout->addWidget(gainUpdateInterval, 6, 0);
 
-	connect(this, &GainWidget::readRequested, this, [=, this]() {
-		outerThreshHigh->readAsync();
-		outerThreshHighDecSteps->readAsync();
-		innerThreshHigh->readAsync();
-		innerThreshHighDecSteps->readAsync();
-		innerThreshLow->readAsync();
-		innerThreshLowIncSteps->readAsync();
-		outerThreshLow->readAsync();
-		outerThreshLowIncSteps->readAsync();
-		sync->readAsync();
-		gainUpdateInterval->readAsync();
-	});
-
 	return agcTresholdGainChangesWidget;
 }
 
@@ -633,16 +602,6 @@ QWidget *GainWidget::adcOverloadWidget(QWidget *parent)
 	immedGainChange->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
 	immedGainChange->showProgressBar(false);
 
-	connect(this, &GainWidget::readRequested, this, [=, this]() {
-		largeOverloadThresh->readAsync();
-		smallOverloadThresh->readAsync();
-		largeOverloadExceed->readAsync();
-		smallOverloadExceed->readAsync();
-		largeDecSteps->readAsync();
-		preventGainIncrease->readAsync();
-		immedGainChange->readAsync();
-	});
-
 	return adcOverloadWidget;
 }
 
@@ -748,15 +707,6 @@ QWidget *GainWidget::lmtOverloadWidget(QWidget *parent)
 	immedGain->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
 	immedGain->showProgressBar(false);
 
-	connect(this, &GainWidget::readRequested, this, [=, this]() {
-		highThresh->readAsync();
-		lowThresh->readAsync();
-		largeExced->readAsync();
-		smallExced->readAsync();
-		largeInc->readAsync();
-		immedGain->readAsync();
-	});
-
 	return widget;
 }
 
@@ -832,13 +782,6 @@ QWidget *GainWidget::digitalGainWidget(QWidget *parent)
 					  .buildSingle();
 	widgetLayout->addWidget(gainStepSize, 2, 1);
 
-	connect(this, &GainWidget::readRequested, this, [=, this]() {
-		gainMode->readAsync();
-		saturationExceedCounter->readAsync();
-		maxDigGain->readAsync();
-		gainStepSize->readAsync();
-	});
-
 	return widget;
 }
 
@@ -893,8 +836,6 @@ QWidget *GainWidget::stateResponseToPeakOverload(QWidget *parent)
 			.buildSingle();
 	layout->addWidget(stateWaitTime);
 
-	connect(this, &GainWidget::readRequested, this, [=, this]() { stateWaitTime->readAsync(); });
-
 	return widget;
 }
 
@@ -975,13 +916,6 @@ QWidget *GainWidget::lowPowerCheck(QWidget *parent)
 			.buildSingle();
 	layout->addWidget(lowPowerThreshIncrementSteps, 2, 1);
 
-	connect(this, &GainWidget::readRequested, this, [=, this]() {
-		allowGainIncrease->readAsync();
-		lowPowerThresh->readAsync();
-		lowPowerThreshIncrementTime->readAsync();
-		lowPowerThreshIncrementSteps->readAsync();
-	});
-
 	return widget;
 }
 
@@ -1043,12 +977,6 @@ QWidget *GainWidget::agcLockLevelAdjustment(QWidget *parent)
 	lockLevelLmtGain->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
 	lockLevelLmtGain->showProgressBar(false);
 
-	connect(this, &GainWidget::readRequested, this, [=, this]() {
-		innerThreshHigh->readAsync();
-		lockLevelGain->readAsync();
-		lockLevelLmtGain->readAsync();
-	});
-
 	return widget;
 }
 
@@ -1127,13 +1055,6 @@ QWidget *GainWidget::peakDetectors(QWidget *parent)
 	increaseAfterGainLock->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
 	increaseAfterGainLock->showProgressBar(false);
 
-	connect(this, &GainWidget::readRequested, this, [=, this]() {
-		lpfFinalSettingsSteps->readAsync();
-		lmtFinalSettingsSteps->readAsync();
-		finalOverrange->readAsync();
-		increaseAfterGainLock->readAsync();
-	});
-
 	return widget;
 }
 
@@ -1448,23 +1369,6 @@ QWidget *GainWidget::gainUnlock(QWidget *parent)
 			.buildSingle();
 	layout->addWidget(powerMeasurementDuration, 8, 1);
 
-	connect(this, &GainWidget::readRequested, this, [=, this]() {
-		gainIndexType->readAsync();
-		increaseAfterGainLock->readAsync();
-		optimiezedGainOffset->readAsync();
-		sigThreshExceedEn->readAsync();
-		fagcRstGlaStrongerSigThresh->readAsync();
-		energyLostStronger->readAsync();
-		rstGlaEngLostSigThreshExceedEn->readAsync();
-		rstGlaEnergyLost->readAsync();
-		rstGlaLargeLmtOverloadEn->readAsync();
-		rstGlaEnergyLostGotoOptimGainEn->readAsync();
-		glaLargeAdcOverloadEn->readAsync();
-		rstGlaEnAgc->readAsync();
-		rstGlaIfEnAgcPulled->readAsync();
-		powerMeasurementDuration->readAsync();
-	});
-
 	return widget;
 }
 
@@ -1496,7 +1400,5 @@ QWidget *GainWidget::miscWidget(QWidget *parent)
 			.buildSingle();
 	layout->addWidget(stateWaitTime);
 
-	connect(this, &GainWidget::readRequested, this, [=, this]() { stateWaitTime->readAsync(); });
-
 	return widget;
 }
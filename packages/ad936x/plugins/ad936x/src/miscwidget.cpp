@@ -167,14 +167,6 @@ MiscWidget::MiscWidget(iio_device *device, IIOWidgetGroup *group, QWidget *paren
 	m_layout->addWidget(qecTracking);
 	m_layout->addItem(new QSpacerItem(1, 1, QSizePolicy::Preferred, QSizePolicy::Expanding));
 
-	connect(this, &MiscWidget::readRequested, this, [=, this]() {
-		attenuationLowRange->readAsync();
-		attenuationHighRange->readAsync();
-		countLowRange->readAsync();
-		countHighRange->readAsync();
-		updateEventMask->readAsync();
-		qecTrackingIio->readAsync();
-	});
 }
 
 MiscWidget::~MiscWidget() {}
@@ -129,12 +129,6 @@ RssiWidget::RssiWidget(iio_device *device, IIOWidgetGroup *group, QWidget *paren
 
 	m_layout->addItem(new QSpacerItem(1, 1, QSizePolicy::Preferred, QSizePolicy::Expanding));
 
-	connect(this, &RssiWidget::readRequested, this, [=, this]() {
-		rssiDuration->readAsync();
-		rssiDelay->readAsync();
-		rssiWait->readAsync();
-		rssiRestartMode->readAsync();
-	});
 }
 
 RssiWidget::~RssiWidget() {}
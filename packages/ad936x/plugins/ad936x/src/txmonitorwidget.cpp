@@ -229,19 +229,6 @@ TxMonitorWidget::TxMonitorWidget(iio_device *device, IIOWidgetGroup *group, QWid
 
 	m_layout->addItem(new QSpacerItem(1, 1, QSizePolicy::Preferred, QSizePolicy::Expanding));
 
-	connect(this, &TxMonitorWidget::readRequested, this, [=, this]() {
-		tx1FrontendGain->readAsync();
-		tx2FrontendGain->readAsync();
-		tx1LoCommonMode->readAsync();
-		tx2LoCommonMode->readAsync();
-		lowHighThresh->readAsync();
-		lowGain->readAsync();
-		highGain->readAsync();
-		delay->readAsync();
-		duration->readAsync();
-		dcTrackingEnabled->readAsync();
-		oneShotModeEnabled->readAsync();
-	});
 }
 
 TxMonitorWidget::~TxMonitorWidget() {}
@@ -34,6 +34,7 @@
 #include <gui/widgets/menuspinbox.h>
 #include <gui/widgets/menusectionwidget.h>
 #include <gui/widgets/menuonoffswitch.h>
+#include <iioutil/configuploader.h>
 #include "ad9371widgetfactory.h"
 
 namespace scopy {
@@ -48,7 +49,7 @@ class SCOPY_AD9371PLUGIN_EXPORT Ad9371 : public QWidget
 	friend class Ad9371_API;
 
 public:
-	Ad9371(iio_context *ctx, IIOWidgetGroup *group = nullptr, QWidget *parent = nullptr);
+	Ad9371(iio_context *ctx, CommandQueue *cmdQueue, IIOWidgetGroup *group = nullptr, QWidget *parent = nullptr);
 	~Ad9371();
 
 Q_SIGNALS:
@@ -62,6 +63,7 @@ private:
 	QWidget *m_centralWidget;
 	QWidget *m_blockDiagramWidget = nullptr;
 	AnimatedRefreshBtn *m_refreshButton;
+	ConfigUploader *m_profileUploader;
 
 	// Device pointers
 	iio_device *m_dev = nullptr;
@@ -126,6 +128,7 @@ private:
 
 private Q_SLOTS:
 	void loadProfileFromFile(QString filePath);
+	void onProfileLoaded(const ConfigUploader::Result &result);
 
 	// FPGA Phase Rotation Helpers
 	void writePhase(iio_device *fpgaDev, int channelIndex, int degrees);
@@ -34,18 +34,25 @@
 #include <gui/widgets/filebrowserwidget.h>
 #include <pkg-manager/pkgmanager.h>
 #include <QFile>
+#include <QFileInfo>
+#include <QHBoxLayout>
 #include <style.h>
 #include <QFutureWatcher>
 #include <QLoggingCategory>
 #include <qtconcurrentrun.h>
 #include <iio-widgets/iiowidgetgroup.h>
 #include <guistrategy/comboguistrategy.h>
+#include <pluginbase/statusbarmanager.h>
 
 Q_LOGGING_CATEGORY(CAT_AD9371, "AD9371");
 
 using namespace scopy;
 using namespace scopy::ad9371;
 
+#define PROFILE_LOAD_TIMEOUT_MS 30000
+#define CONTEXT_TIMEOUT_MS 3000
+#define SKIPPED_MESSAGE_MS 10000
+
 // Status string arrays from iio-oscilloscope ad9371.c
 static const char *dpd_status_strings[] = {
 	"No Error",
@@ -94,14 +101,18 @@ static const char *vswr_status_strings[] = {
 	"Error: Tx is not observable with any of the ORx Channels",
 };
 
-Ad9371::Ad9371(iio_context *ctx, IIOWidgetGroup *group, QWidget *parent)
+Ad9371::Ad9371(iio_context *ctx, CommandQueue *cmdQueue, IIOWidgetGroup *group, QWidget *parent)
 	: QWidget(parent)
 	, m_ctx(ctx)
 	, m_widgetGroup(group)
 	, m_tool(nullptr)
 	, m_refreshButton(nullptr)
+	, m_profileUploader(new ConfigUploader(cmdQueue, this))
 	, m_centralWidget(nullptr)
 {
+	// profiles take several seconds to apply, longer than the default context timeout
+	m_profileUploader->setTimeout(PROFILE_LOAD_TIMEOUT_MS, CONTEXT_TIMEOUT_MS);
+	connect(m_profileUploader, &ConfigUploader::uploadFinished, this, &Ad9371::onProfileLoaded);
 	setupUi();
 	connect(this, &Ad9371::readRequested, this, &Ad9371::readCalibrationFromHardware);
 	readCalibrationFromHardware();
@@ -412,22 +423,32 @@ void Ad9371::loadProfileFromFile(QString filePath)
 		qWarning(CAT_AD9371) << "Profile loading failed, no file path provided";
 		return;
 	}
-	QFile file(filePath);
-	if(!file.open(QIODevice::ReadOnly)) {
-		qWarning(CAT_AD9371) << "Failed to open profile:" << file.errorString();
-		return;
-	}
-	QByteArray buffer = file.readAll();
-	file.close();
+	m_profileUploader->upload(m_dev, "profile_config", filePath);
+}
 
-	iio_context_set_timeout(m_ctx, 30000);
-	int ret = iio_device_attr_write_raw(m_dev, "profile_config", buffer.constData(), buffer.size());
-	iio_context_set_timeout(m_ctx, 3000);
-	if(ret < 0)
-		qWarning(CAT_AD9371) << "Profile loading failed, error:" << ret;
-	else {
+void Ad9371::onProfileLoaded(const ConfigUploader::Result &result)
+{
+	if(result.status == ConfigUploader::UPLOAD_FAILED)
+		qWarning(CAT_AD9371) << "Profile loading failed, error:" << result.errorCode;
+	else if(result.status == ConfigUploader::UPLOAD_OK) {
 		qDebug(CAT_AD9371) << "Profile loaded successfully";
 		Q_EMIT readRequested();
+	} else if(result.status == ConfigUploader::UPLOAD_SKIPPED) {
+		// the device already holds this content, let the user write it anyway
+		qInfo(CAT_AD9371) << result.source << "is already loaded, upload skipped";
+		QWidget *message = new QWidget();
+		QHBoxLayout *messageLayout = new QHBoxLayout(message);
+		messageLayout->setContentsMargins(0, 0, 0, 0);
+		QLabel *messageLabel = new QLabel(QFileInfo(result.source).fileName() + " is already loaded", message);
+		messageLayout->addWidget(messageLabel);
+		QPushButton *forceButton = new QPushButton("Load anyway", message);
+		Style::setStyle(forceButton, style::properties::button::basicButton);
+		messageLayout->addWidget(forceButton);
+		connect(forceButton, &QPushButton::clicked, this, [this, result]() {
+			m_profileUploader->forget(m_dev, result.attribute);
+			loadProfileFromFile(result.source);
+		});
+		StatusBarManager::pushWidget(message, "AD9371ProfileSkipped", SKIPPED_MESSAGE_MS);
 	}
 }
 
@@ -509,7 +530,7 @@ QWidget *Ad9371::generateRxChainWidget(QString title, QWidget *parent)
 		int rfBwRet = iio_channel_attr_read(rxCh0, "rf_bandwidth", rfBwBuf, sizeof(rfBwBuf));
 		if(rfBwRet < 0 || strcmp(rfBwBuf, "ERROR") == 0) {
 			rfBw->setEnabled(false);
-			rfBw->getUiStrategy()->setInfoMessage("Can't access attribute rf_bandwidth");
+			rfBw->setInfoMessage("Can't access attribute rf_bandwidth");
 		}
 		sectionControls->addWidget(rfBw);
 
@@ -558,7 +579,7 @@ QWidget *Ad9371::generateRxChainWidget(QString title, QWidget *parent)
 		if(iio_device_find_debug_attr(m_dev, "adi,rx-agc-conf-agc-enable-sync-pulse-for-gain-counter") ==
 		   nullptr) {
 			gcSyncPulse->setEnabled(false);
-			gcSyncPulse->getUiStrategy()->setInfoMessage(
+			gcSyncPulse->setInfoMessage(
 				"Can't access attribute adi,rx-agc-conf-agc-enable-sync-pulse-for-gain-counter");
 		}
 		sectionControls->addWidget(gcSyncPulse);
@@ -600,21 +621,24 @@ QWidget *Ad9371::generateRxChainWidget(QString title, QWidget *parent)
 		QLabel *gainLabel1 = new QLabel("Gain Control: ", rx1Widget);
 		Style::setStyle(gainLabel1, style::properties::label::subtle);
 		if(gainMode) {
-			auto *comboUi = dynamic_cast<ComboAttrUi *>(gainMode->getUiStrategy());
-			if(comboUi) {
-				connect(comboUi, &ComboAttrUi::displayedNewData, gainLabel1,
-					[gainLabel1](const QString &text, const QString &) {
-						gainLabel1->setText("Gain Control: " + text);
-					});
-			}
-			QComboBox *combo = gainMode->findChild<QComboBox *>();
-			if(combo) {
-				connect(combo, &QComboBox::currentTextChanged, gainLabel1,
-					[gainLabel1](const QString &text) {
-						if(!text.isEmpty())
+			// the combo only exists once gainMode is materialized
+			gainMode->withUiStrategy(gainLabel1, [gainMode, gainLabel1](GuiStrategyInterface *ui) {
+				auto *comboUi = dynamic_cast<ComboAttrUi *>(ui);
+				if(comboUi) {
+					connect(comboUi, &ComboAttrUi::displayedNewData, gainLabel1,
+						[gainLabel1](const QString &text, const QString &) {
 							gainLabel1->setText("Gain Control: " + text);
-					});
-			}
+						});
+				}
+				QComboBox *combo = gainMode->findChild<QComboBox *>();
+				if(combo) {
+					connect(combo, &QComboBox::currentTextChanged, gainLabel1,
+						[gainLabel1](const QString &text) {
+							if(!text.isEmpty())
+								gainLabel1->setText("Gain Control: " + text);
+						});
+				}
+			});
 		}
 		rx1Layout->addWidget(gainLabel1);
 
@@ -669,21 +693,24 @@ QWidget *Ad9371::generateRxChainWidget(QString title, QWidget *parent)
 		QLabel *gainLabel2 = new QLabel("Gain Control: ", rx2Widget);
 		Style::setStyle(gainLabel2, style::properties::label::subtle);
 		if(gainMode) {
-			auto *comboUi = dynamic_cast<ComboAttrUi *>(gainMode->getUiStrategy());
-			if(comboUi) {
-				connect(comboUi, &ComboAttrUi::displayedNewData, gainLabel2,
-					[gainLabel2](const QString &text, const QString &) {
-						gainLabel2->setText("Gain Control: " + text);
-					});
-			}
-			QComboBox *combo = gainMode->findChild<QComboBox *>();
-			if(combo) {
-				connect(combo, &QComboBox::currentTextChanged, gainLabel2,
-					[gainLabel2](const QString &text) {
-						if(!text.isEmpty())
+			// the combo only exists once gainMode is materialized
+			gainMode->withUiStrategy(gainLabel2, [gainMode, gainLabel2](GuiStrategyInterface *ui) {
+				auto *comboUi = dynamic_cast<ComboAttrUi *>(ui);
+				if(comboUi) {
+					connect(comboUi, &ComboAttrUi::displayedNewData, gainLabel2,
+						[gainLabel2](const QString &text, const QString &) {
 							gainLabel2->setText("Gain Control: " + text);
-					});
-			}
+						});
+				}
+				QComboBox *combo = gainMode->findChild<QComboBox *>();
+				if(combo) {
+					connect(combo, &QComboBox::currentTextChanged, gainLabel2,
+						[gainLabel2](const QString &text) {
+							if(!text.isEmpty())
+								gainLabel2->setText("Gain Control: " + text);
+						});
+				}
+			});
 		}
 		rx2Layout->addWidget(gainLabel2);
 
@@ -1574,7 +1601,7 @@ QWidget *Ad9371::generateObsRxChainWidget(QString title, QWidget *parent)
 		int rfBwRet = iio_channel_attr_read(obsCh, "rf_bandwidth", rfBwBuf, sizeof(rfBwBuf));
 		if(rfBwRet < 0 || strcmp(rfBwBuf, "ERROR") == 0) {
 			rfBw->setEnabled(false);
-			rfBw->getUiStrategy()->setInfoMessage("Can't access attribute rf_bandwidth");
+			rfBw->setInfoMessage("Can't access attribute rf_bandwidth");
 		}
 		sectionControls->addWidget(rfBw);
 
@@ -1621,7 +1648,7 @@ QWidget *Ad9371::generateObsRxChainWidget(QString title, QWidget *parent)
 		if(iio_device_find_debug_attr(m_dev, "adi,obs-agc-conf-agc-enable-sync-pulse-for-gain-counter") ==
 		   nullptr) {
 			obsGcSyncPulse->setEnabled(false);
-			obsGcSyncPulse->getUiStrategy()->setInfoMessage(
+			obsGcSyncPulse->setInfoMessage(
 				"Can't access attribute adi,obs-agc-conf-agc-enable-sync-pulse-for-gain-counter");
 		}
 		sectionControls->addWidget(obsGcSyncPulse);
@@ -29,6 +29,7 @@
 #include <style.h>
 #include <gui/deviceiconbuilder.h>
 #include <iio-widgets/iiowidgetgroup.h>
+#include <common/debugtimer.h>
 
 #include <iioutil/connectionprovider.h>
 #include <pluginbase/scopyjs.h>
@@ -103,7 +104,10 @@ bool Ad9371Plugin::onConnect()
 	m_widgetGroup = new IIOWidgetGroup(this);
 
 	// Create basic AD9371 tool with IIO context
-	m_ad9371Tool = new Ad9371(conn->context(), m_widgetGroup);
+	DebugTimer benchmark;
+	IIOWidget::Stats widgetStats = IIOWidget::stats();
+	m_ad9371Tool = new Ad9371(conn->context(), conn->commandQueue(), m_widgetGroup);
+	DEBUGTIMER_LOG(benchmark, "AD9371 tool (" + IIOWidget::loadReport(widgetStats) + ") took:");
 	m_toolList[0]->setTool(m_ad9371Tool);
 	m_toolList[0]->setEnabled(true);
 	m_toolList[0]->setRunBtnVisible(true);
@@ -118,7 +122,11 @@ bool Ad9371Plugin::onConnect()
 	}
 
 	if(device && iio_device_get_debug_attrs_count(device) > 0) {
+		benchmark.restartTimer();
+		widgetStats = IIOWidget::stats();
 		Ad9371Advanced *ad9371Advanced = new Ad9371Advanced(device, m_widgetGroup);
+		DEBUGTIMER_LOG(benchmark,
+			       "AD9371 Advanced tool (" + IIOWidget::loadReport(widgetStats) + ") took:");
 		m_toolList[1]->setTool(ad9371Advanced);
 		m_toolList[1]->setEnabled(true);
 		m_toolList[1]->setRunBtnVisible(true);
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROFILECACHE_H
+#define PROFILECACHE_H
+
+#include "scopy-adrv9002plugin_export.h"
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+namespace scopy::adrv9002 {
+
+/**
+ * @brief Content addressed store of the profile and stream images generated by the profile generator CLI.
+ * Entries are keyed by the hash of the canonical configuration JSON. The most recently used entries are kept in
+ * memory and every entry is also written to a directory, so configurations generated in a previous session are
+ * not generated again. All methods are thread safe.
+ */
+class SCOPY_ADRV9002PLUGIN_EXPORT ProfileCache
+{
+public:
+	typedef struct
+	{
+		QByteArray profile;
+		QByteArray stream;
+	} Entry;
+
+	// an empty directory keeps the entries in memory only
+	explicit ProfileCache(const QString &directory, int capacity = 16, int diskCapacity = 64);
+	~ProfileCache();
+
+	static QString key(const QByteArray &canonicalConfig);
+
+	bool contains(const QString &key);
+	bool lookup(const QString &key, Entry &entry);
+	void insert(const QString &key, const Entry &entry);
+	void clear();
+
+	QString directory() const;
+
+private:
+	void touch(const QString &key);
+	bool readEntry(const QString &key, Entry &entry) const;
+	void writeEntry(const QString &key, const Entry &entry) const;
+	void pruneDirectory() const;
+
+	QString m_directory;
+	int m_capacity;
+	int m_diskCapacity;
+
+	QMutex m_mutex;
+	QHash<QString, Entry> m_entries;
+	QStringList m_recent; // least recently used first
+};
+
+} // namespace scopy::adrv9002
+
+#endif // PROFILECACHE_H
@@ -36,8 +36,13 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QLoggingCategory>
+#include <QMutex>
+#include <QSet>
+#include <QThreadPool>
+#include <QWaitCondition>
 #include <iio.h>
-#include <profilegeneratortypes.h>
+#include "profilecache.h"
+#include "profilegeneratortypes.h"
 
 Q_DECLARE_LOGGING_CATEGORY(CAT_PROFILECLIMANAGER)
 
@@ -64,6 +69,24 @@ public:
 	// Configuration preview for debug display
 	QString generateConfigPreview(const RadioConfig &config);
 
+	/**
+	 * @brief Returns the profile and stream images of config, running the CLI only if they are not cached.
+	 * Requests for a configuration that is being generated wait for that run instead of starting another one.
+	 */
+	bool generate(const RadioConfig &config, QByteArray &profile, QByteArray &stream, QString *error = nullptr);
+
+	/**
+	 * @brief Generates the configurations a user is likely to switch to next on the background worker, so
+	 * loading them is a cache hit. Requests still queued from a previous call are dropped.
+	 */
+	void pregenerate(const RadioConfig &config);
+	void waitForPregeneration();
+
+	// configurations one step away from config (sample rate or duplex mode), most likely first
+	static QList<RadioConfig> neighbours(const RadioConfig &config);
+
+	ProfileCache *cache();
+
 Q_SIGNALS:
 	void operationProgress(const QString &message);
 	void operationError(const QString &error);
@@ -79,13 +102,14 @@ private:
 
 	// CLI execution (based on iio-oscilloscope pattern)
 	bool executeCli(const QStringList &arguments, QString &output);
+	bool runGenerator(const RadioConfig &config, ProfileCache::Entry &entry, QString &error);
+	QString cacheKey(const RadioConfig &config);
 
 	// File operations
 	QByteArray readFileContents(const QString &filename);
 	bool writeDeviceAttribute(const QString &attribute, const QByteArray &data);
-
-	// Cleanup helpers
-	void cleanupTempFiles(const QStringList &files);
+	QByteArray readDeviceStatus();
+	bool writeFileContents(const QString &filename, const QByteArray &data);
 
 	// Member variables
 	iio_device *m_device;
@@ -93,9 +117,22 @@ private:
 	QString m_cliPath;
 	QString m_cliVersion;
 
+	ProfileCache m_cache;
+	// a single long lived thread, background generation never competes with itself for the CLI
+	QThreadPool m_worker;
+	QMutex m_mutex;
+	QWaitCondition m_generated;
+	QSet<QString> m_inFlight;
+
+	// what this manager last loaded and the profile_config the device reported right after, a load of the same
+	// configuration is skipped while the device still reports it
+	QString m_loadedKey;
+	QByteArray m_loadedStatus;
+
 	// CLI constants
 	static const QString CLI_NAME;
 	static const int CLI_TIMEOUT_MS;
+	static const int PREGENERATE_MAX;
 };
 
 } // namespace scopy::adrv9002
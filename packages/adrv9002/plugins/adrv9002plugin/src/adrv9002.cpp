@@ -304,12 +304,14 @@ MenuSectionCollapseWidget *Adrv9002::createGlobalSettingsSection(QWidget *parent
 		if(tempWidget) {
 			tempWidget->showProgressBar(false);
 			// Access the TemperatureGuiStrategy to set critical temperature
-			auto *tempStrategy = dynamic_cast<TemperatureGuiStrategy *>(tempWidget->getUiStrategy());
-			if(tempStrategy) {
-				tempStrategy->setCriticalTemperature(
-					80.0, "ADRV9002 temperature critical! Risk of thermal shutdown.");
-				tempStrategy->setWarningOffset(5.0); // Warn at 75°C (80°C - 5°C)
-			}
+			tempWidget->withUiStrategy(tempWidget, [](GuiStrategyInterface *ui) {
+				auto *tempStrategy = dynamic_cast<TemperatureGuiStrategy *>(ui);
+				if(tempStrategy) {
+					tempStrategy->setCriticalTemperature(
+						80.0, "ADRV9002 temperature critical! Risk of thermal shutdown.");
+					tempStrategy->setWarningOffset(5.0); // Warn at 75°C (80°C - 5°C)
+				}
+			});
 
 			connect(this, &Adrv9002::readRequested, tempWidget, &IIOWidget::readAsync);
 
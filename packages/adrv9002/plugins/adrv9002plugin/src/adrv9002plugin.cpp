@@ -29,6 +29,7 @@
 
 #include "adrv9002.h"
 #include <iio-widgets/iiowidgetgroup.h>
+#include <common/debugtimer.h>
 
 Q_LOGGING_CATEGORY(CAT_ADRV9002PLUGIN, "Adrv9002Plugin")
 using namespace scopy::adrv9002;
@@ -144,7 +145,10 @@ bool Adrv9002Plugin::onConnect()
 	}
 
 	m_widgetGroup = new IIOWidgetGroup(this);
+	DebugTimer benchmark;
+	IIOWidget::Stats widgetStats = IIOWidget::stats();
 	Adrv9002 *adrv9002 = new Adrv9002(conn->context(), m_widgetGroup);
+	DEBUGTIMER_LOG(benchmark, "ADRV9002 tool (" + IIOWidget::loadReport(widgetStats) + ") took:");
 	m_toolList[0]->setTool(adrv9002);
 	m_toolList[0]->setEnabled(true);
 	m_toolList[0]->setRunBtnVisible(false);
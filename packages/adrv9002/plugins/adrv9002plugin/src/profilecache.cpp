@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2025 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <profilecache.h>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <algorithm>
+
+Q_LOGGING_CATEGORY(CAT_PROFILECACHE, "ProfileCache")
+
+using namespace scopy::adrv9002;
+
+#define PROFILE_SUFFIX ".profile"
+#define STREAM_SUFFIX ".stream"
+
+ProfileCache::ProfileCache(const QString &directory, int capacity, int diskCapacity)
+	: m_directory(directory)
+	, m_capacity(std::max(capacity, 1))
+	, m_diskCapacity(diskCapacity)
+{
+	if(!m_directory.isEmpty() && !QDir().mkpath(m_directory)) {
+		qWarning(CAT_PROFILECACHE) << "Cannot create cache directory" << m_directory
+					   << "- caching in memory only";
+		m_directory.clear();
+	}
+}
+
+ProfileCache::~ProfileCache() = default;
+
+QString ProfileCache::key(const QByteArray &canonicalConfig)
+{
+	return QCryptographicHash::hash(canonicalConfig, QCryptographicHash::Sha256).toHex();
+}
+
+QString ProfileCache::directory() const { return m_directory; }
+
+bool ProfileCache::contains(const QString &key)
+{
+	QMutexLocker locker(&m_mutex);
+	if(m_entries.contains(key)) {
+		return true;
+	}
+	return !m_directory.isEmpty() && QFile::exists(QDir(m_directory).filePath(key + PROFILE_SUFFIX)) &&
+		QFile::exists(QDir(m_directory).filePath(key + STREAM_SUFFIX));
+}
+
+bool ProfileCache::lookup(const QString &key, Entry &entry)
+{
+	QMutexLocker locker(&m_mutex);
+	auto it = m_entries.constFind(key);
+	if(it != m_entries.cend()) {
+		entry = it.value();
+		touch(key);
+		return true;
+	}
+
+	if(!readEntry(key, entry)) {
+		return false;
+	}
+
+	m_entries.insert(key, entry);
+	touch(key);
+	return true;
+}
+
+void ProfileCache::insert(const QString &key, const Entry &entry)
+{
+	QMutexLocker locker(&m_mutex);
+	m_entries.insert(key, entry);
+	touch(key);
+	writeEntry(key, entry);
+}
+
+void ProfileCache::clear()
+{
+	QMutexLocker locker(&m_mutex);
+	m_entries.clear();
+	m_recent.clear();
+	if(!m_directory.isEmpty()) {
+		QDir dir(m_directory);
+		for(const QString &file : dir.entryList({"*" PROFILE_SUFFIX, "*" STREAM_SUFFIX}, QDir::Files)) {
+			dir.remove(file);
+		}
+	}
+}
+
+void ProfileCache::touch(const QString &key)
+{
+	m_recent.removeOne(key);
+	m_recent.append(key);
+	while(m_recent.size() > m_capacity) {
+		m_entries.remove(m_recent.takeFirst());
+	}
+}
+
+bool ProfileCache::readEntry(const QString &key, Entry &entry) const
+{
+	if(m_directory.isEmpty()) {
+		return false;
+	}
+
+	QFile profile(QDir(m_directory).filePath(key + PROFILE_SUFFIX));
+	QFile stream(QDir(m_directory).filePath(key + STREAM_SUFFIX));
+	if(!profile.open(QIODevice::ReadOnly) || !stream.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+
+	entry.profile = profile.readAll();
+	entry.stream = stream.readAll();
+	return !entry.profile.isEmpty() && !entry.stream.isEmpty();
+}
+
+void ProfileCache::writeEntry(const QString &key, const Entry &entry) const
+{
+	if(m_directory.isEmpty()) {
+		return;
+	}
+
+	// the stream is committed last, an entry is only complete once both files exist
+	const QStringList files = {key + PROFILE_SUFFIX, key + STREAM_SUFFIX};
+	const QList<QByteArray> data = {entry.profile, entry.stream};
+	for(int i = 0; i < files.size(); i++) {
+		QSaveFile file(QDir(m_directory).filePath(files[i]));
+		if(!file.open(QIODevice::WriteOnly) || file.write(data[i]) != data[i].size() || !file.commit()) {
+			qWarning(CAT_PROFILECACHE) << "Cannot write" << file.fileName();
+			return;
+		}
+	}
+
+	pruneDirectory();
+}
+
+void ProfileCache::pruneDirectory() const
+{
+	QDir dir(m_directory);
+	const QFileInfoList profiles = dir.entryInfoList({"*" PROFILE_SUFFIX}, QDir::Files, QDir::Time);
+	for(int i = m_diskCapacity; i < profiles.size(); i++) {
+		const QString key = profiles[i].completeBaseName();
+		dir.remove(key + PROFILE_SUFFIX);
+		dir.remove(key + STREAM_SUFFIX);
+	}
+}
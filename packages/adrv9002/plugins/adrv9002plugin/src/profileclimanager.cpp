@@ -19,7 +19,12 @@
  */
 
 #include <profileclimanager.h>
+#include <profilegeneratorconstants.h>
+#include <QMutexLocker>
+#include <QSaveFile>
 #include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QtConcurrent>
 
 Q_LOGGING_CATEGORY(CAT_PROFILECLIMANAGER, "ProfileCliManager")
 
@@ -28,6 +33,7 @@ using namespace scopy::adrv9002;
 // Static constants
 const QString ProfileCliManager::CLI_NAME = "adrv9002-iio-cli";
 const int ProfileCliManager::CLI_TIMEOUT_MS = 30000; // 30 seconds
+const int ProfileCliManager::PREGENERATE_MAX = 8;
 
 // Helper function for boolean to numeric conversion (matching iio-oscilloscope cJSON_AddNumberToObject)
 static int boolToInt(bool value) { return value ? 1 : 0; }
@@ -38,7 +44,11 @@ ProfileCliManager::ProfileCliManager(iio_device *device, QObject *parent)
 	, m_cliAvailable(false)
 	, m_cliPath("")
 	, m_cliVersion("unknown")
+	, m_cache(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/adrv9002-profiles")
 {
+	m_worker.setMaxThreadCount(1);
+	m_worker.setExpiryTimeout(-1);
+
 	// Detect CLI availability on construction
 	m_cliAvailable = detectCli();
 
@@ -50,7 +60,11 @@ ProfileCliManager::ProfileCliManager(iio_device *device, QObject *parent)
 	}
 }
 
-ProfileCliManager::~ProfileCliManager() = default;
+ProfileCliManager::~ProfileCliManager()
+{
+	m_worker.clear();
+	m_worker.waitForDone();
+}
 
 bool ProfileCliManager::isCliAvailable() const { return m_cliAvailable; }
 
@@ -129,66 +143,46 @@ void ProfileCliManager::saveProfileToFile(const QString &filename, const RadioCo
 {
 	if(!m_cliAvailable) {
 		Q_EMIT operationError("Profile Generator CLI not available");
+		return;
 	}
 
-	// Create temporary config file
-	QDir tempDir(QStandardPaths::writableLocation(QStandardPaths::TempLocation));
-	QString configFile = tempDir.filePath("adrv9002_config.json");
-
-	if(!writeConfigToTempFile(configFile, config)) {
-		Q_EMIT operationError("Failed to write configuration file");
+	QByteArray profileData, streamData;
+	QString error;
+	if(!generate(config, profileData, streamData, &error)) {
+		Q_EMIT operationError(QString("CLI execution failed: %1").arg(error));
 		return;
 	}
 
-	// Execute CLI command (following iio-oscilloscope pattern)
-	QStringList arguments;
-	arguments << "--config" << configFile << "--profile" << filename;
-
-	QString output;
-	bool success = executeCli(arguments, output);
-
-	// Cleanup temp file
-	cleanupTempFiles(QStringList() << configFile);
-
-	if(!success) {
-		Q_EMIT operationError(QString("CLI execution failed: %1").arg(output));
+	if(!writeFileContents(filename, profileData)) {
+		Q_EMIT operationError("Failed to write profile file");
 		return;
 	}
 
 	Q_EMIT operationProgress("Profile saved successfully");
+	pregenerate(config);
 }
 
 void ProfileCliManager::saveStreamToFile(const QString &filename, const RadioConfig &config)
 {
 	if(!m_cliAvailable) {
 		Q_EMIT operationError("Profile Generator CLI not available");
+		return;
 	}
 
-	// Create temporary config file
-	QDir tempDir(QStandardPaths::writableLocation(QStandardPaths::TempLocation));
-	QString configFile = tempDir.filePath("adrv9002_config.json");
-
-	if(!writeConfigToTempFile(configFile, config)) {
-		Q_EMIT operationError("Failed to write configuration file");
+	QByteArray profileData, streamData;
+	QString error;
+	if(!generate(config, profileData, streamData, &error)) {
+		Q_EMIT operationError(QString("CLI execution failed: %1").arg(error));
 		return;
 	}
 
-	// Execute CLI command for stream image
-	QStringList arguments;
-	arguments << "--config" << configFile << "--stream" << filename;
-
-	QString output;
-	bool success = executeCli(arguments, output);
-
-	// Cleanup temp file
-	cleanupTempFiles(QStringList() << configFile);
-
-	if(!success) {
-		Q_EMIT operationError(QString("CLI execution failed: %1").arg(output));
+	if(!writeFileContents(filename, streamData)) {
+		Q_EMIT operationError("Failed to write stream image file");
 		return;
 	}
 
 	Q_EMIT operationProgress("Stream image saved successfully");
+	pregenerate(config);
 }
 
 void ProfileCliManager::loadProfileToDevice(const RadioConfig &config)
@@ -198,71 +192,211 @@ void ProfileCliManager::loadProfileToDevice(const RadioConfig &config)
 		return;
 	}
 
-	// Create temporary files (following iio-oscilloscope pattern exactly)
-	QDir tempDir(QStandardPaths::writableLocation(QStandardPaths::TempLocation));
+	const QString key = cacheKey(config);
+	const QByteArray status = readDeviceStatus();
+	bool loaded;
+	{
+		QMutexLocker locker(&m_mutex);
+		loaded = (key == m_loadedKey && !status.isEmpty() && status == m_loadedStatus);
+	}
+	if(loaded) {
+		Q_EMIT operationProgress("Device already runs this profile, nothing to load");
+		return;
+	}
+
+	Q_EMIT operationProgress("Generating profile and stream files...");
+
+	QByteArray profileData, streamData;
+	QString error;
+	if(!generate(config, profileData, streamData, &error)) {
+		Q_EMIT operationError(QString("CLI execution failed: %1").arg(error));
+		return;
+	}
+
+	Q_EMIT operationProgress("Loading profile to device...");
+
+	// Write profile to device
+	if(!writeDeviceAttribute("profile_config", profileData)) {
+		Q_EMIT operationError("Failed to write profile to device");
+		return;
+	}
+
+	if(!writeDeviceAttribute("stream_config", streamData)) {
+		Q_EMIT operationError("Failed to write stream image to device");
+		return;
+	}
+
+	const QByteArray newStatus = readDeviceStatus();
+	{
+		QMutexLocker locker(&m_mutex);
+		m_loadedKey = key;
+		m_loadedStatus = newStatus;
+	}
+
+	Q_EMIT operationProgress("Stream_config write completed successfully");
+	pregenerate(config);
+}
+
+// Generation cache
+ProfileCache *ProfileCliManager::cache() { return &m_cache; }
+
+QString ProfileCliManager::cacheKey(const RadioConfig &config)
+{
+	// the compact JSON has sorted keys, equal configurations always hash the same. A different CLI may generate
+	// different images from the same configuration
+	return ProfileCache::key(m_cliVersion.toUtf8() + '\n' + createConfigJson(config).toUtf8());
+}
+
+bool ProfileCliManager::generate(const RadioConfig &config, QByteArray &profile, QByteArray &stream, QString *error)
+{
+	const QString key = cacheKey(config);
+	ProfileCache::Entry entry;
+
+	{
+		QMutexLocker locker(&m_mutex);
+		while(m_inFlight.contains(key)) {
+			m_generated.wait(&m_mutex);
+		}
+		if(m_cache.lookup(key, entry)) {
+			profile = entry.profile;
+			stream = entry.stream;
+			return true;
+		}
+		m_inFlight.insert(key);
+	}
+
+	QString output;
+	bool success = runGenerator(config, entry, output);
+	if(success) {
+		m_cache.insert(key, entry);
+		profile = entry.profile;
+		stream = entry.stream;
+	} else if(error) {
+		*error = output;
+	}
+
+	QMutexLocker locker(&m_mutex);
+	m_inFlight.remove(key);
+	m_generated.wakeAll();
+	return success;
+}
+
+bool ProfileCliManager::runGenerator(const RadioConfig &config, ProfileCache::Entry &entry, QString &error)
+{
+	// every run gets its own files, a background run never overwrites the inputs of a foreground one
+	QTemporaryDir tempDir;
+	if(!tempDir.isValid()) {
+		error = "Failed to create temporary directory";
+		return false;
+	}
+
 	QString configFile = tempDir.filePath("adrv9002_config.json");
 	QString profileFile = tempDir.filePath("adrv9002_profile.json");
 	QString streamFile = tempDir.filePath("adrv9002_stream.json");
 
-	QStringList tempFiles = {configFile, profileFile, streamFile};
-
-	// Write config to temp file
 	if(!writeConfigToTempFile(configFile, config)) {
-		Q_EMIT operationError("Failed to write configuration file");
-		cleanupTempFiles(tempFiles);
-		return;
+		error = "Failed to write configuration file";
+		return false;
 	}
 
-	Q_EMIT operationProgress("Generating profile and stream files...");
-
 	// Execute CLI command to generate both profile and stream
 	QStringList arguments;
 	arguments << "--config" << configFile << "--profile" << profileFile << "--stream" << streamFile;
 
-	QString output;
-	bool success = executeCli(arguments, output);
+	if(!executeCli(arguments, error)) {
+		return false;
+	}
 
-	if(!success) {
-		Q_EMIT operationError(QString("CLI execution failed: %1").arg(output));
-		cleanupTempFiles(tempFiles);
-		return;
+	entry.profile = readFileContents(profileFile);
+	entry.stream = readFileContents(streamFile);
+	if(entry.profile.isEmpty() || entry.stream.isEmpty()) {
+		error = "Failed to read generated profile and stream files";
+		return false;
 	}
 
-	Q_EMIT operationProgress("Loading profile to device...");
+	return true;
+}
 
-	// Read generated profile file
-	QByteArray profileData = readFileContents(profileFile);
-	if(profileData.isEmpty()) {
-		Q_EMIT operationError("Failed to read generated profile file");
-		cleanupTempFiles(tempFiles);
+void ProfileCliManager::pregenerate(const RadioConfig &config)
+{
+	if(!m_cliAvailable) {
 		return;
 	}
 
-	// Write profile to device
-	if(!writeDeviceAttribute("profile_config", profileData)) {
-		Q_EMIT operationError("Failed to write profile to device");
-		cleanupTempFiles(tempFiles);
-		return;
+	// the previous configuration's neighbours that did not start yet are no longer likely
+	m_worker.clear();
+
+	const QList<RadioConfig> candidates = neighbours(config);
+	for(int i = 0; i < candidates.size() && i < PREGENERATE_MAX; i++) {
+		const RadioConfig candidate = candidates[i];
+		QtConcurrent::run(&m_worker, [this, candidate]() {
+			if(m_cache.contains(cacheKey(candidate))) {
+				return;
+			}
+			QByteArray profile, stream;
+			if(generate(candidate, profile, stream)) {
+				qDebug(CAT_PROFILECLIMANAGER) << "Pre-generated" << cacheKey(candidate);
+			}
+		});
 	}
+}
 
-	// Read generated stream file
-	QByteArray streamData = readFileContents(streamFile);
-	if(streamData.isEmpty()) {
-		Q_EMIT operationError("Failed to read generated stream image file");
-		cleanupTempFiles(tempFiles);
-		return;
-	}
+void ProfileCliManager::waitForPregeneration() { m_worker.waitForDone(); }
 
-	if(!writeDeviceAttribute("stream_config", streamData)) {
-		Q_EMIT operationError("Failed to write stream image to device");
-		cleanupTempFiles(tempFiles);
-		return;
+QList<RadioConfig> ProfileCliManager::neighbours(const RadioConfig &config)
+{
+	const QStringList rates = FrequencyTable::getSampleRatesForSSILanes(config.ssi_lanes);
+	QList<RadioConfig> result;
+
+	auto setRate = [](auto &channel, const QString &rate) {
+		channel.sampleRateHz = rate.toUInt();
+		channel.channelBandwidthHz = FrequencyTable::getBandwidthForSampleRate(rate).toUInt();
+	};
+
+	// every enabled channel moved one sample rate up or down, then the other duplex mode, then a single
+	// channel moved on its own
+	for(int step : {1, -1}) {
+		RadioConfig candidate = config;
+		bool changed = false;
+		for(int i = 0; i < 2; i++) {
+			int rx = rates.indexOf(QString::number(config.rx_config[i].sampleRateHz)) + step;
+			if(config.rx_config[i].enabled && rx >= 0 && rx < rates.size()) {
+				setRate(candidate.rx_config[i], rates[rx]);
+				changed = true;
+			}
+			int tx = rates.indexOf(QString::number(config.tx_config[i].sampleRateHz)) + step;
+			if(config.tx_config[i].enabled && tx >= 0 && tx < rates.size()) {
+				setRate(candidate.tx_config[i], rates[tx]);
+				changed = true;
+			}
+		}
+		if(changed) {
+			result.append(candidate);
+		}
 	}
 
-	Q_EMIT operationProgress("Stream_config write completed successfully");
+	RadioConfig duplex = config;
+	duplex.fdd = !config.fdd;
+	result.append(duplex);
 
-	// Cleanup temp files
-	cleanupTempFiles(tempFiles);
+	for(int i = 0; i < 2; i++) {
+		for(int step : {1, -1}) {
+			int rx = rates.indexOf(QString::number(config.rx_config[i].sampleRateHz)) + step;
+			if(config.rx_config[i].enabled && rx >= 0 && rx < rates.size()) {
+				RadioConfig candidate = config;
+				setRate(candidate.rx_config[i], rates[rx]);
+				result.append(candidate);
+			}
+			int tx = rates.indexOf(QString::number(config.tx_config[i].sampleRateHz)) + step;
+			if(config.tx_config[i].enabled && tx >= 0 && tx < rates.size()) {
+				RadioConfig candidate = config;
+				setRate(candidate.tx_config[i], rates[tx]);
+				result.append(candidate);
+			}
+		}
+	}
+
+	return result;
 }
 
 // Config JSON Generation (simple format for CLI input)
@@ -401,6 +535,27 @@ QByteArray ProfileCliManager::readFileContents(const QString &filename)
 	return data;
 }
 
+bool ProfileCliManager::writeFileContents(const QString &filename, const QByteArray &data)
+{
+	QSaveFile file(filename);
+	if(!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+		qWarning(CAT_PROFILECLIMANAGER) << "Failed to write file:" << filename;
+		return false;
+	}
+	return true;
+}
+
+QByteArray ProfileCliManager::readDeviceStatus()
+{
+	if(!m_device) {
+		return QByteArray();
+	}
+
+	char buffer[8192];
+	ssize_t ret = iio_device_attr_read(m_device, "profile_config", buffer, sizeof(buffer));
+	return (ret > 0) ? QByteArray(buffer, ret) : QByteArray();
+}
+
 bool ProfileCliManager::writeDeviceAttribute(const QString &attribute, const QByteArray &data)
 {
 	if(!m_device) {
@@ -419,13 +574,4 @@ bool ProfileCliManager::writeDeviceAttribute(const QString &attribute, const QBy
 	}
 }
 
-void ProfileCliManager::cleanupTempFiles(const QStringList &files)
-{
-	for(const QString &file : files) {
-		if(QFile::exists(file)) {
-			QFile::remove(file);
-		}
-	}
-}
-
 #include "moc_profileclimanager.cpp"
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2025 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <adrv9002plugin/profileclimanager.h>
+
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QtConcurrent>
+
+using namespace scopy::adrv9002;
+
+// stands in for adrv9002-iio-cli: logs every generation and derives the images from the config it was given
+static const char *STUB_CLI = "#!/bin/sh\n"
+			      "case \"$1\" in --version|-v) echo \"stub-cli 1.0\"; exit 0;; esac\n"
+			      "echo \"$@\" >> \"$STUB_LOG\"\n"
+			      "[ -n \"$STUB_FAIL\" ] && { echo \"stub failure\"; exit 1; }\n"
+			      "while [ $# -gt 1 ]; do\n"
+			      "	case \"$1\" in\n"
+			      "	--config) config=\"$2\";;\n"
+			      "	--profile) profile=\"$2\";;\n"
+			      "	--stream) stream=\"$2\";;\n"
+			      "	esac\n"
+			      "	shift 2\n"
+			      "done\n"
+			      "sleep 0.2\n"
+			      "[ -n \"$profile\" ] && { printf 'profile:'; cat \"$config\"; } > \"$profile\"\n"
+			      "[ -n \"$stream\" ] && { printf 'stream:'; cat \"$config\"; } > \"$stream\"\n"
+			      "exit 0\n";
+
+// a generation of the stub takes 200 ms, a cache hit has to be well below that
+#define CACHE_HIT_MS 50
+
+class TST_ProfileCliManager : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void initTestCase();
+	void init();
+	void cacheHit();
+	void concurrentRequests();
+	void pregenerate();
+	void failedRun();
+	void neighbours();
+	void cacheEviction();
+
+private:
+	static RadioConfig config(uint32_t sampleRate);
+	int runs() const;
+
+	QTemporaryDir m_dir;
+};
+
+RadioConfig TST_ProfileCliManager::config(uint32_t sampleRate)
+{
+	RadioConfig config = {};
+	config.ssi_lanes = 2;
+	config.ddr = true;
+	config.lvds = true;
+	config.adcRateMode = 3;
+	for(int i = 0; i < 2; i++) {
+		config.rx_config[i] = {.enabled = true,
+				       .adcHighPerformanceMode = true,
+				       .freqOffsetCorrectionEnable = false,
+				       .analogFilterPowerMode = 2,
+				       .analogFilterBiquad = false,
+				       .analogFilterBandwidthHz = 0,
+				       .channelBandwidthHz = 18000000,
+				       .sampleRateHz = sampleRate,
+				       .ncoEnable = false,
+				       .ncoFrequencyHz = 0,
+				       .rfPort = 0};
+		config.tx_config[i] = {.enabled = true,
+				       .sampleRateHz = sampleRate,
+				       .freqOffsetCorrectionEnable = false,
+				       .analogFilterPowerMode = 2,
+				       .channelBandwidthHz = 18000000,
+				       .orxEnabled = false,
+				       .elbType = 0};
+	}
+	config.clk_config = {.deviceClockFrequencyKhz = 38400,
+			     .deviceClockOutputEnable = true,
+			     .deviceClockOutputDivider = 2,
+			     .clockPllHighPerformanceEnable = true,
+			     .clockPllPowerMode = 2,
+			     .processorClockDivider = 1};
+	return config;
+}
+
+int TST_ProfileCliManager::runs() const
+{
+	QFile log(m_dir.filePath("runs.log"));
+	if(!log.open(QIODevice::ReadOnly)) {
+		return 0;
+	}
+	return log.readAll().count('\n');
+}
+
+void TST_ProfileCliManager::initTestCase()
+{
+#ifdef Q_OS_WIN
+	QSKIP("The stub CLI is a shell script");
+#endif
+	QVERIFY(m_dir.isValid());
+	QStandardPaths::setTestModeEnabled(true);
+
+	QFile cli(m_dir.filePath("adrv9002-iio-cli"));
+	QVERIFY(cli.open(QIODevice::WriteOnly));
+	cli.write(STUB_CLI);
+	cli.close();
+	cli.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner);
+
+	qputenv("PATH", m_dir.path().toLocal8Bit() + ":" + qgetenv("PATH"));
+	qputenv("STUB_LOG", m_dir.filePath("runs.log").toLocal8Bit());
+}
+
+void TST_ProfileCliManager::init()
+{
+	QFile::remove(m_dir.filePath("runs.log"));
+	qunsetenv("STUB_FAIL");
+	ProfileCliManager manager(nullptr);
+	manager.cache()->clear();
+}
+
+void TST_ProfileCliManager::cacheHit()
+{
+	ProfileCliManager manager(nullptr);
+	QVERIFY(manager.isCliAvailable());
+	QCOMPARE(manager.getCliVersion(), QString("stub-cli 1.0"));
+
+	const RadioConfig cfg = config(30720000);
+	const QByteArray json = manager.generateConfigPreview(cfg).toUtf8();
+	QByteArray profile, stream;
+	QVERIFY(manager.generate(cfg, profile, stream));
+	QCOMPARE(profile, "profile:" + json);
+	QCOMPARE(stream, "stream:" + json);
+	QCOMPARE(runs(), 1);
+
+	QElapsedTimer timer;
+	timer.start();
+	QVERIFY(manager.generate(cfg, profile, stream));
+	QVERIFY(timer.elapsed() < CACHE_HIT_MS);
+	QCOMPARE(profile, "profile:" + json);
+	QCOMPARE(runs(), 1);
+
+	// a new session finds the images on disk
+	ProfileCliManager other(nullptr);
+	QVERIFY(other.generate(cfg, profile, stream));
+	QCOMPARE(stream, "stream:" + json);
+	QCOMPARE(runs(), 1);
+
+	// any other configuration is generated
+	QVERIFY(manager.generate(config(15360000), profile, stream));
+	QCOMPARE(runs(), 2);
+}
+
+void TST_ProfileCliManager::concurrentRequests()
+{
+	ProfileCliManager manager(nullptr);
+	const RadioConfig cfg = config(7680000);
+
+	QList<QFuture<bool>> futures;
+	for(int i = 0; i < 4; i++) {
+		futures.append(QtConcurrent::run([&manager, cfg]() {
+			QByteArray profile, stream;
+			return manager.generate(cfg, profile, stream) && !profile.isEmpty();
+		}));
+	}
+	for(QFuture<bool> &future : futures) {
+		QVERIFY(future.result());
+	}
+	QCOMPARE(runs(), 1);
+}
+
+void TST_ProfileCliManager::pregenerate()
+{
+	ProfileCliManager manager(nullptr);
+	const RadioConfig cfg = config(30720000);
+	QByteArray profile, stream;
+	QVERIFY(manager.generate(cfg, profile, stream));
+
+	const QList<RadioConfig> neighbours = ProfileCliManager::neighbours(cfg);
+	QVERIFY(neighbours.size() >= 3);
+
+	manager.pregenerate(cfg);
+	manager.waitForPregeneration();
+	const int generated = runs();
+	QVERIFY(generated > 3);
+
+	// switching to the first few neighbours is instant
+	QElapsedTimer timer;
+	for(int i = 0; i < 3; i++) {
+		timer.start();
+		QVERIFY(manager.generate(neighbours[i], profile, stream));
+		QVERIFY(timer.elapsed() < CACHE_HIT_MS);
+	}
+	QCOMPARE(runs(), generated);
+
+	// pre-generating again only runs the CLI for what is not cached yet
+	manager.pregenerate(cfg);
+	manager.waitForPregeneration();
+	QCOMPARE(runs(), generated);
+}
+
+void TST_ProfileCliManager::failedRun()
+{
+	ProfileCliManager manager(nullptr);
+	const RadioConfig cfg = config(3840000);
+	QByteArray profile, stream;
+	QString error;
+
+	qputenv("STUB_FAIL", "1");
+	QVERIFY(!manager.generate(cfg, profile, stream, &error));
+	QVERIFY(!error.isEmpty());
+
+	// failures are not cached
+	qunsetenv("STUB_FAIL");
+	QVERIFY(manager.generate(cfg, profile, stream, &error));
+	QCOMPARE(runs(), 2);
+}
+
+void TST_ProfileCliManager::neighbours()
+{
+	const RadioConfig cfg = config(61440000);
+	const QList<RadioConfig> neighbours = ProfileCliManager::neighbours(cfg);
+
+	// the highest rate only has neighbours below it
+	QCOMPARE(neighbours.first().rx_config[0].sampleRateHz, 30720000u);
+	QCOMPARE(neighbours.first().tx_config[1].sampleRateHz, 30720000u);
+	QCOMPARE(neighbours.first().rx_config[0].channelBandwidthHz, 18000000u);
+	QCOMPARE(neighbours.at(1).fdd, true);
+
+	ProfileCliManager manager(nullptr);
+	QSet<QString> previews = {manager.generateConfigPreview(cfg)};
+	for(const RadioConfig &neighbour : neighbours) {
+		previews.insert(manager.generateConfigPreview(neighbour));
+	}
+	QCOMPARE(previews.size(), neighbours.size() + 1);
+}
+
+void TST_ProfileCliManager::cacheEviction()
+{
+	ProfileCache cache("", 2);
+	ProfileCache::Entry entry;
+	cache.insert("a", {.profile = "pa", .stream = "sa"});
+	cache.insert("b", {.profile = "pb", .stream = "sb"});
+	QVERIFY(cache.lookup("a", entry));
+	cache.insert("c", {.profile = "pc", .stream = "sc"});
+
+	QVERIFY(cache.lookup("a", entry));
+	QCOMPARE(entry.stream, QByteArray("sa"));
+	QVERIFY(!cache.lookup("b", entry));
+	QVERIFY(cache.contains("c"));
+	QCOMPARE(ProfileCache::key("config"), ProfileCache::key("config"));
+	QVERIFY(ProfileCache::key("config") != ProfileCache::key("config2"));
+}
+
+QTEST_MAIN(TST_ProfileCliManager)
+#include "tst_profileclimanager.moc"
@@ -33,6 +33,7 @@
 #include <animatedrefreshbtn.h>
 #include <gui/widgets/menuspinbox.h>
 #include <gui/widgets/menusectionwidget.h>
+#include <iioutil/configuploader.h>
 #include "adrv9009widgetfactory.h"
 
 namespace scopy::adrv9009 {
@@ -45,7 +46,7 @@ class SCOPY_ADRV9009PLUGIN_EXPORT Adrv9009 : public QWidget
 	friend class Adrv9009Plugin_API;
 
 public:
-	Adrv9009(iio_context *ctx, IIOWidgetGroup *group = nullptr, QWidget *parent = nullptr);
+	Adrv9009(iio_context *ctx, CommandQueue *cmdQueue, IIOWidgetGroup *group = nullptr, QWidget *parent = nullptr);
 	~Adrv9009();
 
 Q_SIGNALS:
@@ -59,6 +60,7 @@ private:
 	QWidget *m_centralWidget;
 	AnimatedRefreshBtn *m_refreshButton;
 	QPushButton *m_mcsButton = nullptr;
+	ConfigUploader *m_profileUploader;
 
 	QMap<QString, iio_device *> m_adrv9009DeviceMap;
 	bool m_multiDeviceMode = false;
@@ -71,6 +73,7 @@ private:
 	void performMcsSync();
 
 	void loadProfileFromFile(QString filePath);
+	void onProfileLoaded(const ConfigUploader::Result &result);
 	QWidget *generateCalibrationWidget(iio_device *device, QWidget *parent);
 
 	// Simple section generators
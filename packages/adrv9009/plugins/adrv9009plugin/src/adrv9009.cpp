@@ -27,6 +27,8 @@
 #include <QSpacerItem>
 #include <QGridLayout>
 #include <QFormLayout>
+#include <QFileInfo>
+#include <QHBoxLayout>
 #include <cmath>
 #include <gui/widgets/menusectionwidget.h>
 #include <style.h>
@@ -36,20 +38,25 @@
 #include <qtconcurrentrun.h>
 #include <filebrowserwidget.h>
 #include <pkg-manager/pkgmanager.h>
+#include <pluginbase/statusbarmanager.h>
 
 Q_LOGGING_CATEGORY(CAT_ADRV9009, "ADRV9009");
 
+#define SKIPPED_MESSAGE_MS 10000
+
 using namespace scopy;
 using namespace scopy::adrv9009;
 
-Adrv9009::Adrv9009(iio_context *ctx, IIOWidgetGroup *group, QWidget *parent)
+Adrv9009::Adrv9009(iio_context *ctx, CommandQueue *cmdQueue, IIOWidgetGroup *group, QWidget *parent)
 	: QWidget(parent)
 	, m_ctx(ctx)
 	, m_widgetGroup(group)
 	, m_tool(nullptr)
 	, m_refreshButton(nullptr)
 	, m_centralWidget(nullptr)
+	, m_profileUploader(new ConfigUploader(cmdQueue, this))
 {
+	connect(m_profileUploader, &ConfigUploader::uploadFinished, this, &Adrv9009::onProfileLoaded);
 	setupUi();
 	qDebug(CAT_ADRV9009) << "ADRV9009 tool initialized successfully";
 }
@@ -336,40 +343,43 @@ void Adrv9009::loadProfileFromFile(QString filePath)
 		qWarning(CAT_ADRV9009) << "Profile loading failed, no file path provided";
 		return;
 	}
-
-	QFile file(filePath);
-	if(!file.open(QIODevice::ReadOnly)) {
-		qWarning(CAT_ADRV9009) << "Failed to open profile:" << file.errorString();
+	if(m_adrv9009DeviceMap.isEmpty()) {
+		qWarning(CAT_ADRV9009) << "Profile loading failed, no device found";
 		return;
 	}
 
-	QByteArray buffer = file.readAll();
-	file.close();
-
 	// Show loading animation
 	m_refreshButton->startAnimation();
+	m_profileUploader->upload(m_adrv9009DeviceMap.first(), "profile_config", filePath);
+}
 
-	QFutureWatcher<ssize_t> *watcher = new QFutureWatcher<ssize_t>(this);
-	connect(
-		watcher, &QFutureWatcher<ssize_t>::finished, this,
-		[this, watcher]() {
-			m_refreshButton->stopAnimation();
-			ssize_t ret = watcher->result();
-			if(ret < 0) {
-				qWarning(CAT_ADRV9009) << "Profile loading failed, error:" << ret;
-			} else {
-				qDebug(CAT_ADRV9009) << "Profile loaded successfully";
-				Q_EMIT readRequested();
+void Adrv9009::onProfileLoaded(const ConfigUploader::Result &result)
+{
+	m_refreshButton->stopAnimation();
+	if(result.status == ConfigUploader::UPLOAD_FAILED) {
+		qWarning(CAT_ADRV9009) << "Profile loading failed, error:" << result.errorCode;
+	} else if(result.status == ConfigUploader::UPLOAD_OK) {
+		qDebug(CAT_ADRV9009) << "Profile loaded successfully";
+		Q_EMIT readRequested();
+	} else if(result.status == ConfigUploader::UPLOAD_SKIPPED) {
+		// the device already holds this content, let the user write it anyway
+		qInfo(CAT_ADRV9009) << result.source << "is already loaded, upload skipped";
+		QWidget *message = new QWidget();
+		QHBoxLayout *messageLayout = new QHBoxLayout(message);
+		messageLayout->setContentsMargins(0, 0, 0, 0);
+		QLabel *messageLabel = new QLabel(QFileInfo(result.source).fileName() + " is already loaded", message);
+		messageLayout->addWidget(messageLabel);
+		QPushButton *forceButton = new QPushButton("Load anyway", message);
+		Style::setStyle(forceButton, style::properties::button::basicButton);
+		messageLayout->addWidget(forceButton);
+		connect(forceButton, &QPushButton::clicked, this, [this, result]() {
+			if(!m_adrv9009DeviceMap.isEmpty()) {
+				m_profileUploader->forget(m_adrv9009DeviceMap.first(), result.attribute);
 			}
-			watcher->deleteLater();
-		},
-		Qt::QueuedConnection);
-
-	iio_device *device = m_adrv9009DeviceMap.first();
-	QFuture<ssize_t> future = QtConcurrent::run([device, buffer]() {
-		return iio_device_attr_write_raw(device, "profile_config", buffer.constData(), buffer.size());
-	});
-	watcher->setFuture(future);
+			loadProfileFromFile(result.source);
+		});
+		StatusBarManager::pushWidget(message, "ADRV9009ProfileSkipped", SKIPPED_MESSAGE_MS);
+	}
 }
 
 QWidget *Adrv9009::generateCalibrationWidget(iio_device *device, QWidget *parent)
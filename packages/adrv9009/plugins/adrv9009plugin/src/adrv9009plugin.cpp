@@ -34,6 +34,7 @@
 #include <iioutil/connectionprovider.h>
 #include <pluginbase/scopyjs.h>
 #include <iio-widgets/iiowidgetgroup.h>
+#include <common/debugtimer.h>
 
 Q_LOGGING_CATEGORY(CAT_ADRV9009PLUGIN, "Adrv9009Plugin")
 using namespace scopy::adrv9009;
@@ -177,7 +178,10 @@ bool Adrv9009Plugin::onConnect()
 	m_widgetGroup = new IIOWidgetGroup(this);
 
 	// Create basic ADRV9009 tool with IIO context
-	Adrv9009 *adrv9009 = new Adrv9009(conn->context(), m_widgetGroup);
+	DebugTimer benchmark;
+	IIOWidget::Stats widgetStats = IIOWidget::stats();
+	Adrv9009 *adrv9009 = new Adrv9009(conn->context(), conn->commandQueue(), m_widgetGroup);
+	DEBUGTIMER_LOG(benchmark, "ADRV9009 tool (" + IIOWidget::loadReport(widgetStats) + ") took:");
 	m_toolList[0]->setTool(adrv9009);
 	m_toolList[0]->setEnabled(true);
 	m_toolList[0]->setRunBtnVisible(true);
@@ -192,6 +196,8 @@ bool Adrv9009Plugin::onConnect()
 		const char *deviceName = iio_device_get_name(device);
 
 		if(deviceName && QString(deviceName).startsWith("adrv9009-phy")) {
+			benchmark.restartTimer();
+			widgetStats = IIOWidget::stats();
 			if(first) {
 				// Set up existing "ADRV9009 Advanced" tool (m_toolList[1])
 				Adrv9009Advanced *adrv9009Advanced = new Adrv9009Advanced(device, m_widgetGroup);
@@ -205,6 +211,9 @@ bool Adrv9009Plugin::onConnect()
 			} else {
 				createAdditionalAdvancedTool(device, deviceName);
 			}
+			DEBUGTIMER_LOG(benchmark,
+				       QString("ADRV9009 Advanced tool for %1 (%2) took:")
+					       .arg(deviceName, IIOWidget::loadReport(widgetStats)));
 		}
 	}
 
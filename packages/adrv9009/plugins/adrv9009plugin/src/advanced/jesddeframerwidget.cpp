@@ -137,8 +137,7 @@ QWidget *JesdDeframerWidget::createDeframerColumn(const QString &columnType, con
 	if(mWidget) {
 		column->contentLayout()->addWidget(mWidget);
 		connect(this, &JesdDeframerWidget::readRequested, mWidget, &IIOWidget::readAsync);
-		mWidget->getUiStrategy()->setInfoMessage(
-			"Number of DACs (0, 2, or 4) - 2 DACs per transmit chain (I and Q)");
+		mWidget->setInfoMessage("Number of DACs (0, 2, or 4) - 2 DACs per transmit chain (I and Q)");
 	}
 
 	// 5. K - Range Widget [1 1 32]
@@ -259,8 +258,7 @@ QWidget *JesdDeframerWidget::createDeframerColumn(const QString &columnType, con
 		column->contentLayout()->addWidget(syncbSelectWidget);
 		syncbSelectWidget->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
 		connect(this, &JesdDeframerWidget::readRequested, syncbSelectWidget, &IIOWidget::readAsync);
-		syncbSelectWidget->getUiStrategy()->setInfoMessage(
-			"Selects deframer SYNCBOUT pin (0 = SYNCBOUT0, 1 = SYNCBOUT1)");
+		syncbSelectWidget->setInfoMessage("Selects deframer SYNCBOUT pin (0 = SYNCBOUT0, 1 = SYNCBOUT1)");
 	}
 
 	// 13. NP - Custom Combo [12,16]
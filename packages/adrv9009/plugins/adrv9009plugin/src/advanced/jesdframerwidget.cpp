@@ -136,7 +136,7 @@ QWidget *JesdFramerWidget::createFramerColumn(const QString &columnType, const Q
 	if(mWidget) {
 		column->contentLayout()->addWidget(mWidget);
 		connect(this, &JesdFramerWidget::readRequested, mWidget, &IIOWidget::readAsync);
-		mWidget->getUiStrategy()->setInfoMessage(
+		mWidget->setInfoMessage(
 			"Number of ADCs (0, 2, or 4) where 2 ADCs are required per receive chain (I and Q)");
 	}
 
@@ -161,7 +161,7 @@ QWidget *JesdFramerWidget::createFramerColumn(const QString &columnType, const Q
 	if(fWidget) {
 		column->contentLayout()->addWidget(fWidget);
 		connect(this, &JesdFramerWidget::readRequested, fWidget, &IIOWidget::readAsync);
-		fWidget->getUiStrategy()->setInfoMessage("Number of bytes(octets) per frame (Valid 1, 2, 4, 8)");
+		fWidget->setInfoMessage("Number of bytes(octets) per frame (Valid 1, 2, 4, 8)");
 	}
 
 	// 7. NP - Combobox [12,16,24]
@@ -174,7 +174,7 @@ QWidget *JesdFramerWidget::createFramerColumn(const QString &columnType, const Q
 	if(npWidget) {
 		column->contentLayout()->addWidget(npWidget);
 		connect(this, &JesdFramerWidget::readRequested, npWidget, &IIOWidget::readAsync);
-		npWidget->getUiStrategy()->setInfoMessage("converter sample resolution (12, 16, 24)");
+		npWidget->setInfoMessage("converter sample resolution (12, 16, 24)");
 	}
 
 	// 8. SCRAMBLE - Checkbox
@@ -24,7 +24,9 @@
 #include <QFutureWatcher>
 #include <QtConcurrent>
 #include <QFileDialog>
-#include <QTextStream>
+#include <QFileInfo>
+#include <QLabel>
+#include <QPushButton>
 
 #include <menusectionwidget.h>
 #include <menucollapsesection.h>
@@ -32,16 +34,20 @@
 #include <preferenceshelper.h>
 #include <iio-widgets/iiowidgetbuilder.h>
 #include <pkg-manager/pkgmanager.h>
+#include <pluginbase/statusbarmanager.h>
 
 Q_LOGGING_CATEGORY(CAT_AD9084, "AD9084");
 
+#define SKIPPED_MESSAGE_MS 10000
+
 using namespace scopy;
 using namespace scopy::ad9084;
 
-Ad9084::Ad9084(struct iio_device *dev, IIOWidgetGroup *group, QWidget *parent)
+Ad9084::Ad9084(struct iio_device *dev, CommandQueue *cmdQueue, IIOWidgetGroup *group, QWidget *parent)
 	: QWidget(parent)
 	, m_group(group)
 	, m_device(dev)
+	, m_uploader(new ConfigUploader(cmdQueue, this))
 	, m_channelPaths({})
 {
 	QHBoxLayout *lay = new QHBoxLayout();
@@ -59,6 +65,8 @@ Ad9084::Ad9084(struct iio_device *dev, IIOWidgetGroup *group, QWidget *parent)
 	m_tool->setRightContainerWidth(300);
 	lay->addWidget(m_tool);
 
+	connect(m_uploader, &ConfigUploader::uploadFinished, this, &Ad9084::onUploadFinished);
+
 	m_settingsBtn = new GearBtn(this);
 	m_settingsBtn->setCheckable(true);
 	m_settingsBtn->setChecked(true);
@@ -344,32 +352,12 @@ QWidget *Ad9084::createMenu()
 	return menu;
 }
 
-QString Ad9084::readFile(QString file)
-{
-	QString content = "";
-
-	QFile f(file);
-
-	if(!f.open(QFile::ReadOnly | QFile::Text)) {
-		return content;
-	}
-
-	QTextStream in(&f);
-
-	content = in.readAll();
-	f.close();
-	return content;
-}
-
 void Ad9084::loadCfir(QString path)
 {
 	if(path.isEmpty()) {
 		return;
 	}
-	QString content = readFile(path);
-	size_t ret = iio_device_attr_write_raw(m_device, "cfir_config", content.toStdString().c_str(), content.size());
-	if(ret < 0)
-		qDebug(CAT_AD9084) << "Failed to load CFIR CONFIG file to CFIR_CONFIG attr";
+	m_uploader->upload(m_device, "cfir_config", path);
 }
 
 void Ad9084::loadPfir(QString path)
@@ -378,8 +366,29 @@ void Ad9084::loadPfir(QString path)
 	if(path.isEmpty()) {
 		return;
 	}
-	QString content = readFile(path);
-	size_t ret = iio_device_attr_write_raw(m_device, "pfilt_config", content.toStdString().c_str(), content.size());
-	if(ret < 0)
-		qDebug(CAT_AD9084) << "Failed to load PFIR CONFIG file to PFILT_CONFIG attr";
+	m_uploader->upload(m_device, "pfilt_config", path);
+}
+
+void Ad9084::onUploadFinished(const ConfigUploader::Result &result)
+{
+	if(result.status == ConfigUploader::UPLOAD_FAILED) {
+		qDebug(CAT_AD9084) << "Failed to load" << result.source << "to" << result.attribute
+				   << "attr, error:" << result.errorCode;
+	} else if(result.status == ConfigUploader::UPLOAD_SKIPPED) {
+		// the device already holds this content, let the user write it anyway
+		qInfo(CAT_AD9084) << result.source << "is already loaded, upload skipped";
+		QWidget *message = new QWidget();
+		QHBoxLayout *messageLayout = new QHBoxLayout(message);
+		messageLayout->setContentsMargins(0, 0, 0, 0);
+		QLabel *messageLabel = new QLabel(QFileInfo(result.source).fileName() + " is already loaded", message);
+		messageLayout->addWidget(messageLabel);
+		QPushButton *forceButton = new QPushButton("Load anyway", message);
+		Style::setStyle(forceButton, style::properties::button::basicButton);
+		messageLayout->addWidget(forceButton);
+		connect(forceButton, &QPushButton::clicked, this, [this, result]() {
+			m_uploader->forget(m_device, result.attribute);
+			m_uploader->upload(m_device, result.attribute, result.source);
+		});
+		StatusBarManager::pushWidget(message, "AD9084FilterSkipped", SKIPPED_MESSAGE_MS);
+	}
 }
@@ -30,6 +30,7 @@
 #include <gui/widgets/menucontrolbutton.h>
 #include <gui/widgets/filebrowserwidget.h>
 #include <iiowidget.h>
+#include <iioutil/configuploader.h>
 #include <QWidget>
 #include <iio.h>
 
@@ -40,7 +41,7 @@ class SCOPY_AD9084_EXPORT Ad9084 : public QWidget
 {
 	Q_OBJECT
 public:
-	Ad9084(struct iio_device *dev, IIOWidgetGroup *mgr, QWidget *parent = nullptr);
+	Ad9084(struct iio_device *dev, CommandQueue *cmdQueue, IIOWidgetGroup *mgr, QWidget *parent = nullptr);
 	~Ad9084();
 
 Q_SIGNALS:
@@ -53,10 +54,11 @@ private:
 	QWidget *createMenu();
 	void loadCfir(QString path);
 	void loadPfir(QString path);
-	QString readFile(QString file);
+	void onUploadFinished(const ConfigUploader::Result &result);
 
 	IIOWidgetGroup *m_group;
 	struct iio_device *m_device;
+	ConfigUploader *m_uploader;
 	ToolTemplate *m_tool;
 	GearBtn *m_settingsBtn;
 	QPushButton *m_deviceName;
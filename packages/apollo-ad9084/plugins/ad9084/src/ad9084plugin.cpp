@@ -102,7 +102,7 @@ bool AD9084Plugin::onConnect()
 	m_widgetGroup = new IIOWidgetGroup(this);
 
 	struct iio_device *dev = iio_context_find_device(conn->context(), "axi-ad9084-rx-hpc");
-	m_toolList.last()->setTool(new Ad9084(dev, m_widgetGroup));
+	m_toolList.last()->setTool(new Ad9084(dev, conn->commandQueue(), m_widgetGroup));
 	m_toolList.last()->setEnabled(true);
 	m_toolList.last()->setRunBtnVisible(true);
 
@@ -136,7 +136,7 @@ bool AD9084Plugin::onConnect()
 			m_toolList.last()->setEnabled(true);
 			m_toolList.last()->setRunBtnVisible(true);
 			Q_EMIT toolListChanged();
-			Ad9084 *ad9084 = new Ad9084(rxDev, m_widgetGroup);
+			Ad9084 *ad9084 = new Ad9084(rxDev, conn->commandQueue(), m_widgetGroup);
 			m_toolList.last()->setTool(ad9084);
 			deviceIdx++;
 		}
@@ -24,16 +24,19 @@
 #include "scopy-cn0540_export.h"
 
 #include <QFuture>
+#include <QHash>
 #include <QLabel>
 #include <QLineEdit>
 #include <QPushButton>
-#include <QTimer>
 #include <QVBoxLayout>
 #include <QWidget>
 #include <iio.h>
 
 #include <iio-widgets/iiowidget.h>
 #include <iio-widgets/iiowidgetgroup.h>
+#include <iioutil/channelmonitor.h>
+#include <iioutil/offsetcalibration.h>
+#include <iioutil/scaledchannel.h>
 #include <gui/tooltemplate.h>
 #include <gui/widgets/animatedrefreshbtn.h>
 #include <gui/widgets/menusectionwidget.h>
@@ -51,7 +54,7 @@ class SCOPY_CN0540_EXPORT CN0540 : public QWidget
 	friend class CN0540_API;
 
 public:
-	explicit CN0540(iio_context *ctx, IIOWidgetGroup *group, QWidget *parent = nullptr);
+	explicit CN0540(iio_context *ctx, CommandQueue *cmdQueue, IIOWidgetGroup *group, QWidget *parent = nullptr);
 	~CN0540();
 
 Q_SIGNALS:
@@ -62,12 +65,13 @@ private Q_SLOTS:
 	void onReadVshift();
 	void onReadVsensor();
 	void onCalibrate();
-	void updateVoltages();
+	void updateVoltages(const scopy::ChannelMonitor::Snapshot &snapshot);
 
 private:
 	void setupUi();
 	void findGpioChannels();
 	void findVoltMonChannels();
+	void addScaledChannel(iio_channel *ch);
 	bool getGpioState(iio_channel *ch);
 	void setGpioState(iio_channel *ch, bool state);
 	double getVoltage(iio_channel *ch);
@@ -96,10 +100,14 @@ private:
 
 	iio_channel *m_analogIn[NUM_ANALOG_PINS];
 
+	// scale read once per channel, filled in the constructor and only read afterwards
+	QHash<iio_channel *, ScaledChannel> m_channels;
+
 	IIOWidgetGroup *m_group;
 
 	QFuture<void> m_calibFuture;
-	QTimer *m_voltMonTimer;
+	OffsetCalibration::Result m_lastCalibration;
+	ChannelMonitor *m_voltMonitor;
 
 	QLabel *m_swffStatusLabel;
 	QLabel *m_sensorVoltageLabel;
@@ -60,6 +60,8 @@ public:
 	Q_INVOKABLE void setShiftVoltage(const QString &mV);
 	Q_INVOKABLE QString getSensorVoltage();
 	Q_INVOKABLE void calibrate();
+	// "<DAC mV>,<ADC mV>" for every step of the last calibration
+	Q_INVOKABLE QStringList getCalibrationHistory();
 
 	// Voltage Monitor
 	Q_INVOKABLE QStringList getVoltageMonitor();
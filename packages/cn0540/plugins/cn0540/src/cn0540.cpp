@@ -29,7 +29,6 @@
 #include <QMetaObject>
 #include <QScrollArea>
 #include <QSpacerItem>
-#include <QThread>
 #include <QtConcurrent>
 
 #include <iio-widgets/iiowidgetbuilder.h>
@@ -42,12 +41,17 @@ static constexpr double G = 0.3;
 static constexpr double FDA_VOCM_MV = 2500.0;
 static constexpr double FDA_GAIN = 2.667;
 static constexpr int CALIB_MAX_ITER = 20;
+static constexpr double CALIB_TOLERANCE_MV = 0.05;
+static constexpr int CALIB_SAMPLES = 1024;
+static constexpr int CALIB_SETTLE_MS = 10;
+static constexpr int DAC_MAX_CODE = 65535;
 static constexpr double XADC_VREF = 3.3;
+static constexpr int VOLTMON_INTERVAL_MS = 1000;
 
 using namespace scopy;
 using namespace scopy::cn0540;
 
-CN0540::CN0540(iio_context *ctx, IIOWidgetGroup *group, QWidget *parent)
+CN0540::CN0540(iio_context *ctx, CommandQueue *cmdQueue, IIOWidgetGroup *group, QWidget *parent)
 	: QWidget(parent)
 	, m_ctx(ctx)
 	, m_adcDev(nullptr)
@@ -62,7 +66,8 @@ CN0540::CN0540(iio_context *ctx, IIOWidgetGroup *group, QWidget *parent)
 	, m_gpioFdaMode(nullptr)
 	, m_gpioCC(nullptr)
 	, m_group(group)
-	, m_voltMonTimer(nullptr)
+	, m_lastCalibration({.converged = false, .control = 0, .residual = 0, .history = {}, .error = ""})
+	, m_voltMonitor(nullptr)
 	, m_swffStatusLabel(nullptr)
 	, m_sensorVoltageLabel(nullptr)
 	, m_calibStatusLabel(nullptr)
@@ -93,9 +98,11 @@ CN0540::CN0540(iio_context *ctx, IIOWidgetGroup *group, QWidget *parent)
 
 	if(m_adcDev) {
 		m_adcCh = iio_device_find_channel(m_adcDev, "voltage0", false);
+		addScaledChannel(m_adcCh);
 	}
 	if(m_dacDev) {
 		m_dacCh = iio_device_find_channel(m_dacDev, "voltage0", true);
+		addScaledChannel(m_dacCh);
 	}
 	if(m_gpioDev) {
 		findGpioChannels();
@@ -107,9 +114,18 @@ CN0540::CN0540(iio_context *ctx, IIOWidgetGroup *group, QWidget *parent)
 	setupUi();
 
 	if(m_voltMonDev) {
-		m_voltMonTimer = new QTimer(this);
-		connect(m_voltMonTimer, &QTimer::timeout, this, &CN0540::updateVoltages);
-		m_voltMonTimer->start(1000);
+		// polled off the GUI thread, a slow network context no longer stalls the UI every second
+		m_voltMonitor = new ChannelMonitor(cmdQueue, this);
+		for(int i = 0; i < NUM_ANALOG_PINS; i++) {
+			ChannelMonitor::Transform transform = nullptr;
+			if(m_isXadc) {
+				transform = [](double value) { return value * XADC_VREF; };
+			}
+			m_voltMonitor->addChannel(QString::number(i), m_analogIn[i], transform);
+		}
+		connect(m_voltMonitor, &ChannelMonitor::updated, this, &CN0540::updateVoltages);
+		m_voltMonitor->setInterval(VOLTMON_INTERVAL_MS);
+		m_voltMonitor->start();
 	}
 
 	Q_EMIT readAll();
@@ -118,8 +134,8 @@ CN0540::CN0540(iio_context *ctx, IIOWidgetGroup *group, QWidget *parent)
 
 CN0540::~CN0540()
 {
-	if(m_voltMonTimer)
-		m_voltMonTimer->stop();
+	if(m_voltMonitor)
+		m_voltMonitor->stop();
 	m_calibFuture.waitForFinished();
 }
 
@@ -164,6 +180,13 @@ void CN0540::findVoltMonChannels()
 	}
 }
 
+void CN0540::addScaledChannel(iio_channel *ch)
+{
+	if(ch) {
+		m_channels.insert(ch, ScaledChannel(ch));
+	}
+}
+
 bool CN0540::getGpioState(iio_channel *ch)
 {
 	long long val = 0;
@@ -184,29 +207,17 @@ void CN0540::setGpioState(iio_channel *ch, bool state)
 
 double CN0540::getVoltage(iio_channel *ch)
 {
-	long long raw = 0;
-	double scale = 0.0;
-	int ret = iio_channel_attr_read_longlong(ch, "raw", &raw);
-	if(ret < 0) {
-		qWarning(CAT_CN0540) << "getVoltage: failed to read raw attr, ret=" << ret;
-	}
-	ret = iio_channel_attr_read_double(ch, "scale", &scale);
-	if(ret < 0) {
-		qWarning(CAT_CN0540) << "getVoltage: failed to read scale attr, ret=" << ret;
+	double value = 0.0;
+	if(!m_channels.value(ch).read(value)) {
+		qWarning(CAT_CN0540) << "getVoltage: failed to read channel";
 	}
-	return (double)raw * scale;
+	return value;
 }
 
 void CN0540::setVoltage(iio_channel *ch, double voltageMv)
 {
-	double scale = 0.0;
-	int ret = iio_channel_attr_read_double(ch, "scale", &scale);
-	if(ret < 0) {
-		qWarning(CAT_CN0540) << "setVoltage: failed to read scale attr, ret=" << ret;
-		return;
-	}
-	if(scale != 0.0) {
-		iio_channel_attr_write_longlong(ch, "raw", (long long)(voltageMv / scale));
+	if(!m_channels.value(ch).write(voltageMv)) {
+		qWarning(CAT_CN0540) << "setVoltage: failed to write channel";
 	}
 }
 
@@ -496,50 +507,69 @@ void CN0540::onCalibrate()
 		m_calibStatusLabel->setText("Calibrating...");
 	}
 
-	if(m_voltMonTimer) {
-		m_voltMonTimer->stop();
+	if(m_voltMonitor) {
+		m_voltMonitor->stop();
 	}
 
 	m_calibFuture = QtConcurrent::run([this]() {
-		double adcVoltageMv = 0.0;
-		for(int i = 0; i < CALIB_MAX_ITER; i++) {
-			adcVoltageMv = getVoltage(m_adcCh);
-			double dacVoltageMv = getVoltage(m_dacCh) - adcVoltageMv;
-			setVoltage(m_dacCh, dacVoltageMv);
-			QThread::msleep(10);
+		const ScaledChannel adc = m_channels.value(m_adcCh);
+		const ScaledChannel dac = m_channels.value(m_dacCh);
+
+		// the ADC moves by about as much as the DAC, the secant steps correct the real slope
+		OffsetCalibration calibration({.maxIterations = CALIB_MAX_ITER,
+					       .tolerance = CALIB_TOLERANCE_MV,
+					       .gain = 1.0,
+					       .resolution = dac.scale(),
+					       .minControl = 0.0,
+					       .maxControl = DAC_MAX_CODE * dac.scale(),
+					       .settleMs = CALIB_SETTLE_MS});
+
+		double dacVoltageMv = 0.0;
+		dac.read(dacVoltageMv);
+		OffsetCalibration::Result result = calibration.run(
+			dacVoltageMv, [&dac](double mV) { return dac.write(mV); },
+			[&adc](double &mV) { return adc.readMean(CALIB_SAMPLES, mV); });
+
+		for(const OffsetCalibration::Step &step : qAsConst(result.history)) {
+			qDebug(CAT_CN0540) << "Calibration step: DAC" << step.control << "mV, ADC" << step.measurement
+					   << "mV";
+		}
+		if(!result.error.isEmpty()) {
+			qWarning(CAT_CN0540) << "Calibration failed:" << result.error;
+		} else {
+			qInfo(CAT_CN0540) << "Calibration" << (result.converged ? "converged" : "did not converge")
+					  << "after" << result.history.size() - 1 << "steps, residual"
+					  << result.residual << "mV";
 		}
-		QString adcStr = QString::number(adcVoltageMv, 'f', 4);
+
 		QMetaObject::invokeMethod(
 			this,
-			[this, adcStr]() {
+			[this, result]() {
+				m_lastCalibration = result;
 				if(m_calibStatusLabel)
-					m_calibStatusLabel->setText(adcStr);
+					m_calibStatusLabel->setText(QString::number(result.residual, 'f', 4));
 				onReadVshift();
 				onReadVsensor();
-				if(m_voltMonTimer)
-					m_voltMonTimer->start(1000);
+				if(m_voltMonitor)
+					m_voltMonitor->start();
 			},
 			Qt::QueuedConnection);
 	});
 }
 
-void CN0540::updateVoltages()
+void CN0540::updateVoltages(const ChannelMonitor::Snapshot &snapshot)
 {
-	if(!m_voltMonDev) {
-		return;
-	}
-
 	for(int i = 0; i < NUM_ANALOG_PINS; i++) {
-		if(!m_analogIn[i] || !m_voltMonLabels[i]) {
+		if(!m_voltMonLabels[i]) {
 			continue;
 		}
 
-		double result = getVoltage(m_analogIn[i]);
-
-		if(m_isXadc) {
-			result *= XADC_VREF;
+		auto it = snapshot.readings.find(QString::number(i));
+		if(it == snapshot.readings.end() || !it->valid) {
+			m_voltMonLabels[i]->setText("---");
+			continue;
 		}
 
-		m_voltMonLabels[i]->setText(QString::number(result, 'f', 2));
+		m_voltMonLabels[i]->setText(QString::number(it->value, 'f', 2));
 	}
 }
@@ -231,6 +231,18 @@ void CN0540_API::calibrate()
 	tool->onCalibrate();
 }
 
+QStringList CN0540_API::getCalibrationHistory()
+{
+	CN0540 *tool = getTool();
+	if(!tool)
+		return QStringList();
+	QStringList result;
+	for(const OffsetCalibration::Step &step : qAsConst(tool->m_lastCalibration.history)) {
+		result.append(QString::number(step.control) + "," + QString::number(step.measurement));
+	}
+	return result;
+}
+
 // --- Voltage Monitor ---
 
 QStringList CN0540_API::getVoltageMonitor()
@@ -89,7 +89,7 @@ bool CN0540Plugin::onConnect()
 	}
 
 	m_widgetGroup = new IIOWidgetGroup(this);
-	CN0540 *tool = new CN0540(conn->context(), m_widgetGroup);
+	CN0540 *tool = new CN0540(conn->context(), conn->commandQueue(), m_widgetGroup);
 	m_toolList[0]->setTool(tool);
 	m_toolList[0]->setEnabled(true);
 	m_toolList[0]->setRunBtnVisible(false);
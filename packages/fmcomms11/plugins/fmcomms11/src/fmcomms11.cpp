@@ -292,8 +292,7 @@ QWidget *FMCOMMS11::generateDacWidget(QWidget *parent)
 			fir85Enable->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::Maximum);
 			if(!voltage0Out || !fir85Attr) {
 				fir85Enable->setEnabled(false);
-				fir85Enable->getUiStrategy()->setInfoMessage(
-					"The attribute for this option is missing");
+				fir85Enable->setInfoMessage("The attribute for this option is missing");
 			} else {
 				connect(this, &FMCOMMS11::readRequested, fir85Enable, &IIOWidget::readAsync);
 			}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ADC_API_H
+#define ADC_API_H
+
+#include "scopy-adc_export.h"
+#include <pluginbase/apiobject.h>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+namespace scopy::adc {
+
+class ADCPlugin;
+class ADCTimeInstrumentController;
+class ScriptCapture;
+
+class SCOPY_ADC_EXPORT ADC_API : public ApiObject
+{
+	Q_OBJECT
+public:
+	explicit ADC_API(ADCPlugin *plugin);
+	~ADC_API();
+
+	// Tool management
+	Q_INVOKABLE QStringList getTools();
+	Q_INVOKABLE QStringList getChannels(const QString &tool);
+	Q_INVOKABLE bool isRunning(const QString &tool);
+	Q_INVOKABLE void setRunning(const QString &tool, bool running);
+
+	// Bulk data - runs a time tool until it acquired the requested number of new buffers
+	Q_INVOKABLE bool capture(const QString &tool, int buffers = 1, int timeoutMs = 10000);
+	Q_INVOKABLE int getCapturedBuffers();
+	Q_INVOKABLE int getCapturedSamples();
+
+	// Captured data is returned as an ArrayBuffer - use new Float32Array(adc.getSamples("ch0"))
+	// Channels are selected by name or by their math channel variable (chK, as listed in the math channel menu)
+	Q_INVOKABLE QByteArray getSamples(const QString &channel);
+	Q_INVOKABLE QByteArray getSamplesDouble(const QString &channel);
+	Q_INVOKABLE QByteArray getTime();
+
+	// Plots float32 samples (the buffer of a Float32Array) as a reference channel of the tool
+	Q_INVOKABLE bool plotSamples(const QString &tool, const QString &name, const QByteArray &samples);
+
+private:
+	ADCTimeInstrumentController *timeController(const QString &tool);
+
+	ADCPlugin *m_plugin;
+	ScriptCapture *m_capture;
+};
+
+} // namespace scopy::adc
+#endif // ADC_API_H
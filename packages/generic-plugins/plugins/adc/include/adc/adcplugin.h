@@ -53,11 +53,15 @@ typedef enum
 	FREQUENCY
 } ADCInstrumentType;
 
+class ADC_API;
+
 class SCOPY_ADC_EXPORT ADCPlugin : public QObject, public PluginBase
 {
 	Q_OBJECT
 	SCOPY_PLUGIN;
 
+	friend class ADC_API;
+
 	// Plugin interface
 public:
 	void initPreferences() override;
@@ -87,7 +91,9 @@ private:
 	iio_context *m_ctx;
 	QLineEdit *edit;
 	QList<ADCInstrumentController *> m_ctrls;
+	ADC_API *m_api = nullptr;
 
+	void initApi();
 	void createGRIIOTreeNode(GRTopBlockNode *node, iio_context *ctx);
 };
 } // namespace adc
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MATHEXPRESSION_H
+#define MATHEXPRESSION_H
+
+#include "scopy-adc_export.h"
+
+#include <QString>
+#include <QStringList>
+#include <vector>
+
+namespace scopy::adc {
+
+/*
+ * MathExpression compiles a formula over channel buffers, such as
+ * "ch0*ch1", "sqrt(ch0^2 + ch1^2)", "diff(ch0)" or "avg(ch0, 16)", into a
+ * flat evaluation plan. Every instruction of the plan is applied to a whole
+ * block of samples at a time, so evaluation is a sequence of tight loops over
+ * float arrays instead of a per sample interpreter.
+ *
+ * Operators: + - * / ^ and unary minus. Functions: sqrt, abs, sin, cos, tan,
+ * exp, log (natural), log10, atan, atan2, pow, min, max, diff (first
+ * difference) and avg (moving average over a constant window). Constants pi
+ * and e are predefined.
+ *
+ * Constant subexpressions are folded at compile time, operands that are
+ * channels are read in place and scalars are never broadcast to a buffer.
+ */
+class SCOPY_ADC_EXPORT MathExpression
+{
+public:
+	static constexpr size_t BLOCK_SIZE = 2048;
+
+	MathExpression();
+	~MathExpression();
+
+	// variables are the names the expression may reference, in the order their inputs are passed
+	bool compile(const QString &expression, const QStringList &variables);
+
+	bool isValid() const;
+	QString expression() const;
+	QString errorString() const;
+	QStringList variables() const;
+	// indices in variables() of the inputs the expression reads
+	const std::vector<int> &usedVariables() const;
+	int instructionCount() const;
+
+	// inputs[i] holds size samples of variables()[i], unused inputs may be null.
+	// Returns false if the plan is invalid or a used input is missing
+	bool evaluate(const std::vector<const float *> &inputs, size_t size, float *out);
+
+	typedef enum
+	{
+		OP_COPY,
+		OP_NEG,
+		OP_SQUARE,
+		OP_SQRT,
+		OP_ABS,
+		OP_SIN,
+		OP_COS,
+		OP_TAN,
+		OP_EXP,
+		OP_LOG,
+		OP_LOG10,
+		OP_ATAN,
+		OP_DIFF,
+		OP_AVG,
+		OP_ADD,
+		OP_SUB,
+		OP_MUL,
+		OP_DIV,
+		OP_POW,
+		OP_MIN,
+		OP_MAX,
+		OP_ATAN2
+	} OpCode;
+
+	typedef enum
+	{
+		OPERAND_REGISTER,
+		OPERAND_INPUT,
+		OPERAND_SCALAR
+	} OperandKind;
+
+	typedef struct
+	{
+		OperandKind kind;
+		int index;
+		float value;
+	} Operand;
+
+	typedef struct
+	{
+		OpCode op;
+		int dst; // register, -1 is the output buffer
+		Operand a;
+		Operand b;
+		int window; // OP_AVG
+	} Instruction;
+
+private:
+	// running state of OP_DIFF and OP_AVG, carried from one block to the next
+	typedef struct
+	{
+		float last;
+		std::vector<float> history;
+		size_t pos;
+		size_t filled;
+		double sum;
+	} State;
+
+	QString m_expression;
+	QStringList m_variables;
+	QString m_error;
+	bool m_valid;
+
+	std::vector<Instruction> m_plan;
+	std::vector<int> m_used;
+	std::vector<std::vector<float>> m_registers;
+	std::vector<State> m_state;
+};
+
+} // namespace scopy::adc
+
+#endif // MATHEXPRESSION_H
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCRIPTCAPTURE_H
+#define SCRIPTCAPTURE_H
+
+#include "scopy-adc_export.h"
+
+#include <QByteArray>
+#include <QStringList>
+#include <vector>
+
+namespace scopy::adc {
+
+/*
+ * ScriptCapture collects a fixed number of acquired buffers for scripts. The
+ * samples of every channel are appended, as native float32, straight into a
+ * QByteArray, which QJSEngine hands to scripts as an ArrayBuffer sharing the
+ * same data. Scripts wrap it in a Float32Array, so pulling a capture costs one
+ * copy per buffer at acquisition time and no per sample conversion at all.
+ *
+ * The time axis is made contiguous: every buffer continues where the previous
+ * one ended, instead of restarting from the first sample time.
+ */
+class SCOPY_ADC_EXPORT ScriptCapture
+{
+public:
+	// variables are the math channel names of the channels, in the same order - ch0..chN-1 if not given
+	ScriptCapture(QStringList channels, int buffers, QStringList variables = QStringList());
+	~ScriptCapture();
+
+	// inputs holds one pointer per channel (null if unavailable), then the time axis
+	void append(const float *xData, const std::vector<const float *> &inputs, size_t size);
+
+	bool done() const;
+	int buffers() const;
+	qint64 size() const;
+
+	const QStringList &channels() const;
+	int indexOf(const QString &channel) const;
+
+	const QByteArray &samples(int channel) const;
+	QByteArray samplesDouble(int channel) const;
+	const QByteArray &time() const;
+
+	static QByteArray toDouble(const QByteArray &samples);
+
+private:
+	QStringList m_channels;
+	QStringList m_variables;
+	int m_buffers;
+	int m_captured;
+	qint64 m_size;
+	float m_nextTime;
+	std::vector<QByteArray> m_samples;
+	QByteArray m_time;
+};
+
+} // namespace scopy::adc
+
+#endif // SCRIPTCAPTURE_H
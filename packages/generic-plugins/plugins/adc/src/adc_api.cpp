@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "adc_api.h"
+#include "adcplugin.h"
+#include "adcinterfaces.h"
+#include "adctimeinstrumentcontroller.h"
+#include "grtimesinkcomponent.h"
+#include "scriptcapture.h"
+
+#include <QEventLoop>
+#include <QLoggingCategory>
+#include <QPointer>
+#include <QTimer>
+#include <pluginbase/toolmenuentry.h>
+
+Q_LOGGING_CATEGORY(CAT_ADC_API, "ADC_API")
+
+using namespace scopy::adc;
+
+namespace {
+// hooks a capture into the time sink next to the math channels
+class CaptureListener : public DerivedChannel
+{
+public:
+	CaptureListener(ScriptCapture *capture, QEventLoop *loop)
+		: m_capture(capture)
+		, m_loop(loop)
+	{}
+
+	void onNewInputs(const float *xData, const std::vector<const float *> &inputs, size_t size,
+			 bool copy) override
+	{
+		// copy is set when the sink tears down and hands out its last buffers again, they were captured already
+		if(copy || m_capture->done()) {
+			return;
+		}
+		m_capture->append(xData, inputs, size);
+		if(m_capture->done()) {
+			m_loop->quit();
+		}
+	}
+
+private:
+	ScriptCapture *m_capture;
+	QEventLoop *m_loop;
+};
+} // namespace
+
+ADC_API::ADC_API(ADCPlugin *plugin)
+	: ApiObject()
+	, m_plugin(plugin)
+	, m_capture(nullptr)
+{}
+
+ADC_API::~ADC_API() { delete m_capture; }
+
+// --- Private helpers ---
+
+ADCTimeInstrumentController *ADC_API::timeController(const QString &tool)
+{
+	for(ToolMenuEntry *tme : qAsConst(m_plugin->m_toolList)) {
+		if(tme->name() != tool) {
+			continue;
+		}
+		for(ADCInstrumentController *ctrl : qAsConst(m_plugin->m_ctrls)) {
+			if(ctrl->ui() == tme->tool()) {
+				return dynamic_cast<ADCTimeInstrumentController *>(ctrl);
+			}
+		}
+	}
+	qWarning(CAT_ADC_API) << "No time tool named" << tool;
+	return nullptr;
+}
+
+// --- Tool management ---
+
+QStringList ADC_API::getTools()
+{
+	QStringList tools;
+	for(ToolMenuEntry *tme : qAsConst(m_plugin->m_toolList)) {
+		tools.append(tme->name());
+	}
+	return tools;
+}
+
+QStringList ADC_API::getChannels(const QString &tool)
+{
+	ADCTimeInstrumentController *ctrl = timeController(tool);
+	if(!ctrl || !ctrl->timeSink()) {
+		return {};
+	}
+	return ctrl->timeSink()->channelNames();
+}
+
+bool ADC_API::isRunning(const QString &tool)
+{
+	for(ToolMenuEntry *tme : qAsConst(m_plugin->m_toolList)) {
+		if(tme->name() == tool) {
+			return tme->running();
+		}
+	}
+	return false;
+}
+
+void ADC_API::setRunning(const QString &tool, bool running)
+{
+	ADCTimeInstrumentController *ctrl = timeController(tool);
+	if(!ctrl || isRunning(tool) == running) {
+		return;
+	}
+	if(running) {
+		Q_EMIT ctrl->requestStart();
+	} else {
+		Q_EMIT ctrl->requestStop();
+	}
+}
+
+// --- Bulk data ---
+
+bool ADC_API::capture(const QString &tool, int buffers, int timeoutMs)
+{
+	ADCTimeInstrumentController *ctrl = timeController(tool);
+	GRTimeSinkComponent *sink = ctrl ? ctrl->timeSink() : nullptr;
+	if(!sink) {
+		return false;
+	}
+
+	delete m_capture;
+	m_capture = new ScriptCapture(sink->channelNames(), buffers, sink->variables());
+
+	// scripts run on the GUI thread, keep the acquisition and the plots going while waiting. The wait
+	// ends when the capture is complete, on timeout, or when the tool goes away with its sink
+	QEventLoop loop;
+	QPointer<GRTimeSinkComponent> guard(sink);
+	CaptureListener listener(m_capture, &loop);
+	connect(sink, &QObject::destroyed, &loop, &QEventLoop::quit);
+	QTimer::singleShot(timeoutMs, &loop, &QEventLoop::quit);
+	sink->addDerivedChannel(&listener);
+
+	const bool wasRunning = isRunning(tool);
+	setRunning(tool, true);
+	if(!m_capture->done()) {
+		loop.exec();
+	}
+
+	if(guard) {
+		guard->removeDerivedChannel(&listener);
+		if(!wasRunning) {
+			setRunning(tool, false);
+		}
+	}
+
+	if(!m_capture->done()) {
+		qWarning(CAT_ADC_API) << "Capture timed out after" << m_capture->buffers() << "of" << buffers
+				      << "buffers";
+	}
+	return m_capture->done();
+}
+
+int ADC_API::getCapturedBuffers() { return m_capture ? m_capture->buffers() : 0; }
+
+int ADC_API::getCapturedSamples() { return m_capture ? m_capture->size() : 0; }
+
+QByteArray ADC_API::getSamples(const QString &channel)
+{
+	if(!m_capture) {
+		qWarning(CAT_ADC_API) << "Nothing captured";
+		return {};
+	}
+	int idx = m_capture->indexOf(channel);
+	if(idx == -1) {
+		qWarning(CAT_ADC_API) << "Channel" << channel << "was not captured";
+		return {};
+	}
+	return m_capture->samples(idx);
+}
+
+QByteArray ADC_API::getSamplesDouble(const QString &channel) { return ScriptCapture::toDouble(getSamples(channel)); }
+
+QByteArray ADC_API::getTime() { return m_capture ? m_capture->time() : QByteArray(); }
+
+bool ADC_API::plotSamples(const QString &tool, const QString &name, const QByteArray &samples)
+{
+	ADCTimeInstrumentController *ctrl = timeController(tool);
+	const int count = samples.size() / sizeof(float);
+	if(!ctrl || count == 0) {
+		return false;
+	}
+
+	const float *src = reinterpret_cast<const float *>(samples.constData());
+	std::vector<float> y(src, src + count);
+	std::vector<float> x(count);
+
+	// samples derived from the last capture share its time axis
+	if(m_capture && m_capture->size() == count) {
+		const float *t = reinterpret_cast<const float *>(m_capture->time().constData());
+		x.assign(t, t + count);
+	} else {
+		for(int i = 0; i < count; i++) {
+			x[i] = i;
+		}
+	}
+
+	ctrl->addReferenceChannel(name, std::move(x), std::move(y));
+	return true;
+}
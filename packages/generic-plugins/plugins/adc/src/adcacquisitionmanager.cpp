@@ -151,3 +151,12 @@ ImportFloatChannelNode::ImportFloatChannelNode(SnapshotRecipe rec, QObject *pare
 ImportFloatChannelNode::~ImportFloatChannelNode() {}
 
 SnapshotRecipe ImportFloatChannelNode::recipe() const { return m_recipe; }
+
+MathChannelNode::MathChannelNode(MathChannelRecipe rec, QObject *parent)
+	: AcqTreeNode(rec.name, parent)
+	, m_recipe(rec)
+{}
+
+MathChannelNode::~MathChannelNode() {}
+
+MathChannelRecipe MathChannelNode::recipe() const { return m_recipe; }
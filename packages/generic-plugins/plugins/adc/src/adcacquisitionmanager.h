@@ -130,6 +130,17 @@ private:
 	SnapshotRecipe m_recipe;
 };
 
+class SCOPY_ADC_EXPORT MathChannelNode : public AcqTreeNode
+{
+public:
+	MathChannelNode(MathChannelRecipe, QObject *parent = nullptr);
+	~MathChannelNode();
+	MathChannelRecipe recipe() const;
+
+private:
+	MathChannelRecipe m_recipe;
+};
+
 class SCOPY_ADC_EXPORT AcqNodeChannelAware
 {
 public:
@@ -24,6 +24,7 @@
 
 #include "scopy-adc_export.h"
 #include <QString>
+#include <vector>
 #include "measurementcontroller.h"
 #include <gr-util/grsignalpath.h>
 #include <gui/plotmarkercontroller.h>
@@ -39,6 +40,8 @@ class SCOPY_ADC_EXPORT GRChannel : public DataProcessor
 {
 public:
 	virtual GRSignalPath *sigpath() = 0;
+	// called on the acquisition thread with the frame the next onNewData() publishes
+	virtual void onNewFrame(const float *xData, const float *yData, size_t size) {}
 };
 
 class TimePlotComponent;
@@ -50,6 +53,22 @@ typedef struct
 	QString name;
 } SnapshotRecipe;
 
+typedef struct
+{
+	QString expression;
+	TimePlotComponent *targetPlot;
+	QString name;
+} MathChannelRecipe;
+
+// a channel computed from the buffers of the acquired channels
+class SCOPY_ADC_EXPORT DerivedChannel
+{
+public:
+	// inputs are indexed like the variables the data provider exposes, missing ones are null
+	virtual void onNewInputs(const float *xData, const std::vector<const float *> &inputs, size_t size,
+				 bool copy) = 0;
+};
+
 class SCOPY_ADC_EXPORT MeasurementProvider
 {
 public:
@@ -21,6 +21,7 @@
 
 #include "adcplugin.h"
 
+#include "adc_api.h"
 #include "adcinstrument.h"
 #include <QBoxLayout>
 #include <QJsonDocument>
@@ -32,6 +33,7 @@
 
 #include <iioutil/connectionprovider.h>
 #include <pluginbase/preferences.h>
+#include <pluginbase/scopyjs.h>
 #include <pluginbase/statusbarmanager.h>
 #include <gui/preferenceshelper.h>
 #include <gui/deviceinfopage.h>
@@ -322,9 +324,18 @@ bool ADCPlugin::onConnect()
 	newInstrument(TIME, root, top);
 	newInstrument(FREQUENCY, root, top);
 	QMetaObject::invokeMethod(top, &GRTopBlock::unsuspendBuild, Qt::QueuedConnection);
+
+	initApi();
 	return true;
 }
 
+void ADCPlugin::initApi()
+{
+	m_api = new ADC_API(this);
+	m_api->setObjectName("adc");
+	ScopyJS::GetInstance()->registerApi(m_api);
+}
+
 void ADCPlugin::newInstrument(ADCInstrumentType t, AcqTreeNode *root, GRTopBlock *grtp)
 {
 
@@ -499,6 +510,12 @@ bool ADCPlugin::onDisconnect()
 	Preferences *p = Preferences::GetInstance();
 	disconnect(p, &Preferences::preferenceChanged, this, &ADCPlugin::preferenceChanged);
 	qDebug(CAT_ADCPLUGIN) << "disconnect";
+	if(m_api) {
+		ScopyJS::GetInstance()->unregisterApi(m_api);
+		delete m_api;
+		m_api = nullptr;
+	}
+
 	if(m_ctx)
 		ConnectionProvider::GetInstance()->close(m_param);
 
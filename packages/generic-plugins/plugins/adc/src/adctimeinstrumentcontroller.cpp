@@ -24,11 +24,17 @@
 #include "grdevicecomponent.h"
 #include "grtimechannelcomponent.h"
 #include "importchannelcomponent.h"
+#include "mathchannelcomponent.h"
 #include "grtimesinkcomponent.h"
 
+#include <QLoggingCategory>
+#include <sigmfcapture.h>
+
 using namespace scopy;
 using namespace adc;
 
+Q_LOGGING_CATEGORY(CAT_ADCTIMEINSTRUMENTCONTROLLER, "ADCTimeInstrumentController")
+
 ADCTimeInstrumentController::ADCTimeInstrumentController(ToolMenuEntry *tme, QString uri, QString name,
 							 AcqTreeNode *tree, QObject *parent)
 	: ADCInstrumentController(tme, uri, name, tree, parent)
@@ -78,6 +84,11 @@ void ADCTimeInstrumentController::init()
 	plotStack->add("time", m_plotComponentManager);
 	m_ui->getRightStack()->add(m_ui->settingsMenuId, m_timePlotSettingsComponent);
 
+	connect(m_timePlotSettingsComponent, &TimePlotManagerSettings::requestImport, this,
+		&ADCTimeInstrumentController::importCapture);
+	connect(m_timePlotSettingsComponent, &TimePlotManagerSettings::requestMathChannel, this,
+		&ADCTimeInstrumentController::addMathChannel);
+
 	connect(m_timePlotSettingsComponent, &TimePlotManagerSettings::requestOpenMenu, [=]() {
 		m_ui->getRightStack()->show(m_ui->settingsMenuId);
 		m_ui->m_settingsBtn->setChecked(true);
@@ -114,6 +125,50 @@ void ADCTimeInstrumentController::init()
 	m_ui->sync()->setVisible(false);
 }
 
+void ADCTimeInstrumentController::importCapture(TimePlotComponent *plot, QString path)
+{
+	// the capture is memory mapped, each channel is a single strided copy out of the mapping
+	SigMFCapture capture;
+	if(!capture.open(path)) {
+		qWarning(CAT_ADCTIMEINSTRUMENTCONTROLLER) << "Could not import" << path;
+		return;
+	}
+
+	const qint64 nrOfSamples = capture.nrOfSamples();
+	const double sampleRate = capture.metadata().sampleRate;
+	std::vector<float> x(nrOfSamples);
+	for(qint64 i = 0; i < nrOfSamples; i++) {
+		x[i] = (sampleRate > 0) ? i / sampleRate : i;
+	}
+
+	for(int ch = 0; ch < capture.nrOfChannels(); ch++) {
+		SnapshotRecipe rec{x, {}, plot, "REF - " + capture.metadata().channelNames[ch]};
+		capture.channel(ch, rec.y);
+		ImportFloatChannelNode *node = new ImportFloatChannelNode(rec, m_tree);
+		m_tree->addTreeChild(node);
+	}
+}
+
+void ADCTimeInstrumentController::addMathChannel(TimePlotComponent *plot, QString expression)
+{
+	MathChannelRecipe rec{expression, plot, "MATH - " + expression};
+	MathChannelNode *node = new MathChannelNode(rec, m_tree);
+	m_tree->addTreeChild(node);
+}
+
+void ADCTimeInstrumentController::addReferenceChannel(QString name, std::vector<float> x, std::vector<float> y)
+{
+	TimePlotComponent *plot = dynamic_cast<TimePlotComponent *>(m_plotComponentManager->plots().first());
+	SnapshotRecipe rec{std::move(x), std::move(y), plot, "REF - " + name};
+	ImportFloatChannelNode *node = new ImportFloatChannelNode(rec, m_tree);
+	m_tree->addTreeChild(node);
+}
+
+GRTimeSinkComponent *ADCTimeInstrumentController::timeSink() const
+{
+	return dynamic_cast<GRTimeSinkComponent *>(m_dataProvider);
+}
+
 void ADCTimeInstrumentController::createTimeSink(AcqTreeNode *node)
 {
 	GRTopBlockNode *grtbn = dynamic_cast<GRTopBlockNode *>(node);
@@ -244,6 +299,38 @@ void ADCTimeInstrumentController::createImportFloatChannel(AcqTreeNode *node)
 		[=](bool en) { c->ctrl()->checkBox()->setChecked(en); });
 }
 
+void ADCTimeInstrumentController::createMathChannel(AcqTreeNode *node)
+{
+	int idx = chIdP->next();
+	MathChannelNode *mcn = dynamic_cast<MathChannelNode *>(node);
+	GRTimeSinkComponent *sink = dynamic_cast<GRTimeSinkComponent *>(m_dataProvider);
+	if(!sink) {
+		qWarning(CAT_ADCTIMEINSTRUMENTCONTROLLER) << "No time sink to evaluate" << mcn->name() << "on";
+		return;
+	}
+	MathChannelComponent *c = new MathChannelComponent(mcn, sink, chIdP->pen(idx));
+
+	m_plotComponentManager->addChannel(c);
+	c->menu()->add(m_plotComponentManager->plotCombo(c), "plot", gui::MenuWidget::MA_BOTTOMFIRST);
+
+	m_otherCMCB->show();
+	CompositeWidget *cw = m_otherCMCB;
+	m_acqNodeComponentMap[mcn] = c;
+	m_ui->addChannel(c->ctrl(), c, cw);
+
+	connect(c->ctrl(), &QAbstractButton::clicked, this, [=]() { m_plotComponentManager->selectChannel(c); });
+
+	c->ctrl()->animateClick();
+
+	m_timePlotSettingsComponent->addChannel(c); // SingleY/etc
+
+	addComponent(c);
+	setupChannelMeasurement(m_plotComponentManager, c);
+
+	connect(m_otherCMCB->onOffSwitch(), &SmallOnOffSwitch::toggled, this,
+		[=](bool en) { c->ctrl()->checkBox()->setChecked(en); });
+}
+
 void ADCTimeInstrumentController::addChannel(AcqTreeNode *node)
 {
 	qInfo() << node->name();
@@ -263,6 +350,10 @@ void ADCTimeInstrumentController::addChannel(AcqTreeNode *node)
 	if(dynamic_cast<ImportFloatChannelNode *>(node) != nullptr) {
 		createImportFloatChannel(node);
 	}
+
+	if(dynamic_cast<MathChannelNode *>(node) != nullptr) {
+		createMathChannel(node);
+	}
 	m_plotComponentManager->replot();
 }
 
@@ -279,6 +370,19 @@ void ADCTimeInstrumentController::removeChannel(AcqTreeNode *node)
 		delete c;
 	}
 
+	if(dynamic_cast<MathChannelNode *>(node) != nullptr) {
+		MathChannelNode *mcn = dynamic_cast<MathChannelNode *>(node);
+		MathChannelComponent *c = dynamic_cast<MathChannelComponent *>(m_acqNodeComponentMap.value(mcn));
+		if(c) {
+			m_otherCMCB->remove(c->ctrl());
+			m_plotComponentManager->removeChannel(c);
+			m_timePlotSettingsComponent->removeChannel(c);
+			removeComponent(c);
+			m_acqNodeComponentMap.remove(mcn);
+			delete c;
+		}
+	}
+
 	if(m_otherCMCB->count() <= 0) {
 		m_otherCMCB->hide();
 	}
@@ -28,6 +28,8 @@
 
 namespace scopy {
 namespace adc {
+class GRTimeSinkComponent;
+
 class SCOPY_ADC_EXPORT ADCTimeInstrumentController : public ADCInstrumentController
 {
 public:
@@ -41,6 +43,11 @@ public:
 	void createIIODevice(AcqTreeNode *node);
 	void createIIOFloatChannel(AcqTreeNode *node);
 	void createImportFloatChannel(AcqTreeNode *node);
+	void createMathChannel(AcqTreeNode *node);
+	void importCapture(TimePlotComponent *plot, QString path);
+	void addMathChannel(TimePlotComponent *plot, QString expression);
+	void addReferenceChannel(QString name, std::vector<float> x, std::vector<float> y);
+	GRTimeSinkComponent *timeSink() const;
 	void setEnableAddRemovePlot(bool b) override;
 
 private:
@@ -30,7 +30,10 @@ using namespace adc;
 FFTMarkerController::FFTMarkerController(FFTPlotComponentChannel *ch, QObject *parent)
 	: PlotMarkerController(ch, parent)
 	, m_ch(ch)
-{}
+{
+	// curves are in dBFS - a parabolic fit on the log data is the gaussian fit of the magnitude
+	m_peakSearch.setInterpolation(PeakSearch::PI_PARABOLIC);
+}
 
 FFTMarkerController::~FFTMarkerController() {}
 
@@ -58,16 +61,14 @@ void FFTMarkerController::attachMarkersToPlot()
 int FFTMarkerController::findPeakNearIdx(int idx, int range)
 {
 	auto data = m_ch->m_ch->chData();
-	int start = (idx - range) > 0 ? idx - range : 0;
-	int maxIdx = start;
-	double maxVal = data->yData()[start];
-	for(int i = start; i <= idx + range && i < data->size(); i++) {
-		if(maxVal < data->yData()[i]) {
-			maxVal = data->yData()[i];
-			maxIdx = i;
-		}
-	}
-	return maxIdx;
+	return PeakSearch::findMaxNear(data->yData(), data->size(), idx, range);
+}
+
+PlotMarkerController::PeakInfo FFTMarkerController::peakAt(int idx)
+{
+	auto data = m_ch->m_ch->chData();
+	PeakSearch::Peak p = m_peakSearch.refine(data->xData(), data->yData(), data->size(), idx);
+	return {.x = p.x, .y = p.y, .idx = p.idx};
 }
 
 void FFTMarkerController::computeImageMarkers()
@@ -84,8 +85,7 @@ void FFTMarkerController::computeImageMarkers()
 	MarkerInfo fund = {.name = QString("Fund"), .marker = m_markers[1], .peak = m_sortedPeakInfo[0]};
 	int fund_offset = m_sortedPeakInfo[0].idx - dc_idx;
 	int idx = dc_idx - fund_offset;
-	MarkerInfo imag = {
-		.name = QString("Imag"), .marker = m_markers[2], .peak = {data->xData()[idx], data->yData()[idx]}};
+	MarkerInfo imag = {.name = QString("Imag"), .marker = m_markers[2], .peak = peakAt(idx)};
 
 	m_markerInfo.append(dc);
 	m_markerInfo.append(fund);
@@ -113,36 +113,16 @@ void FFTMarkerController::computeSingleToneMarkers()
 
 	for(int i = 2; i < this->m_nrOfMarkers; i++) {
 		int idx = findPeakNearIdx((fund_offset * i + dc_idx), histeresis);
-		MarkerInfo mi = {.name = QString::number(i) + "H",
-				 .marker = m_markers[i],
-				 .peak = {data->xData()[idx], data->yData()[idx]}};
+		MarkerInfo mi = {.name = QString::number(i) + "H", .marker = m_markers[i], .peak = peakAt(idx)};
 		m_markerInfo.append(mi);
 	}
 }
 
 void FFTMarkerController::computePeaks()
 {
+	// the acquisition thread already searched this frame, unless a marker setting changed since
 	auto data = m_ch->m_ch->chData();
-	m_peakInfo.clear();
-
-	int m_start = 0;
-	int m_stop = (m_complex) ? data->size() : data->size() / 2;
-
-	for(int i = m_start + 2; i < m_stop - 1; i++) {
-		if(data->yData()[i - 2] < data->yData()[i - 1] &&
-		   data->yData()[i - 1] > data->yData()[i]) { // is there a better way to compute a peak ?
-			PeakInfo mi = {.x = data->xData()[i - 1], .y = data->yData()[i - 1], .idx = i - 1};
-			m_peakInfo.append(mi);
-		}
-	}
-
-	m_sortedPeakInfo.clear();
-	for(auto v : qAsConst(m_peakInfo)) {
-		m_sortedPeakInfo.append(v);
-	}
-
-	std::sort(m_sortedPeakInfo.begin(), m_sortedPeakInfo.end(),
-		  [](const PeakInfo a, const PeakInfo b) { return a.y > b.y; });
+	updateSortedPeaks(data->xData(), data->yData(), data->size());
 }
 
 void FFTMarkerController::initFixedMarker()
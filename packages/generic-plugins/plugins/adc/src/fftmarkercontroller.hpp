@@ -48,6 +48,8 @@ protected:
 	void initFixedMarker() override;
 
 private:
+	PeakInfo peakAt(int idx);
+
 	FFTPlotComponentChannel *m_ch;
 };
 } // namespace adc
@@ -483,6 +483,11 @@ void GRFFTChannelComponent::onNewData(const float *xData, const float *yData, si
 	m_snapBtn->setEnabled(true);
 }
 
+void GRFFTChannelComponent::onNewFrame(const float *xData, const float *yData, size_t size)
+{
+	m_fftPlotComponentChannel->markerController()->searchPeaks(xData, yData, size);
+}
+
 bool GRFFTChannelComponent::sampleRateAvailable() { return m_src->samplerateAttributeAvailable(); }
 
 double GRFFTChannelComponent::sampleRate() { return m_src->readSampleRate(); }
@@ -215,6 +215,7 @@ public Q_SLOTS:
 	void onDeinit() override;
 
 	void onNewData(const float *xData, const float *yData, size_t size, bool copy) override;
+	void onNewFrame(const float *xData, const float *yData, size_t size) override;
 
 	bool sampleRateAvailable() override;
 	double sampleRate() override;
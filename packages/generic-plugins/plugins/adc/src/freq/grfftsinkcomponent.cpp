@@ -97,6 +97,14 @@ size_t GRFFTSinkComponent::updateData()
 	if(!time_sink)
 		return false;
 	uint64_t new_samples = time_sink->updateData();
+
+	// let the channels analyse the frame here, off the GUI thread
+	for(GRChannel *gr : qAsConst(m_channels)) {
+		int index = time_channel_map.value(gr->sigpath()->name(), -1);
+		if(index == -1)
+			continue;
+		gr->onNewFrame(time_sink->freq().data(), time_sink->data()[index].data(), frameSize(index));
+	}
 	return new_samples;
 }
 
@@ -111,15 +119,20 @@ void GRFFTSinkComponent::setData(bool copy)
 
 		const float *xdata = time_sink->freq().data();
 		const float *ydata = time_sink->data()[index].data();
-		size_t size = time_sink->data()[index].size();
 
-		// For float mode FFT, only send first half
-		if(!m_samplingInfo.complexMode) {
-			size = size / 2;
-		}
+		gr->onNewData(xdata, ydata, frameSize(index), copy);
+	}
+}
+
+size_t GRFFTSinkComponent::frameSize(int index)
+{
+	size_t size = time_sink->data()[index].size();
 
-		gr->onNewData(xdata, ydata, size, copy);
+	// For float mode FFT, only send first half
+	if(!m_samplingInfo.complexMode) {
+		size = size / 2;
 	}
+	return size;
 }
 
 SamplingInfo GRFFTSinkComponent::samplingInfo() { return m_samplingInfo; }
@@ -86,6 +86,8 @@ Q_SIGNALS:
 	void requestBufferSize(uint32_t);
 
 private:
+	size_t frameSize(int index);
+
 	std::mutex refillMutex;
 	time_sink_f::sptr time_sink;
 	QMap<QString, int> time_channel_map;
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mathchannelcomponent.h"
+#include "menusectionwidget.h"
+
+#include <QLoggingCategory>
+#include <style.h>
+
+Q_LOGGING_CATEGORY(CAT_MATHCHANNELCOMPONENT, "MathChannelComponent")
+
+using namespace scopy;
+using namespace scopy::adc;
+
+MathChannelComponent::MathChannelComponent(MathChannelNode *node, GRTimeSinkComponent *grtsc, QPen pen,
+					   QWidget *parent)
+	: ChannelComponent(node->recipe().name, pen, parent)
+{
+	m_plotChannelCmpt = new TimePlotComponentChannel(this, node->recipe().targetPlot, this);
+	m_timePlotChannelComponent = dynamic_cast<TimePlotComponentChannel *>(m_plotChannelCmpt);
+	connect(m_chData, &ChannelData::newData, m_timePlotChannelComponent, &TimePlotComponentChannel::onNewData);
+
+	m_node = node;
+	m_grtsc = grtsc;
+	m_channelName = node->name();
+	m_yLock = false;
+
+	m_measureMgr = new TimeMeasureManager(this);
+	m_measureMgr->initMeasure(m_pen);
+
+	setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+	auto m_lay = new QVBoxLayout(this);
+	m_lay->setMargin(0);
+	m_lay->setSpacing(0);
+	widget = createMenu(this);
+	m_lay->addWidget(widget);
+	setLayout(m_lay);
+	createMenuControlButton(this);
+
+	setExpression(node->recipe().expression);
+	m_grtsc->addDerivedChannel(this);
+	connect(m_grtsc, &GRTimeSinkComponent::channelsChanged, this, &MathChannelComponent::onChannelsChanged);
+}
+
+MathChannelComponent::~MathChannelComponent()
+{
+	if(m_grtsc) {
+		m_grtsc->removeDerivedChannel(this);
+	}
+}
+
+void MathChannelComponent::onInit()
+{
+	m_yCtrl->setMin(-1.0);
+	m_yCtrl->setMax(1.0);
+	addChannelToPlot();
+}
+
+bool MathChannelComponent::setExpression(const QString &expression)
+{
+	const bool ok = m_expr.compile(expression, m_grtsc->variables());
+	m_exprEdit->setText(expression);
+	m_exprError->setText(m_expr.errorString());
+	m_exprError->setVisible(!ok);
+	if(!ok) {
+		qWarning(CAT_MATHCHANNELCOMPONENT) << m_channelName << ":" << m_expr.errorString();
+	}
+	return ok;
+}
+
+void MathChannelComponent::onChannelsChanged()
+{
+	// the inputs moved, the variables did not - bind them again. An expression that uses a removed
+	// channel fails until the channel is back
+	updateVariables();
+	setExpression(m_expr.expression());
+}
+
+void MathChannelComponent::updateVariables()
+{
+	QStringList legend;
+	const QStringList vars = m_grtsc->variables();
+	const QStringList names = m_grtsc->channelNames();
+	for(int i = 0; i < names.size(); i++) {
+		legend.append(vars[i] + " = " + names[i]);
+	}
+	legend.append("t = time");
+	m_variables->setText(legend.join("\n"));
+}
+
+void MathChannelComponent::onNewInputs(const float *xData, const std::vector<const float *> &inputs, size_t size,
+				       bool copy)
+{
+	m_buffer.resize(size);
+	if(!m_expr.evaluate(inputs, size, m_buffer.data())) {
+		// one of the channels used by the expression is disabled
+		return;
+	}
+
+	m_chData->onNewData(xData, m_buffer.data(), size, copy);
+	auto model = m_measureMgr->getModel();
+	model->setDataSource(m_buffer.data(), size);
+	model->measure();
+}
+
+void MathChannelComponent::setSamplingInfo(SamplingInfo p)
+{
+	ChannelComponent::setSamplingInfo(p);
+	m_measureMgr->getModel()->setSampleRate(p.sampleRate);
+}
+
+MeasureManagerInterface *MathChannelComponent::getMeasureManager() { return m_measureMgr; }
+
+QWidget *MathChannelComponent::createMenu(QWidget *parent)
+{
+	initMenu(parent);
+	m_menu->header()->title()->setEnabled(true);
+	connect(m_menu->header()->title(), &QLineEdit::textChanged, this, [=](QString s) { m_ctrl->setName(s); });
+
+	QWidget *exprmenu = createExpressionMenu(m_menu);
+	QWidget *yaxismenu = createYAxisMenu(m_menu);
+	QWidget *curvemenu = createCurveMenu(m_menu);
+	QWidget *measuremenu = m_measureMgr->createMeasurementMenu(m_menu);
+
+	QPushButton *m_forget = new QPushButton("Remove math channel");
+	StyleHelper::BasicButton(m_forget);
+	connect(m_forget, &QAbstractButton::clicked, this, &MathChannelComponent::forgetChannel);
+
+	m_menu->add(exprmenu, "expression");
+	m_menu->add(yaxismenu, "yaxis");
+	m_menu->add(curvemenu, "curve");
+	m_menu->add(measuremenu, "measure");
+	m_menu->add(m_forget, "forget", gui::MenuWidget::MA_BOTTOMLAST);
+
+	return m_menu;
+}
+
+QWidget *MathChannelComponent::createExpressionMenu(QWidget *parent)
+{
+	MenuSectionCollapseWidget *section = new MenuSectionCollapseWidget(
+		"EXPRESSION", MenuCollapseSection::MHCW_NONE, MenuCollapseSection::MHW_BASEWIDGET, parent);
+	section->contentLayout()->setSpacing(6);
+
+	m_exprEdit = new QLineEdit(section);
+	m_exprError = new QLabel(section);
+	m_exprError->setWordWrap(true);
+	m_exprError->setVisible(false);
+
+	m_variables = new QLabel(section);
+	Style::setStyle(m_variables, style::properties::label::subtle);
+	updateVariables();
+
+	connect(m_exprEdit, &QLineEdit::editingFinished, this, [=]() {
+		if(m_exprEdit->text() != m_expr.expression()) {
+			setExpression(m_exprEdit->text());
+		}
+	});
+
+	section->contentLayout()->addWidget(m_exprEdit);
+	section->contentLayout()->addWidget(m_exprError);
+	section->contentLayout()->addWidget(m_variables);
+	return section;
+}
+
+QWidget *MathChannelComponent::createYAxisMenu(QWidget *parent)
+{
+	MenuSectionCollapseWidget *section = new MenuSectionCollapseWidget("Y-AXIS", MenuCollapseSection::MHCW_ONOFF,
+									   MenuCollapseSection::MHW_BASEWIDGET, parent);
+
+	m_yCtrl = new MenuPlotAxisRangeControl(m_timePlotChannelComponent->m_timePlotYAxis, section);
+	m_autoscaleBtn = new QPushButton(tr("AUTOSCALE"), section);
+	StyleHelper::BasicButton(m_autoscaleBtn);
+	m_autoscaler = new PlotAutoscaler(this);
+
+	connect(m_autoscaler, &PlotAutoscaler::newMin, m_yCtrl, &MenuPlotAxisRangeControl::setMin);
+	connect(m_autoscaler, &PlotAutoscaler::newMax, m_yCtrl, &MenuPlotAxisRangeControl::setMax);
+
+	connect(m_yCtrl, &MenuPlotAxisRangeControl::intervalChanged, this, [=](double min, double max) {
+		m_timePlotChannelComponent->m_xyPlotYAxis->setInterval(m_yCtrl->min(), m_yCtrl->max());
+	});
+
+	connect(section->collapseSection()->header(), &QAbstractButton::toggled, this, [=](bool b) {
+		m_yLock = b;
+		m_timePlotChannelComponent->lockYAxis(!b);
+	});
+
+	connect(m_autoscaleBtn, &QAbstractButton::pressed, m_autoscaler, &PlotAutoscaler::autoscale);
+
+	section->contentLayout()->addWidget(m_yCtrl);
+	section->contentLayout()->addWidget(m_autoscaleBtn);
+
+	return section;
+}
+
+QWidget *MathChannelComponent::createCurveMenu(QWidget *parent)
+{
+	MenuSectionCollapseWidget *section = new MenuSectionCollapseWidget("CURVE", MenuCollapseSection::MHCW_NONE,
+									   MenuCollapseSection::MHW_BASEWIDGET, parent);
+	section->contentLayout()->setSpacing(10);
+
+	m_curvemenu = new MenuPlotChannelCurveStyleControl(section);
+	section->contentLayout()->addWidget(m_curvemenu);
+	return section;
+}
+
+void MathChannelComponent::addChannelToPlot()
+{
+	m_yCtrl->addAxis(m_timePlotChannelComponent->m_timePlotYAxis);
+	m_curvemenu->addChannels(m_timePlotChannelComponent->m_timePlotCh);
+	m_autoscaler->addChannels(m_timePlotChannelComponent->m_timePlotCh);
+}
+
+void MathChannelComponent::removeChannelFromPlot()
+{
+	m_yCtrl->removeAxis(m_timePlotChannelComponent->m_timePlotYAxis);
+	m_curvemenu->removeChannels(m_timePlotChannelComponent->m_timePlotCh);
+	m_autoscaler->removeChannels(m_timePlotChannelComponent->m_timePlotCh);
+}
+
+void MathChannelComponent::forgetChannel()
+{
+	AcqTreeNode *treeRoot = m_node->treeRoot();
+	treeRoot->removeTreeChild(m_node);
+}
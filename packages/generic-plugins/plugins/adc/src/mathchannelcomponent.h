@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MATHCHANNELCOMPONENT_H
+#define MATHCHANNELCOMPONENT_H
+
+#include <gui/channelcomponent.h>
+#include <gui/plotautoscaler.h>
+#include <gui/widgets/menuplotchannelcurvestylecontrol.h>
+#include <gui/widgets/menuplotaxisrangecontrol.h>
+
+#include <QLabel>
+#include <QLineEdit>
+#include <QPointer>
+
+#include <adcacquisitionmanager.h>
+#include <grtimesinkcomponent.h>
+#include <mathexpression.h>
+#include <measurementcontroller.h>
+#include <timeplotcomponentchannel.h>
+
+namespace scopy {
+namespace adc {
+
+class SCOPY_ADC_EXPORT MathChannelComponent : public ChannelComponent,
+					      public DerivedChannel,
+					      public MeasurementProvider
+{
+	Q_OBJECT
+public:
+	MathChannelComponent(MathChannelNode *node, GRTimeSinkComponent *grtsc, QPen pen, QWidget *parent = nullptr);
+	~MathChannelComponent();
+
+	virtual void onInit() override;
+
+	MeasureManagerInterface *getMeasureManager() override;
+	void onNewInputs(const float *xData, const std::vector<const float *> &inputs, size_t size,
+			 bool copy) override;
+	void setSamplingInfo(SamplingInfo p) override;
+
+	bool setExpression(const QString &expression);
+
+public Q_SLOTS:
+	void forgetChannel();
+
+private Q_SLOTS:
+	void onChannelsChanged();
+
+private:
+	MathChannelNode *m_node;
+	QPointer<GRTimeSinkComponent> m_grtsc;
+	MathExpression m_expr;
+	std::vector<float> m_buffer;
+
+	QLineEdit *m_exprEdit;
+	QLabel *m_exprError;
+	QLabel *m_variables;
+	MenuPlotChannelCurveStyleControl *m_curvemenu;
+	MenuPlotAxisRangeControl *m_yCtrl;
+	PlotAutoscaler *m_autoscaler;
+	QPushButton *m_autoscaleBtn;
+	TimePlotComponentChannel *m_timePlotChannelComponent;
+	TimeMeasureManager *m_measureMgr;
+
+	bool m_yLock;
+
+	QWidget *createMenu(QWidget *parent = nullptr);
+	QWidget *createExpressionMenu(QWidget *parent);
+	QWidget *createYAxisMenu(QWidget *parent);
+	QWidget *createCurveMenu(QWidget *parent);
+	void updateVariables();
+
+	// ChannelComponent interface
+public:
+	void addChannelToPlot() override;
+	void removeChannelFromPlot() override;
+};
+} // namespace adc
+} // namespace scopy
+
+#endif // MATHCHANNELCOMPONENT_H
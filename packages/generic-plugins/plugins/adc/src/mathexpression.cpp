@@ -0,0 +1,717 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "mathexpression.h"
+
+#include <QLoggingCategory>
+#include <QMap>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+Q_LOGGING_CATEGORY(CAT_MATHEXPRESSION, "MathExpression")
+
+using namespace scopy::adc;
+
+namespace {
+
+typedef MathExpression ME;
+
+struct Node
+{
+	enum
+	{
+		NUMBER,
+		VARIABLE,
+		CALL
+	} kind;
+	ME::OpCode op;
+	double value; // NUMBER, the window of OP_AVG
+	int var;      // VARIABLE
+	std::vector<std::unique_ptr<Node>> args;
+};
+
+typedef std::unique_ptr<Node> NodePtr;
+
+NodePtr makeNumber(double value)
+{
+	NodePtr n(new Node());
+	n->kind = Node::NUMBER;
+	n->value = value;
+	return n;
+}
+
+NodePtr makeCall(ME::OpCode op, NodePtr a, NodePtr b = nullptr)
+{
+	NodePtr n(new Node());
+	n->kind = Node::CALL;
+	n->op = op;
+	n->args.push_back(std::move(a));
+	if(b) {
+		n->args.push_back(std::move(b));
+	}
+	return n;
+}
+
+typedef struct
+{
+	ME::OpCode op;
+	int arity;
+} Function;
+
+const QMap<QString, Function> &functions()
+{
+	static const QMap<QString, Function> map = {
+		{"sqrt", {ME::OP_SQRT, 1}},   {"abs", {ME::OP_ABS, 1}},	    {"sin", {ME::OP_SIN, 1}},
+		{"cos", {ME::OP_COS, 1}},     {"tan", {ME::OP_TAN, 1}},	    {"exp", {ME::OP_EXP, 1}},
+		{"log", {ME::OP_LOG, 1}},     {"ln", {ME::OP_LOG, 1}},	    {"log10", {ME::OP_LOG10, 1}},
+		{"atan", {ME::OP_ATAN, 1}},   {"diff", {ME::OP_DIFF, 1}},   {"avg", {ME::OP_AVG, 2}},
+		{"pow", {ME::OP_POW, 2}},     {"min", {ME::OP_MIN, 2}},	    {"max", {ME::OP_MAX, 2}},
+		{"atan2", {ME::OP_ATAN2, 2}},
+	};
+	return map;
+}
+
+template <typename T>
+T apply(ME::OpCode op, T a, T b)
+{
+	switch(op) {
+	case ME::OP_COPY:
+		return a;
+	case ME::OP_NEG:
+		return -a;
+	case ME::OP_SQUARE:
+		return a * a;
+	case ME::OP_SQRT:
+		return std::sqrt(a);
+	case ME::OP_ABS:
+		return std::abs(a);
+	case ME::OP_SIN:
+		return std::sin(a);
+	case ME::OP_COS:
+		return std::cos(a);
+	case ME::OP_TAN:
+		return std::tan(a);
+	case ME::OP_EXP:
+		return std::exp(a);
+	case ME::OP_LOG:
+		return std::log(a);
+	case ME::OP_LOG10:
+		return std::log10(a);
+	case ME::OP_ATAN:
+		return std::atan(a);
+	case ME::OP_ADD:
+		return a + b;
+	case ME::OP_SUB:
+		return a - b;
+	case ME::OP_MUL:
+		return a * b;
+	case ME::OP_DIV:
+		return a / b;
+	case ME::OP_POW:
+		return std::pow(a, b);
+	case ME::OP_MIN:
+		return std::min(a, b);
+	case ME::OP_MAX:
+		return std::max(a, b);
+	case ME::OP_ATAN2:
+		return std::atan2(a, b);
+	default:
+		return a;
+	}
+}
+
+/*
+ * Recursive descent parser, lowest to highest precedence:
+ *   expr  := term (('+' | '-') term)*
+ *   term  := unary (('*' | '/') unary)*
+ *   unary := ('-' | '+') unary | power
+ *   power := primary ('^' unary)?
+ */
+class Parser
+{
+public:
+	Parser(const QString &text, const QStringList &variables)
+		: m_text(text)
+		, m_pos(0)
+		, m_variables(variables)
+	{}
+
+	NodePtr parse(QString &error)
+	{
+		NodePtr root = parseExpr();
+		skipSpaces();
+		if(root && m_pos < m_text.size()) {
+			root = fail(QString("Unexpected '%1'").arg(m_text[m_pos]));
+		}
+		error = m_error;
+		return root;
+	}
+
+private:
+	NodePtr fail(const QString &msg)
+	{
+		if(m_error.isEmpty()) {
+			m_error = msg + QString(" at position %1").arg(m_pos + 1);
+		}
+		return nullptr;
+	}
+
+	void skipSpaces()
+	{
+		while(m_pos < m_text.size() && m_text[m_pos].isSpace()) {
+			m_pos++;
+		}
+	}
+
+	bool accept(QChar c)
+	{
+		skipSpaces();
+		if(m_pos < m_text.size() && m_text[m_pos] == c) {
+			m_pos++;
+			return true;
+		}
+		return false;
+	}
+
+	NodePtr parseExpr()
+	{
+		NodePtr lhs = parseTerm();
+		while(lhs) {
+			ME::OpCode op;
+			if(accept('+')) {
+				op = ME::OP_ADD;
+			} else if(accept('-')) {
+				op = ME::OP_SUB;
+			} else {
+				break;
+			}
+			NodePtr rhs = parseTerm();
+			if(!rhs) {
+				return nullptr;
+			}
+			lhs = makeCall(op, std::move(lhs), std::move(rhs));
+		}
+		return lhs;
+	}
+
+	NodePtr parseTerm()
+	{
+		NodePtr lhs = parseUnary();
+		while(lhs) {
+			ME::OpCode op;
+			if(accept('*')) {
+				op = ME::OP_MUL;
+			} else if(accept('/')) {
+				op = ME::OP_DIV;
+			} else {
+				break;
+			}
+			NodePtr rhs = parseUnary();
+			if(!rhs) {
+				return nullptr;
+			}
+			lhs = makeCall(op, std::move(lhs), std::move(rhs));
+		}
+		return lhs;
+	}
+
+	NodePtr parseUnary()
+	{
+		if(accept('-')) {
+			NodePtr operand = parseUnary();
+			return operand ? makeCall(ME::OP_NEG, std::move(operand)) : nullptr;
+		}
+		if(accept('+')) {
+			return parseUnary();
+		}
+		return parsePower();
+	}
+
+	NodePtr parsePower()
+	{
+		NodePtr base = parsePrimary();
+		if(base && accept('^')) {
+			NodePtr exponent = parseUnary();
+			return exponent ? makeCall(ME::OP_POW, std::move(base), std::move(exponent)) : nullptr;
+		}
+		return base;
+	}
+
+	NodePtr parsePrimary()
+	{
+		skipSpaces();
+		if(m_pos >= m_text.size()) {
+			return fail("Unexpected end of expression");
+		}
+
+		if(accept('(')) {
+			NodePtr inner = parseExpr();
+			if(inner && !accept(')')) {
+				return fail("Expected ')'");
+			}
+			return inner;
+		}
+
+		const QChar c = m_text[m_pos];
+		if(c.isDigit() || c == '.') {
+			return parseNumber();
+		}
+		if(c.isLetter() || c == '_') {
+			return parseIdentifier();
+		}
+		return fail(QString("Unexpected '%1'").arg(c));
+	}
+
+	NodePtr parseNumber()
+	{
+		const int start = m_pos;
+		while(m_pos < m_text.size() && (m_text[m_pos].isDigit() || m_text[m_pos] == '.')) {
+			m_pos++;
+		}
+		if(m_pos < m_text.size() && (m_text[m_pos] == 'e' || m_text[m_pos] == 'E')) {
+			int exp = m_pos + 1;
+			if(exp < m_text.size() && (m_text[exp] == '+' || m_text[exp] == '-')) {
+				exp++;
+			}
+			if(exp < m_text.size() && m_text[exp].isDigit()) {
+				m_pos = exp;
+				while(m_pos < m_text.size() && m_text[m_pos].isDigit()) {
+					m_pos++;
+				}
+			}
+		}
+
+		bool ok;
+		const double value = m_text.mid(start, m_pos - start).toDouble(&ok);
+		if(!ok) {
+			m_pos = start;
+			return fail("Invalid number");
+		}
+		return makeNumber(value);
+	}
+
+	NodePtr parseIdentifier()
+	{
+		const int start = m_pos;
+		while(m_pos < m_text.size() && (m_text[m_pos].isLetterOrNumber() || m_text[m_pos] == '_')) {
+			m_pos++;
+		}
+		const QString name = m_text.mid(start, m_pos - start);
+
+		if(accept('(')) {
+			return parseCall(name, start);
+		}
+
+		const int var = m_variables.indexOf(name);
+		if(var >= 0) {
+			NodePtr n(new Node());
+			n->kind = Node::VARIABLE;
+			n->var = var;
+			return n;
+		}
+		if(name == "pi") {
+			return makeNumber(M_PI);
+		}
+		if(name == "e") {
+			return makeNumber(M_E);
+		}
+
+		m_pos = start;
+		return fail(QString("Unknown variable '%1'").arg(name));
+	}
+
+	NodePtr parseCall(const QString &name, int start)
+	{
+		if(!functions().contains(name)) {
+			m_pos = start;
+			return fail(QString("Unknown function '%1'").arg(name));
+		}
+		const Function f = functions().value(name);
+
+		NodePtr n(new Node());
+		n->kind = Node::CALL;
+		n->op = f.op;
+		if(!accept(')')) {
+			do {
+				NodePtr arg = parseExpr();
+				if(!arg) {
+					return nullptr;
+				}
+				n->args.push_back(std::move(arg));
+			} while(accept(','));
+
+			if(!accept(')')) {
+				return fail("Expected ')'");
+			}
+		}
+
+		if((int)n->args.size() != f.arity) {
+			m_pos = start;
+			return fail(QString("%1() takes %2 argument(s)").arg(name).arg(f.arity));
+		}
+
+		if(f.op == ME::OP_AVG) {
+			// the window is part of the plan, not a signal
+			const Node *window = n->args[1].get();
+			if(window->kind != Node::NUMBER || window->value < 1 || window->value != std::floor(window->value)) {
+				m_pos = start;
+				return fail("The avg() window must be a positive integer constant");
+			}
+			n->value = window->value;
+			n->args.pop_back();
+		}
+		return n;
+	}
+
+	QString m_text;
+	int m_pos;
+	QStringList m_variables;
+	QString m_error;
+};
+
+// folds constant subexpressions and replaces powers by cheaper operations
+NodePtr simplify(NodePtr n)
+{
+	if(n->kind != Node::CALL) {
+		return n;
+	}
+
+	bool constant = true;
+	for(NodePtr &arg : n->args) {
+		arg = simplify(std::move(arg));
+		constant &= (arg->kind == Node::NUMBER);
+	}
+
+	if(constant) {
+		if(n->op == ME::OP_DIFF) {
+			return makeNumber(0);
+		}
+		if(n->op == ME::OP_AVG) {
+			return std::move(n->args[0]);
+		}
+		const double a = n->args[0]->value;
+		const double b = (n->args.size() > 1) ? n->args[1]->value : 0;
+		return makeNumber(apply<double>(n->op, a, b));
+	}
+
+	if(n->op == ME::OP_POW && n->args[1]->kind == Node::NUMBER) {
+		const double exponent = n->args[1]->value;
+		if(exponent == 1) {
+			return std::move(n->args[0]);
+		}
+		if(exponent == 2 || exponent == 0.5) {
+			return makeCall(exponent == 2 ? ME::OP_SQUARE : ME::OP_SQRT, std::move(n->args[0]));
+		}
+	}
+
+	return n;
+}
+
+class Codegen
+{
+public:
+	Codegen(std::vector<ME::Instruction> &plan, std::vector<int> &used)
+		: m_plan(plan)
+		, m_used(used)
+		, m_registers(0)
+	{}
+
+	void generate(const Node *root)
+	{
+		ME::Operand result = emit(root);
+		if(result.kind == ME::OPERAND_REGISTER) {
+			// the root is always the last instruction emitted, let it write the output directly
+			m_plan.back().dst = -1;
+		} else {
+			m_plan.push_back({ME::OP_COPY, -1, result, scalar(0), 0});
+		}
+	}
+
+	int registers() const { return m_registers; }
+
+private:
+	static ME::Operand scalar(float value) { return {ME::OPERAND_SCALAR, -1, value}; }
+
+	ME::Operand emit(const Node *n)
+	{
+		if(n->kind == Node::NUMBER) {
+			return scalar(n->value);
+		}
+		if(n->kind == Node::VARIABLE) {
+			if(std::find(m_used.begin(), m_used.end(), n->var) == m_used.end()) {
+				m_used.push_back(n->var);
+			}
+			return {ME::OPERAND_INPUT, n->var, 0};
+		}
+
+		ME::Operand a = emit(n->args[0].get());
+		ME::Operand b = (n->args.size() > 1) ? emit(n->args[1].get()) : scalar(0);
+		release(a);
+		release(b);
+
+		// elementwise operations may write over one of their operands
+		const int dst = allocate();
+		m_plan.push_back({n->op, dst, a, b, (int)n->value});
+		return {ME::OPERAND_REGISTER, dst, 0};
+	}
+
+	int allocate()
+	{
+		if(!m_free.empty()) {
+			const int r = m_free.back();
+			m_free.pop_back();
+			return r;
+		}
+		return m_registers++;
+	}
+
+	void release(const ME::Operand &op)
+	{
+		if(op.kind == ME::OPERAND_REGISTER) {
+			m_free.push_back(op.index);
+		}
+	}
+
+	std::vector<ME::Instruction> &m_plan;
+	std::vector<int> &m_used;
+	std::vector<int> m_free;
+	int m_registers;
+};
+
+template <typename F>
+inline void unary(float *dst, const float *a, size_t n, F f)
+{
+	for(size_t i = 0; i < n; i++) {
+		dst[i] = f(a[i]);
+	}
+}
+
+template <typename F>
+inline void binary(float *dst, const ME::Operand &opA, const float *a, const ME::Operand &opB, const float *b,
+		   size_t n, F f)
+{
+	if(opA.kind == ME::OPERAND_SCALAR) {
+		const float va = opA.value;
+		for(size_t i = 0; i < n; i++) {
+			dst[i] = f(va, b[i]);
+		}
+	} else if(opB.kind == ME::OPERAND_SCALAR) {
+		const float vb = opB.value;
+		for(size_t i = 0; i < n; i++) {
+			dst[i] = f(a[i], vb);
+		}
+	} else {
+		for(size_t i = 0; i < n; i++) {
+			dst[i] = f(a[i], b[i]);
+		}
+	}
+}
+
+} // namespace
+
+MathExpression::MathExpression()
+	: m_valid(false)
+{}
+
+MathExpression::~MathExpression() {}
+
+bool MathExpression::compile(const QString &expression, const QStringList &variables)
+{
+	m_expression = expression;
+	m_variables = variables;
+	m_error.clear();
+	m_plan.clear();
+	m_used.clear();
+	m_registers.clear();
+	m_state.clear();
+	m_valid = false;
+
+	NodePtr root = Parser(expression, variables).parse(m_error);
+	if(!root) {
+		qDebug(CAT_MATHEXPRESSION) << "Can't compile" << expression << ":" << m_error;
+		return false;
+	}
+
+	Codegen codegen(m_plan, m_used);
+	codegen.generate(simplify(std::move(root)).get());
+
+	m_registers.resize(codegen.registers(), std::vector<float>(BLOCK_SIZE));
+	m_state.resize(m_plan.size());
+	for(size_t i = 0; i < m_plan.size(); i++) {
+		if(m_plan[i].op == OP_AVG) {
+			m_state[i].history.resize(m_plan[i].window);
+		}
+	}
+
+	m_valid = true;
+	return true;
+}
+
+bool MathExpression::isValid() const { return m_valid; }
+
+QString MathExpression::expression() const { return m_expression; }
+
+QString MathExpression::errorString() const { return m_error; }
+
+QStringList MathExpression::variables() const { return m_variables; }
+
+const std::vector<int> &MathExpression::usedVariables() const { return m_used; }
+
+int MathExpression::instructionCount() const { return m_plan.size(); }
+
+bool MathExpression::evaluate(const std::vector<const float *> &inputs, size_t size, float *out)
+{
+	if(!m_valid) {
+		return false;
+	}
+	for(int idx : m_used) {
+		if(idx >= (int)inputs.size() || !inputs[idx]) {
+			return false;
+		}
+	}
+
+	for(State &s : m_state) {
+		s.last = 0;
+		s.pos = 0;
+		s.filled = 0;
+		s.sum = 0;
+	}
+
+	for(size_t offset = 0; offset < size; offset += BLOCK_SIZE) {
+		const size_t n = std::min(BLOCK_SIZE, size - offset);
+
+		auto resolve = [&](const Operand &op) -> const float * {
+			switch(op.kind) {
+			case OPERAND_REGISTER:
+				return m_registers[op.index].data();
+			case OPERAND_INPUT:
+				return inputs[op.index] + offset;
+			default:
+				return nullptr;
+			}
+		};
+
+		for(size_t i = 0; i < m_plan.size(); i++) {
+			const Instruction &ins = m_plan[i];
+			float *dst = (ins.dst < 0) ? out + offset : m_registers[ins.dst].data();
+			const float *a = resolve(ins.a);
+			const float *b = resolve(ins.b);
+
+			switch(ins.op) {
+			case OP_COPY:
+				if(ins.a.kind == OPERAND_SCALAR) {
+					std::fill(dst, dst + n, ins.a.value);
+				} else {
+					std::copy(a, a + n, dst);
+				}
+				break;
+			case OP_NEG:
+				unary(dst, a, n, [](float x) { return -x; });
+				break;
+			case OP_SQUARE:
+				unary(dst, a, n, [](float x) { return x * x; });
+				break;
+			case OP_SQRT:
+				unary(dst, a, n, [](float x) { return std::sqrt(x); });
+				break;
+			case OP_ABS:
+				unary(dst, a, n, [](float x) { return std::abs(x); });
+				break;
+			case OP_SIN:
+				unary(dst, a, n, [](float x) { return std::sin(x); });
+				break;
+			case OP_COS:
+				unary(dst, a, n, [](float x) { return std::cos(x); });
+				break;
+			case OP_TAN:
+				unary(dst, a, n, [](float x) { return std::tan(x); });
+				break;
+			case OP_EXP:
+				unary(dst, a, n, [](float x) { return std::exp(x); });
+				break;
+			case OP_LOG:
+				unary(dst, a, n, [](float x) { return std::log(x); });
+				break;
+			case OP_LOG10:
+				unary(dst, a, n, [](float x) { return std::log10(x); });
+				break;
+			case OP_ATAN:
+				unary(dst, a, n, [](float x) { return std::atan(x); });
+				break;
+			case OP_DIFF: {
+				State &s = m_state[i];
+				for(size_t k = 0; k < n; k++) {
+					const float x = a[k];
+					dst[k] = (s.filled ? x - s.last : 0);
+					s.last = x;
+					s.filled = 1;
+				}
+				break;
+			}
+			case OP_AVG: {
+				// until the window fills up, the average of the samples seen so far
+				State &s = m_state[i];
+				const size_t window = s.history.size();
+				for(size_t k = 0; k < n; k++) {
+					const float x = a[k];
+					if(s.filled == window) {
+						s.sum -= s.history[s.pos];
+					} else {
+						s.filled++;
+					}
+					s.history[s.pos] = x;
+					s.sum += x;
+					s.pos = (s.pos + 1 == window) ? 0 : s.pos + 1;
+					dst[k] = s.sum / s.filled;
+				}
+				break;
+			}
+			case OP_ADD:
+				binary(dst, ins.a, a, ins.b, b, n, [](float x, float y) { return x + y; });
+				break;
+			case OP_SUB:
+				binary(dst, ins.a, a, ins.b, b, n, [](float x, float y) { return x - y; });
+				break;
+			case OP_MUL:
+				binary(dst, ins.a, a, ins.b, b, n, [](float x, float y) { return x * y; });
+				break;
+			case OP_DIV:
+				binary(dst, ins.a, a, ins.b, b, n, [](float x, float y) { return x / y; });
+				break;
+			case OP_POW:
+				binary(dst, ins.a, a, ins.b, b, n, [](float x, float y) { return std::pow(x, y); });
+				break;
+			case OP_MIN:
+				binary(dst, ins.a, a, ins.b, b, n, [](float x, float y) { return std::min(x, y); });
+				break;
+			case OP_MAX:
+				binary(dst, ins.a, a, ins.b, b, n, [](float x, float y) { return std::max(x, y); });
+				break;
+			case OP_ATAN2:
+				binary(dst, ins.a, a, ins.b, b, n, [](float x, float y) { return std::atan2(x, y); });
+				break;
+			}
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "scriptcapture.h"
+
+#include <algorithm>
+
+using namespace scopy::adc;
+
+static const QByteArray emptyBuffer;
+
+ScriptCapture::ScriptCapture(QStringList channels, int buffers, QStringList variables)
+	: m_channels(channels)
+	, m_variables(variables)
+	, m_buffers(std::max(buffers, 1))
+	, m_captured(0)
+	, m_size(0)
+	, m_nextTime(0)
+	, m_samples(channels.size())
+{
+	for(int i = m_variables.size(); i < m_channels.size(); i++) {
+		m_variables.append("ch" + QString::number(i));
+	}
+}
+
+ScriptCapture::~ScriptCapture() {}
+
+void ScriptCapture::append(const float *xData, const std::vector<const float *> &inputs, size_t size)
+{
+	if(done() || size == 0) {
+		return;
+	}
+
+	const int bytes = size * sizeof(float);
+	for(int i = 0; i < m_channels.size(); i++) {
+		const float *data = (i < (int)inputs.size()) ? inputs[i] : nullptr;
+		if(data) {
+			m_samples[i].append(reinterpret_cast<const char *>(data), bytes);
+		} else {
+			// keep the channels aligned with the time axis
+			m_samples[i].append(bytes, '\0');
+		}
+	}
+
+	const float offset = (m_captured == 0 || !xData) ? 0 : m_nextTime - xData[0];
+	const int timeOffset = m_time.size();
+	m_time.resize(timeOffset + bytes);
+	float *t = reinterpret_cast<float *>(m_time.data() + timeOffset);
+	for(size_t i = 0; i < size; i++) {
+		t[i] = xData ? xData[i] + offset : m_size + i;
+	}
+	const float dt = (size > 1) ? t[1] - t[0] : 0;
+	m_nextTime = t[size - 1] + dt;
+
+	m_size += size;
+	m_captured++;
+}
+
+bool ScriptCapture::done() const { return m_captured >= m_buffers; }
+
+int ScriptCapture::buffers() const { return m_captured; }
+
+qint64 ScriptCapture::size() const { return m_size; }
+
+const QStringList &ScriptCapture::channels() const { return m_channels; }
+
+int ScriptCapture::indexOf(const QString &channel) const
+{
+	int idx = m_channels.indexOf(channel);
+	if(idx == -1) {
+		// the variable names math channels use
+		idx = m_variables.indexOf(channel);
+		if(idx >= m_channels.size()) {
+			idx = -1;
+		}
+	}
+	return idx;
+}
+
+const QByteArray &ScriptCapture::samples(int channel) const
+{
+	if(channel < 0 || channel >= (int)m_samples.size()) {
+		return emptyBuffer;
+	}
+	return m_samples[channel];
+}
+
+QByteArray ScriptCapture::samplesDouble(int channel) const { return toDouble(samples(channel)); }
+
+const QByteArray &ScriptCapture::time() const { return m_time; }
+
+QByteArray ScriptCapture::toDouble(const QByteArray &samples)
+{
+	const int count = samples.size() / sizeof(float);
+	const float *src = reinterpret_cast<const float *>(samples.constData());
+	QByteArray out(count * sizeof(double), Qt::Uninitialized);
+	double *dst = reinterpret_cast<double *>(out.data());
+	for(int i = 0; i < count; i++) {
+		dst[i] = src[i];
+	}
+	return out;
+}
@@ -40,6 +40,7 @@ GRTimeSinkComponent::GRTimeSinkComponent(QString name, GRTopBlockNode *t, QObjec
 	m_singleShot = false;
 	m_syncMode = false;
 	m_armed = false;
+	m_newData = false;
 	init();
 	m_sync->addInstrument(this);
 }
@@ -95,6 +96,9 @@ size_t GRTimeSinkComponent::updateData()
 	if(!time_sink)
 		return false;
 	uint64_t new_samples = time_sink->updateData();
+	if(new_samples) {
+		m_newData = true;
+	}
 	return new_samples;
 }
 
@@ -115,6 +119,31 @@ void GRTimeSinkComponent::setData(bool copy)
 
 		gr->onNewData(xdata, ydata, size, copy);
 	}
+
+	const bool newData = m_newData.exchange(false);
+	if(m_derivedChannels.isEmpty() || !(newData || copy)) {
+		return;
+	}
+
+	size_t size = 0;
+	m_inputs.assign(m_channels.size() + 1, nullptr);
+	for(int i = 0; i < m_channels.size(); i++) {
+		int index = time_channel_map.value(m_channels[i]->sigpath()->name(), -1);
+		if(index == -1)
+			continue;
+		m_inputs[i] = time_sink->data()[index].data();
+		size = time_sink->data()[index].size();
+	}
+
+	if(size == 0) {
+		return;
+	}
+
+	const float *xdata = time_sink->time().data();
+	m_inputs.back() = xdata;
+	for(DerivedChannel *d : qAsConst(m_derivedChannels)) {
+		d->onNewInputs(xdata, m_inputs, size, copy);
+	}
 }
 
 void GRTimeSinkComponent::setSingleShot(bool b)
@@ -207,9 +236,45 @@ void GRTimeSinkComponent::setSyncMode(bool b) { m_syncMode = b; }
 
 void GRTimeSinkComponent::setSyncController(SyncController *s) { m_sync = s; }
 
-void GRTimeSinkComponent::addChannel(GRChannel *ch) { m_channels.append(ch); }
+void GRTimeSinkComponent::addChannel(GRChannel *ch)
+{
+	const QString key = ch->sigpath()->name();
+	if(!m_variableIds.contains(key)) {
+		m_variableIds.insert(key, m_variableIds.size());
+	}
+	m_channels.append(ch);
+	Q_EMIT channelsChanged();
+}
+
+void GRTimeSinkComponent::removeChannel(GRChannel *ch)
+{
+	m_channels.removeAll(ch);
+	Q_EMIT channelsChanged();
+}
+
+void GRTimeSinkComponent::addDerivedChannel(DerivedChannel *ch) { m_derivedChannels.append(ch); }
+
+void GRTimeSinkComponent::removeDerivedChannel(DerivedChannel *ch) { m_derivedChannels.removeAll(ch); }
+
+QStringList GRTimeSinkComponent::variables() const
+{
+	QStringList vars;
+	for(GRChannel *gr : qAsConst(m_channels)) {
+		vars.append("ch" + QString::number(m_variableIds.value(gr->sigpath()->name())));
+	}
+	vars.append("t");
+	return vars;
+}
 
-void GRTimeSinkComponent::removeChannel(GRChannel *ch) { m_channels.removeAll(ch); }
+QStringList GRTimeSinkComponent::channelNames() const
+{
+	QStringList names;
+	for(GRChannel *gr : qAsConst(m_channels)) {
+		ChannelComponent *c = dynamic_cast<ChannelComponent *>(gr);
+		names.append(c ? c->name() : gr->sigpath()->name());
+	}
+	return names;
+}
 
 void GRTimeSinkComponent::setSyncSingleShot(bool b) { Q_EMIT requestSingleShot(b); }
 
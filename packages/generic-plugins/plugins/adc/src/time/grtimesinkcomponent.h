@@ -23,6 +23,7 @@
 #define GRTIMESINKCOMPONENT_H
 
 #include <QObject>
+#include <atomic>
 #include "adcinterfaces.h"
 #include <gui/toolcomponent.h>
 #include <gui/channelcomponent.h>
@@ -69,6 +70,13 @@ public Q_SLOTS:
 	void addChannel(GRChannel *ch);
 	void removeChannel(GRChannel *c);
 
+	// derived channels get the acquired channels in their order, then t, the time. variables() names these
+	// inputs: a channel is chK from the first time it is added, removing another channel does not renumber it
+	void addDerivedChannel(DerivedChannel *ch);
+	void removeDerivedChannel(DerivedChannel *ch);
+	QStringList variables() const;
+	QStringList channelNames() const;
+
 	void setSyncSingleShot(bool) override;
 	void setSyncBufferSize(uint32_t) override;
 
@@ -85,6 +93,9 @@ Q_SIGNALS:
 	void requestSingleShot(bool);
 	void requestBufferSize(uint32_t);
 
+	// a channel was added or removed, variables() and channelNames() changed
+	void channelsChanged();
+
 private:
 	std::mutex refillMutex;
 	time_sink_f::sptr time_sink;
@@ -101,6 +112,13 @@ private:
 	SyncController *m_sync;
 
 	QList<GRChannel *> m_channels;
+	QList<DerivedChannel *> m_derivedChannels;
+	// math variable of each channel, by signal path name. Kept when the channel is removed, so a variable
+	// always names the same channel
+	QMap<QString, int> m_variableIds;
+	std::vector<const float *> m_inputs;
+	// set by the refill thread, derived channels only see buffers that were not dispatched yet
+	std::atomic<bool> m_newData;
 	QString m_name;
 
 	// SampleRateProvider interface
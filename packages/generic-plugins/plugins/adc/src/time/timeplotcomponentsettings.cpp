@@ -29,6 +29,7 @@
 #include <style.h>
 #include <pluginbase/preferences.h>
 #include <filemanager.h>
+#include <QFileDialog>
 
 using namespace scopy;
 using namespace scopy::adc;
@@ -151,6 +152,28 @@ TimePlotComponentSettings::TimePlotComponentSettings(TimePlotComponent *plt, QWi
 		FileManagerHelper::saveDataToFile(this, csvData, tr("Export Plot Data"));
 	});
 
+	QPushButton *importBtn = new QPushButton("Import capture");
+	StyleHelper::BasicButton(importBtn);
+	connect(importBtn, &QPushButton::clicked, this, [=]() {
+		bool useNativeDialogs = Preferences::get("general_use_native_dialogs").toBool();
+		QString path = QFileDialog::getOpenFileName(
+			this, tr("Import capture"), "", tr("SigMF binary captures (*.sigmf-data *.sigmf-meta)"), nullptr,
+			(useNativeDialogs ? QFileDialog::Options() : QFileDialog::DontUseNativeDialog));
+		if(!path.isEmpty()) {
+			Q_EMIT requestImport(path);
+		}
+	});
+
+	QLineEdit *mathExpr = new QLineEdit(this);
+	mathExpr->setPlaceholderText("e.g. sqrt(ch0^2 + ch1^2)");
+	QPushButton *mathBtn = new QPushButton("Add math channel");
+	StyleHelper::BasicButton(mathBtn);
+	connect(mathBtn, &QPushButton::clicked, this, [=]() {
+		if(!mathExpr->text().trimmed().isEmpty()) {
+			Q_EMIT requestMathChannel(mathExpr->text().trimmed());
+		}
+	});
+
 	yaxis->contentLayout()->setSpacing(2);
 	yaxis->contentLayout()->addWidget(m_autoscaleBtn);
 	yaxis->contentLayout()->addWidget(m_yCtrl);
@@ -161,6 +184,9 @@ TimePlotComponentSettings::TimePlotComponentSettings(TimePlotComponent *plt, QWi
 	plotMenu->contentLayout()->addWidget(labelsSwitch);
 	plotMenu->contentLayout()->addWidget(legendSwitch);
 	plotMenu->contentLayout()->addWidget(exportBtn);
+	plotMenu->contentLayout()->addWidget(importBtn);
+	plotMenu->contentLayout()->addWidget(mathExpr);
+	plotMenu->contentLayout()->addWidget(mathBtn);
 	plotMenu->contentLayout()->setSpacing(10);
 
 	xySection->add(m_xAxisSrc);
@@ -53,6 +53,8 @@ public Q_SLOTS:
 Q_SIGNALS:
 	void requestDeletePlot();
 	void requestSettings();
+	void requestImport(QString path);
+	void requestMathChannel(QString expression);
 
 private:
 	PlotAutoscaler *m_autoscaler;
@@ -400,6 +400,10 @@ void TimePlotManagerSettings::addPlot(TimePlotComponent *p)
 		m_menu->scrollTo(m_plotCb);
 		Q_EMIT requestOpenMenu();
 	});
+	connect(p->plotMenu(), &TimePlotComponentSettings::requestImport, this,
+		[=](QString path) { Q_EMIT requestImport(p, path); });
+	connect(p->plotMenu(), &TimePlotComponentSettings::requestMathChannel, this,
+		[=](QString expression) { Q_EMIT requestMathChannel(p, expression); });
 
 	updateXMode(m_xModeCb->combo()->currentIndex(), p->timePlot()->xAxis());
 }
@@ -101,6 +101,8 @@ Q_SIGNALS:
 	void syncBufferPlotSizeChanged(bool);
 	void samplingInfoChanged(SamplingInfo);
 	void requestOpenMenu();
+	void requestImport(TimePlotComponent *plot, QString path);
+	void requestMathChannel(TimePlotComponent *plot, QString expression);
 
 private:
 	TimePlotManager *m_plotManager;
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QTest>
+
+#include <adc/mathexpression.h>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace scopy::adc;
+
+class TST_MathExpression : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void evaluate_data();
+	void evaluate();
+	void errors_data();
+	void errors();
+	void diffAvg();
+	void throughput_data();
+	void throughput();
+};
+
+typedef std::function<float(float, float, float)> Reference;
+Q_DECLARE_METATYPE(Reference)
+
+static const QStringList VARIABLES = {"ch0", "ch1", "t"};
+
+static std::vector<float> uniform(size_t size, float lo, float hi, unsigned seed)
+{
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<float> dist(lo, hi);
+	std::vector<float> v(size);
+	for(float &x : v) {
+		x = dist(gen);
+	}
+	return v;
+}
+
+void TST_MathExpression::evaluate_data()
+{
+	QTest::addColumn<QString>("expression");
+	QTest::addColumn<Reference>("reference");
+
+	QTest::newRow("product") << "ch0*ch1" << Reference([](float a, float b, float) { return a * b; });
+	QTest::newRow("magnitude") << "sqrt(ch0^2 + ch1^2)"
+				   << Reference([](float a, float b, float) { return std::sqrt(a * a + b * b); });
+	QTest::newRow("precedence") << "1 + 2*ch0 - ch1/4"
+				    << Reference([](float a, float b, float) { return 1 + 2 * a - b / 4; });
+	QTest::newRow("unary") << "-ch0^2" << Reference([](float a, float, float) { return -(a * a); });
+	QTest::newRow("scalar fold") << "ch0 * (2*pi)"
+				     << Reference([](float a, float, float) { return a * float(2 * M_PI); });
+	QTest::newRow("functions") << "atan2(ch1, ch0) + abs(sin(ch0)) - min(ch0, ch1) + max(ch0, 0.5)"
+				   << Reference([](float a, float b, float) {
+					      return std::atan2(b, a) + std::abs(std::sin(a)) - std::min(a, b) +
+						      std::max(a, 0.5f);
+				      });
+	QTest::newRow("log") << "log10(abs(ch0) + 1) + log(exp(ch1))"
+			     << Reference([](float a, float b, float) { return std::log10(std::abs(a) + 1) + b; });
+	QTest::newRow("time") << "ch0 * cos(2*pi*1000*t)" << Reference([](float a, float, float t) {
+		return a * std::cos(float(2 * M_PI * 1000) * t);
+	});
+}
+
+void TST_MathExpression::evaluate()
+{
+	QFETCH(QString, expression);
+	QFETCH(Reference, reference);
+
+	// not a multiple of the block size, so the tail block is exercised as well
+	const size_t size = 3 * MathExpression::BLOCK_SIZE + 17;
+	std::vector<float> ch0 = uniform(size, -2, 2, 1);
+	std::vector<float> ch1 = uniform(size, -2, 2, 2);
+	std::vector<float> t(size);
+	for(size_t i = 0; i < size; i++) {
+		t[i] = i / 1e6f;
+	}
+
+	MathExpression expr;
+	QVERIFY2(expr.compile(expression, VARIABLES), qPrintable(expr.errorString()));
+
+	std::vector<float> out(size);
+	QVERIFY(expr.evaluate({ch0.data(), ch1.data(), t.data()}, size, out.data()));
+	for(size_t i = 0; i < size; i++) {
+		const float expected = reference(ch0[i], ch1[i], t[i]);
+		QVERIFY2(std::abs(out[i] - expected) <= 1e-4f * std::max(1.0f, std::abs(expected)),
+			 qPrintable(QString("sample %1: %2 != %3").arg(i).arg(out[i]).arg(expected)));
+	}
+}
+
+void TST_MathExpression::errors_data()
+{
+	QTest::addColumn<QString>("expression");
+
+	QTest::newRow("empty") << "";
+	QTest::newRow("unknown variable") << "ch7 + 1";
+	QTest::newRow("unknown function") << "foo(ch0)";
+	QTest::newRow("arity") << "atan2(ch0)";
+	QTest::newRow("unbalanced") << "(ch0 + ch1";
+	QTest::newRow("trailing") << "ch0 ch1";
+	QTest::newRow("avg window") << "avg(ch0, ch1)";
+}
+
+void TST_MathExpression::errors()
+{
+	QFETCH(QString, expression);
+
+	MathExpression expr;
+	QVERIFY(!expr.compile(expression, VARIABLES));
+	QVERIFY(!expr.isValid());
+	QVERIFY(!expr.errorString().isEmpty());
+
+	float out;
+	QVERIFY(!expr.evaluate({}, 1, &out));
+}
+
+void TST_MathExpression::diffAvg()
+{
+	// the running state must carry over block boundaries
+	const size_t size = 2 * MathExpression::BLOCK_SIZE + 5;
+	std::vector<float> ch0 = uniform(size, -1, 1, 3);
+	std::vector<float> out(size);
+
+	MathExpression diff;
+	QVERIFY(diff.compile("diff(ch0)", VARIABLES));
+	QCOMPARE(diff.usedVariables(), std::vector<int>({0}));
+	QVERIFY(diff.evaluate({ch0.data(), nullptr, nullptr}, size, out.data()));
+	QCOMPARE(out[0], 0.0f);
+	for(size_t i = 1; i < size; i++) {
+		QCOMPARE(out[i], ch0[i] - ch0[i - 1]);
+	}
+
+	const int window = 16;
+	MathExpression avg;
+	QVERIFY(avg.compile("avg(ch0, 16)", VARIABLES));
+	QVERIFY(avg.evaluate({ch0.data(), nullptr, nullptr}, size, out.data()));
+	for(size_t i = 0; i < size; i++) {
+		const size_t first = (i + 1 >= window) ? i + 1 - window : 0;
+		double sum = 0;
+		for(size_t k = first; k <= i; k++) {
+			sum += ch0[k];
+		}
+		QVERIFY(std::abs(out[i] - sum / (i + 1 - first)) < 1e-5);
+	}
+
+	// a second evaluation starts over, it does not continue the previous buffer
+	std::vector<float> again(size);
+	QVERIFY(avg.evaluate({ch0.data(), nullptr, nullptr}, size, again.data()));
+	QCOMPARE(again, out);
+}
+
+void TST_MathExpression::throughput_data()
+{
+	QTest::addColumn<QString>("expression");
+
+	QTest::newRow("ch0*ch1") << "ch0*ch1";
+	QTest::newRow("magnitude") << "sqrt(ch0^2 + ch1^2)";
+	QTest::newRow("scale offset") << "2.5*ch0 + 0.1";
+	QTest::newRow("avg") << "avg(ch0, 64)";
+}
+
+void TST_MathExpression::throughput()
+{
+	QFETCH(QString, expression);
+
+	const size_t size = 1 << 20;
+	std::vector<float> ch0 = uniform(size, -1, 1, 4);
+	std::vector<float> ch1 = uniform(size, -1, 1, 5);
+	std::vector<float> out(size);
+
+	MathExpression expr;
+	QVERIFY(expr.compile(expression, VARIABLES));
+
+	QBENCHMARK { expr.evaluate({ch0.data(), ch1.data(), nullptr}, size, out.data()); }
+}
+
+QTEST_MAIN(TST_MathExpression)
+
+#include "tst_mathexpression.moc"
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QJSEngine>
+#include <QTest>
+#include <adc/scriptcapture.h>
+#include <vector>
+
+using namespace scopy::adc;
+
+class TST_ScriptCapture : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void capture();
+	void channelLookup();
+	void typedArray();
+	void typedArrayThroughput();
+	void variantListThroughput();
+
+private:
+	void fill(ScriptCapture &capture, int buffers, int size);
+};
+
+void TST_ScriptCapture::fill(ScriptCapture &capture, int buffers, int size)
+{
+	std::vector<float> x(size);
+	std::vector<float> ch0(size);
+	for(int b = 0; b < buffers; b++) {
+		for(int i = 0; i < size; i++) {
+			x[i] = i * 0.5f;
+			ch0[i] = b * size + i;
+		}
+		capture.append(x.data(), {ch0.data(), nullptr, x.data()}, size);
+	}
+}
+
+void TST_ScriptCapture::capture()
+{
+	ScriptCapture capture({"voltage0", "voltage1"}, 3);
+	fill(capture, 2, 4);
+	QVERIFY(!capture.done());
+	fill(capture, 2, 4);
+
+	// buffers past the requested count are dropped
+	QVERIFY(capture.done());
+	QCOMPARE(capture.buffers(), 3);
+	QCOMPARE(capture.size(), qint64(12));
+
+	const float *ch0 = reinterpret_cast<const float *>(capture.samples(0).constData());
+	const float *ch1 = reinterpret_cast<const float *>(capture.samples(1).constData());
+	const float *t = reinterpret_cast<const float *>(capture.time().constData());
+	QCOMPARE(capture.samples(0).size(), 12 * (int)sizeof(float));
+	for(int i = 0; i < 12; i++) {
+		QCOMPARE(ch0[i], (float)(i % 8));
+		// a missing channel is zero filled and the time axis does not restart with every buffer
+		QCOMPARE(ch1[i], 0.0f);
+		QCOMPARE(t[i], i * 0.5f);
+	}
+
+	const double *ch0d = reinterpret_cast<const double *>(capture.samplesDouble(0).constData());
+	QCOMPARE(capture.samplesDouble(0).size(), 12 * (int)sizeof(double));
+	QCOMPARE(ch0d[5], 5.0);
+}
+
+void TST_ScriptCapture::channelLookup()
+{
+	ScriptCapture capture({"voltage0", "voltage1"}, 1);
+	QCOMPARE(capture.indexOf("voltage1"), 1);
+	QCOMPARE(capture.indexOf("ch0"), 0);
+	QCOMPARE(capture.indexOf("ch2"), -1);
+	QCOMPARE(capture.indexOf("ch-1"), -1);
+	QCOMPARE(capture.indexOf("current0"), -1);
+	QVERIFY(capture.samples(-1).isEmpty());
+
+	// voltage1 was removed from the sink, voltage2 keeps its variable
+	ScriptCapture bound({"voltage0", "voltage2"}, 1, {"ch0", "ch2", "t"});
+	QCOMPARE(bound.indexOf("ch2"), 1);
+	QCOMPARE(bound.indexOf("ch1"), -1);
+	QCOMPARE(bound.indexOf("t"), -1);
+}
+
+void TST_ScriptCapture::typedArray()
+{
+	ScriptCapture capture({"voltage0"}, 2);
+	fill(capture, 2, 1024);
+
+	QJSEngine engine;
+	engine.globalObject().setProperty("buf", engine.toScriptValue(capture.samples(0)));
+	QJSValue ret = engine.evaluate("var a = new Float32Array(buf); [a.length, a[0], a[1500], a[2047]]");
+	QVERIFY(!ret.isError());
+	QCOMPARE(ret.property(0).toInt(), 2048);
+	QCOMPARE(ret.property(1).toNumber(), 0.0);
+	QCOMPARE(ret.property(2).toNumber(), 1500.0);
+	QCOMPARE(ret.property(3).toNumber(), 2047.0);
+
+	// results come back the same way, as the buffer of a typed array
+	ret = engine.evaluate("var r = new Float32Array(a.length); for(var i = 0; i < a.length; i++) r[i] = 2 * a[i];"
+			      "r.buffer");
+	QByteArray result = ret.toVariant().toByteArray();
+	QCOMPARE(result.size(), 2048 * (int)sizeof(float));
+	QCOMPARE(reinterpret_cast<const float *>(result.constData())[1500], 3000.0f);
+}
+
+void TST_ScriptCapture::typedArrayThroughput()
+{
+	// 16 buffers of 64k samples - 1M samples handed to a script
+	ScriptCapture capture({"voltage0"}, 16);
+	fill(capture, 16, 1 << 16);
+	QCOMPARE(capture.size(), qint64(1 << 20));
+
+	QJSEngine engine;
+	QJSValue view = engine.evaluate("(function(buf) { return new Float32Array(buf).length; })");
+	QBENCHMARK { QCOMPARE(view.call({engine.toScriptValue(capture.samples(0))}).toInt(), 1 << 20); }
+}
+
+void TST_ScriptCapture::variantListThroughput()
+{
+	// reference - the per sample conversion scripts had before
+	ScriptCapture capture({"voltage0"}, 16);
+	fill(capture, 16, 1 << 16);
+
+	const float *samples = reinterpret_cast<const float *>(capture.samples(0).constData());
+	QJSEngine engine;
+	QJSValue length = engine.evaluate("(function(list) { return list.length; })");
+	QBENCHMARK
+	{
+		QVariantList list;
+		list.reserve(capture.size());
+		for(int i = 0; i < capture.size(); i++) {
+			list.append(samples[i]);
+		}
+		QCOMPARE(length.call({engine.toScriptValue(list)}).toInt(), 1 << 20);
+	}
+}
+
+QTEST_MAIN(TST_ScriptCapture)
+
+#include "tst_scriptcapture.moc"
@@ -24,11 +24,13 @@
 #include "databuffer.h"
 #include "dac_logging_categories.h"
 #include "csvfilestrategy.h"
+#include "sigmffilestrategy.h"
 #include "databufferstrategyinterface.h"
 #include "filedataguistrategy.h"
 #include "dataguistrategyinterface.h"
 #include <QFile>
 #include <QString>
+#include <sigmfcapture.h>
 
 using namespace scopy;
 using namespace scopy::dac;
@@ -106,6 +108,8 @@ DataBufferStrategyInterface *DataBufferBuilder::createDS()
 	case DS::FileStrategy:
 		if(m_filename.endsWith(".csv")) {
 			ds = new CSVFileStrategy(m_filename, m_widgetParent);
+		} else if(SigMFCapture::isSigMF(m_filename)) {
+			ds = new SigMFFileStrategy(m_filename, m_widgetParent);
 		} else {
 			qDebug(CAT_DAC_DATABUILDER) << "No compatible strategy found";
 		}
@@ -121,6 +125,14 @@ DataBufferStrategyInterface *DataBufferBuilder::createDS()
 			qDebug(CAT_DAC_DATABUILDER) << "Provide a valid file path for CSV Strategy";
 		}
 		break;
+	case DS::BinaryFileStrategy:
+		fileOk = checkFileValidity(m_filename, m_dataStrategy);
+		if(fileOk) {
+			ds = new SigMFFileStrategy(m_filename, m_widgetParent);
+		} else {
+			qDebug(CAT_DAC_DATABUILDER) << "Provide a valid SigMF capture for Binary Strategy";
+		}
+		break;
 	case DS::SinewaveData:
 	default:
 		qDebug(CAT_DAC_DATABUILDER) << "No valid arguments provided";
@@ -153,6 +165,8 @@ bool DataBufferBuilder::checkFileValidity(QString filepath, DataBufferBuilder::D
 			valid = filepath.endsWith(".csv");
 		} else if(ds == DS::MatlabFileStrategy) {
 			valid = filepath.endsWith(".mat");
+		} else if(ds == DS::BinaryFileStrategy) {
+			valid = SigMFCapture::isSigMF(filepath);
 		}
 	}
 	return valid;
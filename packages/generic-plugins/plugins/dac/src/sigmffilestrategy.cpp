@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "sigmffilestrategy.h"
+#include "dac_logging_categories.h"
+#include "dacutils.h"
+
+#include <QString>
+#include <QVector>
+#include <algorithm>
+
+using namespace scopy;
+using namespace scopy::dac;
+SigMFFileStrategy::SigMFFileStrategy(QString filename, QWidget *parent)
+	: QObject(parent)
+	, m_max(0.0)
+{
+	m_filename = filename;
+	m_recipe = {.scale = 0.0, .scaled = false};
+}
+
+QVector<QVector<double>> SigMFFileStrategy::data()
+{
+	qDebug(CAT_DAC_DATASTRATEGY) << "Retrieve data.";
+	return m_dataConverted;
+}
+
+void SigMFFileStrategy::recipeUpdated(DataBufferRecipe recipe)
+{
+	qDebug(CAT_DAC_DATASTRATEGY) << "Recipe update in SigMF file strategy.";
+	m_recipe = recipe;
+	applyConversion();
+}
+
+void SigMFFileStrategy::loadData()
+{
+	if(!m_capture.open(m_filename)) {
+		qDebug(CAT_DAC_DATASTRATEGY) << "Can't open selected capture";
+		Q_EMIT loadFailed();
+		return;
+	}
+
+	const qint64 nrOfSamples = m_capture.nrOfSamples();
+	const int nrOfChannels = m_capture.nrOfChannels();
+	m_max = 0.0;
+	for(qint64 i = 0; i < nrOfSamples; ++i) {
+		for(int j = 0; j < nrOfChannels; ++j) {
+			m_max = std::max(m_max, double(m_capture.sample(i, j)));
+		}
+	}
+	qDebug(CAT_DAC_DATASTRATEGY) << "Loaded" << nrOfSamples << "samples on" << nrOfChannels << "channels from"
+				     << m_filename;
+
+	applyConversion();
+	Q_EMIT loadFinished();
+}
+
+void SigMFFileStrategy::applyConversion()
+{
+	// the rows are the DataBufferStrategyInterface layout, they are filled once out of the mapping
+	const qint64 nrOfSamples = m_capture.nrOfSamples();
+	const int nrOfChannels = m_capture.nrOfChannels();
+	const double factor = scale();
+	m_dataConverted.resize(nrOfSamples);
+	for(qint64 i = 0; i < nrOfSamples; ++i) {
+		QVector<double> &row = m_dataConverted[i];
+		row.resize(nrOfChannels);
+		for(int j = 0; j < nrOfChannels; ++j) {
+			row[j] = m_capture.sample(i, j) * factor;
+		}
+	}
+	Q_EMIT dataUpdated();
+	qDebug(CAT_DAC_DATASTRATEGY) << "Apply conversion on all samples";
+}
+
+double SigMFFileStrategy::scale() const
+{
+	if(!m_recipe.scaled || m_max == 0.0) {
+		return 1.0;
+	}
+
+	double full_scale = DacUtils::dbFullScaleConvert(m_recipe.scale, false);
+	double max_target =
+		m_recipe.targetSigned ? ((1LL << (m_recipe.targetBits - 1)) - 1) : ((1LL << m_recipe.targetBits) - 1);
+	return max_target * full_scale / m_max;
+}
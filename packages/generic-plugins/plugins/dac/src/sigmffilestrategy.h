@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SIGMFFILESTRATEGY_H
+#define SIGMFFILESTRATEGY_H
+
+#include <QWidget>
+#include <sigmfcapture.h>
+#include "databufferstrategyinterface.h"
+#include "scopy-dac_export.h"
+#include "dac_logging_categories.h"
+namespace scopy {
+namespace dac {
+/*
+ * Loads binary SigMF captures (.sigmf-data + .sigmf-meta) such as the ones exported by the
+ * FileManager. The capture stays memory mapped, the converted buffer is built straight out of
+ * the mapping in a single pass and rebuilt from it when the recipe changes.
+ */
+class SCOPY_DAC_EXPORT SigMFFileStrategy : public QObject, public DataBufferStrategyInterface
+{
+	Q_OBJECT
+	Q_INTERFACES(scopy::dac::DataBufferStrategyInterface)
+public:
+	explicit SigMFFileStrategy(QString filename, QWidget *parent = nullptr);
+	~SigMFFileStrategy(){};
+	QVector<QVector<double>> data() override;
+
+public Q_SLOTS:
+	void recipeUpdated(DataBufferRecipe) override;
+	void loadData() override;
+
+Q_SIGNALS:
+	void loadFinished() override;
+	void loadFailed() override;
+	void dataUpdated() override;
+
+private:
+	double m_max;
+	QString m_filename;
+	SigMFCapture m_capture;
+	QVector<QVector<double>> m_dataConverted;
+	DataBufferRecipe m_recipe;
+	double scale() const;
+	void applyConversion();
+};
+} // namespace dac
+} // namespace scopy
+#endif // SIGMFFILESTRATEGY_H
@@ -22,6 +22,7 @@
 #include "monitorplotcurve.hpp"
 
 #include <datamonitorutils.hpp>
+#include <lodplotcurve.h>
 #include <plotaxis.h>
 
 using namespace scopy;
@@ -37,6 +38,13 @@ MonitorPlotCurve::MonitorPlotCurve(DataMonitorModel *dataMonitorModel, PlotWidge
 	plot->addPlotChannel(m_plotch);
 	m_plotch->setEnabled(true);
 
+	// the history is appended to until the storage limit is reached, extend the LOD pyramid instead of
+	// rebuilding it on every new value
+	LodPlotCurve *lodCurve = dynamic_cast<LodPlotCurve *>(m_plotch->curve());
+	if(lodCurve) {
+		lodCurve->setAppendOnly(true);
+	}
+
 	m_plotch->curve()->setRawSamples(m_dataMonitorModel->getXdata()->data(), m_dataMonitorModel->getYdata()->data(),
 					 m_dataMonitorModel->getYdata()->size());
 
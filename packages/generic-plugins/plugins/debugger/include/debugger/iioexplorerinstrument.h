@@ -27,6 +27,7 @@
 #include "detailsview.h"
 #include <gui/widgets/searchbar.h>
 #include "iiosortfilterproxymodel.h"
+#include "iiosearchindex.h"
 #include "watchlistview.h"
 #include "savecontextsetup.h"
 #include "iiodebuglogger.h"
@@ -37,6 +38,8 @@
 #include <QTreeView>
 #include <QSplitter>
 #include <QTabWidget>
+#include <QFutureWatcher>
+#include <atomic>
 
 namespace scopy::debugger {
 
@@ -66,8 +69,11 @@ private:
 	// Recursive function to find an item in the source model
 	IIOStandardItem *findItemRecursive(QStandardItem *currentItem, QStandardItem *targetItem);
 
-	// Recursively expand all items (and their parents) with the title matching the text param
-	void recursiveExpandItems(QStandardItem *item, const QString &text);
+	// Filters the tree down to the matches of a search and expands their parents
+	void applySearchResult(const IIOSearchIndex::Result &result);
+
+	// Blocks until the pending search, if any, is applied to the tree
+	void finishSearch();
 
 	// Expand the searchItem and all its parents
 	void recursiveExpandItem(QStandardItem *item, QStandardItem *searchItem);
@@ -98,6 +104,11 @@ private:
 	QCheckBox *m_sortChannelsBtn;
 	QCheckBox *m_sortAttributesBtn;
 	IIOSortFilterProxyModel *m_proxyModel;
+	IIOSearchIndex *m_searchIndex;
+	QFutureWatcher<IIOSearchIndex::Result> *m_searchWatcher;
+	// bumped by every search, a query still running for an older one cancels itself
+	std::atomic<int> m_searchGeneration;
+	int m_appliedSearchGeneration;
 	WatchListView *m_watchListView;
 	ApiObject *m_apiObject;
 	IIOStandardItem *m_currentlySelectedItem;
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCOPY_IIOSEARCHINDEX_H
+#define SCOPY_IIOSEARCHINDEX_H
+
+#include "scopy-debugger_export.h"
+
+#include <QHash>
+#include <QObject>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QStandardItemModel>
+#include <QVector>
+#include <functional>
+
+namespace scopy::debugger {
+
+/*
+ * Search index over the names shown in the IIO Explorer tree. Every item gets
+ * an entry with its lower case text and the entry of its parent, and every
+ * trigram of a name points to the entries containing it. A query intersects
+ * the trigrams of the search text instead of walking the whole tree, so it
+ * only compares strings against a few candidates.
+ *
+ * The index follows the model: inserted, removed and renamed rows are indexed
+ * incrementally. Queries are thread safe and can be cancelled, so they can run
+ * off the GUI thread while the model keeps changing on it.
+ */
+class SCOPY_DEBUGGER_EXPORT IIOSearchIndex : public QObject
+{
+	Q_OBJECT
+public:
+	typedef struct
+	{
+		QString query;
+		int generation;
+		bool canceled;
+		// items whose text contains the query
+		QSet<const QStandardItem *> matches;
+		// the matches and all their ancestors - the rows the tree has to show
+		QSet<const QStandardItem *> visible;
+		// the ancestors of the matches - the rows the tree has to expand
+		QSet<const QStandardItem *> expanded;
+	} Result;
+
+	explicit IIOSearchIndex(QStandardItemModel *model, QObject *parent = nullptr);
+	~IIOSearchIndex();
+
+	// canceled is polled while the query runs, returning true abandons it
+	Result query(const QString &text, std::function<bool()> canceled = nullptr) const;
+
+	int size() const;
+
+private Q_SLOTS:
+	void onRowsInserted(const QModelIndex &parent, int first, int last);
+	void onRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+	void onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+
+private:
+	typedef struct
+	{
+		const QStandardItem *item;
+		int parent;
+		QString text;
+	} Entry;
+
+	QStandardItem *itemFromIndex(const QModelIndex &index) const;
+	void addSubtree(QStandardItem *item, int parent);
+	void removeSubtree(QStandardItem *item);
+	void indexText(int id);
+	void unindexText(int id);
+	bool isCanceled(const std::function<bool()> &canceled, int step) const;
+	static quint64 trigram(const QString &text, int pos);
+
+	QStandardItemModel *m_model;
+	mutable QReadWriteLock m_lock;
+	QVector<Entry> m_entries;
+	QHash<const QStandardItem *, int> m_ids;
+	QHash<quint64, QVector<int>> m_trigrams;
+	int m_alive;
+};
+} // namespace scopy::debugger
+
+#endif // SCOPY_IIOSEARCHINDEX_H
@@ -24,7 +24,9 @@
 
 #include <QObject>
 #include <QModelIndex>
+#include <QSet>
 #include <QSortFilterProxyModel>
+#include <QStandardItem>
 
 namespace scopy::debugger {
 class IIOSortFilterProxyModel : public QSortFilterProxyModel
@@ -35,6 +37,11 @@ public:
 	void setSortChannels(bool enabled);
 	void setSortAttributes(bool enabled);
 
+	// Only the rows of these items are shown, usually an IIOSearchIndex result
+	void setVisibleItems(const QSet<const QStandardItem *> &items);
+	// Shows every row again
+	void clearVisibleItems();
+
 protected:
 	bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
 	bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
@@ -42,6 +49,8 @@ protected:
 private:
 	bool m_sortChannels = false;
 	bool m_sortAttributes = false;
+	bool m_filterActive = false;
+	QSet<const QStandardItem *> m_visibleItems;
 };
 } // namespace scopy::debugger
 
@@ -45,6 +45,8 @@ IIOExplorerInstrument::IIOExplorerInstrument(struct iio_context *context, QStrin
 	, m_context(context)
 	, m_uri(uri)
 	, m_currentlySelectedItem(nullptr)
+	, m_searchGeneration(0)
+	, m_appliedSearchGeneration(0)
 {
 	setObjectName("IIOExplorerInstrument - " + uri);
 	setupUi();
@@ -56,7 +58,13 @@ IIOExplorerInstrument::IIOExplorerInstrument(struct iio_context *context, QStrin
 	ScopyJS::GetInstance()->registerApi(m_apiObject);
 }
 
-IIOExplorerInstrument::~IIOExplorerInstrument() { ScopyJS::GetInstance()->unregisterApi(m_apiObject); }
+IIOExplorerInstrument::~IIOExplorerInstrument()
+{
+	// the running query reads the index, which is destroyed with this widget
+	++m_searchGeneration;
+	m_searchWatcher->waitForFinished();
+	ScopyJS::GetInstance()->unregisterApi(m_apiObject);
+}
 
 void IIOExplorerInstrument::saveSettings(QSettings &s)
 {
@@ -139,6 +147,9 @@ void IIOExplorerInstrument::setupUi()
 	m_proxyModel->setSortRole(Qt::DisplayRole);
 	m_proxyModel->sort(0); // sorting is gated by the proxy's channel flag, toggled from the UI
 
+	m_searchIndex = new IIOSearchIndex(m_iioModel->getModel(), this);
+	m_searchWatcher = new QFutureWatcher<IIOSearchIndex::Result>(this);
+
 	Style::setBackgroundColor(m_mainWidget, json::theme::background_subtle);
 	Style::setBackgroundColor(m_debugLogger, json::theme::background_subtle);
 	Style::setBackgroundColor(m_codeGenerator, json::theme::background_subtle);
@@ -188,7 +199,8 @@ void IIOExplorerInstrument::connectSignalsAndSlots()
 	QObject::connect(m_searchBar->getLineEdit(), &QLineEdit::textChanged, this, [this](QString text) {
 		if(text.isEmpty()) {
 			auto sourceModel = qobject_cast<QStandardItemModel *>(m_proxyModel->sourceModel());
-			m_proxyModel->setFilterRegExp(QRegExp("", Qt::CaseInsensitive, QRegExp::FixedString));
+			++m_searchGeneration; // drop the result of a search still running
+			m_proxyModel->clearVisibleItems();
 			m_proxyModel->invalidate(); // Trigger re-filtering
 			collapseAllItems(sourceModel->invisibleRootItem());
 			m_treeView->expand(m_proxyModel->index(0, 0));
@@ -197,6 +209,9 @@ void IIOExplorerInstrument::connectSignalsAndSlots()
 		}
 	});
 
+	QObject::connect(m_searchWatcher, &QFutureWatcher<IIOSearchIndex::Result>::finished, this,
+			 [this]() { applySearchResult(m_searchWatcher->result()); });
+
 	QObject::connect(m_sortChannelsBtn, &QCheckBox::toggled, this, [this](bool checked) {
 		m_proxyModel->setSortChannels(checked);
 		m_proxyModel->invalidate(); // Trigger re-filtering
@@ -315,33 +330,6 @@ IIOStandardItem *IIOExplorerInstrument::findItemRecursive(QStandardItem *current
 	return nullptr;
 }
 
-void IIOExplorerInstrument::recursiveExpandItems(QStandardItem *item, const QString &text)
-{
-	for(int row = 0; row < item->rowCount(); ++row) {
-		QStandardItem *childItem = item->child(row);
-
-		if(childItem == nullptr) {
-			qWarning(CAT_DEBUGGERIIOMODEL) << "Error, invalid row. Skipping item.";
-			continue;
-		}
-
-		// Check if the item's data contains the filter string
-		if(childItem->text().contains(text, Qt::CaseInsensitive)) {
-			QModelIndex proxyIndex = m_proxyModel->mapFromSource(childItem->index());
-
-			// Expand all parents from the root to the current element
-			QModelIndex parent = proxyIndex.parent();
-			while(parent.isValid()) {
-				m_treeView->expand(parent);
-				parent = parent.parent();
-			}
-		}
-
-		// Recursively process children
-		recursiveExpandItems(childItem, text);
-	}
-}
-
 void IIOExplorerInstrument::recursiveExpandItem(QStandardItem *item, QStandardItem *searchItem)
 {
 	for(int row = 0; row < item->rowCount(); ++row) {
@@ -469,23 +457,45 @@ void IIOExplorerInstrument::applySelection(const QItemSelection &selected, const
 
 void IIOExplorerInstrument::filterAndExpand(const QString &text)
 {
-	m_proxyModel->setFilterRegExp(QRegExp(text, Qt::CaseInsensitive, QRegExp::FixedString));
-	m_proxyModel->invalidate(); // Trigger re-filtering
-
 	if(text.isEmpty()) {
 		qDebug(CAT_DEBUGGERIIOMODEL) << "Text is empty, will not recursively expand items.";
 		return;
 	}
 
-	QStandardItemModel *sourceModel = qobject_cast<QStandardItemModel *>(m_proxyModel->sourceModel());
+	// the index is queried off the GUI thread, a newer keystroke cancels the query in flight
+	const int generation = ++m_searchGeneration;
+	m_searchWatcher->setFuture(QtConcurrent::run([this, text, generation]() {
+		IIOSearchIndex::Result result =
+			m_searchIndex->query(text, [this, generation]() { return m_searchGeneration != generation; });
+		result.generation = generation;
+		return result;
+	}));
+}
 
-	if(!sourceModel) {
-		qWarning(CAT_DEBUGGERIIOMODEL) << "Failed to obtain source model.";
+void IIOExplorerInstrument::applySearchResult(const IIOSearchIndex::Result &result)
+{
+	if(result.canceled || result.generation != m_searchGeneration ||
+	   result.generation == m_appliedSearchGeneration) {
 		return;
 	}
+	m_appliedSearchGeneration = result.generation;
+
+	m_proxyModel->setVisibleItems(result.visible);
+	m_proxyModel->invalidate(); // Trigger re-filtering
+
+	// every parent of a match is expanded once, no matter how many matches it holds
+	for(const QStandardItem *item : result.expanded) {
+		m_treeView->expand(m_proxyModel->mapFromSource(item->index()));
+	}
+}
 
-	// Iterate through the items in the source model
-	recursiveExpandItems(sourceModel->invisibleRootItem(), text);
+void IIOExplorerInstrument::finishSearch()
+{
+	m_searchWatcher->waitForFinished();
+	QFuture<IIOSearchIndex::Result> future = m_searchWatcher->future();
+	if(future.resultCount() > 0) {
+		applySearchResult(future.result());
+	}
 }
 
 void IIOExplorerInstrument::selectItem(IIOStandardItem *item)
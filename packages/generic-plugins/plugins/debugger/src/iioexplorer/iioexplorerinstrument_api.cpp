@@ -537,6 +537,8 @@ void IIOExplorerInstrument_API::setSearchText(const QString &text)
 		return;
 	}
 	p->m_searchBar->getLineEdit()->setText(text);
+	// scripts read the filtered tree right after, do not leave them racing the search
+	p->finishSearch();
 }
 
 QString IIOExplorerInstrument_API::getSearchText()
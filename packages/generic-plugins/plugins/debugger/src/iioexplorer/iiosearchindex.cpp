@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "iiosearchindex.h"
+
+using namespace scopy::debugger;
+
+// how many entries a query checks between two polls of its cancel callback
+#define CANCEL_POLL_MASK 0xff
+
+IIOSearchIndex::IIOSearchIndex(QStandardItemModel *model, QObject *parent)
+	: QObject(parent)
+	, m_model(model)
+	, m_alive(0)
+{
+	QStandardItem *root = m_model->invisibleRootItem();
+	for(int row = 0; row < root->rowCount(); ++row) {
+		addSubtree(root->child(row), -1);
+	}
+
+	connect(m_model, &QAbstractItemModel::rowsInserted, this, &IIOSearchIndex::onRowsInserted);
+	connect(m_model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &IIOSearchIndex::onRowsAboutToBeRemoved);
+	connect(m_model, &QAbstractItemModel::dataChanged, this, &IIOSearchIndex::onDataChanged);
+}
+
+IIOSearchIndex::~IIOSearchIndex() {}
+
+IIOSearchIndex::Result IIOSearchIndex::query(const QString &text, std::function<bool()> canceled) const
+{
+	Result result = {.query = text, .generation = 0, .canceled = false};
+	const QString needle = text.toLower();
+	if(needle.isEmpty()) {
+		return result;
+	}
+
+	QReadLocker lock(&m_lock);
+	QVector<int> matched;
+	auto check = [&](int id) {
+		const Entry &e = m_entries[id];
+		if(e.item && e.text.contains(needle)) {
+			matched.append(id);
+		}
+	};
+
+	if(needle.size() < 3) {
+		// too short for a trigram, the lower case names are still a lot cheaper to scan than the tree
+		for(int id = 0; id < m_entries.size(); ++id) {
+			if(isCanceled(canceled, id)) {
+				result.canceled = true;
+				return result;
+			}
+			check(id);
+		}
+	} else {
+		// every match contains all trigrams of the needle - only the entries of the rarest one are checked
+		const QVector<int> *candidates = nullptr;
+		for(int pos = 0; pos + 3 <= needle.size(); ++pos) {
+			auto it = m_trigrams.constFind(trigram(needle, pos));
+			if(it == m_trigrams.cend()) {
+				return result;
+			}
+			if(!candidates || it->size() < candidates->size()) {
+				candidates = &it.value();
+			}
+		}
+		for(int i = 0; i < candidates->size(); ++i) {
+			if(isCanceled(canceled, i)) {
+				result.canceled = true;
+				return result;
+			}
+			check(candidates->at(i));
+		}
+	}
+
+	for(int id : qAsConst(matched)) {
+		result.matches.insert(m_entries[id].item);
+		result.visible.insert(m_entries[id].item);
+		for(int p = m_entries[id].parent; p != -1; p = m_entries[p].parent) {
+			const QStandardItem *item = m_entries[p].item;
+			if(!item || result.expanded.contains(item)) {
+				break;
+			}
+			result.expanded.insert(item);
+			result.visible.insert(item);
+		}
+	}
+
+	return result;
+}
+
+int IIOSearchIndex::size() const
+{
+	QReadLocker lock(&m_lock);
+	return m_alive;
+}
+
+void IIOSearchIndex::onRowsInserted(const QModelIndex &parent, int first, int last)
+{
+	QStandardItem *parentItem = itemFromIndex(parent);
+	if(!parentItem) {
+		return;
+	}
+
+	QWriteLocker lock(&m_lock);
+	const int parentId = m_ids.value(parentItem, -1);
+	for(int row = first; row <= last; ++row) {
+		addSubtree(parentItem->child(row), parentId);
+	}
+}
+
+void IIOSearchIndex::onRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+	QStandardItem *parentItem = itemFromIndex(parent);
+	if(!parentItem) {
+		return;
+	}
+
+	QWriteLocker lock(&m_lock);
+	for(int row = first; row <= last; ++row) {
+		removeSubtree(parentItem->child(row));
+	}
+}
+
+void IIOSearchIndex::onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+				   const QVector<int> &roles)
+{
+	if(!roles.isEmpty() && !roles.contains(Qt::DisplayRole)) {
+		return;
+	}
+
+	QWriteLocker lock(&m_lock);
+	for(int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+		const QStandardItem *item = itemFromIndex(topLeft.siblingAtRow(row));
+		const int id = m_ids.value(item, -1);
+		if(id == -1) {
+			continue;
+		}
+
+		const QString text = item->text().toLower();
+		if(text == m_entries[id].text) {
+			continue;
+		}
+		unindexText(id);
+		m_entries[id].text = text;
+		indexText(id);
+	}
+}
+
+QStandardItem *IIOSearchIndex::itemFromIndex(const QModelIndex &index) const
+{
+	return index.isValid() ? m_model->itemFromIndex(index) : m_model->invisibleRootItem();
+}
+
+void IIOSearchIndex::addSubtree(QStandardItem *item, int parent)
+{
+	if(!item || m_ids.contains(item)) {
+		return;
+	}
+
+	const int id = m_entries.size();
+	m_entries.append({.item = item, .parent = parent, .text = item->text().toLower()});
+	m_ids.insert(item, id);
+	indexText(id);
+	m_alive++;
+
+	for(int row = 0; row < item->rowCount(); ++row) {
+		addSubtree(item->child(row), id);
+	}
+}
+
+void IIOSearchIndex::removeSubtree(QStandardItem *item)
+{
+	const int id = m_ids.value(item, -1);
+	if(id == -1) {
+		return;
+	}
+
+	for(int row = 0; row < item->rowCount(); ++row) {
+		removeSubtree(item->child(row));
+	}
+
+	// the entry stays as a tombstone, its id may still be the parent of other entries
+	unindexText(id);
+	m_entries[id].item = nullptr;
+	m_entries[id].text.clear();
+	m_ids.remove(item);
+	m_alive--;
+}
+
+void IIOSearchIndex::indexText(int id)
+{
+	const QString &text = m_entries[id].text;
+	QSet<quint64> seen;
+	for(int pos = 0; pos + 3 <= text.size(); ++pos) {
+		const quint64 t = trigram(text, pos);
+		if(!seen.contains(t)) {
+			seen.insert(t);
+			m_trigrams[t].append(id);
+		}
+	}
+}
+
+void IIOSearchIndex::unindexText(int id)
+{
+	const QString &text = m_entries[id].text;
+	QSet<quint64> seen;
+	for(int pos = 0; pos + 3 <= text.size(); ++pos) {
+		const quint64 t = trigram(text, pos);
+		if(seen.contains(t)) {
+			continue;
+		}
+		seen.insert(t);
+		auto it = m_trigrams.find(t);
+		if(it == m_trigrams.end()) {
+			continue;
+		}
+		it->removeOne(id);
+		if(it->isEmpty()) {
+			m_trigrams.erase(it);
+		}
+	}
+}
+
+bool IIOSearchIndex::isCanceled(const std::function<bool()> &canceled, int step) const
+{
+	return canceled && (step & CANCEL_POLL_MASK) == 0 && canceled();
+}
+
+quint64 IIOSearchIndex::trigram(const QString &text, int pos)
+{
+	return (quint64(text[pos].unicode()) << 32) | (quint64(text[pos + 1].unicode()) << 16) |
+		quint64(text[pos + 2].unicode());
+}
+
+#include "moc_iiosearchindex.cpp"
@@ -28,26 +28,16 @@ using namespace scopy::debugger;
 
 bool IIOSortFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
 {
-	// Get the source index for the current row
-	QModelIndex sourceIndex = sourceModel()->index(sourceRow, 0, sourceParent);
-
-	// Get the item data from the source index
-	QVariant itemData = sourceModel()->data(sourceIndex, Qt::DisplayRole);
-
-	// Check if the item's data contains the filter string
-	QString filterString = filterRegExp().pattern(); // Get the filter string
-	if(itemData.toString().contains(filterString, Qt::CaseInsensitive)) {
+	if(!m_filterActive) {
 		return true;
 	}
 
-	// Check recursively for children
-	for(int i = 0; i < sourceModel()->rowCount(sourceIndex); ++i) {
-		if(filterAcceptsRow(i, sourceIndex)) {
-			return true;
-		}
+	// The search index already resolved which rows match or lead to a match, no need to visit the children
+	auto *src = qobject_cast<QStandardItemModel *>(sourceModel());
+	if(!src) {
+		return true;
 	}
-
-	return false;
+	return m_visibleItems.contains(src->itemFromIndex(src->index(sourceRow, 0, sourceParent)));
 }
 
 bool IIOSortFilterProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
@@ -76,6 +66,18 @@ void IIOSortFilterProxyModel::setSortChannels(bool enabled) { m_sortChannels = e
 
 void IIOSortFilterProxyModel::setSortAttributes(bool enabled) { m_sortAttributes = enabled; }
 
+void IIOSortFilterProxyModel::setVisibleItems(const QSet<const QStandardItem *> &items)
+{
+	m_visibleItems = items;
+	m_filterActive = true;
+}
+
+void IIOSortFilterProxyModel::clearVisibleItems()
+{
+	m_visibleItems.clear();
+	m_filterActive = false;
+}
+
 IIOSortFilterProxyModel::IIOSortFilterProxyModel(QObject *parent)
 	: QSortFilterProxyModel(parent)
 {}
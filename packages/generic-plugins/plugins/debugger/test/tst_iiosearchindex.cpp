@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QStandardItemModel>
+#include <QTest>
+#include <debugger/iiosearchindex.h>
+
+using namespace scopy::debugger;
+
+static const QStringList ATTRIBUTES = {
+	"raw", "scale", "offset", "sampling_frequency", "hardwaregain",
+	"calibscale", "phase", "rf_bandwidth", "rssi", "filter_fir_en",
+};
+
+class TST_IIOSearchIndex : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void query();
+	void incremental();
+	void cancel();
+	void latency_data();
+	void latency();
+
+private:
+	// context0 / deviceN / voltageN / <ATTRIBUTES>, devices * channels * 10 attributes
+	QStandardItemModel *buildModel(int devices, int channels);
+	QStandardItem *find(QStandardItemModel *model, const QString &path);
+};
+
+QStandardItemModel *TST_IIOSearchIndex::buildModel(int devices, int channels)
+{
+	QStandardItemModel *model = new QStandardItemModel(this);
+	QStandardItem *ctx = new QStandardItem("context0");
+	for(int d = 0; d < devices; d++) {
+		QStandardItem *dev = new QStandardItem("device" + QString::number(d));
+		for(int c = 0; c < channels; c++) {
+			QStandardItem *ch = new QStandardItem("voltage" + QString::number(c) + " (input)");
+			for(const QString &attr : ATTRIBUTES) {
+				ch->appendRow(new QStandardItem(attr));
+			}
+			dev->appendRow(ch);
+		}
+		ctx->appendRow(dev);
+	}
+	model->appendRow(ctx);
+	return model;
+}
+
+QStandardItem *TST_IIOSearchIndex::find(QStandardItemModel *model, const QString &path)
+{
+	QStandardItem *item = model->invisibleRootItem();
+	for(const QString &name : path.split("/")) {
+		QStandardItem *next = nullptr;
+		for(int row = 0; row < item->rowCount() && !next; row++) {
+			if(item->child(row)->text() == name) {
+				next = item->child(row);
+			}
+		}
+		if(!next) {
+			return nullptr;
+		}
+		item = next;
+	}
+	return item;
+}
+
+void TST_IIOSearchIndex::query()
+{
+	QStandardItemModel *model = buildModel(2, 3);
+	IIOSearchIndex index(model);
+	QCOMPARE(index.size(), 1 + 2 + 2 * 3 + 2 * 3 * 10);
+
+	// trigram lookup, case insensitive
+	IIOSearchIndex::Result r = index.query("HardWareGain");
+	QVERIFY(!r.canceled);
+	QCOMPARE(r.matches.size(), 6);
+	QVERIFY(r.matches.contains(find(model, "context0/device1/voltage2 (input)/hardwaregain")));
+
+	// every match is shown together with its parents, only the parents are expanded
+	QCOMPARE(r.expanded.size(), 1 + 2 + 6);
+	QCOMPARE(r.visible.size(), 6 + 1 + 2 + 6);
+	QVERIFY(r.expanded.contains(find(model, "context0/device1")));
+	QVERIFY(!r.expanded.contains(find(model, "context0/device1/voltage2 (input)/hardwaregain")));
+
+	// shorter than a trigram - scanned
+	r = index.query("ss");
+	QCOMPARE(r.matches.size(), 6); // rssi
+
+	// substrings in the middle of a name
+	r = index.query("age1");
+	QCOMPARE(r.matches.size(), 2);
+	QVERIFY(r.matches.contains(find(model, "context0/device0/voltage1 (input)")));
+
+	QVERIFY(index.query("voltage9").matches.isEmpty());
+	QVERIFY(index.query("").matches.isEmpty());
+}
+
+void TST_IIOSearchIndex::incremental()
+{
+	QStandardItemModel *model = buildModel(2, 3);
+	IIOSearchIndex index(model);
+
+	QStandardItem *dev = find(model, "context0/device0");
+	QStandardItem *ch = new QStandardItem("temp0 (input)");
+	ch->appendRow(new QStandardItem("thermocouple_type"));
+	dev->appendRow(ch);
+	IIOSearchIndex::Result r = index.query("thermo");
+	QCOMPARE(r.matches.size(), 1);
+	QVERIFY(r.expanded.contains(ch));
+	QVERIFY(r.expanded.contains(dev));
+
+	ch->child(0)->setText("oversampling_ratio");
+	QVERIFY(index.query("thermo").matches.isEmpty());
+	QCOMPARE(index.query("oversampling").matches.size(), 1);
+
+	const int size = index.size();
+	dev->removeRow(ch->row());
+	QCOMPARE(index.size(), size - 2);
+	QVERIFY(index.query("oversampling").matches.isEmpty());
+	QVERIFY(index.query("temp0").matches.isEmpty());
+	QCOMPARE(index.query("hardwaregain").matches.size(), 6);
+}
+
+void TST_IIOSearchIndex::cancel()
+{
+	QStandardItemModel *model = buildModel(2, 3);
+	IIOSearchIndex index(model);
+
+	IIOSearchIndex::Result r = index.query("raw", []() { return true; });
+	QVERIFY(r.canceled);
+	QVERIFY(r.matches.isEmpty());
+
+	r = index.query("raw", []() { return false; });
+	QVERIFY(!r.canceled);
+	QCOMPARE(r.matches.size(), 6);
+}
+
+void TST_IIOSearchIndex::latency_data()
+{
+	QTest::addColumn<QString>("text");
+
+	QTest::newRow("attribute") << "hardwaregain";
+	QTest::newRow("channel") << "voltage12";
+	QTest::newRow("short") << "ph";
+	QTest::newRow("no match") << "altvoltage";
+}
+
+void TST_IIOSearchIndex::latency()
+{
+	QFETCH(QString, text);
+
+	// 10k attributes, the size of a large multi chip transceiver context
+	QStandardItemModel *model = buildModel(25, 40);
+	IIOSearchIndex index(model);
+
+	QBENCHMARK { index.query(text); }
+}
+
+QTEST_MAIN(TST_IIOSearchIndex)
+
+#include "tst_iiosearchindex.moc"
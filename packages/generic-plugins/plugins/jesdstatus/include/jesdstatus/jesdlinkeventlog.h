@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JESDLINKEVENTLOG_H
+#define JESDLINKEVENTLOG_H
+
+#include "scopy-jesdstatus_export.h"
+#include <QDateTime>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+namespace scopy::jesdstatus {
+
+struct JesdLinkEvent
+{
+	quint64 id; // assigned by the log, strictly increasing
+	QDateTime timestamp;
+	int lane; // -1 for link level events
+	QString field;
+	QString previous;
+	QString current;
+};
+
+/*
+ * Fixed size, thread safe ring of link state transitions. The parser appends
+ * from its worker thread, the UI and export read snapshots of it.
+ */
+class SCOPY_JESDSTATUS_EXPORT JesdLinkEventLog
+{
+public:
+	JesdLinkEventLog(int capacity = 1024);
+	~JesdLinkEventLog();
+
+	void append(JesdLinkEvent event);
+	void clear();
+
+	int capacity() const;
+	int count() const;
+
+	// oldest event first
+	QVector<JesdLinkEvent> events() const;
+	QVector<JesdLinkEvent> eventsSince(quint64 id) const;
+
+	QString toCsv() const;
+
+private:
+	mutable QMutex m_mutex;
+	QVector<JesdLinkEvent> m_ring;
+	int m_head;
+	int m_count;
+	quint64 m_nextId;
+};
+
+} // namespace scopy::jesdstatus
+#endif // JESDLINKEVENTLOG_H
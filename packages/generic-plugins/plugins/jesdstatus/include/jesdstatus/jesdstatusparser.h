@@ -22,6 +22,7 @@
 #define JESDSTATUSPARSER_H
 
 #include "scopy-jesdstatus_export.h"
+#include "jesdlinkeventlog.h"
 #include <QString>
 #include <QMap>
 #include <QObject>
@@ -50,6 +51,8 @@ class SCOPY_JESDSTATUS_EXPORT JesdStatusParser : public QObject
 	Q_OBJECT
 public:
 	JesdStatusParser(struct iio_device *dev, QObject *parent);
+	// parses attribute text handed to parse(), without reading a device
+	JesdStatusParser(ENCODER_TYPE encoder, QObject *parent);
 	virtual ~JesdStatusParser();
 
 	ENCODER_TYPE getEncoder() const;
@@ -78,6 +81,15 @@ public:
 	QPair<QString, VISUAL_STATUS> getSysrefAlignmentError();
 	QPair<QString, VISUAL_STATUS> getSyncState();
 
+	/** Changes detected by the last update **/
+	bool statusChanged() const;
+	QList<unsigned int> changedLanes() const;
+
+	const JesdLinkEventLog &eventLog() const;
+
+	// diffs the raw "status" / "laneN_info" attribute text against the previous snapshot
+	void parse(const QMap<QString, QString> &snapshot);
+
 public Q_SLOTS:
 	void update();
 
@@ -149,12 +161,20 @@ private:
 
 	QMap<unsigned int, JESD204B_LANEINFO> m_allLaneStatus;
 
+	// raw attribute text from the previous poll - unchanged attributes are not parsed again
+	QMap<QString, QString> m_snapshot;
+	bool m_statusChanged;
+	QList<unsigned int> m_changedLanes;
+	JesdLinkEventLog m_eventLog;
+
 private:
 	int extractLaneNumber(const QString &text);
 	void readEncoder();
-	void readLaneStatus(QString laneAttr);
-	void readAllLaneStatus();
-	void readStatus();
+	QMap<QString, QString> readSnapshot();
+	int readLaneStatus(QString laneAttr, const QString &laneStatus);
+	void computeMinLatency();
+	void readStatus(const QString &status);
+	void recordEvent(int lane, const QString &field, const QString &previous, const QString &current);
 	QString regexMatch(QString container, QRegularExpression regex, QString init = "");
 	long regexMatchUInt(QString container, QRegularExpression regex);
 	QList<QString> regexMatchMultiple(QString container, QRegularExpression regex, int count);
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "jesdlinkeventlog.h"
+#include <QMutexLocker>
+
+using namespace scopy::jesdstatus;
+
+JesdLinkEventLog::JesdLinkEventLog(int capacity)
+	: m_ring(std::max(capacity, 1))
+	, m_head(0)
+	, m_count(0)
+	, m_nextId(1)
+{}
+
+JesdLinkEventLog::~JesdLinkEventLog() {}
+
+void JesdLinkEventLog::append(JesdLinkEvent event)
+{
+	QMutexLocker lock(&m_mutex);
+	event.id = m_nextId++;
+	m_ring[m_head] = event;
+	m_head = (m_head + 1) % m_ring.size();
+	m_count = std::min(m_count + 1, (int)m_ring.size());
+}
+
+void JesdLinkEventLog::clear()
+{
+	QMutexLocker lock(&m_mutex);
+	m_head = 0;
+	m_count = 0;
+}
+
+int JesdLinkEventLog::capacity() const { return m_ring.size(); }
+
+int JesdLinkEventLog::count() const
+{
+	QMutexLocker lock(&m_mutex);
+	return m_count;
+}
+
+QVector<JesdLinkEvent> JesdLinkEventLog::events() const { return eventsSince(0); }
+
+QVector<JesdLinkEvent> JesdLinkEventLog::eventsSince(quint64 id) const
+{
+	QMutexLocker lock(&m_mutex);
+	QVector<JesdLinkEvent> ret;
+	ret.reserve(m_count);
+
+	int first = (m_head - m_count + m_ring.size()) % m_ring.size();
+	for(int i = 0; i < m_count; i++) {
+		const JesdLinkEvent &e = m_ring.at((first + i) % m_ring.size());
+		if(e.id > id) {
+			ret.append(e);
+		}
+	}
+	return ret;
+}
+
+QString JesdLinkEventLog::toCsv() const
+{
+	QString csv = "Timestamp,Lane,Field,Previous,Current\n";
+	for(const JesdLinkEvent &e : events()) {
+		csv += QString("%1,%2,%3,%4,%5\n")
+			       .arg(e.timestamp.toString(Qt::ISODateWithMs))
+			       .arg(e.lane < 0 ? QString("link") : QString::number(e.lane))
+			       .arg(e.field, e.previous, e.current);
+	}
+	return csv;
+}
@@ -99,8 +99,13 @@ void JesdStatus::poll()
 	unsigned int idx = m_deviceSelector->combo()->currentIndex();
 	QString device = m_deviceSelector->combo()->itemText(idx);
 	m_jesdDeviceStack->show(device);
-	JesdStatusView *current = dynamic_cast<JesdStatusView *>(m_jesdDeviceStack->get(device));
-	if(current) {
-		current->update();
+
+	// every link is polled on its own worker so transitions on hidden links are recorded too
+	for(int i = 0; i < m_deviceSelector->combo()->count(); i++) {
+		QString key = m_deviceSelector->combo()->itemText(i);
+		JesdStatusView *view = dynamic_cast<JesdStatusView *>(m_jesdDeviceStack->get(key));
+		if(view) {
+			view->update();
+		}
 	}
 }
@@ -24,6 +24,7 @@
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 #include <QLoggingCategory>
+#include <cstring>
 using namespace scopy::jesdstatus;
 
 Q_LOGGING_CATEGORY(CAT_JESDPARSER, "JesdParser");
@@ -34,6 +35,8 @@ JesdStatusParser::JesdStatusParser(iio_device *dev, QObject *parent)
 	, m_dev(dev)
 	, m_laneCount(0)
 	, m_encoder(JESD204_UNKNOWN)
+	, m_minLatency(0)
+	, m_statusChanged(false)
 {
 	readEncoder();
 	unsigned int attrCount = iio_device_get_attrs_count(m_dev);
@@ -45,15 +48,116 @@ JesdStatusParser::JesdStatusParser(iio_device *dev, QObject *parent)
 	}
 }
 
+JesdStatusParser::JesdStatusParser(ENCODER_TYPE encoder, QObject *parent)
+	: QObject(parent)
+	, m_dev(nullptr)
+	, m_laneCount(0)
+	, m_encoder(encoder)
+	, m_minLatency(0)
+	, m_statusChanged(false)
+{}
+
 JesdStatusParser::~JesdStatusParser() {}
 
 void JesdStatusParser::update()
 {
-	readAllLaneStatus();
-	readStatus();
+	if(m_dev != nullptr && m_encoder != JESD204_UNKNOWN) {
+		parse(readSnapshot());
+	}
+
 	Q_EMIT finished();
 }
 
+void JesdStatusParser::parse(const QMap<QString, QString> &snapshot)
+{
+	m_statusChanged = false;
+	m_changedLanes.clear();
+
+	if(m_encoder == JESD204_UNKNOWN) {
+		return;
+	}
+
+	for(auto it = snapshot.cbegin(); it != snapshot.cend(); ++it) {
+		auto prev = m_snapshot.constFind(it.key());
+		if(prev != m_snapshot.cend() && prev.value() == it.value()) {
+			continue;
+		}
+
+		if(it.key() == "status") {
+			readStatus(it.value());
+			m_statusChanged = true;
+		} else {
+			int lane = readLaneStatus(it.key(), it.value());
+			if(lane >= 0) {
+				m_changedLanes.append(lane);
+			}
+		}
+	}
+	m_snapshot = snapshot;
+
+	if(!m_changedLanes.isEmpty()) {
+		computeMinLatency();
+	}
+}
+
+bool JesdStatusParser::statusChanged() const { return m_statusChanged; }
+
+QList<unsigned int> JesdStatusParser::changedLanes() const { return m_changedLanes; }
+
+const JesdLinkEventLog &JesdStatusParser::eventLog() const { return m_eventLog; }
+
+void JesdStatusParser::recordEvent(int lane, const QString &field, const QString &previous, const QString &current)
+{
+	// the first read only establishes the initial state
+	if(m_snapshot.isEmpty() || previous == current) {
+		return;
+	}
+	m_eventLog.append({.id = 0,
+			   .timestamp = QDateTime::currentDateTime(),
+			   .lane = lane,
+			   .field = field,
+			   .previous = previous,
+			   .current = current});
+}
+
+static int collectJesdAttr(struct iio_device *, const char *attr, const char *value, size_t len, void *d)
+{
+	QString name(attr);
+	if(name == "status" || name.contains("lane")) {
+		auto snapshot = static_cast<QMap<QString, QString> *>(d);
+		snapshot->insert(name, QString::fromUtf8(value, strnlen(value, len)));
+	}
+	return 0;
+}
+
+QMap<QString, QString> JesdStatusParser::readSnapshot()
+{
+	QMap<QString, QString> snapshot;
+
+	// a single request for all device attributes - one round trip on network contexts
+	if(iio_device_attr_read_all(m_dev, collectJesdAttr, &snapshot) >= 0) {
+		return snapshot;
+	}
+
+	snapshot.clear();
+	char buf[MAX_JESD_ATTR_SIZE];
+	unsigned int attrCount = iio_device_get_attrs_count(m_dev);
+	for(unsigned i = 0; i < attrCount; i++) {
+		const char *attr = iio_device_get_attr(m_dev, i);
+		QString name(attr);
+		if(name != "status" && !name.contains("lane")) {
+			continue;
+		}
+		int ret = iio_device_attr_read(m_dev, attr, buf, MAX_JESD_ATTR_SIZE);
+		if(ret < 0) {
+			qDebug(CAT_JESDPARSER) << "There is an issue reading the JESD204 attribute" << name;
+			continue;
+		}
+		snapshot.insert(name, QString(buf));
+	}
+	return snapshot;
+}
+
 ENCODER_TYPE JesdStatusParser::getEncoder() const { return m_encoder; }
 
 unsigned int JesdStatusParser::getLaneCount() { return m_laneCount; }
@@ -393,23 +497,14 @@ void JesdStatusParser::readEncoder()
 	}
 }
 
-void JesdStatusParser::readLaneStatus(QString laneAttr)
+int JesdStatusParser::readLaneStatus(QString laneAttr, const QString &laneStatus)
 {
 	JESD204B_LANEINFO m_jesd204_lanestatus;
-	QString laneStatus = "";
 	int laneId = regexMatchUInt(laneAttr, QRegularExpression("lane(\\d+)_info"));
 
-	if(m_encoder == JESD204_UNKNOWN) {
-		return;
-	}
-
-	char buf[MAX_JESD_ATTR_SIZE];
-	int ret = iio_device_attr_read(m_dev, laneAttr.toUtf8(), buf, MAX_JESD_ATTR_SIZE);
-	if(ret < 0) {
-		qDebug(CAT_JESDPARSER) << "There is an issue reading the JESD204 lane status. Aborting...";
-		return;
+	if(m_encoder == JESD204_UNKNOWN || laneId < 0) {
+		return -1;
 	}
-	laneStatus = QString(buf);
 
 	m_jesd204_lanestatus.lane_errors = regexMatchUInt(laneStatus, QRegularExpression("Errors: (\\S+)[ \\n]?"));
 	if(m_encoder == JESD204_64B66B) {
@@ -489,23 +584,26 @@ void JesdStatusParser::readLaneStatus(QString laneAttr)
 		qDebug(CAT_JESDPARSER) << "There is an issue reading the JESD204 adjustment info.";
 	}
 
+	const JESD204B_LANEINFO previous = m_allLaneStatus.value(laneId);
+	if(m_jesd204_lanestatus.lane_errors > previous.lane_errors) {
+		recordEvent(laneId, "Errors", QString::number(previous.lane_errors),
+			    QString::number(m_jesd204_lanestatus.lane_errors));
+	}
+	recordEvent(laneId, "Latency", QString::number(previous.lane_latency),
+		    QString::number(m_jesd204_lanestatus.lane_latency));
+	recordEvent(laneId, "CGS state", previous.cgs_state, m_jesd204_lanestatus.cgs_state);
+	recordEvent(laneId, "Initial Frame Sync", previous.init_frame_sync, m_jesd204_lanestatus.init_frame_sync);
+	recordEvent(laneId, "Initial Lane Alignment Sequence", previous.init_lane_align_seq,
+		    m_jesd204_lanestatus.init_lane_align_seq);
+	recordEvent(laneId, "Extended multiblock alignment", previous.ext_multiblock_align_state,
+		    m_jesd204_lanestatus.ext_multiblock_align_state);
+
 	m_allLaneStatus.insert(laneId, m_jesd204_lanestatus);
+	return laneId;
 }
 
-void JesdStatusParser::readAllLaneStatus()
+void JesdStatusParser::computeMinLatency()
 {
-	if(m_encoder == JESD204_UNKNOWN) {
-		return;
-	}
-
-	unsigned int attrCount = iio_device_get_attrs_count(m_dev);
-	for(unsigned i = 0; i < attrCount; i++) {
-		QString attr = iio_device_get_attr(m_dev, i);
-		if(!attr.isEmpty() && attr.contains("lane")) {
-			readLaneStatus(attr);
-		}
-	}
-
 	int minLatency = 0;
 	int octetsPerMultiframe = 0;
 	unsigned int laneCount = m_allLaneStatus.size();
@@ -522,24 +620,21 @@ void JesdStatusParser::readAllLaneStatus()
 				      octetsPerMultiframe * (unsigned int)lane.lane_latency_multiframes +
 					      lane.lane_latency_octets);
 	}
+	if(minLatency != m_minLatency) {
+		// the latency state of every lane is relative to the minimum
+		m_changedLanes = m_allLaneStatus.keys();
+	}
 	m_minLatency = minLatency;
 }
 
-void JesdStatusParser::readStatus()
+void JesdStatusParser::readStatus(const QString &status)
 {
-	QString status = "";
 	const QString notAvailable = "N/A";
 	if(m_encoder == JESD204_UNKNOWN) {
 		return;
 	}
 
-	char buf[MAX_JESD_ATTR_SIZE];
-	int ret = iio_device_attr_read(m_dev, "status", buf, MAX_JESD_ATTR_SIZE);
-	if(ret < 0) {
-		qDebug(CAT_JESDPARSER) << "There is an issue reading the JESD204 status. Aborting...";
-		return;
-	}
-	status = QString(buf);
+	const JESD204B_JESD204_STATUS previous = m_jesd204_status;
 
 	m_jesd204_status.link_state = regexMatch(status, QRegularExpression("Link is (\\S+)"));
 	m_jesd204_status.measured_link_clock =
@@ -578,6 +673,14 @@ void JesdStatusParser::readStatus()
 	m_jesd204_status.sysref_captured = regexMatch(status, QRegularExpression("SYSREF captured: (\\S+)[ \\n]?"));
 	m_jesd204_status.sysref_alignment_error =
 		regexMatch(status, QRegularExpression("SYSREF alignment error: (\\S+)[ \\n]?"));
+
+	recordEvent(-1, "Link is", previous.link_state, m_jesd204_status.link_state);
+	recordEvent(-1, "Link status", previous.link_status, m_jesd204_status.link_status);
+	recordEvent(-1, "SYNC~", previous.sync_state, m_jesd204_status.sync_state);
+	recordEvent(-1, "SYSREF captured", previous.sysref_captured, m_jesd204_status.sysref_captured);
+	recordEvent(-1, "SYSREF alignment error", previous.sysref_alignment_error,
+		    m_jesd204_status.sysref_alignment_error);
+	recordEvent(-1, "Lane rate", previous.lane_rate, m_jesd204_status.lane_rate);
 }
 
 long JesdStatusParser::regexMatchUInt(QString container, QRegularExpression regex)
@@ -21,14 +21,22 @@
 #include "jesdstatusview.h"
 #include <style.h>
 #include <gui/widgets/menusectionwidget.h>
+#include <QFile>
+#include <QFileDialog>
+#include <QLoggingCategory>
+#include <QPushButton>
 #include <QVBoxLayout>
+#include <pluginbase/preferences.h>
 
 using namespace scopy;
 using namespace jesdstatus;
 
+Q_LOGGING_CATEGORY(CAT_JESDSTATUSVIEW, "JesdStatusView");
+
 JesdStatusView::JesdStatusView(iio_device *dev, QWidget *parent)
 	: QWidget(parent)
 	, m_parserThread(new QThread(this))
+	, m_lastEventId(0)
 {
 	m_parser = new JesdStatusParser(dev, nullptr);
 	m_parser->moveToThread(m_parserThread);
@@ -104,6 +112,8 @@ JesdStatusView::JesdStatusView(iio_device *dev, QWidget *parent)
 		lay->addWidget(laneScroll);
 	}
 
+	lay->addWidget(createEventsSection());
+
 	lay->addSpacerItem(new QSpacerItem(0, 0, QSizePolicy::Expanding, QSizePolicy::Expanding));
 }
 
@@ -259,10 +269,76 @@ void JesdStatusView::update()
 	}
 }
 
+QWidget *JesdStatusView::createEventsSection()
+{
+	QWidget *eventsHeader = new QWidget(this);
+	QVBoxLayout *eventsLay = new QVBoxLayout();
+	eventsHeader->setLayout(eventsLay);
+
+	QHBoxLayout *titleLay = new QHBoxLayout();
+	QLabel *eventsLbl = new QLabel("LINK EVENTS", eventsHeader);
+	QPushButton *exportBtn = new QPushButton("Export", eventsHeader);
+	titleLay->addWidget(eventsLbl);
+	titleLay->addStretch();
+	titleLay->addWidget(exportBtn);
+	connect(exportBtn, &QPushButton::clicked, this, &JesdStatusView::exportEvents);
+
+	m_events = new QPlainTextEdit(eventsHeader);
+	m_events->setReadOnly(true);
+	m_events->setMaximumBlockCount(m_parser->eventLog().capacity());
+	m_events->setMaximumHeight(150);
+	eventsLay->addLayout(titleLay);
+	eventsLay->addWidget(m_events);
+
+	Style::setStyle(eventsLbl, style::properties::label::menuBig);
+	Style::setStyle(exportBtn, style::properties::button::basicButton);
+	Style::setBackgroundColor(eventsHeader, json::theme::background_primary);
+	Style::setStyle(eventsHeader, style::properties::widget::border_interactive);
+
+	return eventsHeader;
+}
+
+void JesdStatusView::exportEvents()
+{
+	bool useNativeDialogs = Preferences::get("general_use_native_dialogs").toBool();
+	QString fileName = QFileDialog::getSaveFileName(
+		this, tr("Export link events"), "", tr("Comma-separated values files (*.csv)"), nullptr,
+		(useNativeDialogs ? QFileDialog::Options() : QFileDialog::DontUseNativeDialog));
+	if(fileName.isEmpty()) {
+		return;
+	}
+	if(!fileName.endsWith(".csv", Qt::CaseInsensitive)) {
+		fileName += ".csv";
+	}
+
+	QFile file(fileName);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		qWarning(CAT_JESDSTATUSVIEW) << "Can't open" << fileName << "for writing";
+		return;
+	}
+	file.write(m_parser->eventLog().toCsv().toUtf8());
+}
+
 void JesdStatusView::updateUi()
 {
-	updateStatus();
-	updateLaneStatus();
+	// only the values that changed since the previous poll are refreshed
+	if(m_parser->statusChanged()) {
+		updateStatus();
+	}
+	updateLaneStatus(m_parser->changedLanes());
+	updateEvents();
+}
+
+void JesdStatusView::updateEvents()
+{
+	const QVector<JesdLinkEvent> events = m_parser->eventLog().eventsSince(m_lastEventId);
+	for(const JesdLinkEvent &e : events) {
+		QString source = (e.lane < 0) ? QString("Link") : QString("Lane %1").arg(e.lane);
+		m_events->appendPlainText(QString("%1  %2  %3: %4 -> %5")
+						  .arg(e.timestamp.toString("yyyy-MM-dd hh:mm:ss.zzz"), source, e.field,
+						       e.previous, e.current));
+		m_lastEventId = e.id;
+	}
 }
 
 void JesdStatusView::updateStatus()
@@ -276,10 +352,12 @@ void JesdStatusView::updateStatus()
 	}
 }
 
-void JesdStatusView::updateLaneStatus()
+void JesdStatusView::updateLaneStatus(const QList<unsigned int> &lanes)
 {
-	auto lanes = m_laneLabels.keys();
-	for(unsigned int i : qAsConst(lanes)) {
+	for(unsigned int i : lanes) {
+		if(!m_laneLabels.contains(i)) {
+			continue;
+		}
 		for(auto &pair : m_laneLabels.value(i)) {
 			QLabel *vLbl = pair.first;
 			auto callback = pair.second;
@@ -24,6 +24,7 @@
 #include <QWidget>
 #include <QTextEdit>
 #include <QLabel>
+#include <QPlainTextEdit>
 #include <QThread>
 #include <gui/widgets/menusectionwidget.h>
 #include "scopy-jesdstatus_export.h"
@@ -43,16 +44,19 @@ public Q_SLOTS:
 
 private Q_SLOTS:
 	void updateUi();
+	void exportEvents();
 
 private:
 	void updateStatus();
-	void updateLaneStatus();
+	void updateLaneStatus(const QList<unsigned int> &lanes);
+	void updateEvents();
 	void appendToStatusLabels(QString lbl, std::function<QPair<QString, VISUAL_STATUS>()> cb,
 				  MenuSectionWidget *labelContainer, MenuSectionWidget *valueContainer);
 	void appendToLaneValues(unsigned int laneIdx, std::function<QPair<QString, VISUAL_STATUS>(unsigned int)> cb,
 				MenuSectionWidget *valueContainer);
 	void initLaneStatusValues(QWidget *laneContainer);
 	void initStatusValues(QWidget *statusContainer);
+	QWidget *createEventsSection();
 
 	JesdStatusParser *m_parser;
 	QThread *m_parserThread;
@@ -62,6 +66,9 @@ private:
 
 	QMap<QLabel *, statusCallback> m_statusLabels;
 	QMap<unsigned int, QVector<laneStatusCallback>> m_laneLabels;
+
+	QPlainTextEdit *m_events;
+	quint64 m_lastEventId;
 };
 } // namespace jesdstatus
 } // namespace scopy
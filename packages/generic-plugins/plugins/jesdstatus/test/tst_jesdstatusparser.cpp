@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2023 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <QTest>
+
+#include <jesdstatus/jesdlinkeventlog.h>
+#include <jesdstatus/jesdstatusparser.h>
+
+using namespace scopy::jesdstatus;
+
+class TST_JesdStatusParser : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void firstSnapshot();
+	void unchangedSnapshot();
+	void transitions();
+	void ringWrapAround();
+	void csv();
+};
+
+// attribute text as read from an axi-jesd204-rx device
+static QString status(const QString &linkStatus)
+{
+	return QString("Link is enabled\n"
+		       "Measured Link Clock: 245.760 MHz\n"
+		       "Reported Link Clock: 245.760 MHz\n"
+		       "Lane rate: 9830.400 MHz\n"
+		       "Lane rate / 40: 245.760 MHz\n"
+		       "LMFC rate: 7.680 MHz\n"
+		       "SYNC~: deasserted\n"
+		       "Link status: %1\n"
+		       "SYSREF captured: Yes\n"
+		       "SYSREF alignment error: No\n")
+		.arg(linkStatus);
+}
+
+static QString laneInfo(int errors)
+{
+	return QString("Errors: %1\n"
+		       "CGS state: DATA\n"
+		       "Initial Frame Synchronization: Yes\n"
+		       "Initial Lane Alignment Sequence: Yes\n"
+		       "DID: 0, BID: 0, LID: 0, L: 2, SCR: 1, F: 2\n"
+		       "K: 32, M: 4, N: 16, CS: 0, N': 16, S: 1, HD: 0\n"
+		       "FCHK: 61, CF: 0\n"
+		       "ADJCNT: 0, PHADJ: 0, ADJDIR: 0, JESDV: 1, SUBCLASS: 1\n")
+		.arg(errors);
+}
+
+static QMap<QString, QString> snapshot(const QString &linkStatus, int lane1Errors)
+{
+	return {{"status", status(linkStatus)}, {"lane0_info", laneInfo(0)}, {"lane1_info", laneInfo(lane1Errors)}};
+}
+
+void TST_JesdStatusParser::firstSnapshot()
+{
+	JesdStatusParser parser(JESD204_8B10B, nullptr);
+	parser.parse(snapshot("DATA", 0));
+
+	QVERIFY(parser.statusChanged());
+	QCOMPARE(parser.changedLanes(), QList<unsigned int>({0, 1}));
+	QCOMPARE(parser.getLinkState(), qMakePair(QString("enabled"), C_GOOD));
+	QCOMPARE(parser.getLinkStatus(), qMakePair(QString("DATA"), C_GOOD));
+	QCOMPARE(parser.getSyncState(), qMakePair(QString("deasserted"), C_GOOD));
+	QCOMPARE(parser.getCgsState(1), qMakePair(QString("DATA"), C_GOOD));
+	QCOMPARE(parser.getErrors(1), qMakePair(QString("0"), C_GOOD));
+
+	// the first read only establishes the initial state
+	QCOMPARE(parser.eventLog().count(), 0);
+}
+
+void TST_JesdStatusParser::unchangedSnapshot()
+{
+	JesdStatusParser parser(JESD204_8B10B, nullptr);
+	parser.parse(snapshot("DATA", 0));
+	parser.parse(snapshot("DATA", 0));
+
+	QVERIFY(!parser.statusChanged());
+	QVERIFY(parser.changedLanes().isEmpty());
+	QCOMPARE(parser.eventLog().count(), 0);
+}
+
+void TST_JesdStatusParser::transitions()
+{
+	JesdStatusParser parser(JESD204_8B10B, nullptr);
+	parser.parse(snapshot("DATA", 0));
+	parser.parse(snapshot("CGS", 5));
+
+	QVERIFY(parser.statusChanged());
+	QCOMPARE(parser.changedLanes(), QList<unsigned int>({1}));
+	QCOMPARE(parser.getLinkStatus(), qMakePair(QString("CGS"), C_ERR));
+	QCOMPARE(parser.getErrors(1), qMakePair(QString("5"), C_ERR));
+	QCOMPARE(parser.getErrors(0), qMakePair(QString("0"), C_GOOD));
+
+	const QVector<JesdLinkEvent> events = parser.eventLog().events();
+	QCOMPARE(events.size(), 2);
+	for(const JesdLinkEvent &e : events) {
+		if(e.lane < 0) {
+			QCOMPARE(e.field, QString("Link status"));
+			QCOMPARE(e.previous, QString("DATA"));
+			QCOMPARE(e.current, QString("CGS"));
+		} else {
+			QCOMPARE(e.lane, 1);
+			QCOMPARE(e.field, QString("Errors"));
+			QCOMPARE(e.previous, QString("0"));
+			QCOMPARE(e.current, QString("5"));
+		}
+	}
+	QVERIFY(events[0].id < events[1].id);
+
+	// recovering is a transition as well, errors going back down are not
+	parser.parse(snapshot("DATA", 0));
+	const QVector<JesdLinkEvent> recovered = parser.eventLog().eventsSince(events.last().id);
+	QCOMPARE(recovered.size(), 1);
+	QCOMPARE(recovered[0].current, QString("DATA"));
+}
+
+void TST_JesdStatusParser::ringWrapAround()
+{
+	JesdLinkEventLog log(4);
+	for(int i = 0; i < 10; i++) {
+		log.append({.id = 0, .timestamp = QDateTime(), .lane = i, .field = "f", .previous = "", .current = ""});
+	}
+
+	QCOMPARE(log.capacity(), 4);
+	QCOMPARE(log.count(), 4);
+
+	// the oldest events were overwritten, the order is kept across the wrap
+	const QVector<JesdLinkEvent> events = log.events();
+	QCOMPARE(events.size(), 4);
+	for(int i = 0; i < 4; i++) {
+		QCOMPARE(events[i].id, quint64(7 + i));
+		QCOMPARE(events[i].lane, 6 + i);
+	}
+
+	const QVector<JesdLinkEvent> since = log.eventsSince(8);
+	QCOMPARE(since.size(), 2);
+	QCOMPARE(since[0].id, quint64(9));
+	QCOMPARE(since[1].id, quint64(10));
+
+	log.clear();
+	QCOMPARE(log.count(), 0);
+	QVERIFY(log.events().isEmpty());
+}
+
+void TST_JesdStatusParser::csv()
+{
+	JesdLinkEventLog log;
+	const QDateTime t(QDate(2024, 5, 6), QTime(7, 8, 9, 10));
+	log.append({.id = 0, .timestamp = t, .lane = -1, .field = "Link status", .previous = "DATA", .current = "CGS"});
+	log.append({.id = 0, .timestamp = t, .lane = 2, .field = "Errors", .previous = "0", .current = "3"});
+
+	const QStringList lines = log.toCsv().split('\n', Qt::SkipEmptyParts);
+	QCOMPARE(lines.size(), 3);
+	QCOMPARE(lines[0], QString("Timestamp,Lane,Field,Previous,Current"));
+	QCOMPARE(lines[1], t.toString(Qt::ISODateWithMs) + ",link,Link status,DATA,CGS");
+	QCOMPARE(lines[2], t.toString(Qt::ISODateWithMs) + ",2,Errors,0,3");
+}
+
+QTEST_MAIN(TST_JesdStatusParser)
+
+#include "tst_jesdstatusparser.moc"
@@ -26,6 +26,7 @@
 #include "bubblelevelrenderer.hpp"
 #include "imuanalyzersettings.hpp"
 #include "datavisualizer.hpp"
+#include "orientationfilter.hpp"
 
 #include <QLineEdit>
 #include <QObject>
@@ -49,6 +50,7 @@
 #include <QStackedLayout>
 #include <measurementpanel.h>
 #include <math.h>
+#include <chrono>
 
 namespace scopy {
 
@@ -72,6 +74,24 @@ public:
 	void initIIODevice();
 
 private:
+	typedef struct ImuChannel
+	{
+		iio_channel *ch = nullptr;
+		double scale = 1.0;
+		double offset = 0.0;
+
+		float convert(double raw) const { return float((raw + offset) * scale); }
+	} ImuChannel;
+
+	ImuChannel findChannel(const char *name);
+	bool hasGyro() const;
+	bool generateRotationBuffered();
+	void generateRotationPolled();
+	void publish(float temp, bool force);
+	static double sample(iio_channel *ch, const void *src);
+
+	static constexpr int DISPLAY_RATE_HZ = 60;
+
 	ToolTemplate *m_tool;
 
 	InfoBtn *m_infoBtn;
@@ -88,6 +108,12 @@ private:
 	data3P m_rot = {0.0f, 0.0f, 0.0f};
 	data3P m_dist = {0.0f, 0.0f, 0.0f};
 
+	ImuChannel m_accel[3];
+	ImuChannel m_gyro[3];
+	ImuChannel m_temp;
+	OrientationFilter m_filter;
+	std::chrono::steady_clock::time_point m_lastPublish;
+
 	std::atomic<bool> m_runThread{false};
 	std::thread t;
 	QString m_uri;
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORIENTATIONFILTER_H
+#define ORIENTATIONFILTER_H
+
+#include "scopy-imuanalyzer_export.h"
+#include "imuanalyzerutils.hpp"
+
+namespace scopy {
+
+/*
+ * Fixed-step complementary filter. The gyroscope rate is integrated for the
+ * short term response and the tilt derived from the accelerometer slowly
+ * pulls pitch and roll back, removing the gyroscope drift. Without gyroscope
+ * data the accelerometer tilt is low-pass filtered with the same time constant.
+ * Rotations are in degrees, gyroscope rates in rad/s.
+ */
+class SCOPY_IMUANALYZER_EXPORT OrientationFilter
+{
+public:
+	OrientationFilter(float timeConstant = 0.5f);
+	~OrientationFilter();
+
+	void setTimeConstant(float seconds);
+	float timeConstant() const;
+
+	void reset();
+	void update(const data3P &accel, float dt);
+	void update(const data3P &accel, const data3P &gyro, float dt);
+
+	data3P rotation() const;
+
+private:
+	static data3P accelTilt(const data3P &accel);
+	static float wrap(float angle);
+
+	float m_timeConstant;
+	bool m_initialized;
+	data3P m_rot;
+};
+} // namespace scopy
+
+#endif // ORIENTATIONFILTER_H
@@ -22,6 +22,8 @@
 
 #include <pluginbase/preferences.h>
 
+#include <algorithm>
+
 using namespace scopy;
 
 Q_DECLARE_METATYPE(data3P)
@@ -102,11 +104,12 @@ IMUAnalyzerInterface::IMUAnalyzerInterface(QString uri, QWidget *parent)
 	});
 
 	connect(m_runBtn, &QPushButton::toggled, [=, this](bool toggled) {
-		m_runThread = !m_runThread;
+		m_runThread = toggled;
+		if(t.joinable()) {
+			t.join();
+		}
 		if(toggled) {
 			t = std::thread(&IMUAnalyzerInterface::generateRotation, this);
-		} else {
-			t.join();
 		}
 		Q_EMIT runBtnPressed(toggled);
 	});
@@ -148,55 +151,233 @@ IMUAnalyzerInterface::~IMUAnalyzerInterface()
 
 void IMUAnalyzerInterface::runToggled(bool toggled) { m_runBtn->setChecked(toggled); }
 
+IMUAnalyzerInterface::ImuChannel IMUAnalyzerInterface::findChannel(const char *name)
+{
+	ImuChannel ch;
+	ch.ch = iio_device_find_channel(m_device, name, false);
+	if(ch.ch != nullptr) {
+		iio_channel_attr_read_double(ch.ch, "scale", &ch.scale);
+		if(iio_channel_attr_read_double(ch.ch, "offset", &ch.offset) < 0) {
+			ch.offset = 0;
+		}
+	}
+	return ch;
+}
+
 void IMUAnalyzerInterface::generateRotation()
 {
+	m_accel[0] = findChannel("accel_x");
+	m_accel[1] = findChannel("accel_y");
+	m_accel[2] = findChannel("accel_z");
+	m_gyro[0] = findChannel("anglvel_x");
+	m_gyro[1] = findChannel("anglvel_y");
+	m_gyro[2] = findChannel("anglvel_z");
+	m_temp = findChannel("temp0");
+
+	m_filter.reset();
+	m_lastPublish = std::chrono::steady_clock::time_point();
+
+	// attribute polling is kept for devices (or contexts) without buffer support
+	if(!generateRotationBuffered()) {
+		generateRotationPolled();
+	}
 
-	iio_channel *linearAccChX = iio_device_find_channel(m_device, "accel_x", false);
-	iio_channel *linearAccChY = iio_device_find_channel(m_device, "accel_y", false);
-	iio_channel *linearAccChZ = iio_device_find_channel(m_device, "accel_z", false);
+	// the acquisition stopped on its own (device lost), release the run button
+	if(m_runThread.exchange(false)) {
+		QMetaObject::invokeMethod(this, "runToggled", Qt::QueuedConnection, Q_ARG(bool, false));
+	}
+}
 
-	iio_channel *tempCh = iio_device_find_channel(m_device, "temp0", false);
+bool IMUAnalyzerInterface::hasGyro() const
+{
+	return m_gyro[0].ch != nullptr && m_gyro[1].ch != nullptr && m_gyro[2].ch != nullptr;
+}
 
-	double samplingFreq;
-	iio_device_attr_read_double(m_device, "sampling_frequency", &samplingFreq);
+bool IMUAnalyzerInterface::generateRotationBuffered()
+{
+	for(const ImuChannel &c : m_accel) {
+		if(c.ch == nullptr || !iio_channel_is_scan_element(c.ch)) {
+			return false;
+		}
+	}
+
+	bool useGyro = hasGyro();
+	for(const ImuChannel &c : m_gyro) {
+		useGyro = useGyro && iio_channel_is_scan_element(c.ch);
+	}
+	bool bufferedTemp = m_temp.ch != nullptr && iio_channel_is_scan_element(m_temp.ch);
+
+	double samplingFreq = 0;
+	if(iio_device_attr_read_double(m_device, "sampling_frequency", &samplingFreq) < 0 || samplingFreq <= 0) {
+		return false;
+	}
 
-	double linearAccGainX, linearAccGainY, linearAccGainZ;
-	iio_channel_attr_read_double(linearAccChX, "scale", &linearAccGainX);
-	iio_channel_attr_read_double(linearAccChY, "scale", &linearAccGainY);
-	iio_channel_attr_read_double(linearAccChZ, "scale", &linearAccGainZ);
+	QList<iio_channel *> enabled;
+	for(const ImuChannel &c : m_accel) {
+		enabled.append(c.ch);
+	}
+	if(useGyro) {
+		for(const ImuChannel &c : m_gyro) {
+			enabled.append(c.ch);
+		}
+	}
+	if(bufferedTemp) {
+		enabled.append(m_temp.ch);
+	}
+	for(iio_channel *ch : qAsConst(enabled)) {
+		iio_channel_enable(ch);
+	}
 
-	double tempGain, tempOffset;
-	if(tempCh != nullptr) {
-		iio_channel_attr_read_double(tempCh, "scale", &tempGain);
-		iio_channel_attr_read_double(tempCh, "offset", &tempOffset);
+	// one refill per displayed frame - the filter still runs on every sample
+	size_t samples = std::max<size_t>(1, samplingFreq / DISPLAY_RATE_HZ);
+	iio_buffer *buf = iio_device_create_buffer(m_device, samples, false);
+	if(buf == nullptr) {
+		for(iio_channel *ch : qAsConst(enabled)) {
+			iio_channel_disable(ch);
+		}
+		return false;
 	}
 
+	const float dt = 1.0 / samplingFreq;
+	double temp = 0;
+	bool refilled = true;
+
+	while(m_runThread) {
+		if(iio_buffer_refill(buf) < 0) {
+			refilled = false;
+			break;
+		}
+
+		ptrdiff_t step = iio_buffer_step(buf);
+		uintptr_t end = (uintptr_t)iio_buffer_end(buf);
+		uintptr_t accelPtr[3], gyroPtr[3];
+		for(int i = 0; i < 3; i++) {
+			accelPtr[i] = (uintptr_t)iio_buffer_first(buf, m_accel[i].ch);
+			gyroPtr[i] = useGyro ? (uintptr_t)iio_buffer_first(buf, m_gyro[i].ch) : 0;
+		}
+
+		for(; accelPtr[0] < end; accelPtr[0] += step, accelPtr[1] += step, accelPtr[2] += step) {
+			m_dist.dataX = m_accel[0].convert(sample(m_accel[0].ch, (void *)accelPtr[0]));
+			m_dist.dataY = m_accel[1].convert(sample(m_accel[1].ch, (void *)accelPtr[1]));
+			m_dist.dataZ = m_accel[2].convert(sample(m_accel[2].ch, (void *)accelPtr[2]));
+
+			if(useGyro) {
+				data3P gyro;
+				gyro.dataX = m_gyro[0].convert(sample(m_gyro[0].ch, (void *)gyroPtr[0]));
+				gyro.dataY = m_gyro[1].convert(sample(m_gyro[1].ch, (void *)gyroPtr[1]));
+				gyro.dataZ = m_gyro[2].convert(sample(m_gyro[2].ch, (void *)gyroPtr[2]));
+				for(int i = 0; i < 3; i++) {
+					gyroPtr[i] += step;
+				}
+				m_filter.update(m_dist, gyro, dt);
+			} else {
+				m_filter.update(m_dist, dt);
+			}
+		}
+
+		if(bufferedTemp) {
+			void *last = (uint8_t *)iio_buffer_first(buf, m_temp.ch) + (samples - 1) * step;
+			temp = sample(m_temp.ch, last) * m_temp.scale - m_temp.offset;
+		} else if(m_temp.ch != nullptr) {
+			iio_channel_attr_read_double(m_temp.ch, "raw", &temp);
+			temp = temp * m_temp.scale - m_temp.offset;
+		}
+
+		publish(float(temp), true);
+	}
+
+	iio_buffer_destroy(buf);
+	for(iio_channel *ch : qAsConst(enabled)) {
+		iio_channel_disable(ch);
+	}
+
+	// a failed refill falls back to attribute polling
+	return refilled;
+}
+
+void IMUAnalyzerInterface::generateRotationPolled()
+{
+	for(const ImuChannel &c : m_accel) {
+		if(c.ch == nullptr) {
+			return;
+		}
+	}
+
+	bool useGyro = hasGyro();
 	double linearAccX, linearAccY, linearAccZ;
-	double temp;
+	double gyroX, gyroY, gyroZ;
+	double temp = 0;
+	auto last = std::chrono::steady_clock::now();
 
 	while(m_runThread) {
 
-		iio_channel_attr_read_double(linearAccChX, "raw", &linearAccX);
-		iio_channel_attr_read_double(linearAccChY, "raw", &linearAccY);
-		iio_channel_attr_read_double(linearAccChZ, "raw", &linearAccZ);
+		if(iio_channel_attr_read_double(m_accel[0].ch, "raw", &linearAccX) < 0 ||
+		   iio_channel_attr_read_double(m_accel[1].ch, "raw", &linearAccY) < 0 ||
+		   iio_channel_attr_read_double(m_accel[2].ch, "raw", &linearAccZ) < 0) {
+			return;
+		}
+
+		m_dist.dataX = m_accel[0].convert(linearAccX);
+		m_dist.dataY = m_accel[1].convert(linearAccY);
+		m_dist.dataZ = m_accel[2].convert(linearAccZ);
+
+		auto now = std::chrono::steady_clock::now();
+		float dt = std::chrono::duration<float>(now - last).count();
+		last = now;
 
-		m_dist.dataX = float(linearAccX * linearAccGainX);
-		m_dist.dataY = float(linearAccY * linearAccGainY);
-		m_dist.dataZ = float(linearAccZ * linearAccGainZ);
+		if(useGyro) {
+			iio_channel_attr_read_double(m_gyro[0].ch, "raw", &gyroX);
+			iio_channel_attr_read_double(m_gyro[1].ch, "raw", &gyroY);
+			iio_channel_attr_read_double(m_gyro[2].ch, "raw", &gyroZ);
 
-		if(tempCh != nullptr) {
-			iio_channel_attr_read_double(tempCh, "raw", &temp);
-			temp = temp * tempGain - tempOffset;
+			data3P gyro = {m_gyro[0].convert(gyroX), m_gyro[1].convert(gyroY), m_gyro[2].convert(gyroZ)};
+			m_filter.update(m_dist, gyro, dt);
+		} else {
+			m_filter.update(m_dist, dt);
+		}
+
+		if(m_temp.ch != nullptr) {
+			iio_channel_attr_read_double(m_temp.ch, "raw", &temp);
+			temp = temp * m_temp.scale - m_temp.offset;
 		}
 
-		m_rot.dataX = atan2(-m_dist.dataX, sqrt(m_dist.dataY * m_dist.dataY + m_dist.dataZ * m_dist.dataZ)) *
-			180 / 3.14f;
-		m_rot.dataY = atan2(m_dist.dataY, m_dist.dataZ) * 180 / 3.14f;
-		m_rot.dataZ = 0;
+		publish(float(temp), false);
+	}
+}
+
+void IMUAnalyzerInterface::publish(float temp, bool force)
+{
+	// decimate to the display rate so the renderers are not flooded with queued events
+	auto now = std::chrono::steady_clock::now();
+	if(!force && now - m_lastPublish < std::chrono::milliseconds(1000 / DISPLAY_RATE_HZ)) {
+		return;
+	}
+	m_lastPublish = now;
+
+	m_rot = m_filter.rotation();
+
+	QMetaObject::invokeMethod(this, "generateRot", Qt::QueuedConnection, Q_ARG(data3P, m_rot));
+	QMetaObject::invokeMethod(this, "updateValues", Qt::QueuedConnection, Q_ARG(data3P, m_rot),
+				  Q_ARG(data3P, m_dist), Q_ARG(float, temp));
+}
 
-		QMetaObject::invokeMethod(this, "generateRot", Qt::QueuedConnection, Q_ARG(data3P, m_rot));
-		QMetaObject::invokeMethod(this, "updateValues", Qt::QueuedConnection, Q_ARG(data3P, m_rot),
-					  Q_ARG(data3P, m_dist), Q_ARG(float, float(temp)));
+double IMUAnalyzerInterface::sample(iio_channel *ch, const void *src)
+{
+	const iio_data_format *fmt = iio_channel_get_data_format(ch);
+	uint8_t dst[8] = {0};
+	iio_channel_convert(ch, dst, src);
+
+	switch(fmt->length / 8) {
+	case 1:
+		return fmt->is_signed ? double(*(int8_t *)dst) : double(*(uint8_t *)dst);
+	case 2:
+		return fmt->is_signed ? double(*(int16_t *)dst) : double(*(uint16_t *)dst);
+	case 4:
+		return fmt->is_signed ? double(*(int32_t *)dst) : double(*(uint32_t *)dst);
+	case 8:
+		return fmt->is_signed ? double(*(int64_t *)dst) : double(*(uint64_t *)dst);
+	default:
+		return 0;
 	}
 }
 
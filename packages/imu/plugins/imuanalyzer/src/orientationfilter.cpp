@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2025 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "orientationfilter.hpp"
+
+#include <math.h>
+
+using namespace scopy;
+
+static constexpr float RAD_TO_DEG = 180.0f / float(M_PI);
+
+OrientationFilter::OrientationFilter(float timeConstant)
+	: m_timeConstant(timeConstant)
+{
+	reset();
+}
+
+OrientationFilter::~OrientationFilter() {}
+
+void OrientationFilter::setTimeConstant(float seconds) { m_timeConstant = seconds; }
+
+float OrientationFilter::timeConstant() const { return m_timeConstant; }
+
+void OrientationFilter::reset()
+{
+	m_initialized = false;
+	m_rot = {0.0f, 0.0f, 0.0f};
+}
+
+data3P OrientationFilter::rotation() const { return m_rot; }
+
+data3P OrientationFilter::accelTilt(const data3P &accel)
+{
+	data3P tilt;
+	tilt.dataX = atan2(-accel.dataX, sqrt(accel.dataY * accel.dataY + accel.dataZ * accel.dataZ)) * RAD_TO_DEG;
+	tilt.dataY = atan2(accel.dataY, accel.dataZ) * RAD_TO_DEG;
+	tilt.dataZ = 0.0f;
+	return tilt;
+}
+
+float OrientationFilter::wrap(float angle)
+{
+	while(angle > 180.0f) {
+		angle -= 360.0f;
+	}
+	while(angle < -180.0f) {
+		angle += 360.0f;
+	}
+	return angle;
+}
+
+void OrientationFilter::update(const data3P &accel, float dt)
+{
+	data3P tilt = accelTilt(accel);
+	if(!m_initialized || dt <= 0) {
+		m_rot = tilt;
+		m_initialized = true;
+		return;
+	}
+
+	float k = dt / (m_timeConstant + dt);
+	m_rot.dataX = wrap(m_rot.dataX + k * wrap(tilt.dataX - m_rot.dataX));
+	m_rot.dataY = wrap(m_rot.dataY + k * wrap(tilt.dataY - m_rot.dataY));
+}
+
+void OrientationFilter::update(const data3P &accel, const data3P &gyro, float dt)
+{
+	data3P tilt = accelTilt(accel);
+	if(!m_initialized || dt <= 0) {
+		m_rot = tilt;
+		m_initialized = true;
+		return;
+	}
+
+	// pitch rotates around the Y axis, roll around the X axis
+	float pitch = m_rot.dataX + gyro.dataY * RAD_TO_DEG * dt;
+	float roll = m_rot.dataY + gyro.dataX * RAD_TO_DEG * dt;
+
+	float k = dt / (m_timeConstant + dt);
+	m_rot.dataX = wrap(pitch + k * wrap(tilt.dataX - pitch));
+	m_rot.dataY = wrap(roll + k * wrap(tilt.dataY - roll));
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <QTest>
+
+#include <imuanalyzer/orientationfilter.hpp>
+#include <math.h>
+
+using namespace scopy;
+
+class TST_OrientationFilter : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void initialTilt();
+	void accelConvergence();
+	void gyroBiasDrift();
+	void rotationTracking();
+};
+
+#define G 9.80665f
+#define RATE_HZ 1000
+#define DT (1.0f / RATE_HZ)
+
+static constexpr float DEG_TO_RAD = float(M_PI) / 180.0f;
+
+// accelerometer reading of a device at rest with the given pitch and roll (degrees)
+static data3P gravity(float pitch, float roll)
+{
+	pitch *= DEG_TO_RAD;
+	roll *= DEG_TO_RAD;
+	return {-G * sinf(pitch), G * cosf(pitch) * sinf(roll), G * cosf(pitch) * cosf(roll)};
+}
+
+void TST_OrientationFilter::initialTilt()
+{
+	OrientationFilter filter;
+	filter.update(gravity(20, -35), {0, 0, 0}, DT);
+
+	// the first sample initializes the pose to the accelerometer tilt
+	QVERIFY(fabs(filter.rotation().dataX - 20) < 1e-3);
+	QVERIFY(fabs(filter.rotation().dataY + 35) < 1e-3);
+}
+
+void TST_OrientationFilter::accelConvergence()
+{
+	OrientationFilter filter(0.5f);
+	filter.update(gravity(0, 0), DT);
+
+	// a step in tilt is followed with the filter time constant: ~e^-10 left after 5 s
+	const data3P tilted = gravity(30, 45);
+	for(int i = 0; i < 5 * RATE_HZ; i++) {
+		filter.update(tilted, DT);
+	}
+	QVERIFY2(fabs(filter.rotation().dataX - 30) < 0.01, qPrintable(QString::number(filter.rotation().dataX)));
+	QVERIFY2(fabs(filter.rotation().dataY - 45) < 0.01, qPrintable(QString::number(filter.rotation().dataY)));
+
+	// 1 - e^-1 of the step after one time constant
+	filter.reset();
+	filter.update(gravity(0, 0), DT);
+	for(int i = 0; i < RATE_HZ / 2; i++) {
+		filter.update(tilted, DT);
+	}
+	QVERIFY(fabs(filter.rotation().dataX - 30 * (1 - expf(-1))) < 0.5);
+}
+
+void TST_OrientationFilter::gyroBiasDrift()
+{
+	OrientationFilter filter(0.5f);
+	const data3P level = gravity(0, 0);
+	// a constant gyroscope bias on both tilt axes, a device at rest
+	const float bias = 0.01f;
+	const data3P gyro = {bias, bias, 0};
+
+	// integrated alone, the bias would drift 0.57 degrees every second
+	float error30 = 0;
+	for(int i = 0; i < 60 * RATE_HZ; i++) {
+		filter.update(level, gyro, DT);
+		if(i == 30 * RATE_HZ) {
+			error30 = filter.rotation().dataY;
+		}
+	}
+
+	// the accelerometer bounds the error to bias * timeConstant
+	const float bound = bias * filter.timeConstant() / DEG_TO_RAD;
+	const data3P rot = filter.rotation();
+	QVERIFY2(fabs(rot.dataX) < bound * 1.1f, qPrintable(QString::number(rot.dataX)));
+	QVERIFY2(fabs(rot.dataY) < bound * 1.1f, qPrintable(QString::number(rot.dataY)));
+	QVERIFY(fabs(rot.dataY - error30) < 1e-3);
+}
+
+void TST_OrientationFilter::rotationTracking()
+{
+	OrientationFilter filter(0.5f);
+	// roll at 0.5 rad/s for 1 second, gyroscope and accelerometer agree
+	const float rate = 0.5f;
+	filter.update(gravity(0, 0), {rate, 0, 0}, DT);
+	for(int i = 1; i <= RATE_HZ; i++) {
+		const float roll = rate * i * DT / DEG_TO_RAD;
+		filter.update(gravity(0, roll), {rate, 0, 0}, DT);
+	}
+
+	const float expected = rate / DEG_TO_RAD;
+	QVERIFY2(fabs(filter.rotation().dataY - expected) < 0.1, qPrintable(QString::number(filter.rotation().dataY)));
+	QVERIFY(fabs(filter.rotation().dataX) < 0.1);
+}
+
+QTEST_MAIN(TST_OrientationFilter)
+
+#include "tst_orientationfilter.moc"
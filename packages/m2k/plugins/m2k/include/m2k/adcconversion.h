@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ADCCONVERSION_H
+#define ADCCONVERSION_H
+
+#include "scopy-m2k_export.h"
+
+#include <cstddef>
+#include <functional>
+
+namespace scopy::m2k {
+
+/*
+ * AdcConversion turns the raw shorts of an M2K ADC buffer into volts in a
+ * single pass.
+ *
+ * libm2k converts one sample per call, looking up the calibration gain, the
+ * hardware range, the filter compensation and the vertical offset every time,
+ * and the oscilloscope fed it with floats from a separate short_to_float stage.
+ * The conversion is linear in the raw code, so fit() evaluates it at a few codes
+ * once per buffer and convert() applies the resulting gain and offset straight
+ * from the device shorts in a plain vectorizable loop.
+ */
+class SCOPY_M2K_EXPORT AdcConversion
+{
+public:
+	// volts of a raw sample of a channel, e.g. M2kAnalogIn::convertRawToVolts
+	typedef std::function<double(unsigned int, short)> Function;
+
+	typedef struct
+	{
+		double gain;
+		double offset;
+	} Coefficients;
+
+	// false if the conversion of the channel is not linear in the raw code
+	static bool fit(const Function &conversion, unsigned int channel, Coefficients &c);
+
+	static void convert(const short *in, float *out, size_t count, const Coefficients &c);
+	// per sample fallback for conversions fit() rejected
+	static void convert(const short *in, float *out, size_t count, const Function &conversion,
+			    unsigned int channel);
+};
+
+} // namespace scopy::m2k
+
+#endif // ADCCONVERSION_H
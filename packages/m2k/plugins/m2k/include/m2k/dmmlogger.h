@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef DMMLOGGER_H
+#define DMMLOGGER_H
+
+#include "scopy-m2k_export.h"
+
+#include <QFile>
+#include <QString>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace scopy::m2k {
+
+/*
+ * DmmLogger writes the Voltmeter readings to a file without ever blocking the
+ * caller.
+ *
+ * push() only appends the record to a bounded queue. A writer thread takes the
+ * whole queue at once, formats the batch and writes it with a single call,
+ * flushing and syncing the file at configurable intervals. When the queue is
+ * full the record is dropped and counted, the GUI thread never waits for the
+ * disk.
+ *
+ * Records carry the timestamp of the samples they were computed from. With a
+ * logging interval set, push() keeps the first record at or after every
+ * multiple of the interval, on that sample time base, so the logged rows don't
+ * drift however late the records are delivered.
+ *
+ * The CSV format is the one the Voltmeter always wrote. The binary format is a
+ * 16 byte header ("SCPYDMM1", version, number of values) followed by fixed
+ * size little endian records: an int64 timestamp in ns since the epoch and
+ * the values as doubles, NaN for the readings of the other mode.
+ */
+class SCOPY_M2K_EXPORT DmmLogger
+{
+public:
+	typedef enum
+	{
+		DL_CSV,
+		DL_BINARY
+	} Format;
+
+	// channel 0 DC, channel 0 AC, channel 1 DC, channel 1 AC
+	static constexpr int NR_OF_VALUES = 4;
+
+	typedef struct
+	{
+		// ns since the epoch
+		int64_t timestamp;
+		double values[NR_OF_VALUES];
+	} Record;
+
+	DmmLogger();
+	~DmmLogger();
+
+	// the settings apply to the next start()
+	size_t capacity() const;
+	void setCapacity(size_t capacity);
+	int flushInterval() const;
+	// ms between flushes of the written rows, 0 flushes every batch
+	void setFlushInterval(int ms);
+	int syncInterval() const;
+	// ms between fsync calls, -1 never syncs, 0 syncs every flush
+	void setSyncInterval(int ms);
+
+	// ns between logged records, 0 logs every record. Can change while logging
+	int64_t interval() const;
+	void setInterval(int64_t ns);
+
+	// a new or overwritten file starts with the header of the format
+	bool start(const QString &path, Format format, bool append);
+	// writes whatever is queued and closes the file
+	void stop();
+	bool isRunning() const;
+
+	bool push(const Record &record);
+
+	uint64_t written() const;
+	uint64_t dropped() const;
+	// the writer stopped on an error, see errorString()
+	bool failed() const;
+	QString errorString() const;
+
+	static Format formatForPath(const QString &path);
+
+private:
+	void writerThread();
+	bool writeBatch(const std::vector<Record> &batch);
+	void writeHeader();
+
+	QFile m_file;
+	Format m_format;
+	std::thread m_thread;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_cond;
+	std::vector<Record> m_queue;
+	bool m_stop;
+	bool m_running;
+
+	size_t m_capacity;
+	int m_flushInterval;
+	int m_syncInterval;
+	std::atomic<int64_t> m_interval;
+	int64_t m_next;
+
+	std::atomic<uint64_t> m_written;
+	std::atomic<uint64_t> m_dropped;
+	std::atomic<bool> m_failed;
+	QString m_error;
+};
+
+} // namespace scopy::m2k
+
+#endif // DMMLOGGER_H
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef DMMSTATS_H
+#define DMMSTATS_H
+
+#include "scopy-m2k_export.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace scopy::m2k {
+
+/*
+ * DmmStats computes the Voltmeter readouts of a raw ADC stream in a single
+ * pass: DC (mean), AC RMS (standard deviation), true RMS, min and max.
+ *
+ * Samples are accumulated in blocks with exact integer sums, so the inner loop
+ * is a plain vectorizable reduction over the raw shorts. Every full block is
+ * folded into double precision mean / sum of squared deviations accumulators
+ * with the pairwise (Chan) update, which keeps the variance accurate for
+ * arbitrarily long windows and large DC offsets.
+ */
+class SCOPY_M2K_EXPORT DmmStats
+{
+public:
+	typedef struct
+	{
+		double mean;
+		double acRms;
+		double rms;
+		double min;
+		double max;
+		uint64_t count;
+	} Stats;
+
+	DmmStats();
+	~DmmStats();
+
+	void reset();
+	void process(const short *in, size_t count);
+	uint64_t count() const;
+	// the statistics of every sample processed since the last reset
+	Stats stats() const;
+
+	// one shot statistics of a buffer
+	static Stats compute(const short *in, size_t count);
+
+private:
+	void flush();
+
+	// exact sums of the current block
+	int64_t m_blockSum;
+	int64_t m_blockSumSq;
+	uint32_t m_blockCount;
+	short m_min;
+	short m_max;
+
+	uint64_t m_count;
+	double m_mean;
+	double m_m2;
+};
+
+} // namespace scopy::m2k
+
+#endif // DMMSTATS_H
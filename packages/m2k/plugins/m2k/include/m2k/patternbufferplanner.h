@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PATTERNBUFFERPLANNER_H
+#define PATTERNBUFFERPLANNER_H
+
+#include "scopy-m2k_export.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace scopy::m2k {
+
+/*
+ * PatternBufferPlanner picks the length of the cyclic Pattern Generator buffer.
+ *
+ * The exact length is the LCM of the pattern periods (computed from their
+ * prime factorizations, saturated at the maximum size) rounded up to cover the
+ * non periodic patterns. Coprime periods quickly make it too long to fit, or
+ * long enough to be slow to generate and push. When a tolerance is set, the
+ * planner looks for a shorter length that every periodic pattern divides after
+ * adjusting its period (in steps of its granularity) by at most that relative
+ * error - rate matching. Without a match, the buffer is clamped to the maximum
+ * size and patterns glitch at the wrap, as before.
+ *
+ * A plan reports the buffer memory and an estimate of the push time, so the
+ * caller can decide before generating anything.
+ */
+class SCOPY_M2K_EXPORT PatternBufferPlanner
+{
+public:
+	typedef struct
+	{
+		// samples per period of a periodic pattern, 0 for patterns that just need minSize samples
+		uint64_t period;
+		// the period can be rate matched to any multiple of granularity, 0 if it can't change
+		uint64_t granularity;
+		uint64_t minSize;
+	} Request;
+
+	typedef struct
+	{
+		uint64_t size;
+		// every periodic pattern wraps on a period boundary and every pattern fits
+		bool exact;
+		// the period of every request, rate matched periods differ from the requested ones
+		std::vector<uint64_t> periods;
+		// largest relative frequency error introduced by rate matching
+		double error;
+		uint64_t bytes;
+		// estimated time to push the buffer, in seconds
+		double pushTime;
+	} Plan;
+
+	PatternBufferPlanner();
+	~PatternBufferPlanner();
+
+	uint64_t minSize() const;
+	void setMinSize(uint64_t minSize);
+	uint64_t maxSize() const;
+	void setMaxSize(uint64_t maxSize);
+	// the buffer length is always a multiple of alignment
+	uint64_t alignment() const;
+	void setAlignment(uint64_t alignment);
+	// relative period error allowed for rate matching, 0 only allows exact lengths
+	double tolerance() const;
+	void setTolerance(double tolerance);
+	// bytes per second, used for the push time estimate
+	double throughput() const;
+	void setThroughput(double throughput);
+
+	Plan plan(const std::vector<Request> &requests) const;
+
+	// prime factors with their powers, in increasing order
+	static std::vector<std::pair<uint64_t, int>> factorize(uint64_t n);
+	// saturates to limit + 1 when the lcm is larger than limit
+	static uint64_t lcm(const std::vector<uint64_t> &values, uint64_t limit);
+
+private:
+	bool rateMatch(const std::vector<Request> &requests, uint64_t from, uint64_t to, Plan &plan) const;
+	void finish(Plan &plan) const;
+
+	uint64_t m_minSize;
+	uint64_t m_maxSize;
+	uint64_t m_alignment;
+	double m_tolerance;
+	double m_throughput;
+};
+
+} // namespace scopy::m2k
+
+#endif // PATTERNBUFFERPLANNER_H
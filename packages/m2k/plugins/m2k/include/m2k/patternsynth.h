@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PATTERNSYNTH_H
+#define PATTERNSYNTH_H
+
+#include "scopy-m2k_export.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace scopy::m2k {
+
+/*
+ * PatternSynth merges the Pattern Generator patterns into the 16 bit samples
+ * pushed to the digital output.
+ *
+ * Every pattern is cached as bit-planes, one bit per sample and 64 samples per
+ * word for each of its channels, keyed by its parameters, the sample rate and
+ * the buffer size. A pattern is generated again only when its key changes.
+ * Periodic patterns are generated for a single period, which is then
+ * replicated over the buffer.
+ * Merging works on 64 sample blocks: each nibble of a plane is spread to four
+ * 16 bit lanes through a 16 entry table and shifted to its output channel, so
+ * the channel remapping costs one shift per 4 samples instead of a per sample,
+ * per bit loop.
+ *
+ * synthesize() returns false when the merged samples did not change, so the
+ * output doesn't need to be pushed (and restarted) again.
+ */
+class SCOPY_M2K_EXPORT PatternSynth
+{
+public:
+	// fills out with size samples, bit i of every sample is the i-th channel of the pattern
+	typedef std::function<void(short *out, uint32_t sampleRate, uint32_t size)> Generator;
+
+	typedef struct
+	{
+		// identifies the pattern between calls
+		const void *id;
+		// the pattern parameters. Empty if they can't be described, the pattern is then
+		// generated every time
+		std::string key;
+		// output channel of every pattern bit
+		std::vector<int> channels;
+		Generator generate;
+		// samples per period of a pattern that wraps exactly in the buffer. Only one period
+		// is generated and then replicated. 0 generates the whole buffer
+		uint32_t period;
+	} Pattern;
+
+	PatternSynth();
+	~PatternSynth();
+
+	// a channel mapped by more than one pattern is driven by the last one
+	bool synthesize(const std::vector<Pattern> &patterns, uint32_t sampleRate, uint32_t size);
+
+	uint16_t *data();
+	uint32_t size() const;
+	// patterns generated by the last synthesize() call
+	int generated() const;
+	void clear();
+
+	// repeats the first period samples of buffer up to size
+	static void replicate(short *buffer, uint32_t period, uint32_t size);
+	// planes holds nrOfPlanes * ceil(size / 64) words, plane after plane
+	static void toPlanes(const short *in, uint32_t size, int nrOfPlanes, uint64_t *planes);
+	// out holds ceil(size / 64) * 64 samples
+	static void merge(const uint64_t *const *planes, const int *channels, int nrOfPlanes, uint32_t size,
+			  uint16_t *out);
+
+private:
+	struct Entry
+	{
+		std::string key;
+		uint32_t sampleRate;
+		uint32_t size;
+		uint32_t period;
+		int nrOfPlanes;
+		uint64_t generation;
+		std::vector<uint64_t> planes;
+	};
+
+	// what drives every output channel: the generation of the plane and its index
+	typedef std::vector<std::pair<uint64_t, int>> Signature;
+
+	std::map<const void *, Entry> m_cache;
+	Signature m_signature;
+	uint64_t m_generation;
+	uint32_t m_sampleRate;
+	uint32_t m_size;
+	int m_generated;
+	std::vector<short> m_scratch;
+	std::vector<uint16_t> m_out;
+};
+
+} // namespace scopy::m2k
+
+#endif // PATTERNSYNTH_H
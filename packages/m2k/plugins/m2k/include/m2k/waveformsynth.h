@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WAVEFORMSYNTH_H
+#define WAVEFORMSYNTH_H
+
+#include "scopy-m2k_export.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace scopy::m2k {
+
+/*
+ * WaveformSynth renders the Signal Generator waveforms straight into a sample
+ * buffer, without building a GNU Radio flowgraph.
+ *
+ * A channel is described as a list of tones combined in order (set, added or
+ * multiplied into the buffer, so sums and amplitude modulated variants are
+ * just more tones), optional noise and an output gain/rail. Sine waves run the
+ * gr::fxpt phase accumulator and sine table exactly as gr::analog::sig_source_f
+ * does, so they match it bit for bit. Trapezoidal waves (square, triangle, saw)
+ * are rendered one linear segment at a time, so every inner loop is a plain
+ * vectorizable ramp.
+ *
+ * render() keeps the last buffer and returns it untouched while the channel
+ * description does not change, so only the channel whose knob moved is
+ * synthesized again.
+ */
+class SCOPY_M2K_EXPORT WaveformSynth
+{
+public:
+	typedef enum
+	{
+		WS_CONSTANT,
+		WS_SINE,
+		// rise, high, fall, low segments. Square, triangle and saw waves are special cases
+		WS_TRAPEZOIDAL,
+		// table played cyclically, one entry per sample
+		WS_TABLE
+	} Shape;
+
+	typedef enum
+	{
+		WS_SET,
+		WS_ADD,
+		WS_MULTIPLY
+	} Op;
+
+	typedef enum
+	{
+		WS_NO_NOISE,
+		WS_UNIFORM,
+		WS_GAUSSIAN,
+		WS_LAPLACIAN,
+		WS_IMPULSE
+	} Noise;
+
+	typedef struct
+	{
+		Shape shape;
+		double frequency;
+		double amplitude; // peak amplitude
+		double offset;
+		double phase; // radians
+		// relative durations of the trapezoidal segments
+		double rise;
+		double high;
+		double fall;
+		double low;
+		std::vector<float> table;
+	} Tone;
+
+	WaveformSynth();
+	~WaveformSynth();
+
+	void clear();
+	void addTone(const Tone &tone, Op op = WS_ADD);
+	// noise of the given standard amplitude, clamped to +/-limit
+	void setNoise(Noise type, double amplitude, double limit, uint32_t seed);
+	// as above, with a random seed. The seed of the last buffer is kept while the noise settings do not change,
+	// so other knobs still find the buffer cached, reseed() draws a new one
+	void setNoise(Noise type, double amplitude, double limit);
+	void reseed();
+	// applied last: the buffer is multiplied by gain and clamped to +/-limit
+	void setOutput(double gain, double limit);
+
+	const std::vector<float> &render(double sampleRate, size_t count);
+
+	static void renderTone(float *out, size_t count, double sampleRate, const Tone &tone, Op op = WS_SET);
+	static void renderNoise(float *out, size_t count, Noise type, double amplitude, double limit, uint32_t seed);
+	static void scaleClamp(float *out, size_t count, float gain, float limit);
+
+private:
+	struct Component
+	{
+		Tone tone;
+		Op op;
+	};
+
+	struct Description
+	{
+		std::vector<Component> components;
+		Noise noise;
+		double noiseAmplitude;
+		double noiseLimit;
+		uint32_t noiseSeed;
+		double gain;
+		double limit;
+		double sampleRate;
+		size_t count;
+	};
+
+	static bool equal(const Description &a, const Description &b);
+
+	Description m_desc;
+	Description m_rendered;
+	bool m_valid;
+	bool m_reseed;
+	std::vector<float> m_out;
+};
+
+} // namespace scopy::m2k
+
+#endif // WAVEFORMSYNTH_H
@@ -44,6 +44,7 @@
 
 #include "FftDisplayPlot.h"
 #include "TimeDomainDisplayPlot.h"
+#include "sampleblockpool.h"
 #include "scope_sink_f.h"
 #include "scopy-gui_export.h"
 
@@ -63,9 +64,11 @@ private:
 
 	int d_index, d_start, d_end;
 	std::vector<float *> d_fbuffers;
-	std::vector<double *> d_buffers;
 	std::vector<std::vector<gr::tag_t>> d_tags;
 
+	// frames are converted into pooled blocks that the plot takes over
+	SampleBlockPool d_pool;
+
 	QObject *plot;
 
 	gr::high_res_timer_type d_update_time;
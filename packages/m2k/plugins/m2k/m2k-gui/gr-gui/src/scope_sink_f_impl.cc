@@ -79,12 +79,10 @@ scope_sink_f_impl::scope_sink_f_impl(int size, double samp_rate, const std::stri
 	, d_index(0)
 	, d_start(0)
 	, d_end(size)
+	, d_pool(nconnections)
 {
 
 	for(int n = 0; n < d_nconnections; n++) {
-		d_buffers.push_back((double *)volk_malloc(d_buffer_size * sizeof(double), volk_get_alignment()));
-		memset(d_buffers[n], 0, d_buffer_size * sizeof(double));
-
 		d_fbuffers.push_back((float *)volk_malloc(d_buffer_size * sizeof(float), volk_get_alignment()));
 		memset(d_fbuffers[n], 0, d_buffer_size * sizeof(float));
 
@@ -115,7 +113,6 @@ scope_sink_f_impl::scope_sink_f_impl(int size, double samp_rate, const std::stri
 scope_sink_f_impl::~scope_sink_f_impl()
 {
 	for(int n = 0; n < d_nconnections; n++) {
-		volk_free(d_buffers[n]);
 		volk_free(d_fbuffers[n]);
 	}
 }
@@ -166,10 +163,6 @@ void scope_sink_f_impl::set_nsamps(const int newsize)
 
 		// Resize buffers and replace data
 		for(int n = 0; n < d_nconnections; n++) {
-			volk_free(d_buffers[n]);
-			d_buffers[n] = (double *)volk_malloc(d_buffer_size * sizeof(double), volk_get_alignment());
-			memset(d_buffers[n], 0, d_buffer_size * sizeof(double));
-
 			volk_free(d_fbuffers[n]);
 			d_fbuffers[n] = (float *)volk_malloc(d_buffer_size * sizeof(float), volk_get_alignment());
 			memset(d_fbuffers[n], 0, d_buffer_size * sizeof(float));
@@ -261,10 +254,6 @@ void scope_sink_f_impl::clean_buffers()
 
 	// Resize buffers and replace data
 	for(int n = 0; n < d_nconnections; n++) {
-		volk_free(d_buffers[n]);
-		d_buffers[n] = (double *)volk_malloc(d_buffer_size * sizeof(double), volk_get_alignment());
-		memset(d_buffers[n], 0, d_buffer_size * sizeof(double));
-
 		volk_free(d_fbuffers[n]);
 		d_fbuffers[n] = (float *)volk_malloc(d_buffer_size * sizeof(float), volk_get_alignment());
 		memset(d_fbuffers[n], 0, d_buffer_size * sizeof(float));
@@ -303,7 +292,6 @@ int scope_sink_f_impl::work(int noutput_items, gr_vector_const_void_star &input_
 	for(n = 0; n < d_nconnections; n++) {
 		in = (const float *)input_items[idx];
 		memcpy(&d_fbuffers[n][d_index], &in[0], nitems * sizeof(float));
-		volk_32f_convert_64f(&d_buffers[n][d_index], &in[1], nitems);
 
 		uint64_t nr = nitems_read(idx);
 		std::vector<gr::tag_t> tags;
@@ -319,20 +307,14 @@ int scope_sink_f_impl::work(int noutput_items, gr_vector_const_void_star &input_
 	// If we've have a full d_size of items in the buffers, plot.
 	if((d_end != 0 && !d_displayOneBuffer) ||
 	   ((d_triggered) && (d_index == d_end) && d_end != 0 && d_displayOneBuffer)) {
-		// Copy data to be plotted to start of buffers.
-		for(n = 0; n < d_nconnections; n++) {
-			if(!d_displayOneBuffer) {
-				nItemsToSend = d_index;
-				if(nItemsToSend >= d_size) {
-					nItemsToSend = d_size;
-					d_cleanBuffers = false;
-				}
-				volk_32f_convert_64f(d_buffers[n], &d_fbuffers[n][d_start], nItemsToSend);
-			} else {
-				// memmove(d_buffers[n], &d_buffers[n][d_start], d_size*sizeof(double));
-				volk_32f_convert_64f(d_buffers[n], &d_fbuffers[n][d_start], d_size);
+		if(!d_displayOneBuffer) {
+			nItemsToSend = d_index;
+			if(nItemsToSend >= d_size) {
 				nItemsToSend = d_size;
+				d_cleanBuffers = false;
 			}
+		} else {
+			nItemsToSend = d_size;
 		}
 
 		// Plot if we are able to update
@@ -341,9 +323,15 @@ int scope_sink_f_impl::work(int noutput_items, gr_vector_const_void_star &input_
 			if(d_qApplication) {
 				qDebug() << QString::fromStdString(d_name);
 
-				d_qApplication->postEvent(
-					this->plot,
-					new IdentifiableTimeUpdateEvent(d_buffers, nItemsToSend, d_tags, d_name));
+				// Convert the frame straight into a block the plot takes over, frames
+				// that are dropped by the update rate are not converted at all.
+				std::shared_ptr<SampleBlock> block = d_pool.acquire(nItemsToSend);
+				for(n = 0; n < d_nconnections; n++) {
+					volk_32f_convert_64f(block->data(n), &d_fbuffers[n][d_start], nItemsToSend);
+				}
+
+				d_qApplication->postEvent(this->plot,
+							  new IdentifiableTimeUpdateEvent(block, d_tags, d_name));
 			}
 		}
 
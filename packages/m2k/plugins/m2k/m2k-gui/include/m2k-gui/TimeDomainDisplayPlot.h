@@ -109,8 +109,13 @@ public:
 			      int qwtAxis = QwtAxis::YLeft);
 	virtual ~TimeDomainDisplayPlot();
 
+	/*
+	 * When the points come in a block from a pool, the channel buffers are swapped with the block's
+	 * instead of copied and the previous ones go back to the pool with it.
+	 */
 	void plotNewData(const std::string &sender, const std::vector<double *> &dataPoints,
-			 const int64_t numDataPoints, const double timeInterval /*,
+			 const int64_t numDataPoints, const double timeInterval,
+			 const std::shared_ptr<SampleBlock> &block = nullptr /*,
 			  const std::vector< std::vector<gr::tag_t> > &tags \
 			  = std::vector< std::vector<gr::tag_t> >()*/
 	);
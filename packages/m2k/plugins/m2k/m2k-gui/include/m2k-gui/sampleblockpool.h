@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SAMPLEBLOCKPOOL_H
+#define SAMPLEBLOCKPOOL_H
+
+#include "scopy-m2k-gui_export.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace scopy {
+
+/*
+ * A frame of a time sink: one buffer of samples per channel, all of the same length.
+ * The buffers are plain new[] arrays, so a plot can take one over in exchange for a buffer it
+ * owns and keep deleting its buffers the way it always did.
+ */
+class SCOPY_M2K_GUI_EXPORT SampleBlock
+{
+public:
+	SampleBlock(size_t channels, size_t length);
+	~SampleBlock();
+
+	size_t channels() const;
+	size_t length() const;
+	double *data(size_t channel) const;
+	const std::vector<double *> &buffers() const;
+
+	// hands out the buffer of a channel and keeps buffer, a new[] array of length() items, instead
+	double *exchange(size_t channel, double *buffer);
+
+private:
+	std::vector<double *> m_buffers;
+	size_t m_length;
+};
+
+/*
+ * SampleBlockPool keeps the frames a sink sends to the GUI thread. A block is refilled by the sink,
+ * handed to the plot with its event and returns to the pool once the last reference to it is dropped,
+ * so a running acquisition stops allocating after the first few frames.
+ *
+ * acquire() and the release of a block can happen on any thread. Blocks may outlive the pool.
+ */
+class SCOPY_M2K_GUI_EXPORT SampleBlockPool
+{
+public:
+	// capacity is the number of free blocks kept, a frame in flight per block
+	SampleBlockPool(size_t channels, size_t capacity = 3);
+	~SampleBlockPool();
+
+	// a block of length items per channel, reused if one is free
+	std::shared_ptr<SampleBlock> acquire(size_t length);
+
+	// blocks allocated so far, a block reused is not counted again
+	size_t allocations() const;
+
+private:
+	struct State;
+	std::shared_ptr<State> m_state;
+};
+
+} // namespace scopy
+
+#endif // SAMPLEBLOCKPOOL_H
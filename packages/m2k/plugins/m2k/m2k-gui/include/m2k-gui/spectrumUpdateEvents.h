@@ -21,6 +21,7 @@
 #ifndef M2K_SPECTRUM_UPDATE_EVENTS_H
 #define M2K_SPECTRUM_UPDATE_EVENTS_H
 
+#include "sampleblockpool.h"
 #include "scopy-m2k-gui_export.h"
 #include <gnuradio/high_res_timer.h>
 #include <gnuradio/tags.h>
@@ -29,6 +30,7 @@
 #include <QString>
 
 #include <complex>
+#include <memory>
 #include <stdint.h>
 #include <vector>
 #include <volk/volk_alloc.hh>
@@ -118,6 +120,9 @@ class SCOPY_M2K_GUI_EXPORT TimeUpdateEvent : public QEvent
 public:
 	TimeUpdateEvent(const std::vector<double *> &timeDomainPoints, const uint64_t numTimeDomainDataPoints,
 			const std::vector<std::vector<gr::tag_t>> &tags);
+	// carries the block instead of copying it, the block goes back to its pool with the event
+	TimeUpdateEvent(const std::shared_ptr<scopy::SampleBlock> &block,
+			const std::vector<std::vector<gr::tag_t>> &tags);
 
 	~TimeUpdateEvent();
 
@@ -127,6 +132,7 @@ public:
 	bool getRepeatDataFlag() const;
 
 	const std::vector<std::vector<gr::tag_t>> getTags() const;
+	const std::shared_ptr<scopy::SampleBlock> &block() const;
 
 	static QEvent::Type Type() { return QEvent::Type(SpectrumUpdateEventType); }
 
@@ -136,6 +142,7 @@ private:
 	std::vector<double *> _dataTimeDomainPoints;
 	uint64_t _numTimeDomainDataPoints;
 	std::vector<std::vector<gr::tag_t>> _tags;
+	std::shared_ptr<scopy::SampleBlock> _block;
 };
 
 /********************************************************************/
@@ -146,6 +153,8 @@ public:
 	IdentifiableTimeUpdateEvent(const std::vector<double *> &timeDomainPoints,
 				    const uint64_t numTimeDomainDataPoints,
 				    const std::vector<std::vector<gr::tag_t>> &tags, const std::string &senderName);
+	IdentifiableTimeUpdateEvent(const std::shared_ptr<scopy::SampleBlock> &block,
+				    const std::vector<std::vector<gr::tag_t>> &tags, const std::string &senderName);
 
 	~IdentifiableTimeUpdateEvent();
 
@@ -46,6 +46,7 @@
 
 #include "osc_scale_engine.h"
 #include "smoothcurvefitter.h"
+#include <gui/lodplotcurve.h>
 
 #include <QColor>
 #include <QFont>
@@ -411,7 +412,7 @@ void TimeDomainDisplayPlot::replot() { BasicPlot::replot(); }
 
 void TimeDomainDisplayPlot::plotNewData(
 	const std::string &sender, const std::vector<double *> &dataPoints, const int64_t numDataPoints,
-	const double timeInterval
+	const double timeInterval, const std::shared_ptr<SampleBlock> &block
 	//				   const std::vector< std::vector<gr::tag_t> > &tags
 )
 {
@@ -447,12 +448,36 @@ void TimeDomainDisplayPlot::plotNewData(
 				reset_x_axis_points = false;
 			}
 
-			for(int i = 0; i < sinkNumChannels; i++) {
-				if(d_semilogy) {
-					for(int n = 0; n < numDataPoints; n++)
-						d_ydata[start + i][n] = fabs(dataPoints[i][n]);
-				} else {
-					memcpy(d_ydata[start + i], dataPoints[i], numDataPoints * sizeof(double));
+			bool adopt = block && block->channels() == sinkNumChannels && block->length() == numDataPoints;
+			if(adopt) {
+				int ref_offset = countReferenceWaveform(start);
+				for(int i = start; i < start + sinkNumChannels; i++) {
+					d_ydata[i] = block->exchange(i - start, d_ydata[i]);
+					if(d_semilogy) {
+						for(int n = 0; n < numDataPoints; n++)
+							d_ydata[i][n] = fabs(d_ydata[i][n]);
+					}
+
+					d_plot_curve[i + ref_offset]->setRawSamples(d_xdata[sinkIndex], d_ydata[i],
+										    numDataPoints);
+				}
+			} else {
+				for(int i = 0; i < sinkNumChannels; i++) {
+					if(d_semilogy) {
+						for(int n = 0; n < numDataPoints; n++)
+							d_ydata[start + i][n] = fabs(dataPoints[i][n]);
+					} else {
+						memcpy(d_ydata[start + i], dataPoints[i],
+						       numDataPoints * sizeof(double));
+					}
+				}
+			}
+
+			// the raw buffers were rewritten in place, the curves have to resummarize them
+			for(size_t i = 0; i < d_plot_curve.size(); i++) {
+				LodPlotCurve *lodCurve = dynamic_cast<LodPlotCurve *>(d_plot_curve.at(i));
+				if(lodCurve) {
+					lodCurve->invalidateLod();
 				}
 			}
 
@@ -502,7 +527,7 @@ void TimeDomainDisplayPlot::newData(const QEvent *updateEvent)
 		Q_EMIT filledScreen(true, numDataPoints);
 	}
 
-	this->plotNewData(sender, dataPoints, numDataPoints, 0);
+	this->plotNewData(sender, dataPoints, numDataPoints, 0, tevent->block());
 }
 
 void TimeDomainDisplayPlot::customEvent(QEvent *e)
@@ -1260,7 +1285,7 @@ bool TimeDomainDisplayPlot::registerSink(std::string sinkUniqueNme, unsigned int
 
 			QColor color = getChannelColor();
 
-			QwtPlotCurve *curve = new QwtPlotCurve(QString("Data %1").arg(n));
+			QwtPlotCurve *curve = new LodPlotCurve(QString("Data %1").arg(n));
 			curve->setPen(QPen(color));
 			curve->setRenderHint(QwtPlotItem::RenderAntialiased);
 			d_plot_curve.push_back(curve);
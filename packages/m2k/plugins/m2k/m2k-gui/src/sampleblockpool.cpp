@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "sampleblockpool.h"
+
+#include <atomic>
+#include <mutex>
+
+using namespace scopy;
+
+SampleBlock::SampleBlock(size_t channels, size_t length)
+	: m_length(length)
+{
+	for(size_t i = 0; i < channels; i++) {
+		m_buffers.push_back(new double[length]);
+	}
+}
+
+SampleBlock::~SampleBlock()
+{
+	for(double *buffer : m_buffers) {
+		delete[] buffer;
+	}
+}
+
+size_t SampleBlock::channels() const { return m_buffers.size(); }
+
+size_t SampleBlock::length() const { return m_length; }
+
+double *SampleBlock::data(size_t channel) const { return m_buffers[channel]; }
+
+const std::vector<double *> &SampleBlock::buffers() const { return m_buffers; }
+
+double *SampleBlock::exchange(size_t channel, double *buffer)
+{
+	double *previous = m_buffers[channel];
+	m_buffers[channel] = buffer;
+	return previous;
+}
+
+struct SampleBlockPool::State
+{
+	std::mutex mutex;
+	std::vector<SampleBlock *> free;
+	size_t channels;
+	size_t capacity;
+	std::atomic<size_t> allocations{0};
+
+	~State()
+	{
+		for(SampleBlock *block : free) {
+			delete block;
+		}
+	}
+
+	void release(SampleBlock *block)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(free.size() < capacity) {
+			free.push_back(block);
+		} else {
+			delete block;
+		}
+	}
+};
+
+SampleBlockPool::SampleBlockPool(size_t channels, size_t capacity)
+	: m_state(std::make_shared<State>())
+{
+	m_state->channels = channels;
+	m_state->capacity = capacity;
+}
+
+SampleBlockPool::~SampleBlockPool() {}
+
+std::shared_ptr<SampleBlock> SampleBlockPool::acquire(size_t length)
+{
+	SampleBlock *block = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		while(!block && !m_state->free.empty()) {
+			block = m_state->free.back();
+			m_state->free.pop_back();
+			// left from before a buffer size change
+			if(block->length() != length) {
+				delete block;
+				block = nullptr;
+			}
+		}
+	}
+
+	if(!block) {
+		block = new SampleBlock(m_state->channels, length);
+		m_state->allocations++;
+	}
+
+	// the state outlives the pool while blocks are in flight
+	std::shared_ptr<State> state = m_state;
+	return std::shared_ptr<SampleBlock>(block, [state](SampleBlock *b) { state->release(b); });
+}
+
+size_t SampleBlockPool::allocations() const { return m_state->allocations; }
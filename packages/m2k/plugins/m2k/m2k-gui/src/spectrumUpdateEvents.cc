@@ -149,8 +149,22 @@ TimeUpdateEvent::TimeUpdateEvent(const std::vector<double *> &timeDomainPoints,
 	_tags = tags;
 }
 
+TimeUpdateEvent::TimeUpdateEvent(const std::shared_ptr<scopy::SampleBlock> &block,
+				 const std::vector<std::vector<gr::tag_t>> &tags)
+	: QEvent(QEvent::Type(SpectrumUpdateEventType))
+	, _nplots(block->channels())
+	, _dataTimeDomainPoints(block->buffers())
+	, _numTimeDomainDataPoints(block->length())
+	, _tags(tags)
+	, _block(block)
+{}
+
 TimeUpdateEvent::~TimeUpdateEvent()
 {
+	if(_block) {
+		return;
+	}
+
 	for(size_t i = 0; i < _nplots; i++) {
 		delete[] _dataTimeDomainPoints[i];
 	}
@@ -162,6 +176,8 @@ uint64_t TimeUpdateEvent::getNumTimeDomainDataPoints() const { return _numTimeDo
 
 const std::vector<std::vector<gr::tag_t>> TimeUpdateEvent::getTags() const { return _tags; }
 
+const std::shared_ptr<scopy::SampleBlock> &TimeUpdateEvent::block() const { return _block; }
+
 /***************************************************************************/
 
 IdentifiableTimeUpdateEvent::IdentifiableTimeUpdateEvent(const std::vector<double *> &timeDomainPoints,
@@ -172,6 +188,13 @@ IdentifiableTimeUpdateEvent::IdentifiableTimeUpdateEvent(const std::vector<doubl
 	, _senderName(senderName)
 {}
 
+IdentifiableTimeUpdateEvent::IdentifiableTimeUpdateEvent(const std::shared_ptr<scopy::SampleBlock> &block,
+							 const std::vector<std::vector<gr::tag_t>> &tags,
+							 const std::string &senderName)
+	: TimeUpdateEvent(block, tags)
+	, _senderName(senderName)
+{}
+
 IdentifiableTimeUpdateEvent::~IdentifiableTimeUpdateEvent() {}
 
 std::string IdentifiableTimeUpdateEvent::senderName() { return _senderName; }
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "adcconversion.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace scopy::m2k;
+
+// the codes the conversion is evaluated at: both ends of the 12 bit ADC range, zero and a point in between
+#define FIT_CODE 2048
+#define CHECK_CODE -1000
+// allowed deviation of the check code from the fitted line, relative to the full scale span
+#define LINEARITY_TOLERANCE 1e-9
+
+bool AdcConversion::fit(const Function &conversion, unsigned int channel, Coefficients &c)
+{
+	const double low = conversion(channel, -FIT_CODE);
+	const double high = conversion(channel, FIT_CODE);
+
+	c.gain = (high - low) / (2 * FIT_CODE);
+	c.offset = conversion(channel, 0);
+
+	const double expected = c.gain * CHECK_CODE + c.offset;
+	const double span = std::max(std::fabs(high - low), 1.0);
+	const double deviation = std::fabs(conversion(channel, CHECK_CODE) - expected);
+	const double midpoint = std::fabs((high + low) / 2 - c.offset);
+
+	return std::isfinite(c.gain) && std::isfinite(c.offset) && deviation <= span * LINEARITY_TOLERANCE &&
+		midpoint <= span * LINEARITY_TOLERANCE;
+}
+
+void AdcConversion::convert(const short *in, float *out, size_t count, const Coefficients &c)
+{
+	const float gain = c.gain;
+	const float offset = c.offset;
+
+	for(size_t i = 0; i < count; i++) {
+		out[i] = in[i] * gain + offset;
+	}
+}
+
+void AdcConversion::convert(const short *in, float *out, size_t count, const Function &conversion,
+			    unsigned int channel)
+{
+	for(size_t i = 0; i < count; i++) {
+		out[i] = conversion(channel, in[i]);
+	}
+}
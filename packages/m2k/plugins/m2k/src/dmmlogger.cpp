@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "dmmlogger.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QtEndian>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <common/scopy-common_config.h>
+#include <cstring>
+#include <limits>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+Q_LOGGING_CATEGORY(CAT_DMM_LOGGER, "DmmLogger")
+
+using namespace scopy::m2k;
+
+#define BINARY_MAGIC "SCPYDMM1"
+#define BINARY_VERSION 1
+// wake up at least this often when flushing every batch
+#define MIN_WAIT_MS 100
+
+DmmLogger::DmmLogger()
+	: m_format(DL_CSV)
+	, m_stop(false)
+	, m_running(false)
+	, m_capacity(65536)
+	, m_flushInterval(1000)
+	, m_syncInterval(60000)
+	, m_interval(0)
+	, m_next(std::numeric_limits<int64_t>::min())
+	, m_written(0)
+	, m_dropped(0)
+	, m_failed(false)
+{}
+
+DmmLogger::~DmmLogger() { stop(); }
+
+size_t DmmLogger::capacity() const { return m_capacity; }
+
+void DmmLogger::setCapacity(size_t capacity) { m_capacity = std::max<size_t>(capacity, 2); }
+
+int DmmLogger::flushInterval() const { return m_flushInterval; }
+
+void DmmLogger::setFlushInterval(int ms) { m_flushInterval = std::max(ms, 0); }
+
+int DmmLogger::syncInterval() const { return m_syncInterval; }
+
+void DmmLogger::setSyncInterval(int ms) { m_syncInterval = std::max(ms, -1); }
+
+int64_t DmmLogger::interval() const { return m_interval; }
+
+void DmmLogger::setInterval(int64_t ns)
+{
+	m_interval = std::max<int64_t>(ns, 0);
+	m_next = std::numeric_limits<int64_t>::min();
+}
+
+DmmLogger::Format DmmLogger::formatForPath(const QString &path)
+{
+	const QString suffix = QFileInfo(path).suffix().toLower();
+	return (suffix == "bin" || suffix == "dmm") ? DL_BINARY : DL_CSV;
+}
+
+bool DmmLogger::start(const QString &path, Format format, bool append)
+{
+	stop();
+
+	m_file.setFileName(path);
+	const bool exists = append && m_file.exists() && m_file.size() > 0;
+	if(!m_file.open(exists ? QIODevice::Append : QIODevice::WriteOnly | QIODevice::Truncate)) {
+		m_error = m_file.errorString();
+		qWarning(CAT_DMM_LOGGER) << "Can't open" << path << ":" << m_error;
+		return false;
+	}
+
+	m_format = format;
+	m_queue.clear();
+	m_queue.reserve(m_capacity);
+	m_stop = false;
+	m_next = std::numeric_limits<int64_t>::min();
+	m_written = 0;
+	m_dropped = 0;
+	m_failed = false;
+	m_error.clear();
+
+	if(!exists) {
+		writeHeader();
+	}
+
+	m_running = true;
+	m_thread = std::thread(&DmmLogger::writerThread, this);
+	return true;
+}
+
+void DmmLogger::stop()
+{
+	if(!m_running) {
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_cond.notify_all();
+	m_thread.join();
+	m_running = false;
+	m_file.close();
+
+	if(m_dropped) {
+		qWarning(CAT_DMM_LOGGER) << m_dropped << "readings dropped, the writer could not keep up";
+	}
+}
+
+bool DmmLogger::isRunning() const { return m_running; }
+
+bool DmmLogger::push(const Record &record)
+{
+	// keep one record per interval, on the time base of the samples
+	const int64_t interval = m_interval;
+	if(interval > 0) {
+		if(m_next != std::numeric_limits<int64_t>::min() && record.timestamp < m_next) {
+			return true;
+		}
+		if(m_next == std::numeric_limits<int64_t>::min()) {
+			m_next = record.timestamp + interval;
+		} else {
+			m_next += ((record.timestamp - m_next) / interval + 1) * interval;
+		}
+	}
+
+	bool wake = false;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if(!m_running || m_failed || m_queue.size() >= m_capacity) {
+			m_dropped++;
+			return false;
+		}
+		m_queue.push_back(record);
+		wake = m_queue.size() == m_capacity / 2;
+	}
+
+	if(wake) {
+		m_cond.notify_one();
+	}
+	return true;
+}
+
+uint64_t DmmLogger::written() const { return m_written; }
+
+uint64_t DmmLogger::dropped() const { return m_dropped; }
+
+bool DmmLogger::failed() const { return m_failed; }
+
+QString DmmLogger::errorString() const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_error;
+}
+
+void DmmLogger::writeHeader()
+{
+	QByteArray header;
+	if(m_format == DL_BINARY) {
+		const uint32_t version = qToLittleEndian<uint32_t>(BINARY_VERSION);
+		const uint32_t nrOfValues = qToLittleEndian<uint32_t>(NR_OF_VALUES);
+		header.append(BINARY_MAGIC, strlen(BINARY_MAGIC));
+		header.append(reinterpret_cast<const char *>(&version), sizeof(version));
+		header.append(reinterpret_cast<const char *>(&nrOfValues), sizeof(nrOfValues));
+	} else {
+		header.append(QString(";Generated by Scopy-%1\n;Started on %2\n")
+				      .arg(SCOPY_VERSION_GIT, QDateTime::currentDateTime().toString())
+				      .toUtf8());
+		header.append("Timestamp,Channel_0_DC_RMS,Channel_0_AC_RMS,Channel_1_DC_RMS,Channel_1_AC_RMS\n");
+	}
+	m_file.write(header);
+}
+
+bool DmmLogger::writeBatch(const std::vector<Record> &batch)
+{
+	if(batch.empty()) {
+		return true;
+	}
+
+	QByteArray out;
+	if(m_format == DL_BINARY) {
+		const size_t recordSize = sizeof(int64_t) + NR_OF_VALUES * sizeof(double);
+		out.resize(batch.size() * recordSize);
+		char *dst = out.data();
+		for(const Record &r : batch) {
+			qToLittleEndian<int64_t>(r.timestamp, dst);
+			dst += sizeof(int64_t);
+			qToLittleEndian<double>(r.values, NR_OF_VALUES, dst);
+			dst += NR_OF_VALUES * sizeof(double);
+		}
+	} else {
+		out.reserve(batch.size() * 80);
+		for(const Record &r : batch) {
+			const QDateTime time = QDateTime::fromMSecsSinceEpoch(r.timestamp / 1000000);
+			out.append(time.toString("yyyy-MM-dd HH:mm:ss.zzz").toLatin1());
+			for(double v : r.values) {
+				out.append(',');
+				out.append(std::isnan(v) ? QByteArray("-") : QByteArray::number(v));
+			}
+			out.append('\n');
+		}
+	}
+
+	if(m_file.write(out) != out.size()) {
+		return false;
+	}
+	m_written += batch.size();
+	return true;
+}
+
+void DmmLogger::writerThread()
+{
+	typedef std::chrono::steady_clock Clock;
+	const auto wait = std::chrono::milliseconds(m_flushInterval > 0 ? m_flushInterval : MIN_WAIT_MS);
+	Clock::time_point lastFlush = Clock::now();
+	Clock::time_point lastSync = lastFlush;
+	std::vector<Record> batch;
+	batch.reserve(m_capacity);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while(true) {
+		m_cond.wait_for(lock, wait, [this]() { return m_stop || m_queue.size() >= m_capacity / 2; });
+		batch.swap(m_queue);
+		const bool stopping = m_stop;
+		lock.unlock();
+
+		bool ok = writeBatch(batch);
+		batch.clear();
+
+		const Clock::time_point now = Clock::now();
+		if(ok && (stopping || now - lastFlush >= std::chrono::milliseconds(m_flushInterval))) {
+			ok = m_file.flush();
+			lastFlush = now;
+			if(ok && m_syncInterval >= 0 &&
+			   (stopping || now - lastSync >= std::chrono::milliseconds(m_syncInterval))) {
+#ifdef _WIN32
+				ok = _commit(m_file.handle()) == 0;
+#else
+				ok = fsync(m_file.handle()) == 0;
+#endif
+				lastSync = now;
+			}
+		}
+
+		lock.lock();
+		if(!ok) {
+			m_error = m_file.errorString();
+			m_failed = true;
+			qWarning(CAT_DMM_LOGGER) << "Logging to" << m_file.fileName() << "failed:" << m_error;
+			break;
+		}
+		if(stopping && m_queue.empty()) {
+			break;
+		}
+	}
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "dmmstats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace scopy::m2k;
+
+// samples summed exactly before being folded into the double accumulators.
+// BLOCK_SIZE * 32768^2 (and BLOCK_SIZE * sumSq) can't overflow an int64
+#define BLOCK_SIZE 4096
+
+DmmStats::DmmStats() { reset(); }
+
+DmmStats::~DmmStats() {}
+
+void DmmStats::reset()
+{
+	m_blockSum = 0;
+	m_blockSumSq = 0;
+	m_blockCount = 0;
+	m_min = std::numeric_limits<short>::max();
+	m_max = std::numeric_limits<short>::min();
+	m_count = 0;
+	m_mean = 0;
+	m_m2 = 0;
+}
+
+void DmmStats::process(const short *in, size_t count)
+{
+	while(count) {
+		const size_t n = std::min<size_t>(count, BLOCK_SIZE - m_blockCount);
+		int64_t sum = 0;
+		int64_t sumSq = 0;
+		short lo = m_min;
+		short hi = m_max;
+		for(size_t i = 0; i < n; i++) {
+			const int32_t v = in[i];
+			sum += v;
+			sumSq += v * v;
+			lo = std::min<short>(lo, in[i]);
+			hi = std::max<short>(hi, in[i]);
+		}
+
+		m_blockSum += sum;
+		m_blockSumSq += sumSq;
+		m_blockCount += n;
+		m_min = lo;
+		m_max = hi;
+		if(m_blockCount == BLOCK_SIZE) {
+			flush();
+		}
+
+		in += n;
+		count -= n;
+	}
+}
+
+void DmmStats::flush()
+{
+	if(!m_blockCount) {
+		return;
+	}
+
+	// the block statistics are exact: n * sumSq - sum^2 is computed in integers
+	const double n = m_blockCount;
+	const double blockMean = m_blockSum / n;
+	const double blockM2 = double(int64_t(m_blockCount) * m_blockSumSq - m_blockSum * m_blockSum) / n;
+
+	const double total = m_count + n;
+	const double delta = blockMean - m_mean;
+	m_mean += delta * n / total;
+	m_m2 += blockM2 + delta * delta * m_count * n / total;
+	m_count += m_blockCount;
+
+	m_blockSum = 0;
+	m_blockSumSq = 0;
+	m_blockCount = 0;
+}
+
+uint64_t DmmStats::count() const { return m_count + m_blockCount; }
+
+DmmStats::Stats DmmStats::stats() const
+{
+	// fold the partial block into a copy, the accumulation continues unchanged
+	DmmStats s = *this;
+	s.flush();
+
+	if(!s.m_count) {
+		return {.mean = 0, .acRms = 0, .rms = 0, .min = 0, .max = 0, .count = 0};
+	}
+
+	const double variance = std::max(s.m_m2 / s.m_count, 0.0);
+	return {.mean = s.m_mean,
+		.acRms = std::sqrt(variance),
+		.rms = std::sqrt(variance + s.m_mean * s.m_mean),
+		.min = double(s.m_min),
+		.max = double(s.m_max),
+		.count = s.m_count};
+}
+
+DmmStats::Stats DmmStats::compute(const short *in, size_t count)
+{
+	DmmStats s;
+	s.process(in, count);
+	return s.stats();
+}
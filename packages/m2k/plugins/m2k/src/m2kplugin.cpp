@@ -269,6 +269,7 @@ void M2kPlugin::initPreferences()
 	p->init("m2k_logic_separate_annotations", false);
 	p->init("m2k_logic_display_sampling_points", false);
 	p->init("m2k_logic_display_sample_time", true);
+	p->init("m2k_pg_rate_match_ppm", 0);
 }
 
 bool M2kPlugin::loadPreferencesPage()
@@ -378,6 +379,17 @@ bool M2kPlugin::loadPreferencesPage()
 				     "Select whether the sample and time detailed information is shown in the "
 				     "decoder table of the Logic Analyzer. Enabled by default.",
 				     logicSection));
+	logicSection->contentLayout()->addWidget(PREFERENCE_EDIT_VALIDATION(
+		p, "m2k_pg_rate_match_ppm", "Pattern Generator rate matching (ppm)",
+		"Largest frequency error, in parts per million, the Pattern Generator may introduce to fit "
+		"patterns with unrelated periods in a shorter buffer. 0 keeps every frequency exact. "
+		"Default value is 0.",
+		[](const QString &text) {
+			bool ok;
+			auto value = text.toDouble(&ok);
+			return ok && value >= 0;
+		},
+		logicSection));
 
 	return true;
 }
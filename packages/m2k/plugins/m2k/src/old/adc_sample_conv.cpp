@@ -32,11 +32,22 @@ using namespace scopy;
 using namespace libm2k::analog;
 
 adc_sample_conv::adc_sample_conv(int nconnections, M2kAnalogIn *adc, bool inverse)
-	: gr::sync_block("adc_sample_conv", gr::io_signature::make(nconnections, nconnections, sizeof(float)),
+	: gr::sync_block("adc_sample_conv",
+			 gr::io_signature::make(nconnections, nconnections, inverse ? sizeof(float) : sizeof(short)),
 			 gr::io_signature::make(nconnections, nconnections, sizeof(float)))
 	, d_nconnections(nconnections)
 	, inverse(inverse)
 	, m2k_adc(adc)
+	, m_rawToVolts([adc](unsigned int chn_idx, short raw) { return adc->convertRawToVolts(chn_idx, raw); })
+{}
+
+adc_sample_conv::adc_sample_conv(int nconnections, const m2k::AdcConversion::Function &rawToVolts)
+	: gr::sync_block("adc_sample_conv", gr::io_signature::make(nconnections, nconnections, sizeof(short)),
+			 gr::io_signature::make(nconnections, nconnections, sizeof(float)))
+	, d_nconnections(nconnections)
+	, inverse(false)
+	, m2k_adc(nullptr)
+	, m_rawToVolts(rawToVolts)
 {}
 
 adc_sample_conv::~adc_sample_conv() {}
@@ -60,17 +71,23 @@ int adc_sample_conv::work(int noutput_items, gr_vector_const_void_star &input_it
 	gr::thread::scoped_lock lock(d_setlock);
 
 	for(unsigned int i = 0; i < input_items.size(); i++) {
-		const float *in = static_cast<const float *>(input_items[i]);
 		float *out = static_cast<float *>(output_items[i]);
 
 		if(inverse) {
+			const float *in = static_cast<const float *>(input_items[i]);
 			for(int j = 0; j < noutput_items; j++) {
 				out[j] = m2k_adc->convertVoltsToRaw(i, in[j]);
 			}
-		} else {
+			continue;
+		}
 
-			for(int j = 0; j < noutput_items; j++)
-				out[j] = m2k_adc->convertRawToVolts(i, in[j]);
+		// the calibration can change between buffers (range, gain, offset), so it is fitted for each one
+		const short *in = static_cast<const short *>(input_items[i]);
+		m2k::AdcConversion::Coefficients coefficients;
+		if(m2k::AdcConversion::fit(m_rawToVolts, i, coefficients)) {
+			m2k::AdcConversion::convert(in, out, noutput_items, coefficients);
+		} else {
+			m2k::AdcConversion::convert(in, out, noutput_items, m_rawToVolts, i);
 		}
 	}
 
@@ -21,6 +21,9 @@
 #ifndef ADC_SAMPLE_CONV_HPP
 #define ADC_SAMPLE_CONV_HPP
 
+#include "adcconversion.h"
+#include "scopy-m2k_export.h"
+
 #include <gnuradio/sync_block.h>
 
 #include <memory>
@@ -30,15 +33,22 @@ class M2kAnalogIn;
 }
 } // namespace libm2k
 namespace scopy {
-class adc_sample_conv : public gr::sync_block
+/*
+ * Converts the raw shorts of the ADC channels to volts in one pass, without a
+ * short_to_float stage in front. The inverse block converts floats to raw.
+ */
+class SCOPY_M2K_EXPORT adc_sample_conv : public gr::sync_block
 {
 private:
 	int d_nconnections;
 	bool inverse;
 	libm2k::analog::M2kAnalogIn *m2k_adc;
+	m2k::AdcConversion::Function m_rawToVolts;
 
 public:
 	explicit adc_sample_conv(int nconnections, libm2k::analog::M2kAnalogIn *m2k_adc, bool inverse = false);
+	// raw to volts with the given conversion, no device behind it: conversionWrapper() can't be used
+	adc_sample_conv(int nconnections, const m2k::AdcConversion::Function &rawToVolts);
 
 	~adc_sample_conv();
 
@@ -25,25 +25,9 @@
 
 #include "ui_dmm.h"
 
-#include <gnuradio/blocks/delay.h>
-#include <gnuradio/blocks/keep_one_in_n.h>
-#include <gnuradio/blocks/max_blk.h>
-#include <gnuradio/blocks/min_blk.h>
-#include <gnuradio/blocks/moving_average.h>
-#include <gnuradio/blocks/rms_ff.h>
-#include <gnuradio/blocks/short_to_float.h>
-#include <gnuradio/blocks/skiphead.h>
-#include <gnuradio/blocks/stream_to_vector.h>
-#include <gnuradio/blocks/sub.h>
-#include <gnuradio/blocks/vector_to_stream.h>
-#include <gnuradio/filter/dc_blocker_ff.h>
-
 #include <QDateTime>
-#include <QFile>
 #include <QFileDialog>
 #include <QMessageBox>
-#include <QTextStream>
-#include <QThread>
 
 #include <memory>
 
@@ -68,16 +52,13 @@ DMM::DMM(libm2k::context::M2k *m2k, QString uri, Filter *filt, ToolMenuEntry *tm
 	 QWidget *parent)
 	: M2kTool(tme, new DMM_API(this), "Voltmeter", parent)
 	, ui(new Ui::DMM)
-	, signal(std::make_shared<signal_sample>())
 	, manager(m2k_man->get_instance(m2k, filt->device_name(TOOL_DMM)))
 	, m_m2k_context(m2k)
 	, m_m2k_analogin(m_m2k_context->getAnalogIn())
 	, m_adc_nb_channels(m_m2k_analogin->getNbChannels())
-	, interrupt_data_logging(false)
 	, data_logging(false)
 	, filename("")
-	, use_timer(false)
-	, logging_refresh_rate(0)
+	, m_readoutEpoch(-1)
 	, wheelEventGuard(nullptr)
 	, m_autoGainEnabled({true, true})
 	, m_gainHistorySize(25)
@@ -88,6 +69,9 @@ DMM::DMM(libm2k::context::M2k *m2k, QString uri, Filter *filt, ToolMenuEntry *tm
 	/* TODO: avoid hardcoding sample rate */
 	sample_rate = 1e5;
 
+	/* 10 fps refresh rate for the readouts */
+	signal = std::make_shared<dmm_stats_block>(m_adc_nb_channels, sample_rate / 10);
+
 	ui->sismograph_ch1->setColor(QColor("#ff7200"));
 	ui->sismograph_ch2->setColor(QColor("#9013fe"));
 
@@ -115,8 +99,8 @@ DMM::DMM(libm2k::context::M2k *m2k, QString uri, Filter *filt, ToolMenuEntry *tm
 		scale->addScale(-25.0, 25.0, 10, 5);
 	}
 
-	data_logging_timer =
-		new PositionSpinButton({{"s", 1}, {"min", 60}, {"h", 3600}}, tr("Timer"), 0, 3600, true, false, this);
+	data_logging_timer = new PositionSpinButton({{"ms", 1e-3}, {"s", 1}, {"min", 60}, {"h", 3600}}, tr("Timer"), 0,
+						     3600, true, false, this);
 
 	ui->horizontalLayout_2->addWidget(data_logging_timer);
 
@@ -146,13 +130,8 @@ DMM::DMM(libm2k::context::M2k *m2k, QString uri, Filter *filt, ToolMenuEntry *tm
 		}
 	});
 
-	connect(data_logging_timer, &PositionSpinButton::valueChanged, [&](double value) {
-		if(value == 0)
-			use_timer = false;
-		else
-			use_timer = true;
-		logging_refresh_rate = value * 1000;
-	});
+	connect(data_logging_timer, &PositionSpinButton::valueChanged,
+		[&](double value) { m_logger.setInterval(llround(value * 1e9)); });
 
 	data_logging_timer->setValue(0);
 	enableDataLogging(false);
@@ -194,7 +173,7 @@ DMM::DMM(libm2k::context::M2k *m2k, QString uri, Filter *filt, ToolMenuEntry *tm
 
 	configureModes();
 
-	connect(&*signal, SIGNAL(triggered(std::vector<float>)), this, SLOT(updateValuesList(std::vector<float>)));
+	connect(&*signal, &dmm_stats_block::triggered, this, &DMM::updateValuesList);
 
 	if(started)
 		manager->unlock();
@@ -292,11 +271,8 @@ DMM::~DMM()
 	delete ui;
 }
 
-void DMM::updateValuesList(std::vector<float> values)
+void DMM::updateValuesList(std::vector<float> values, qulonglong sample)
 {
-	if(!use_timer)
-		std::unique_lock<std::mutex> lock(data_mutex);
-
 	const double volts_ch1 = m_m2k_analogin->convertRawToVolts(0, static_cast<int>(values[0]));
 	const double volts_ch2 = m_m2k_analogin->convertRawToVolts(1, static_cast<int>(values[1]));
 
@@ -317,8 +293,30 @@ void DMM::updateValuesList(std::vector<float> values)
 				m_m2k_analogin->convertRawToVolts(1, static_cast<int>(values[4])),
 				m_m2k_analogin->convertRawToVolts(1, static_cast<int>(values[5]))});
 
-	if(!use_timer)
-		data_cond.notify_all();
+	if(m_logger.isRunning()) {
+		logReadout(sample, volts_ch1, volts_ch2);
+	}
+}
+
+void DMM::logReadout(qulonglong sample, double volts_ch1, double volts_ch2)
+{
+	// the readouts are timestamped on the sample clock, anchored to the wall clock by the first one
+	const double sampleTime = sample * 1e9 / sample_rate;
+	if(m_readoutEpoch < 0) {
+		m_readoutEpoch = QDateTime::currentMSecsSinceEpoch() * 1000000LL - llround(sampleTime);
+	}
+
+	const bool is_ac_ch1 = ui->btn_ch1_ac->isChecked();
+	const bool is_ac_ch2 = ui->btn_ch2_ac->isChecked();
+	DmmLogger::Record record = {.timestamp = m_readoutEpoch + llround(sampleTime),
+				    .values = {is_ac_ch1 ? qQNaN() : volts_ch1, is_ac_ch1 ? volts_ch1 : qQNaN(),
+					       is_ac_ch2 ? qQNaN() : volts_ch2, is_ac_ch2 ? volts_ch2 : qQNaN()}};
+
+	if(!m_logger.push(record) && m_logger.failed()) {
+		ui->lblFileStatus->setText(m_logger.errorString());
+		setDynamicProperty(ui->filename, "invalid", true);
+		ui->btnDataLogging->setChecked(false);
+	}
 }
 
 void DMM::checkPeakValues(int ch, double peak)
@@ -502,6 +500,11 @@ void DMM::toggleTimer(bool start)
 		ResourceManager::open("m2k-adc" + m_uri, this);
 		manager->set_kernel_buffer_count(4);
 		writeAllSettingsToHardware();
+
+		// the flowgraph thread feeds signal once started, clear what the previous run left first
+		signal->reset();
+		m_readoutEpoch = -1;
+
 		manager->start(id_ch1);
 		manager->start(id_ch2);
 
@@ -522,68 +525,17 @@ void DMM::toggleTimer(bool start)
 	m_running = start;
 }
 
-gr::basic_block_sptr DMM::configureGraph(gr::basic_block_sptr s2f, bool is_ac)
-{
-	/* 10 fps refresh rate for the plot */
-	auto keep_one = gr::blocks::keep_one_in_n::make(sizeof(float), sample_rate / 10.0);
-
-	auto blocker_val = 4000;
-	auto blocker = gr::filter::dc_blocker_ff::make(blocker_val, true);
-
-	manager->connect(s2f, 0, blocker, 0);
-
-	if(is_ac) {
-		/* TODO: figure out best value for the RMS parameter */
-		auto rms = gr::blocks::rms_ff::make(0.0001);
-		manager->connect(blocker, 0, rms, 0);
-		manager->connect(rms, 0, keep_one, 0);
-	} else {
-		auto sub = gr::blocks::sub_ff::make();
-		manager->connect(s2f, 0, sub, 0);
-		manager->connect(blocker, 0, sub, 1);
-		auto moving = gr::blocks::moving_average_ff::make(4000, 1.0 / 4000);
-		manager->connect(sub, 0, moving, 0);
-		manager->connect(moving, 0, keep_one, 0);
-	}
-
-	return keep_one;
-}
-
 void DMM::configureModes()
 {
-	auto s2f1 = gr::blocks::short_to_float::make();
-	auto s2f2 = gr::blocks::short_to_float::make();
-
-	auto max1 = gr::blocks::max_ff::make(sample_rate / 10);
-	auto max2 = gr::blocks::max_ff::make(sample_rate / 10);
-	auto min1 = gr::blocks::min_ff::make(sample_rate / 10);
-	auto min2 = gr::blocks::min_ff::make(sample_rate / 10);
-	auto stv1 = gr::blocks::stream_to_vector::make(sizeof(float), sample_rate / 10);
-	auto stv2 = gr::blocks::stream_to_vector::make(sizeof(float), sample_rate / 10);
-
-	const bool is_ac_ch1 = ui->btn_ch1_ac->isChecked();
-	const bool is_ac_ch2 = ui->btn_ch2_ac->isChecked();
-
-	id_ch1 = manager->connect(s2f1, 0, 0, false, sample_rate / 10);
-	id_ch2 = manager->connect(s2f2, 1, 0, false, sample_rate / 10);
+	signal->set_ac(0, ui->btn_ch1_ac->isChecked());
+	signal->set_ac(1, ui->btn_ch2_ac->isChecked());
 
-	manager->connect(s2f1, 0, stv1, 0);
-	manager->connect(s2f2, 0, stv2, 0);
-	manager->connect(stv1, 0, max1, 0);
-	manager->connect(stv2, 0, max2, 0);
-	manager->connect(stv1, 0, min1, 0);
-	manager->connect(stv2, 0, min2, 0);
+	// samples captured with the previous settings are dropped
+	signal->reset();
+	m_readoutEpoch = -1;
 
-	auto block1 = configureGraph(s2f1, is_ac_ch1);
-	auto block2 = configureGraph(s2f2, is_ac_ch2);
-
-	manager->connect(block1, 0, signal, 0);
-	manager->connect(block2, 0, signal, 1);
-
-	manager->connect(max1, 0, signal, 2);
-	manager->connect(min1, 0, signal, 3);
-	manager->connect(max2, 0, signal, 4);
-	manager->connect(min2, 0, signal, 5);
+	id_ch1 = manager->connect(signal, 0, 0, false, signal->window());
+	id_ch2 = manager->connect(signal, 1, 1, false, signal->window());
 }
 
 void DMM::chooseFile()
@@ -592,7 +544,8 @@ void DMM::chooseFile()
 
 	bool useNativeDialogs = Preferences::get("general_use_native_dialogs").toBool();
 	filename = QFileDialog::getSaveFileName(
-		this, tr("Export"), "", tr("Comma-separated values files (*.csv);;All Files(*)"), &selectedFilter,
+		this, tr("Export"), "",
+		tr("Comma-separated values files (*.csv);;Binary files (*.bin);;All Files(*)"), &selectedFilter,
 		(useNativeDialogs ? QFileDialog::Options() : QFileDialog::DontUseNativeDialog));
 
 	ui->filename->setText(filename);
@@ -642,49 +595,20 @@ void DMM::toggleDataLogging(bool en)
 	}
 
 	if(en && ui->run_button->isChecked()) {
-		QFile file(filename);
-
-		if(ui->btn_overwrite->isChecked() || file.size() == 0) {
-			if(!file.open(QIODevice::WriteOnly)) {
-				ui->lblFileStatus->setText(tr("File is open in another program"));
-				setDynamicProperty(ui->filename, "invalid", true);
-				if(ui->run_button->isChecked()) {
-					ui->btnDataLogging->setChecked(false);
-				}
-				return;
-			} else {
-				ui->lblFileStatus->setText(tr("Choose a file"));
-				setDynamicProperty(ui->filename, "invalid", false);
-			}
-			QTextStream out(&file);
-
-			/* Write the header */
-			out << ";Generated by Scopy-" << SCOPY_VERSION_GIT << "\n"
-			    << ";Started on " << QDateTime::currentDateTime().toString() << "\n";
-			out << "Timestamp,Channel_0_DC_RMS,Channel_0_AC_RMS,Channel_1_DC_RMS,Channel_1_AC_RMS\n";
-
-			file.close();
+		if(!m_logger.isRunning() &&
+		   !m_logger.start(filename, DmmLogger::formatForPath(filename), ui->btn_append->isChecked())) {
+			ui->lblFileStatus->setText(tr("File is open in another program"));
+			setDynamicProperty(ui->filename, "invalid", true);
+			ui->btnDataLogging->setChecked(false);
+			return;
 		}
+		ui->lblFileStatus->setText(tr("Choose a file"));
+		setDynamicProperty(ui->filename, "invalid", false);
 	} else {
+		m_logger.stop();
 		ui->btn_overwrite->setEnabled(true);
 		ui->btn_append->setEnabled(true);
 	}
-
-	/* If running, start the thread */
-	if(ui->run_button->isChecked() && en) {
-		if(data_logging_thread.joinable())
-			return;
-
-		interrupt_data_logging = false;
-		data_logging_thread = std::thread(&DMM::dataLoggingThread, this);
-	} else if(!en) {
-		if(!use_timer)
-			data_cond.notify_all();
-		interrupt_data_logging = true;
-		if(data_logging_thread.joinable()) {
-			data_logging_thread.detach();
-		}
-	}
 }
 
 void DMM::startDataLogging(bool start)
@@ -692,88 +616,8 @@ void DMM::startDataLogging(bool start)
 	if(!data_logging)
 		return;
 
+	// opens the file when running, closes it when stopped
 	toggleDataLogging(data_logging);
-	if(start) {
-		if(filename == "")
-			return;
-		if(data_logging_thread.joinable())
-			return;
-
-		interrupt_data_logging = false;
-		ui->btn_overwrite->setEnabled(false);
-		ui->btn_append->setEnabled(false);
-		data_logging_thread = std::thread(&DMM::dataLoggingThread, this);
-
-	} else {
-		if(!use_timer)
-			data_cond.notify_all();
-		interrupt_data_logging = true;
-		if(data_logging_thread.joinable()) {
-			data_logging_thread.detach();
-		}
-		ui->btn_overwrite->setEnabled(true);
-		ui->btn_append->setEnabled(true);
-	}
-}
-
-void DMM::dataLoggingThread()
-{
-	QString separator = ",";
-	QFile file(filename);
-
-	QTextStream out(&file);
-
-	while(!interrupt_data_logging) {
-		if(!file.isOpen()) {
-			if(!file.open(QIODevice::Append)) {
-				ui->lblFileStatus->setText(tr("File is open in another program"));
-				setDynamicProperty(ui->filename, "invalid", true);
-				if(ui->run_button->isChecked()) {
-					ui->btnDataLogging->setChecked(false);
-				}
-				return;
-			} else {
-				ui->lblFileStatus->setText(tr("Choose a file"));
-			}
-		}
-		bool is_ac_ch1 = ui->btn_ch1_ac->isChecked();
-		bool is_ac_ch2 = ui->btn_ch2_ac->isChecked();
-
-		QString ch1_dc_rms = "-", ch2_dc_rms = "-", ch1_ac_rms = "-", ch2_ac_rms = "-";
-
-		out << QDateTime::currentDateTime().time().toString() << separator;
-
-		if(!use_timer) {
-			std::unique_lock<std::mutex> lock(data_mutex);
-			data_cond.wait(lock);
-		}
-
-		if(!is_ac_ch1) {
-			ch1_dc_rms = QString::number(ui->lcdCh1->value());
-		} else {
-			ch1_ac_rms = QString::number(ui->lcdCh1->value());
-		}
-
-		if(!is_ac_ch2) {
-			ch2_dc_rms = QString::number(ui->lcdCh2->value());
-		} else {
-			ch2_ac_rms = QString::number(ui->lcdCh2->value());
-		}
-
-		/* Write the values to file */
-		out << ch1_dc_rms << separator << ch1_ac_rms << separator << ch2_dc_rms << separator << ch2_ac_rms
-		    << "\n";
-
-		if(file.isOpen()) {
-			file.close();
-		}
-		if(use_timer) {
-			QThread::msleep(logging_refresh_rate);
-		}
-	}
-	if(file.isOpen()) {
-		file.close();
-	}
 }
 
 void DMM::toggleAC()
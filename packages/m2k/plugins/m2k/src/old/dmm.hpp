@@ -21,20 +21,19 @@
 #ifndef DMM_HPP
 #define DMM_HPP
 
+#include "dmm_stats_block.hpp"
+#include "dmmlogger.h"
 #include "filter.hpp"
 #include "gui/mousewheelwidgetguard.h"
 #include "gui/spinbox_a.hpp"
 #include "iio_manager.hpp"
 #include "pluginbase/toolmenuentry.h"
-#include "signal_sample.hpp"
 
 #include <QPushButton>
 #include <QWidget>
 
 #include <atomic>
-#include <condition_variable>
 #include <deque>
-#include <thread>
 
 /* libm2k includes */
 #include "m2ktool.hpp"
@@ -72,20 +71,16 @@ private:
 	Ui::DMM *ui;
 	std::shared_ptr<iio_manager> manager;
 	iio_manager::port_id id_ch1, id_ch2;
-	std::shared_ptr<signal_sample> signal;
+	std::shared_ptr<dmm_stats_block> signal;
 	unsigned long sample_rate;
 	bool m_running;
 
-	std::atomic<bool> interrupt_data_logging;
 	std::atomic<bool> data_logging;
 	QString filename;
-	std::thread data_logging_thread;
-	bool use_timer;
-	unsigned long logging_refresh_rate;
 	PositionSpinButton *data_logging_timer;
-
-	std::mutex data_mutex;
-	std::condition_variable data_cond;
+	DmmLogger m_logger;
+	// wall clock time of sample 0 of the readouts, in ns. -1 until the first readout
+	int64_t m_readoutEpoch;
 	MouseWheelWidgetGuard *wheelEventGuard;
 
 	std::vector<double> m_min, m_max;
@@ -95,12 +90,12 @@ private:
 	int m_gainHistorySize;
 
 	void disconnectAll();
-	gr::basic_block_sptr configureGraph(gr::basic_block_sptr s2f, bool is_ac);
 	void configureModes();
 	libm2k::analog::M2K_RANGE suggestRange(double volt_max, double volt_min);
 	int numSamplesFromIdx(int idx);
 	void writeAllSettingsToHardware();
 	void checkPeakValues(int, double);
+	void logReadout(qulonglong sample, double volts_ch1, double volts_ch2);
 	bool isIioManagerStarted() const;
 	void checkAndUpdateGainMode(const std::vector<double> &volts);
 
@@ -116,7 +111,7 @@ private Q_SLOTS:
 	void setLineThicknessCh1(int idx);
 	void setLineThicknessCh2(int idx);
 
-	void updateValuesList(std::vector<float> values);
+	void updateValuesList(std::vector<float> values, qulonglong sample);
 
 	void toggleAC();
 
@@ -126,8 +121,6 @@ private Q_SLOTS:
 
 	void startDataLogging(bool);
 
-	void dataLoggingThread();
-
 	void chooseFile();
 
 	void resetPeakHold(bool);
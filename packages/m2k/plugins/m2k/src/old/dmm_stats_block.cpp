@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see http://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dmm_stats_block.hpp"
+
+#include <algorithm>
+
+using namespace scopy::m2k;
+
+dmm_stats_block::dmm_stats_block(int nrOfChannels, size_t window)
+	: gr::sync_block("dmm_stats_block", gr::io_signature::make(nrOfChannels, nrOfChannels, sizeof(short)),
+			 gr::io_signature::make(0, 0, 0))
+	, QObject()
+	, d_window(std::max<size_t>(window, 1))
+	, d_samples(0)
+	, d_stats(nrOfChannels)
+	, d_ac(nrOfChannels)
+{
+	qRegisterMetaType<std::vector<float>>();
+	for(auto &ac : d_ac) {
+		ac = false;
+	}
+}
+
+dmm_stats_block::~dmm_stats_block() {}
+
+void dmm_stats_block::set_ac(int channel, bool ac) { d_ac[channel] = ac; }
+
+size_t dmm_stats_block::window() const { return d_window; }
+
+void dmm_stats_block::reset()
+{
+	for(DmmStats &stats : d_stats) {
+		stats.reset();
+	}
+	d_samples = 0;
+}
+
+int dmm_stats_block::work(int noutput_items, gr_vector_const_void_star &input_items,
+			  gr_vector_void_star &output_items)
+{
+	const size_t nrOfChannels = d_stats.size();
+	int done = 0;
+
+	while(done < noutput_items) {
+		// every channel gets the same number of items, so all the windows end together
+		const size_t n = std::min<size_t>(noutput_items - done, d_window - d_stats[0].count());
+		for(size_t ch = 0; ch < nrOfChannels; ch++) {
+			d_stats[ch].process(static_cast<const short *>(input_items[ch]) + done, n);
+		}
+		done += n;
+		d_samples += n;
+
+		if(d_stats[0].count() < d_window) {
+			break;
+		}
+
+		std::vector<float> values(3 * nrOfChannels);
+		for(size_t ch = 0; ch < nrOfChannels; ch++) {
+			const DmmStats::Stats s = d_stats[ch].stats();
+			values[ch] = d_ac[ch] ? s.acRms : s.mean;
+			values[nrOfChannels + 2 * ch] = s.max;
+			values[nrOfChannels + 2 * ch + 1] = s.min;
+			d_stats[ch].reset();
+		}
+		Q_EMIT triggered(values, d_samples);
+	}
+
+	return noutput_items;
+}
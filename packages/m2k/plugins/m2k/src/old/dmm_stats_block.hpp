@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see http://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DMM_STATS_BLOCK_HPP
+#define DMM_STATS_BLOCK_HPP
+
+#include "dmmstats.h"
+#include "signal_sample.hpp"
+
+#include <gnuradio/sync_block.h>
+
+#include <QObject>
+
+#include <atomic>
+#include <vector>
+
+namespace scopy::m2k {
+/*
+ * Sink for the raw ADC channels of the Voltmeter. Every window of samples is
+ * reduced in place by DmmStats, with no intermediate float streams, and emits
+ * {reading ch1, reading ch2, ..., max ch1, min ch1, max ch2, min ch2, ...}.
+ * The reading is the mean of a DC channel and the AC RMS of an AC one, all
+ * values are raw ADC codes. Every readout also carries the number of samples
+ * processed since the last reset, the sample time of the readout.
+ */
+class dmm_stats_block : public QObject, public gr::sync_block
+{
+	Q_OBJECT
+
+public:
+	explicit dmm_stats_block(int nrOfChannels, size_t window);
+	~dmm_stats_block();
+
+	void set_ac(int channel, bool ac);
+	size_t window() const;
+	// drops the partial window, call it with the flowgraph stopped or locked
+	void reset();
+
+	int work(int noutput_items, gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
+
+Q_SIGNALS:
+	void triggered(const std::vector<float> &values, qulonglong sample);
+
+private:
+	size_t d_window;
+	uint64_t d_samples;
+	std::vector<DmmStats> d_stats;
+	std::vector<std::atomic<bool>> d_ac;
+};
+} // namespace scopy::m2k
+
+#endif // DMM_STATS_BLOCK_HPP
@@ -48,6 +48,7 @@
 #include "adc_sample_conv.hpp"
 #include "buffer_previewer.hpp"
 #include "filemanager.h"
+#include "sigmfcapture.h"
 #include "m2k-gui/channel_widget.hpp"
 #include "gui/customPushButton.h"
 #include "m2k-gui/customplotpositionbutton.h"
@@ -84,6 +85,7 @@
 #include <gui/utils.h>
 #include <memory>
 #include <pluginbase/scopyjs.h>
+#include <pluginbase/statusbarmanager.h>
 
 Q_LOGGING_CATEGORY(CAT_M2K_OSCILLOSCOPE, "M2kOscilloscope");
 
@@ -294,7 +296,7 @@ Oscilloscope::Oscilloscope(libm2k::context::M2k *m2k, QString uri, Filter *filt,
 	adc_samp_conv_block = gnuradio::get_initial_sptr(adc_samp_conv);
 
 	for(unsigned int i = 0; i < nb_channels; i++) {
-		ids[i] = iio->connect(adc_samp_conv_block, i, i, true, qt_time_block->nsamps());
+		ids[i] = iio->connect(adc_samp_conv_block, i, i, false, qt_time_block->nsamps());
 
 		iio->connect(adc_samp_conv_block, i, qt_time_block, i);
 
@@ -1928,6 +1930,7 @@ void Oscilloscope::btnExport_clicked()
 	QStringList filter;
 	filter += QString(tr("Comma-separated values files (*.csv)"));
 	filter += QString(tr("Tab-delimited values files (*.txt)"));
+	filter += QString(tr("SigMF binary captures (*.sigmf-data)"));
 	filter += QString(tr("All Files(*)"));
 
 	QString selectedFilter = filter[0];
@@ -1959,13 +1962,19 @@ void Oscilloscope::btnExport_clicked()
 		fm.open(fileName, FileManager::EXPORT);
 
 		int channels_number = nb_channels + nb_math_channels;
-		QVector<double> time_data;
+		// binary captures carry the sample rate in their metadata instead of a time column
+		bool binaryCapture = SigMFCapture::isSigMF(fileName);
+		QStringList units;
 
-		for(size_t i = 0; i < plot.Curve(0)->data()->size(); ++i) {
-			time_data.push_back(plot.Curve(0)->sample(i).x());
-		}
+		if(!binaryCapture) {
+			QVector<double> time_data;
 
-		fm.save(time_data, "Time(S)");
+			for(size_t i = 0; i < plot.Curve(0)->data()->size(); ++i) {
+				time_data.push_back(plot.Curve(0)->sample(i).x());
+			}
+
+			fm.save(time_data, "Time(S)");
+		}
 
 		for(int i = 0; i < channels_number; ++i) {
 			if(exportConfig[i]) {
@@ -1976,11 +1985,33 @@ void Oscilloscope::btnExport_clicked()
 				QString chNo = (i > 1) ? QString::number(i - 1) : QString::number(i + 1);
 
 				fm.save(data, ((i > 1) ? "M" : "CH") + chNo + "(V)");
+				units.append("V");
 			}
 		}
 
 		fm.setSampleRate(active_sample_rate);
-		fm.performWrite();
+		if(binaryCapture) {
+			fm.setUnits(units);
+			FileExportTask *task = fm.performWriteAsync(true, this);
+			QProgressBar *progressBar = new QProgressBar();
+			progressBar->setRange(0, 100);
+			progressBar->setFormat("Exporting " + QFileInfo(fileName).fileName() + " %p%");
+			StatusBarManager::pushWidget(progressBar, "OscilloscopeExport");
+
+			connect(task, &FileExportTask::progress, progressBar, &QProgressBar::setValue);
+			connect(task, &FileExportTask::exportFinished, this, [=](bool success) {
+				progressBar->deleteLater();
+				if(success) {
+					StatusBarManager::pushMessage("Exported " + fileName, 3000);
+				} else {
+					qWarning(CAT_M2K_OSCILLOSCOPE) << "Failed to export" << fileName;
+					StatusBarManager::pushUrgentMessage("Failed to export " + fileName);
+				}
+			});
+			task->start();
+		} else {
+			fm.performWrite();
+		}
 	}
 	pause(false);
 }
@@ -35,6 +35,8 @@
 
 #include <QDebug>
 #include <QDockWidget>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <style.h>
 #include <stylehelper.h>
 
@@ -91,6 +93,7 @@ PatternGenerator::PatternGenerator(libm2k::context::M2k *m2k, Filter *filt, Tool
 	, m_outputMode(0)
 	, m_singleTimer(new QTimer(this))
 	, m_buffer(nullptr)
+	, m_outputChanged(true)
 
 {
 	setupUi();
@@ -150,6 +153,7 @@ PatternGenerator::PatternGenerator(libm2k::context::M2k *m2k, Filter *filt, Tool
 	m_plotScrollBar->setRange(0, 140);
 
 	setupPatterns();
+	m_planner.setMaxSize(MAX_BUFFER_SIZE);
 
 	checkEnabledChannels();
 
@@ -170,6 +174,15 @@ void PatternGenerator::readPreferences()
 	bool showFps = p->get("general_show_plot_fps").toBool();
 	m_plot.setVisibleFpsLabel(showFps);
 	m_ui->instrumentNotes->setVisible(p->get("m2k_instrument_notes_active").toBool());
+
+	const double tolerance = p->get("m2k_pg_rate_match_ppm").toDouble() / 1e6;
+	if(tolerance != m_planner.tolerance()) {
+		m_planner.setTolerance(tolerance);
+		if(!m_enabledPatterns.isEmpty()) {
+			generateBuffer();
+			regenerate();
+		}
+	}
 }
 
 PatternGenerator::~PatternGenerator()
@@ -186,10 +199,7 @@ PatternGenerator::~PatternGenerator()
 		delete curve;
 	}
 
-	if(m_buffer) {
-		delete[] m_buffer;
-		m_buffer = nullptr;
-	}
+	m_buffer = nullptr;
 
 	auto i = m_annotationCurvePatternUiMap.begin();
 	while(i != m_annotationCurvePatternUiMap.end()) {
@@ -596,7 +606,7 @@ uint64_t PatternGenerator::computeSampleRate() const
 	return sr;
 }
 
-uint64_t PatternGenerator::computeBufferSize(uint64_t sampleRate) const
+uint64_t PatternGenerator::computeMinBufferSize(uint64_t sampleRate) const
 {
 	const uint64_t divconst = 50000000 / 256;
 	uint64_t size = sampleRate / divconst;
@@ -605,77 +615,62 @@ uint64_t PatternGenerator::computeBufferSize(uint64_t sampleRate) const
 		size = minSize;
 	}
 
-	uint64_t bufferSize = detail::lcm(size, 4);
-	uint64_t maxNonPeriodic = size;
-
-	for(const QPair<QVector<int>, PatternUI *> &pattern : m_enabledPatterns) {
-		const uint64_t patternBufferSize =
-			pattern.second->get_pattern()->get_required_nr_of_samples(sampleRate, pattern.first.size());
-
-		qDebug() << patternBufferSize;
-
-		if(!patternBufferSize) {
-			continue;
-		}
+	return size;
+}
 
-		if(pattern.second->get_pattern()->is_periodic()) {
-			bufferSize = detail::lcm(patternBufferSize, bufferSize);
-		} else {
-			if(maxNonPeriodic < patternBufferSize) {
-				maxNonPeriodic = patternBufferSize;
-			}
-		}
+PatternBufferPlanner::Request PatternGenerator::patternRequest(Pattern *pattern, uint64_t sampleRate,
+							       int nrOfChannels)
+{
+	const uint64_t required = pattern->get_required_nr_of_samples(sampleRate, nrOfChannels);
+	if(!pattern->is_periodic() || !required) {
+		return {.period = 0, .granularity = 0, .minSize = required};
 	}
 
-	if(maxNonPeriodic > bufferSize) {
-		uint64_t result = 1;
-
-		for(int i = 1; result < MAX_BUFFER_SIZE && maxNonPeriodic > result; ++i) {
-			result = bufferSize * i;
-		}
+	// get_required_nr_of_samples truncates sample_rate / frequency, while the generators round
+	// it. Use the period the generators actually produce, so the pattern wraps cleanly
+	if(ClockPattern *cp = dynamic_cast<ClockPattern *>(pattern)) {
+		const float period = (float)sampleRate / cp->get_frequency();
+		return {.period = std::max<uint64_t>(round(period), 1), .granularity = 1, .minSize = 0};
+	}
 
-		bufferSize = result;
+	// and the gray counter
+	if(BinaryCounterPattern *bcp = dynamic_cast<BinaryCounterPattern *>(pattern)) {
+		const uint64_t counts = 1ULL << nrOfChannels;
+		const uint64_t samplesPerCount = round((float)sampleRate / (float)bcp->get_frequency());
+		return {.period = std::max<uint64_t>(samplesPerCount, 1) * counts, .granularity = counts, .minSize = 0};
 	}
 
-	return bufferSize > MAX_BUFFER_SIZE ? MAX_BUFFER_SIZE : bufferSize;
+	// a period that can't be rate matched nor replicated
+	return {.period = required, .granularity = 0, .minSize = 0};
 }
 
-uint16_t PatternGenerator::remapBuffer(uint8_t *mapping, uint32_t val)
+uint32_t PatternGenerator::patternSampleRate(Pattern *pattern, uint64_t sampleRate,
+					     const PatternBufferPlanner::Request &request, uint64_t period)
 {
-	short ret = 0;
-	int i = 0;
-
-	while(val) {
-		if(val & 0x01) {
-			ret = ret | (1 << mapping[i]);
-		}
-
-		i++;
-		val >>= 1;
+	if(period == request.period) {
+		return sampleRate;
 	}
 
-	return ret;
+	// rate matched: the pattern is generated for the sample rate that makes its period
+	// exactly the planned one
+	if(ClockPattern *cp = dynamic_cast<ClockPattern *>(pattern)) {
+		return llround(period * (double)cp->get_frequency());
+	}
+	if(BinaryCounterPattern *bcp = dynamic_cast<BinaryCounterPattern *>(pattern)) {
+		return (period / request.granularity) * bcp->get_frequency();
+	}
+	return sampleRate;
 }
 
-void PatternGenerator::commitBuffer(const QPair<QVector<int>, PatternUI *> &pattern, uint16_t *buffer,
-				    uint32_t bufferSize)
+std::string PatternGenerator::patternKey(Pattern *pattern)
 {
-	uint8_t channelMapping[16];
-	memset(channelMapping, 0x00, 16 * sizeof(uint8_t));
-	short *bufferPtr = pattern.second->get_pattern()->get_buffer();
-
-	uint16_t chgMask = 0;
-
-	auto bufferChannelMask = (1 << pattern.first.size()) - 1;
-	for(int i = 0; i < pattern.first.size(); ++i) {
-		channelMapping[i] = pattern.first[i];
-		chgMask = chgMask | (1 << pattern.first[i]);
-	}
-
-	for(size_t i = 0; i < bufferSize; ++i) {
-		auto val = (bufferPtr[i] & bufferChannelMask);
-		buffer[i] = (buffer[i] & ~(chgMask)) | remapBuffer(channelMapping, val);
+	// the parameters saved in the setup describe what the pattern generates. Patterns that
+	// have no description (or import their samples from a file) are not cached
+	const QJsonObject obj = Pattern_API::toJson(pattern).toObject();
+	if(obj["name"].toString() == "none" || dynamic_cast<ImportPattern *>(pattern)) {
+		return "";
 	}
+	return QJsonDocument(obj).toJson(QJsonDocument::Compact).toStdString();
 }
 
 void PatternGenerator::checkEnabledChannels()
@@ -695,7 +690,13 @@ void PatternGenerator::checkEnabledChannels()
 
 void PatternGenerator::regenerate()
 {
-	if(m_running) {
+	if(!m_running) {
+		return;
+	}
+
+	// only restart the output when the samples actually changed
+	generateBuffer();
+	if(m_outputChanged) {
 		startStop(false);
 		startStop(true);
 	}
@@ -735,6 +736,7 @@ void PatternGenerator::startStop(bool start)
 			m_m2kDigital->setSampleRateOut(m_sampleRate);
 			m_m2kDigital->setCyclic(!isSingle);
 			m_m2kDigital->push(m_buffer, m_bufferSize);
+			m_outputChanged = false;
 
 			// timeout = buffer duration for the given samplerate + 200 milliseconds usb transfer (push)
 			const double timeout =
@@ -774,11 +776,54 @@ void PatternGenerator::generateBuffer()
 	// Compute samplerate
 	const uint64_t sr = computeSampleRate();
 
+	std::vector<PatternBufferPlanner::Request> requests;
+	for(const QPair<QVector<int>, PatternUI *> &pattern : qAsConst(m_enabledPatterns)) {
+		requests.push_back(patternRequest(pattern.second->get_pattern(), sr, pattern.first.size()));
+	}
+
+	m_planner.setMinSize(computeMinBufferSize(sr));
+	const PatternBufferPlanner::Plan plan = m_planner.plan(requests);
+	const uint64_t bufferSize = plan.size;
+
+	std::vector<PatternSynth::Pattern> patterns;
+	for(int i = 0; i < m_enabledPatterns.size(); i++) {
+		QPair<QVector<int>, PatternUI *> &pattern = m_enabledPatterns[i];
+		Pattern *p = pattern.second->get_pattern();
+		const int nrOfChannels = pattern.first.size();
+		const uint32_t rate = patternSampleRate(p, sr, requests[i], plan.periods[i]);
+		std::string key = patternKey(p);
+		if(!key.empty()) {
+			key += " " + std::to_string(rate);
+		}
+
+		patterns.push_back({.id = pattern.second,
+				    .key = key,
+				    .channels = std::vector<int>(pattern.first.begin(), pattern.first.end()),
+				    .generate = [p, nrOfChannels, rate](short *out, uint32_t, uint32_t size) {
+					    p->generate_pattern(rate, size, nrOfChannels);
+					    memcpy(out, p->get_buffer(), size * sizeof(short));
+					    p->delete_buffer();
+				    },
+				    // only the periods known to be exact are replicated
+				    .period = requests[i].granularity ? (uint32_t)plan.periods[i] : 0});
+		updateAnnotationCurveChannelsForPattern(pattern);
+		p->setNrOfChannels(nrOfChannels);
+	}
+
+	const bool changed = m_synth.synthesize(patterns, sr, bufferSize);
+	m_buffer = m_synth.data();
+	if(!changed) {
+		return;
+	}
+	qDebug() << "Generated" << m_synth.generated() << "of" << patterns.size() << "patterns";
+
+	m_outputChanged = true;
 	qDebug() << "Sample rate is: " << sr;
 	m_sampleRate = sr;
 
-	const uint64_t bufferSize = computeBufferSize(sr);
-	m_plot.setMaxBufferSizeErrorLabel(bufferSize == MAX_BUFFER_SIZE);
+	qDebug() << "Buffer plan:" << plan.bytes << "bytes, push takes ~" << plan.pushTime * 1000 << "ms,"
+		 << (plan.exact ? "exact" : "patterns are cut at the wrap") << "- rate match error" << plan.error;
+	m_plot.setMaxBufferSizeErrorLabel(!plan.exact);
 
 	qDebug() << "Buffer size is: " << bufferSize;
 	m_bufferSize = bufferSize;
@@ -788,13 +833,6 @@ void PatternGenerator::generateBuffer()
 	m_plot.setTimeBaseLabelValue(static_cast<double>(m_bufferSize) / static_cast<double>(m_sampleRate) /
 				     m_plot.xAxisNumDiv());
 
-	if(m_buffer) {
-		delete[] m_buffer;
-	}
-
-	m_buffer = new uint16_t[bufferSize];
-	memset(m_buffer, 0x0000, bufferSize * sizeof(uint16_t));
-
 	for(int i = 0; i < m_plotCurves.size(); ++i) {
 		QwtPlotCurve *curve = m_plot.getDigitalPlotCurve(i);
 		GenericLogicPlotCurve *logic_curve = dynamic_cast<GenericLogicPlotCurve *>(curve);
@@ -810,14 +848,6 @@ void PatternGenerator::generateBuffer()
 	m_plot.cancelZoom();
 	m_plot.zoomBaseUpdate(true);
 
-	for(QPair<QVector<int>, PatternUI *> &pattern : m_enabledPatterns) {
-		pattern.second->get_pattern()->generate_pattern(sr, bufferSize, pattern.first.size());
-		commitBuffer(pattern, m_buffer, bufferSize);
-		pattern.second->get_pattern()->delete_buffer();
-		updateAnnotationCurveChannelsForPattern(pattern);
-		pattern.second->get_pattern()->setNrOfChannels(pattern.first.size());
-	}
-
 	Q_EMIT dataAvailable(0, bufferSize, m_buffer);
 }
 
@@ -27,6 +27,8 @@
 #include "m2ktool.hpp"
 #include "mousewheelwidgetguard.h"
 #include "oscilloscope_plot.hpp"
+#include "patternbufferplanner.h"
+#include "patternsynth.h"
 
 #include <QMap>
 #include <QQueue>
@@ -55,6 +57,7 @@ class CustomPushButton;
 namespace scopy::m2k {
 class Filter;
 class DIOManager;
+class Pattern;
 class PatternUI;
 
 namespace logic {
@@ -108,9 +111,11 @@ private:
 	void channelInGroupRemoved(int position);
 	void loadTriggerMenu();
 	uint64_t computeSampleRate() const;
-	uint64_t computeBufferSize(uint64_t sampleRate) const;
-	uint16_t remapBuffer(uint8_t *mapping, uint32_t val);
-	void commitBuffer(const QPair<QVector<int>, PatternUI *> &pattern, uint16_t *buffer, uint32_t bufferSize);
+	uint64_t computeMinBufferSize(uint64_t sampleRate) const;
+	static PatternBufferPlanner::Request patternRequest(Pattern *pattern, uint64_t sampleRate, int nrOfChannels);
+	static uint32_t patternSampleRate(Pattern *pattern, uint64_t sampleRate,
+					  const PatternBufferPlanner::Request &request, uint64_t period);
+	static std::string patternKey(Pattern *pattern);
 	void checkEnabledChannels();
 	void removeAnnotationCurveOfPattern(PatternUI *pattern);
 	void updateAnnotationCurveChannelsForPattern(const QPair<QVector<int>, PatternUI *> &pattern);
@@ -140,6 +145,10 @@ private:
 	M2kDigital *m_m2kDigital;
 	uint64_t m_bufferSize;
 	uint64_t m_sampleRate;
+	PatternBufferPlanner m_planner;
+	PatternSynth m_synth;
+	// the samples changed since they were last pushed
+	bool m_outputChanged;
 
 	DIOManager *m_diom;
 	uint16_t m_outputMode;
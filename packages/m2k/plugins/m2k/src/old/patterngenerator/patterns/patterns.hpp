@@ -22,6 +22,7 @@
 #define PG_PATTERNS_HPP
 
 #include "m2k-gui/osc_import_settings.h"
+#include "scopy-m2k_export.h"
 #include "gui/spinbox_a.hpp"
 
 #include <QIntValidator>
@@ -122,7 +123,7 @@ public:
 	Q_INVOKABLE void log(QString msg);
 };
 
-class Pattern
+class SCOPY_M2K_EXPORT Pattern
 {
 private:
 	std::string name;
@@ -197,7 +198,7 @@ Q_SIGNALS:
 	void decoderChanged();
 };
 
-class ClockPattern : virtual public Pattern
+class SCOPY_M2K_EXPORT ClockPattern : virtual public Pattern
 {
 	int duty_cycle_granularity = 20;
 	int phase_granularity = 20;
@@ -276,7 +277,7 @@ private Q_SLOTS:
 	void parse_ui();
 };
 
-class BinaryCounterPattern : virtual public Pattern
+class SCOPY_M2K_EXPORT BinaryCounterPattern : virtual public Pattern
 {
 protected:
 	uint32_t frequency;
@@ -1064,12 +1064,21 @@ void SignalGenerator::updatePreview()
 
 	time_block_data->time_block->reset();
 	m_resampOk = true;
+	m_previewSynth.resize(channels.size());
 	for(auto it = channels.begin(); it != channels.end(); ++it) {
 		basic_block_sptr source;
 
 		if((*it)->enableButton()->isChecked()) {
-
-			source = getSource((*it), sample_rate, top, true);
+			WaveformSynth &synth = m_previewSynth[i];
+			if(setupSynth(i, synth, true)) {
+				source = blocks::vector_source_f::make(
+					synth.render(sample_rate, nb_points + nb_points_correction));
+				if(getData(*it)->type == SIGNAL_TYPE_WAVEFORM) {
+					handleResampler(source);
+				}
+			} else {
+				source = getSource((*it), sample_rate, top, true);
+			}
 			enabled = true;
 		} else {
 			source = blocks::nop::make(sizeof(float));
@@ -1388,6 +1397,7 @@ void SignalGenerator::start()
 	unsigned long oversampling;
 
 	m_resampOk = true;
+	m_synth.resize(m_m2k_analogout->getNbChannels());
 	for(size_t i = 0; i < m_m2k_analogout->getNbChannels(); i++) {
 		buffers.push_back({});
 		if(!m_m2k_analogout->isChannelEnabled(i)) {
@@ -1406,26 +1416,30 @@ void SignalGenerator::start()
 		calc_sampling_params(i, best_rate, final_rate, oversampling);
 
 		QWidget *w = channels[i];
-		auto source = getSource(w, best_rate, top_block);
-		auto head = blocks::head::make(sizeof(float), samples_count);
-		auto vector = blocks::vector_sink_f::make();
-
 		auto load = getData(w)->load;
 		auto scaling_factor = ((load + ExternalLoadLineEdit::OUTPUT_AWG_RESISTANCE) / load);
-		auto load_scaling = blocks::multiply_const_ff::make(scaling_factor);
-
-		auto clamp = analog::rail_ff::make(-AMPLITUDE_VOLTS, AMPLITUDE_VOLTS);
-
-		top_block->connect(source, 0, load_scaling, 0);
-		top_block->connect(load_scaling, 0, clamp, 0);
-		top_block->connect(clamp, 0, head, 0);
-		top_block->connect(head, 0, vector, 0);
-		top_block->run();
 
-		const std::vector<float> &f_samples = vector->data();
-		std::vector<double> samples(f_samples.begin(), f_samples.end());
-
-		buffers.at(i) = samples;
+		WaveformSynth &synth = m_synth[i];
+		if(setupSynth(i, synth, false)) {
+			synth.setOutput(scaling_factor, AMPLITUDE_VOLTS);
+			const std::vector<float> &f_samples = synth.render(best_rate, samples_count);
+			buffers.at(i).assign(f_samples.begin(), f_samples.end());
+		} else {
+			auto source = getSource(w, best_rate, top_block);
+			auto head = blocks::head::make(sizeof(float), samples_count);
+			auto vector = blocks::vector_sink_f::make();
+			auto load_scaling = blocks::multiply_const_ff::make(scaling_factor);
+			auto clamp = analog::rail_ff::make(-AMPLITUDE_VOLTS, AMPLITUDE_VOLTS);
+
+			top_block->connect(source, 0, load_scaling, 0);
+			top_block->connect(load_scaling, 0, clamp, 0);
+			top_block->connect(clamp, 0, head, 0);
+			top_block->connect(head, 0, vector, 0);
+			top_block->run();
+
+			const std::vector<float> &f_samples = vector->data();
+			buffers.at(i).assign(f_samples.begin(), f_samples.end());
+		}
 
 		m_m2k_analogout->setOversamplingRatio(i, oversampling);
 		m_m2k_analogout->setSampleRate(i, final_rate);
@@ -1459,6 +1473,10 @@ void SignalGenerator::startStop(bool pressed)
 		return;
 	}
 	if(pressed) {
+		// fresh noise on every run, as the flowgraph noise sources used to get
+		for(WaveformSynth &synth : m_synth) {
+			synth.reseed();
+		}
 		start();
 	} else {
 		stop();
@@ -1479,21 +1497,18 @@ void SignalGenerator::setFunction(const QString &function)
 
 // std::vector<float> stairdata;
 
-basic_block_sptr SignalGenerator::getSignalSource(gr::top_block_sptr top, double samp_rate,
-						  struct signal_generator_data &data, double phase_correction)
+WaveformSynth::Tone SignalGenerator::getTone(struct signal_generator_data &data, double phase_correction)
 {
-	double phase;
-	double amplitude;
-	double rise = 0.5, fall = 0.5;
-	double holdh = 0.0, holdl = 0.0;
-	float offset;
-	int rising_steps = 1;
-	int falling_steps = 1;
-	int stairphase = 0;
-
-	amplitude = data.amplitude / 2.0;
-	offset = data.offset;
-	phase = data.phase + phase_correction;
+	WaveformSynth::Tone tone = {.shape = WaveformSynth::WS_TRAPEZOIDAL,
+				    .frequency = data.frequency,
+				    .amplitude = data.amplitude / 2.0,
+				    .offset = data.offset,
+				    .phase = 0,
+				    .rise = 0.5,
+				    .high = 0.0,
+				    .fall = 0.5,
+				    .low = 0.0};
+	double phase = data.phase + phase_correction;
 
 	if(data.waveform == SG_TRI_WAVE) {
 		phase = std::fmod(phase + 90.0, 360.0);
@@ -1502,54 +1517,118 @@ basic_block_sptr SignalGenerator::getSignalSource(gr::top_block_sptr top, double
 	} else if(phase < 0) {
 		phase = phase + 360.0;
 	}
+	tone.phase = phase * 0.01745329;
 
 	switch(data.waveform) {
+	case SG_SIN_WAVE:
+		tone.shape = WaveformSynth::WS_SINE;
+		break;
 	case SG_SQR_WAVE:
-		rise = fall = 0;
-		holdh = (data.dutycycle / 100.0);
-		holdl = 1.0 - (data.dutycycle / 100.0);
+		tone.rise = tone.fall = 0;
+		tone.high = (data.dutycycle / 100.0);
+		tone.low = 1.0 - (data.dutycycle / 100.0);
 		break;
 	case SG_TRI_WAVE:
-		rise = fall = 1;
-		holdh = 0;
-		holdl = 0;
+		tone.rise = tone.fall = 1;
+		tone.high = 0;
+		tone.low = 0;
 		break;
 	case SG_SAW_WAVE:
-		fall = holdh = holdl = 0;
-		rise = 1;
+		tone.fall = tone.high = tone.low = 0;
+		tone.rise = 1;
 		break;
 	case SG_INV_SAW_WAVE:
-		rise = holdh = holdl = 0;
-		fall = 1;
+		tone.rise = tone.high = tone.low = 0;
+		tone.fall = 1;
 		break;
 	case SG_TRA_WAVE:
-		rise = data.rise;
-		fall = data.fall;
-		holdl = data.holdl;
-		holdh = data.holdh;
+		tone.rise = data.rise;
+		tone.fall = data.fall;
+		tone.low = data.holdl;
+		tone.high = data.holdh;
 		break;
 	case SG_STAIR_WAVE:
-		rising_steps = data.steps_up;
-		falling_steps = data.steps_down;
-		stairphase = data.stairphase;
+		tone.shape = WaveformSynth::WS_TABLE;
+		data.stairdata =
+			get_stairstep(data.steps_up, data.steps_down, tone.amplitude, tone.offset, data.stairphase);
+		tone.table = data.stairdata;
 		break;
 	default:
 		break;
 	}
 
-	basic_block_sptr src = nullptr;
-	if(data.waveform == SG_SIN_WAVE)
-		src = analog::sig_source_f::make(samp_rate, analog::GR_SIN_WAVE, data.frequency, amplitude, offset,
-						 phase * 0.01745329);
-	else if(data.waveform == SG_STAIR_WAVE) {
-		data.stairdata = get_stairstep(rising_steps, falling_steps, amplitude, offset, stairphase);
-		src = blocks::vector_source_f::make(data.stairdata, true);
+	return tone;
+}
+
+basic_block_sptr SignalGenerator::getSignalSource(gr::top_block_sptr top, double samp_rate,
+						  struct signal_generator_data &data, double phase_correction)
+{
+	WaveformSynth::Tone tone = getTone(data, phase_correction);
+
+	if(tone.shape == WaveformSynth::WS_SINE) {
+		return analog::sig_source_f::make(samp_rate, analog::GR_SIN_WAVE, tone.frequency, tone.amplitude,
+						  tone.offset, tone.phase);
+	}
+	if(tone.shape == WaveformSynth::WS_TABLE) {
+		return blocks::vector_source_f::make(tone.table, true);
+	}
+	return gr::scopy::trapezoidal::make(samp_rate, tone.frequency, tone.amplitude, tone.rise, tone.high, tone.fall,
+					    tone.low, tone.offset, tone.phase);
+}
+
+bool SignalGenerator::setupSynth(int chIdx, WaveformSynth &synth, bool preview)
+{
+	auto ptr = getData(channels[chIdx]);
+	double phase = 0.0;
+
+	synth.clear();
+	switch(ptr->type) {
+	case SIGNAL_TYPE_CONSTANT:
+		synth.addTone({.shape = WaveformSynth::WS_CONSTANT, .offset = ptr->constant}, WaveformSynth::WS_SET);
+		break;
+
+	case SIGNAL_TYPE_WAVEFORM:
+		if(preview) {
+			// the stair preview is stretched to the display rate by the GR resampler
+			if(ptr->waveform == SG_STAIR_WAVE) {
+				return false;
+			}
+			int full_periods = (int)((double)zoomT1OnScreen * ptr->frequency);
+			double phase_in_time = zoomT1OnScreen - full_periods / ptr->frequency;
+			phase = (phase_in_time * ptr->frequency) * 360.0;
+		}
+		synth.addTone(getTone(*ptr, phase), WaveformSynth::WS_SET);
+		break;
+
+	default:
+		// files and math expressions are still rendered by the flowgraph
+		return false;
+	}
 
-	} else
-		src = gr::scopy::trapezoidal::make(samp_rate, data.frequency, amplitude, rise, holdh, fall, holdl,
-						   offset, phase * 0.01745329);
+	if((int)ptr->noiseType != 0) {
+		double noiseDivider;
+		float noiseAmpl;
+		WaveformSynth::Noise type;
+		switch(ptr->noiseType) {
+		case analog::GR_IMPULSE:
+			type = WaveformSynth::WS_IMPULSE;
+			break;
+		case analog::GR_GAUSSIAN:
+			type = WaveformSynth::WS_GAUSSIAN;
+			break;
+		case analog::GR_LAPLACIAN:
+			type = WaveformSynth::WS_LAPLACIAN;
+			break;
+		case analog::GR_UNIFORM:
+		default:
+			type = WaveformSynth::WS_UNIFORM;
+			break;
+		}
+		getNoiseScale(ptr->noiseType, ptr->noiseAmplitude, noiseDivider, noiseAmpl);
+		synth.setNoise(type, ptr->noiseAmplitude / noiseDivider, noiseAmpl);
+	}
 
-	return src;
+	return true;
 }
 
 void SignalGenerator::loadFileCurrentChannelData()
@@ -1619,31 +1698,37 @@ void SignalGenerator::loadFileChannelData(int chIdx)
 	}
 }
 
+void SignalGenerator::getNoiseScale(gr::analog::noise_type_t type, float amplitude, double &divider, float &limit)
+{
+	limit = amplitude / 2;
+	switch(type) {
+	case analog::GR_IMPULSE:
+		limit = amplitude;
+		divider = 15;
+		break;
+	case analog::GR_GAUSSIAN:
+		divider = 7;
+		break;
+	case analog::GR_UNIFORM:
+		divider = 2;
+		break;
+	case analog::GR_LAPLACIAN:
+		divider = 14;
+		break;
+	default:
+		divider = 1;
+		break;
+	}
+}
+
 gr::basic_block_sptr SignalGenerator::getNoise(QWidget *obj, gr::top_block_sptr top)
 {
 	auto ptr = getData(obj);
-	auto noiseaAmpl = ptr->noiseAmplitude / 2;
 	if((int)ptr->noiseType != 0) {
 		long noiseSeed = (rand());
-		double noiseDivider = 1;
-		switch(ptr->noiseType) {
-		case analog::GR_IMPULSE:
-			noiseaAmpl = ptr->noiseAmplitude;
-			noiseDivider = 15;
-			break;
-		case analog::GR_GAUSSIAN:
-			noiseDivider = 7;
-			break;
-		case analog::GR_UNIFORM:
-			noiseDivider = 2;
-			break;
-		case analog::GR_LAPLACIAN:
-			noiseDivider = 14;
-			break;
-		default:
-			noiseDivider = 1;
-			break;
-		}
+		double noiseDivider;
+		float noiseaAmpl;
+		getNoiseScale(ptr->noiseType, ptr->noiseAmplitude, noiseDivider, noiseaAmpl);
 
 		auto noise = analog::noise_source_f::make((analog::noise_type_t)ptr->noiseType,
 							  ptr->noiseAmplitude / noiseDivider, noiseSeed);
@@ -28,6 +28,7 @@
 #include "oscilloscope_plot.hpp"
 #include "pluginbase/apiobject.h"
 #include "scope_sink_f.h"
+#include "waveformsynth.h"
 
 #include <gnuradio/analog/noise_type.h>
 #include <gnuradio/analog/sig_source_waveform.h>
@@ -188,6 +189,9 @@ private:
 	QQueue<QPair<int, bool>> menuButtonActions;
 
 	std::vector<std::vector<double>> buffers;
+	// per channel synthesis caches, for the DAC buffers and for the preview plot
+	std::vector<WaveformSynth> m_synth;
+	std::vector<WaveformSynth> m_previewSynth;
 	QVector<ChannelWidget *> channels;
 
 	QSharedPointer<signal_generator_data> getData(QWidget *obj);
@@ -205,8 +209,12 @@ private:
 
 	gr::basic_block_sptr getSignalSource(gr::top_block_sptr top, double sample_rate,
 					     struct signal_generator_data &data, double phase_correction = 0.0);
+	WaveformSynth::Tone getTone(struct signal_generator_data &data, double phase_correction = 0.0);
+	// describes the channel for direct synthesis. False for signals that still need the GR flowgraph
+	bool setupSynth(int chIdx, WaveformSynth &synth, bool preview);
 
 	gr::basic_block_sptr getNoise(QWidget *obj, gr::top_block_sptr top);
+	static void getNoiseScale(gr::analog::noise_type_t type, float amplitude, double &divider, float &limit);
 	gr::basic_block_sptr getSource(QWidget *obj, double sample_rate, gr::top_block_sptr top,
 				       bool phase_correction = false);
 	gr::basic_block_sptr displayResampler(double samp_rate, double freq, gr::top_block_sptr top,
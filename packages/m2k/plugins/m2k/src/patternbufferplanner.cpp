@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "patternbufferplanner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+using namespace scopy::m2k;
+
+// bytes per second of a USB 2.0 push, for the estimate only
+#define DEFAULT_THROUGHPUT 20e6
+
+namespace {
+
+uint64_t roundUp(uint64_t value, uint64_t multiple) { return (value + multiple - 1) / multiple * multiple; }
+
+} // namespace
+
+PatternBufferPlanner::PatternBufferPlanner()
+	: m_minSize(4)
+	, m_maxSize(1024 * 1024)
+	, m_alignment(4)
+	, m_tolerance(0)
+	, m_throughput(DEFAULT_THROUGHPUT)
+{}
+
+PatternBufferPlanner::~PatternBufferPlanner() {}
+
+uint64_t PatternBufferPlanner::minSize() const { return m_minSize; }
+
+void PatternBufferPlanner::setMinSize(uint64_t minSize) { m_minSize = minSize; }
+
+uint64_t PatternBufferPlanner::maxSize() const { return m_maxSize; }
+
+void PatternBufferPlanner::setMaxSize(uint64_t maxSize) { m_maxSize = maxSize; }
+
+uint64_t PatternBufferPlanner::alignment() const { return m_alignment; }
+
+void PatternBufferPlanner::setAlignment(uint64_t alignment) { m_alignment = std::max<uint64_t>(alignment, 1); }
+
+double PatternBufferPlanner::tolerance() const { return m_tolerance; }
+
+void PatternBufferPlanner::setTolerance(double tolerance) { m_tolerance = std::max(tolerance, 0.0); }
+
+double PatternBufferPlanner::throughput() const { return m_throughput; }
+
+void PatternBufferPlanner::setThroughput(double throughput) { m_throughput = throughput; }
+
+std::vector<std::pair<uint64_t, int>> PatternBufferPlanner::factorize(uint64_t n)
+{
+	std::vector<std::pair<uint64_t, int>> factors;
+	for(uint64_t f = 2; f * f <= n; f += (f == 2) ? 1 : 2) {
+		int power = 0;
+		while(n % f == 0) {
+			n /= f;
+			power++;
+		}
+		if(power) {
+			factors.push_back({f, power});
+		}
+	}
+	if(n > 1) {
+		factors.push_back({n, 1});
+	}
+	return factors;
+}
+
+uint64_t PatternBufferPlanner::lcm(const std::vector<uint64_t> &values, uint64_t limit)
+{
+	// highest power of every prime
+	std::map<uint64_t, int> powers;
+	for(uint64_t v : values) {
+		if(!v) {
+			continue;
+		}
+		for(const auto &f : factorize(v)) {
+			int &power = powers[f.first];
+			power = std::max(power, f.second);
+		}
+	}
+
+	uint64_t result = 1;
+	for(const auto &p : powers) {
+		for(int i = 0; i < p.second; i++) {
+			if(result > limit / p.first) {
+				return limit + 1;
+			}
+			result *= p.first;
+		}
+	}
+	return result;
+}
+
+PatternBufferPlanner::Plan PatternBufferPlanner::plan(const std::vector<Request> &requests) const
+{
+	Plan plan = {.size = 0, .exact = true, .periods = {}, .error = 0, .bytes = 0, .pushTime = 0};
+	const uint64_t maxSize = m_maxSize / m_alignment * m_alignment;
+
+	uint64_t need = m_minSize;
+	std::vector<uint64_t> periods = {m_alignment};
+	for(const Request &r : requests) {
+		need = std::max(need, r.minSize);
+		plan.periods.push_back(r.period);
+		periods.push_back(r.period);
+	}
+	need = roundUp(need, m_alignment);
+
+	const uint64_t exact = lcm(periods, maxSize);
+	const uint64_t exactSize = (exact <= maxSize) ? roundUp(need, exact) : maxSize + 1;
+
+	// a rate matched buffer is only worth it if it is shorter than the exact one
+	if(m_tolerance > 0 && rateMatch(requests, need, std::min(exactSize - 1, maxSize), plan)) {
+		finish(plan);
+		return plan;
+	}
+
+	if(exactSize <= maxSize) {
+		plan.size = exactSize;
+	} else if(exact <= maxSize) {
+		// the periodic patterns still wrap cleanly, the longest non periodic one is cut
+		plan.size = maxSize / exact * exact;
+		plan.exact = false;
+	} else {
+		plan.size = maxSize;
+		plan.exact = false;
+	}
+	finish(plan);
+	return plan;
+}
+
+bool PatternBufferPlanner::rateMatch(const std::vector<Request> &requests, uint64_t from, uint64_t to,
+				     Plan &plan) const
+{
+	std::vector<uint64_t> periods(requests.size());
+	for(uint64_t size = from; size <= to; size += m_alignment) {
+		double worst = 0;
+		bool match = true;
+
+		for(size_t i = 0; i < requests.size() && match; i++) {
+			const uint64_t period = requests[i].period;
+			periods[i] = period;
+			if(!period || size % period == 0) {
+				continue;
+			}
+
+			match = false;
+			const uint64_t granularity = requests[i].granularity;
+			if(!granularity) {
+				break;
+			}
+
+			// every number of whole periods within the tolerance
+			const uint64_t first = std::max<uint64_t>(std::floor(size / (period * (1 + m_tolerance))), 1);
+			const uint64_t last = std::ceil(size / (period * std::max(1 - m_tolerance, 1e-9)));
+			double best = m_tolerance;
+			for(uint64_t c = first; c <= std::min(last, size); c++) {
+				if(size % c || (size / c) % granularity) {
+					continue;
+				}
+				const double error = std::fabs(double(size / c) - period) / period;
+				if(error <= best) {
+					best = error;
+					periods[i] = size / c;
+					match = true;
+				}
+			}
+			worst = std::max(worst, best);
+		}
+
+		if(match) {
+			plan.size = size;
+			plan.exact = true;
+			plan.periods = periods;
+			plan.error = worst;
+			return true;
+		}
+	}
+	return false;
+}
+
+void PatternBufferPlanner::finish(Plan &plan) const
+{
+	plan.bytes = plan.size * sizeof(uint16_t);
+	plan.pushTime = (m_throughput > 0) ? plan.bytes / m_throughput : 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "patternsynth.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace scopy::m2k;
+
+namespace {
+
+constexpr int NR_OF_CHANNELS = 16;
+constexpr uint32_t BLOCK_SIZE = 64;
+constexpr int LANES = BLOCK_SIZE / 4;
+
+// a nibble of a plane spread to bit 0 of four consecutive 16 bit samples
+struct SpreadTable
+{
+	uint64_t v[16];
+
+	SpreadTable()
+	{
+		for(int n = 0; n < 16; n++) {
+			const uint16_t samples[4] = {uint16_t(n & 1), uint16_t((n >> 1) & 1), uint16_t((n >> 2) & 1),
+						     uint16_t((n >> 3) & 1)};
+			memcpy(&v[n], samples, sizeof(v[n]));
+		}
+	}
+};
+
+const SpreadTable spread;
+
+size_t nrOfWords(uint32_t size) { return (size + BLOCK_SIZE - 1) / BLOCK_SIZE; }
+
+} // namespace
+
+PatternSynth::PatternSynth()
+	: m_generation(0)
+	, m_sampleRate(0)
+	, m_size(0)
+	, m_generated(0)
+{}
+
+PatternSynth::~PatternSynth() {}
+
+bool PatternSynth::synthesize(const std::vector<Pattern> &patterns, uint32_t sampleRate, uint32_t size)
+{
+	const size_t words = nrOfWords(size);
+	std::map<const void *, Entry> cache;
+	Signature signature(NR_OF_CHANNELS, {0, 0});
+	std::vector<const void *> sources(NR_OF_CHANNELS, nullptr);
+	m_generated = 0;
+
+	for(const Pattern &p : patterns) {
+		const int nrOfPlanes = std::min<int>(p.channels.size(), NR_OF_CHANNELS);
+		const uint32_t period = (p.period && p.period < size && size % p.period == 0) ? p.period : size;
+		Entry entry = {.key = "",
+			       .sampleRate = 0,
+			       .size = 0,
+			       .period = 0,
+			       .nrOfPlanes = 0,
+			       .generation = 0,
+			       .planes = {}};
+		auto it = m_cache.find(p.id);
+		if(it != m_cache.end()) {
+			entry = std::move(it->second);
+			m_cache.erase(it);
+		}
+
+		const bool sameLayout = entry.generation && entry.sampleRate == sampleRate && entry.size == size &&
+			entry.period == period && entry.nrOfPlanes == nrOfPlanes;
+		if(!sameLayout || p.key.empty() || entry.key != p.key) {
+			m_scratch.assign(size, 0);
+			if(p.generate) {
+				p.generate(m_scratch.data(), sampleRate, period);
+			}
+			replicate(m_scratch.data(), period, size);
+			std::vector<uint64_t> planes(nrOfPlanes * words);
+			toPlanes(m_scratch.data(), size, nrOfPlanes, planes.data());
+			m_generated++;
+
+			// a new key (or a pattern that can't be cached) often produces the same samples
+			if(!sameLayout || planes != entry.planes) {
+				entry.generation = ++m_generation;
+				entry.planes = std::move(planes);
+			}
+			entry.key = p.key;
+			entry.sampleRate = sampleRate;
+			entry.size = size;
+			entry.period = period;
+			entry.nrOfPlanes = nrOfPlanes;
+		}
+
+		for(int i = 0; i < nrOfPlanes; i++) {
+			const int ch = p.channels[i];
+			if(ch >= 0 && ch < NR_OF_CHANNELS) {
+				signature[ch] = {entry.generation, i};
+				sources[ch] = p.id;
+			}
+		}
+		cache[p.id] = std::move(entry);
+	}
+
+	// patterns no longer used are dropped
+	m_cache = std::move(cache);
+
+	const bool changed = signature != m_signature || sampleRate != m_sampleRate || size != m_size;
+	m_signature = signature;
+	m_sampleRate = sampleRate;
+	m_size = size;
+	if(!changed) {
+		return false;
+	}
+
+	std::vector<const uint64_t *> planes;
+	std::vector<int> channels;
+	for(int ch = 0; ch < NR_OF_CHANNELS; ch++) {
+		if(sources[ch]) {
+			const Entry &entry = m_cache.at(sources[ch]);
+			planes.push_back(entry.planes.data() + signature[ch].second * words);
+			channels.push_back(ch);
+		}
+	}
+
+	m_out.resize(words * BLOCK_SIZE);
+	merge(planes.data(), channels.data(), planes.size(), size, m_out.data());
+	return true;
+}
+
+uint16_t *PatternSynth::data() { return m_out.data(); }
+
+uint32_t PatternSynth::size() const { return m_size; }
+
+int PatternSynth::generated() const { return m_generated; }
+
+void PatternSynth::clear()
+{
+	m_cache.clear();
+	m_signature.clear();
+	m_sampleRate = 0;
+	m_size = 0;
+	m_out.clear();
+}
+
+void PatternSynth::replicate(short *buffer, uint32_t period, uint32_t size)
+{
+	// doubling copies, log2(size / period) memcpy calls
+	for(uint32_t filled = period; filled < size;) {
+		const uint32_t count = std::min(filled, size - filled);
+		memcpy(buffer + filled, buffer, count * sizeof(short));
+		filled += count;
+	}
+}
+
+void PatternSynth::toPlanes(const short *in, uint32_t size, int nrOfPlanes, uint64_t *planes)
+{
+	const size_t words = nrOfWords(size);
+	for(size_t w = 0; w < words; w++) {
+		uint64_t acc[NR_OF_CHANNELS] = {};
+		const uint32_t start = w * BLOCK_SIZE;
+		const uint32_t count = std::min(BLOCK_SIZE, size - start);
+		for(uint32_t i = 0; i < count; i++) {
+			const uint16_t v = in[start + i];
+			for(int b = 0; b < nrOfPlanes; b++) {
+				acc[b] |= uint64_t((v >> b) & 1) << i;
+			}
+		}
+		for(int b = 0; b < nrOfPlanes; b++) {
+			planes[b * words + w] = acc[b];
+		}
+	}
+}
+
+void PatternSynth::merge(const uint64_t *const *planes, const int *channels, int nrOfPlanes, uint32_t size,
+			 uint16_t *out)
+{
+	const size_t words = nrOfWords(size);
+	for(size_t w = 0; w < words; w++) {
+		// 4 samples per lane, the block is written once
+		uint64_t lanes[LANES] = {};
+		for(int p = 0; p < nrOfPlanes; p++) {
+			const uint64_t bits = planes[p][w];
+			if(!bits) {
+				continue;
+			}
+			const int ch = channels[p];
+			for(int n = 0; n < LANES; n++) {
+				lanes[n] |= spread.v[(bits >> (4 * n)) & 0xf] << ch;
+			}
+		}
+		memcpy(out + w * BLOCK_SIZE, lanes, sizeof(lanes));
+	}
+}
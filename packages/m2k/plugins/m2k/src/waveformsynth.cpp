@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "waveformsynth.h"
+
+#include <gnuradio/fxpt.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace scopy::m2k;
+
+namespace {
+
+void renderSine(float *out, size_t count, double sampleRate, const WaveformSynth::Tone &tone)
+{
+	// the arithmetic of gr::analog::sig_source_f, step for step, so the samples are the same bits
+	const uint32_t phase = gr::fxpt::float_to_fixed(tone.phase);
+	const uint32_t inc = gr::fxpt::float_to_fixed(2 * M_PI * tone.frequency / sampleRate);
+	const float offset = tone.offset;
+	const double amplitude = tone.amplitude;
+
+	for(size_t i = 0; i < count; i++) {
+		const uint32_t p = phase + static_cast<uint32_t>(i) * inc;
+		out[i] = static_cast<float>(gr::fxpt::sin(p) * amplitude);
+	}
+
+	// the source skips the offset pass altogether when it is 0
+	if(offset != 0) {
+		for(size_t i = 0; i < count; i++) {
+			out[i] += offset;
+		}
+	}
+}
+
+void renderTrapezoidal(float *out, size_t count, double sampleRate, const WaveformSynth::Tone &tone)
+{
+	const double total = tone.rise + tone.high + tone.fall + tone.low;
+	const double period = sampleRate / tone.frequency;
+	if(total <= 0 || !(period > 0) || !std::isfinite(period)) {
+		std::fill(out, out + count, static_cast<float>(tone.offset));
+		return;
+	}
+
+	const double a = tone.amplitude;
+	const double offset = tone.offset;
+	const double len[4] = {period * tone.rise / total, period * tone.high / total, period * tone.fall / total,
+			       period * tone.low / total};
+	const double end[4] = {len[0], len[0] + len[1], len[0] + len[1] + len[2], period};
+
+	double idx = std::fmod(tone.phase / (2 * M_PI), 1.0) * period;
+	if(idx < 0) {
+		idx += period;
+	}
+
+	size_t i = 0;
+	while(i < count) {
+		int seg = 0;
+		while(seg < 3 && idx >= end[seg]) {
+			seg++;
+		}
+
+		const double start = end[seg] - len[seg];
+		const size_t n = std::min(static_cast<size_t>(std::max(std::ceil(end[seg] - idx), 1.0)), count - i);
+		float *dst = out + i;
+
+		// each segment is a ramp y = base + slope * (idx - start), so the loops below vectorize
+		double base, slope;
+		switch(seg) {
+		case 0:
+			base = -a;
+			slope = 2 * a / len[0];
+			break;
+		case 1:
+			base = a;
+			slope = 0;
+			break;
+		case 2:
+			base = a;
+			slope = -2 * a / len[2];
+			break;
+		default:
+			base = -a;
+			slope = 0;
+			break;
+		}
+
+		const double x0 = idx - start;
+		for(size_t k = 0; k < n; k++) {
+			dst[k] = static_cast<float>(base + slope * (x0 + k) + offset);
+		}
+
+		i += n;
+		idx += n;
+		if(idx >= period) {
+			idx -= period;
+		}
+	}
+}
+
+void renderTable(float *out, size_t count, const std::vector<float> &table)
+{
+	if(table.empty()) {
+		std::fill(out, out + count, 0.0f);
+		return;
+	}
+
+	for(size_t i = 0; i < count; i += table.size()) {
+		std::memcpy(out + i, table.data(), std::min(table.size(), count - i) * sizeof(float));
+	}
+}
+
+} // namespace
+
+WaveformSynth::WaveformSynth()
+	: m_valid(false)
+	, m_reseed(false)
+{
+	clear();
+}
+
+WaveformSynth::~WaveformSynth() {}
+
+void WaveformSynth::clear()
+{
+	m_desc.components.clear();
+	m_desc.noise = WS_NO_NOISE;
+	m_desc.noiseAmplitude = 0;
+	m_desc.noiseLimit = 0;
+	m_desc.noiseSeed = 0;
+	m_desc.gain = 1;
+	m_desc.limit = std::numeric_limits<double>::infinity();
+}
+
+void WaveformSynth::addTone(const Tone &tone, Op op) { m_desc.components.push_back({tone, op}); }
+
+void WaveformSynth::setNoise(Noise type, double amplitude, double limit, uint32_t seed)
+{
+	m_desc.noise = type;
+	m_desc.noiseAmplitude = amplitude;
+	m_desc.noiseLimit = limit;
+	m_desc.noiseSeed = seed;
+}
+
+void WaveformSynth::setNoise(Noise type, double amplitude, double limit)
+{
+	uint32_t seed;
+	if(!m_reseed && m_valid && m_rendered.noise == type && m_rendered.noiseAmplitude == amplitude &&
+	   m_rendered.noiseLimit == limit) {
+		seed = m_rendered.noiseSeed;
+	} else {
+		seed = std::random_device()();
+	}
+	m_reseed = false;
+	setNoise(type, amplitude, limit, seed);
+}
+
+void WaveformSynth::reseed() { m_reseed = true; }
+
+void WaveformSynth::setOutput(double gain, double limit)
+{
+	m_desc.gain = gain;
+	m_desc.limit = limit;
+}
+
+const std::vector<float> &WaveformSynth::render(double sampleRate, size_t count)
+{
+	m_desc.sampleRate = sampleRate;
+	m_desc.count = count;
+	if(m_valid && equal(m_desc, m_rendered)) {
+		return m_out;
+	}
+
+	m_out.assign(count, 0.0f);
+	for(const Component &c : m_desc.components) {
+		renderTone(m_out.data(), count, sampleRate, c.tone, c.op);
+	}
+	if(m_desc.noise != WS_NO_NOISE) {
+		renderNoise(m_out.data(), count, m_desc.noise, m_desc.noiseAmplitude, m_desc.noiseLimit,
+			    m_desc.noiseSeed);
+	}
+	if(m_desc.gain != 1 || std::isfinite(m_desc.limit)) {
+		scaleClamp(m_out.data(), count, m_desc.gain, m_desc.limit);
+	}
+
+	m_rendered = m_desc;
+	m_valid = true;
+	return m_out;
+}
+
+void WaveformSynth::renderTone(float *out, size_t count, double sampleRate, const Tone &tone, Op op)
+{
+	std::vector<float> scratch;
+	float *dst = out;
+	if(op != WS_SET) {
+		scratch.resize(count);
+		dst = scratch.data();
+	}
+
+	switch(tone.shape) {
+	case WS_SINE:
+		renderSine(dst, count, sampleRate, tone);
+		break;
+	case WS_TRAPEZOIDAL:
+		renderTrapezoidal(dst, count, sampleRate, tone);
+		break;
+	case WS_TABLE:
+		renderTable(dst, count, tone.table);
+		break;
+	case WS_CONSTANT:
+	default:
+		std::fill(dst, dst + count, static_cast<float>(tone.offset));
+		break;
+	}
+
+	if(op == WS_ADD) {
+		for(size_t i = 0; i < count; i++) {
+			out[i] += dst[i];
+		}
+	} else if(op == WS_MULTIPLY) {
+		for(size_t i = 0; i < count; i++) {
+			out[i] *= dst[i];
+		}
+	}
+}
+
+void WaveformSynth::renderNoise(float *out, size_t count, Noise type, double amplitude, double limit, uint32_t seed)
+{
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+	std::normal_distribution<float> gaussian(0.0f, 1.0f);
+	const float lim = limit;
+	const float ampl = amplitude;
+
+	auto next = [&]() -> float {
+		switch(type) {
+		case WS_UNIFORM:
+			return 2 * uniform(gen) - 1;
+		case WS_GAUSSIAN:
+			return gaussian(gen);
+		case WS_LAPLACIAN: {
+			const float z = uniform(gen);
+			return (z > 0.5f) ? -std::log(2 * (1 - z)) : std::log(2 * z);
+		}
+		case WS_IMPULSE: {
+			// rare spikes, the distribution used by the GNU Radio impulse noise source
+			const float z = -M_SQRT2 * std::log(1 - uniform(gen));
+			return (std::fabs(z) <= 9) ? 0 : z;
+		}
+		default:
+			return 0;
+		}
+	};
+
+	for(size_t i = 0; i < count; i++) {
+		out[i] += std::clamp(ampl * next(), -lim, lim);
+	}
+}
+
+void WaveformSynth::scaleClamp(float *out, size_t count, float gain, float limit)
+{
+	for(size_t i = 0; i < count; i++) {
+		out[i] = std::clamp(out[i] * gain, -limit, limit);
+	}
+}
+
+bool WaveformSynth::equal(const Description &a, const Description &b)
+{
+	if(a.components.size() != b.components.size() || a.noise != b.noise ||
+	   a.noiseAmplitude != b.noiseAmplitude || a.noiseLimit != b.noiseLimit || a.noiseSeed != b.noiseSeed ||
+	   a.gain != b.gain || a.limit != b.limit || a.sampleRate != b.sampleRate || a.count != b.count) {
+		return false;
+	}
+
+	for(size_t i = 0; i < a.components.size(); i++) {
+		const Tone &x = a.components[i].tone;
+		const Tone &y = b.components[i].tone;
+		if(a.components[i].op != b.components[i].op || x.shape != y.shape || x.frequency != y.frequency ||
+		   x.amplitude != y.amplitude || x.offset != y.offset || x.phase != y.phase || x.rise != y.rise ||
+		   x.high != y.high || x.fall != y.fall || x.low != y.low || x.table != y.table) {
+			return false;
+		}
+	}
+	return true;
+}
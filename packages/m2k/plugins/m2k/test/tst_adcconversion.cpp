@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "adc_sample_conv.hpp"
+
+#include <QElapsedTimer>
+#include <QSet>
+#include <QTest>
+#include <QwtCPointerData>
+
+#include <algorithm>
+#include <cmath>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/sptr_magic.h>
+#include <gnuradio/top_block.h>
+#include <m2k-gui/m2kmeasure.h>
+#include <m2k-gui/oscilloscope_plot.hpp>
+#include <m2k-gui/sampleblockpool.h>
+#include <m2k-gui/spectrumUpdateEvents.h>
+#include <m2k/adcconversion.h>
+#include <random>
+#include <scope_sink_f.h>
+
+using namespace scopy;
+using namespace scopy::m2k;
+
+#define NB_CHANNELS 2
+#define SAMPLE_RATE 100e6
+
+// the shape of the libm2k conversion: volts per LSB of the range, calibration gain and vertical offset
+static double rawToVolts(unsigned int channel, short raw)
+{
+	const double voltsPerLsb[NB_CHANNELS] = {0.78 / ((1 << 11) * 1.3 * 0.02), 0.78 / ((1 << 11) * 1.3 * 0.2)};
+	const double calibGain[NB_CHANNELS] = {1.0131, 0.9874};
+	const double offset[NB_CHANNELS] = {-0.25, 3.1};
+	return raw * voltsPerLsb[channel] * calibGain[channel] - offset[channel];
+}
+
+// the time chain of the oscilloscope: device shorts -> adc_sample_conv -> scope_sink_f -> CapturePlot
+class TimeChain
+{
+public:
+	explicit TimeChain(int frameSize)
+		: plot(nullptr)
+	{
+		plot.registerSink("Osc Time", NB_CHANNELS, 0);
+		plot.setMeasuremensEnabled(true);
+
+		m_conv = gnuradio::get_initial_sptr(new adc_sample_conv(NB_CHANNELS, rawToVolts));
+		m_top = gr::make_top_block("Osc Time");
+		m_sink = scope_sink_f::make(frameSize, SAMPLE_RATE, "Osc Time", NB_CHANNELS, &plot);
+		m_sink->set_update_time(0);
+		for(unsigned int i = 0; i < NB_CHANNELS; i++) {
+			auto src = gr::blocks::vector_source_s::make(std::vector<short>(frameSize));
+			m_top->connect(src, 0, m_conv, i);
+			m_top->connect(m_conv, i, m_sink, i);
+			m_sources.push_back(src);
+		}
+	}
+
+	// acquires one frame and plots it, the way the GUI thread gets to a frame before the next one
+	void run(const std::vector<std::vector<short>> &frame)
+	{
+		for(unsigned int i = 0; i < NB_CHANNELS; i++) {
+			m_sources[i]->set_data(frame[i]);
+		}
+		m_top->run();
+		QCoreApplication::sendPostedEvents(&plot);
+	}
+
+	CapturePlot plot;
+
+private:
+	gr::top_block_sptr m_top;
+	gr::block_sptr m_conv;
+	scope_sink_f::sptr m_sink;
+	std::vector<gr::blocks::vector_source_s::sptr> m_sources;
+};
+
+class TST_AdcConversion : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void init();
+	void linear();
+	void nonLinear();
+	void chain();
+	void benchmark();
+
+protected:
+	bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+	// the blocks the sink sent to the plot and the buffers of the last one
+	QSet<SampleBlock *> m_blocks;
+	std::vector<double *> m_delivered;
+	int m_frames = 0;
+};
+
+static std::vector<std::vector<short>> makeSignal(size_t count, unsigned int seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> codes(-2048, 2047);
+	std::vector<std::vector<short>> samples(NB_CHANNELS, std::vector<short>(count));
+	for(auto &channel : samples) {
+		std::generate(channel.begin(), channel.end(), [&]() { return codes(rng); });
+	}
+	return samples;
+}
+
+void TST_AdcConversion::init()
+{
+	m_blocks.clear();
+	m_delivered.clear();
+	m_frames = 0;
+}
+
+bool TST_AdcConversion::eventFilter(QObject *watched, QEvent *event)
+{
+	if(event->type() == TimeUpdateEvent::Type()) {
+		const std::shared_ptr<SampleBlock> &block = static_cast<TimeUpdateEvent *>(event)->block();
+		if(block) {
+			m_blocks.insert(block.get());
+			m_delivered = block->buffers();
+		}
+		m_frames++;
+	}
+	return QObject::eventFilter(watched, event);
+}
+
+void TST_AdcConversion::linear()
+{
+	std::vector<short> codes;
+	for(int raw = -32768; raw <= 32767; raw++) {
+		codes.push_back(raw);
+	}
+	std::vector<float> out(codes.size());
+
+	for(unsigned int ch = 0; ch < NB_CHANNELS; ch++) {
+		AdcConversion::Coefficients c;
+		QVERIFY(AdcConversion::fit(rawToVolts, ch, c));
+		AdcConversion::convert(codes.data(), out.data(), codes.size(), c);
+
+		const double fullScale = std::fabs(rawToVolts(ch, 32767)) + std::fabs(rawToVolts(ch, -32768));
+		for(size_t i = 0; i < codes.size(); i++) {
+			const double expected = rawToVolts(ch, codes[i]);
+			QVERIFY2(std::fabs(out[i] - expected) <= fullScale * 1e-6,
+				 qPrintable(QString("%1: %2 != %3").arg(codes[i]).arg(out[i]).arg(expected)));
+		}
+	}
+}
+
+void TST_AdcConversion::nonLinear()
+{
+	// a conversion that saturates can't be reduced to gain and offset
+	auto clamped = [](unsigned int, short raw) { return std::clamp(raw * 0.01, -5.0, 5.0); };
+	std::vector<short> codes = {-2048, -1000, -500, 0, 499, 2047};
+	std::vector<float> out(codes.size());
+
+	AdcConversion::Coefficients c;
+	QVERIFY(!AdcConversion::fit(clamped, 0, c));
+	AdcConversion::convert(codes.data(), out.data(), codes.size(), clamped, 0);
+	for(size_t i = 0; i < codes.size(); i++) {
+		QCOMPARE(out[i], float(clamped(0, codes[i])));
+	}
+}
+
+void TST_AdcConversion::chain()
+{
+	const int frameSize = 8192;
+	TimeChain chain(frameSize);
+	chain.plot.installEventFilter(this);
+
+	for(int frame = 0; frame < 8; frame++) {
+		const std::vector<std::vector<short>> samples = makeSignal(frameSize, frame);
+		chain.run(samples);
+		QCOMPARE(m_frames, frame + 1);
+		QCOMPARE(m_delivered.size(), size_t(NB_CHANNELS));
+
+		for(unsigned int ch = 0; ch < NB_CHANNELS; ch++) {
+			auto data = dynamic_cast<const QwtCPointerData<double> *>(chain.plot.Curve(ch)->data());
+			QVERIFY(data);
+			QCOMPARE(data->size(), size_t(frameSize));
+			// the plot shows the buffer the sink converted the frame into, nothing copied it on the way
+			QCOMPARE(data->yData(), m_delivered[ch]);
+
+			const double *y = data->yData();
+			for(int i = 0; i < frameSize; i++) {
+				// a few float ulps of the +/-30 V range
+				QVERIFY(std::fabs(y[i] - rawToVolts(ch, samples[ch][i])) < 1e-4);
+			}
+
+			// the measurements read the same buffer
+			const auto [min, max] = std::minmax_element(y, y + frameSize);
+			QCOMPARE(chain.plot.measurement(M2kMeasure::MIN, ch)->value(), *min);
+			QCOMPARE(chain.plot.measurement(M2kMeasure::MAX, ch)->value(), *max);
+		}
+	}
+
+	// each frame is back in the pool before the next one is converted
+	QCOMPARE(m_blocks.size(), 1);
+}
+
+void TST_AdcConversion::benchmark()
+{
+	// one oscilloscope frame of both channels at the largest plot size
+	const int frameSize = 1 << 20;
+	const std::vector<std::vector<short>> samples = makeSignal(frameSize, 42);
+	TimeChain chain(frameSize);
+	chain.plot.installEventFilter(this);
+
+	QElapsedTimer timer;
+	timer.start();
+	QBENCHMARK
+	{
+		chain.run(samples);
+	}
+	qInfo("%.1f frames per second, %d sample blocks for %d frames",
+	      m_frames * 1000.0 / std::max<qint64>(timer.elapsed(), 1), m_blocks.size(), m_frames);
+}
+
+QTEST_MAIN(TST_AdcConversion)
+
+#include "tst_adcconversion.moc"
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QtEndian>
+
+#include <chrono>
+#include <cmath>
+#include <m2k/dmmlogger.h>
+#include <random>
+#include <thread>
+
+using namespace scopy::m2k;
+
+class TST_DmmLogger : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void csv();
+	void binary();
+	void interval();
+	void openError();
+};
+
+#define BINARY_HEADER_SIZE 16
+#define RECORD_SIZE (8 + DmmLogger::NR_OF_VALUES * 8)
+// 10 Hz readouts
+#define READOUT_PERIOD 100000000LL
+
+static DmmLogger::Record makeRecord(int64_t timestamp, double value)
+{
+	return {.timestamp = timestamp, .values = {value, NAN, NAN, -value}};
+}
+
+static std::vector<DmmLogger::Record> readBinary(const QString &path)
+{
+	QFile file(path);
+	if(!file.open(QIODevice::ReadOnly)) {
+		return {};
+	}
+	const QByteArray data = file.readAll();
+	if(!data.startsWith("SCPYDMM1")) {
+		return {};
+	}
+
+	std::vector<DmmLogger::Record> records((data.size() - BINARY_HEADER_SIZE) / RECORD_SIZE);
+	const char *src = data.constData() + BINARY_HEADER_SIZE;
+	for(DmmLogger::Record &r : records) {
+		r.timestamp = qFromLittleEndian<int64_t>(src);
+		qFromLittleEndian<double>(src + 8, DmmLogger::NR_OF_VALUES, r.values);
+		src += RECORD_SIZE;
+	}
+	return records;
+}
+
+void TST_DmmLogger::csv()
+{
+	QTemporaryDir dir;
+	const QString path = dir.filePath("log.csv");
+	QCOMPARE(DmmLogger::formatForPath(path), DmmLogger::DL_CSV);
+
+	DmmLogger logger;
+	QVERIFY(logger.start(path, DmmLogger::DL_CSV, false));
+	const int64_t start = QDateTime::currentMSecsSinceEpoch() * 1000000LL;
+	for(int i = 0; i < 10; i++) {
+		QVERIFY(logger.push(makeRecord(start + i * READOUT_PERIOD, 1.25 * i)));
+	}
+	logger.stop();
+	QCOMPARE(logger.written(), uint64_t(10));
+
+	// appending doesn't repeat the header
+	QVERIFY(logger.start(path, DmmLogger::DL_CSV, true));
+	QVERIFY(logger.push(makeRecord(start + 10 * READOUT_PERIOD, 12.5)));
+	logger.stop();
+
+	QFile file(path);
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	const QStringList lines = QString(file.readAll()).split('\n', Qt::SkipEmptyParts);
+	QCOMPARE(lines.size(), 3 + 11);
+	QVERIFY(lines[0].startsWith(";Generated by Scopy"));
+	QCOMPARE(lines[2], QString("Timestamp,Channel_0_DC_RMS,Channel_0_AC_RMS,Channel_1_DC_RMS,Channel_1_AC_RMS"));
+
+	for(int i = 0; i < 11; i++) {
+		const QStringList row = lines[3 + i].split(',');
+		QCOMPARE(row.size(), 1 + DmmLogger::NR_OF_VALUES);
+		const QDateTime time = QDateTime::fromString(row[0], "yyyy-MM-dd HH:mm:ss.zzz");
+		QCOMPARE(time.toMSecsSinceEpoch(), (start + i * READOUT_PERIOD) / 1000000);
+		QCOMPARE(row[1].toDouble(), 1.25 * i);
+		QCOMPARE(row[2], QString("-"));
+		QCOMPARE(row[3], QString("-"));
+		QCOMPARE(row[4].toDouble(), -1.25 * i);
+	}
+}
+
+void TST_DmmLogger::binary()
+{
+	// more than a day of readouts at 10 Hz, pushed as fast as the writer allows
+	const int count = 1000000;
+	QTemporaryDir dir;
+	const QString path = dir.filePath("log.bin");
+	QCOMPARE(DmmLogger::formatForPath(path), DmmLogger::DL_BINARY);
+
+	DmmLogger logger;
+	logger.setFlushInterval(100);
+	logger.setSyncInterval(-1);
+	QVERIFY(logger.start(path, DmmLogger::DL_BINARY, false));
+
+	typedef std::chrono::steady_clock Clock;
+	Clock::duration slowest(0);
+	for(int i = 0; i < count; i++) {
+		const Clock::time_point before = Clock::now();
+		QVERIFY(logger.push(makeRecord(i * READOUT_PERIOD, i)));
+		slowest = std::max(slowest, Clock::now() - before);
+
+		// bursts of readouts, far faster than the DMM produces them
+		if(i % 1000 == 0) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+	logger.stop();
+
+	// the caller never waits for the disk
+	QVERIFY2(slowest < std::chrono::milliseconds(20),
+		 qPrintable(QString("push took %1 us").arg(
+			 std::chrono::duration_cast<std::chrono::microseconds>(slowest).count())));
+	QCOMPARE(logger.dropped(), uint64_t(0));
+	QCOMPARE(logger.written(), uint64_t(count));
+
+	const std::vector<DmmLogger::Record> records = readBinary(path);
+	QCOMPARE(records.size(), size_t(count));
+	for(int i = 0; i < count; i++) {
+		// the exact sample timestamps, no jitter
+		if(records[i].timestamp != i * READOUT_PERIOD || records[i].values[0] != i ||
+		   !std::isnan(records[i].values[1]) || records[i].values[3] != -i) {
+			QFAIL(qPrintable(QString("record %1 differs").arg(i)));
+		}
+	}
+}
+
+void TST_DmmLogger::interval()
+{
+	// readouts delivered with jitter, logged once per second
+	const int count = 1000000;
+	const int64_t interval = 1000000000LL;
+	QTemporaryDir dir;
+	const QString path = dir.filePath("log.bin");
+
+	DmmLogger logger;
+	logger.setInterval(interval);
+	QVERIFY(logger.start(path, DmmLogger::DL_BINARY, false));
+
+	std::mt19937 rng(3);
+	std::uniform_int_distribution<int64_t> jitter(-READOUT_PERIOD / 5, READOUT_PERIOD / 5);
+	int64_t last = 0;
+	for(int i = 0; i < count; i++) {
+		last = i * READOUT_PERIOD + jitter(rng);
+		QVERIFY(logger.push(makeRecord(last, i)));
+		if(i % 10000 == 0) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+	logger.stop();
+
+	// one row per second, each the first readout of its second: the interval doesn't drift
+	const std::vector<DmmLogger::Record> records = readBinary(path);
+	const int64_t first = records.front().timestamp;
+	QVERIFY(records.size() >= size_t((last - first) / interval));
+	QVERIFY(records.size() <= size_t((last - first) / interval) + 1);
+	for(size_t k = 0; k < records.size(); k++) {
+		const int64_t late = records[k].timestamp - first - int64_t(k) * interval;
+		if(late < 0 || late > READOUT_PERIOD + 2 * READOUT_PERIOD / 5) {
+			QFAIL(qPrintable(QString("row %1 is %2 ns late").arg(k).arg(late)));
+		}
+	}
+}
+
+void TST_DmmLogger::openError()
+{
+	QTemporaryDir dir;
+	DmmLogger logger;
+	QVERIFY(!logger.start(dir.path(), DmmLogger::DL_CSV, false));
+	QVERIFY(!logger.isRunning());
+	QVERIFY(!logger.push(makeRecord(0, 0)));
+	QCOMPARE(logger.dropped(), uint64_t(1));
+}
+
+QTEST_MAIN(TST_DmmLogger)
+
+#include "tst_dmmlogger.moc"
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QTest>
+
+#include <algorithm>
+#include <cmath>
+#include <gnuradio/blocks/keep_one_in_n.h>
+#include <gnuradio/blocks/max_blk.h>
+#include <gnuradio/blocks/min_blk.h>
+#include <gnuradio/blocks/moving_average.h>
+#include <gnuradio/blocks/rms_ff.h>
+#include <gnuradio/blocks/short_to_float.h>
+#include <gnuradio/blocks/stream_to_vector.h>
+#include <gnuradio/blocks/sub.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/filter/dc_blocker_ff.h>
+#include <gnuradio/top_block.h>
+#include <m2k/dmmstats.h>
+#include <random>
+
+using namespace scopy::m2k;
+
+class TST_DmmStats : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void exact();
+	void largeOffset();
+	void chunks();
+	void matchesFlowgraph();
+	void benchmark_data();
+	void benchmark();
+};
+
+// the Voltmeter refresh rate
+#define READOUTS_PER_SECOND 10
+
+typedef struct
+{
+	// the reading: mean of a DC channel, RMS of an AC one
+	std::vector<float> values;
+	std::vector<float> max;
+	std::vector<float> min;
+} Readouts;
+
+// the per channel flowgraph the Voltmeter used before DmmStats
+static Readouts runFlowgraph(const std::vector<short> &samples, size_t window, bool ac)
+{
+	auto top = gr::make_top_block("DMM reference");
+	auto src = gr::blocks::vector_source_s::make(samples);
+	auto s2f = gr::blocks::short_to_float::make();
+	auto blocker = gr::filter::dc_blocker_ff::make(4000, true);
+	auto keep = gr::blocks::keep_one_in_n::make(sizeof(float), window);
+	auto stv = gr::blocks::stream_to_vector::make(sizeof(float), window);
+	auto max = gr::blocks::max_ff::make(window);
+	auto min = gr::blocks::min_ff::make(window);
+	auto sink = gr::blocks::vector_sink_f::make();
+	auto maxSink = gr::blocks::vector_sink_f::make();
+	auto minSink = gr::blocks::vector_sink_f::make();
+
+	top->connect(src, 0, s2f, 0);
+	top->connect(s2f, 0, blocker, 0);
+	if(ac) {
+		auto rms = gr::blocks::rms_ff::make(0.0001);
+		top->connect(blocker, 0, rms, 0);
+		top->connect(rms, 0, keep, 0);
+	} else {
+		auto sub = gr::blocks::sub_ff::make();
+		auto moving = gr::blocks::moving_average_ff::make(4000, 1.0 / 4000);
+		top->connect(s2f, 0, sub, 0);
+		top->connect(blocker, 0, sub, 1);
+		top->connect(sub, 0, moving, 0);
+		top->connect(moving, 0, keep, 0);
+	}
+	top->connect(keep, 0, sink, 0);
+	top->connect(s2f, 0, stv, 0);
+	top->connect(stv, 0, max, 0);
+	top->connect(stv, 0, min, 0);
+	top->connect(max, 0, maxSink, 0);
+	top->connect(min, 0, minSink, 0);
+	top->run();
+
+	return {.values = sink->data(), .max = maxSink->data(), .min = minSink->data()};
+}
+
+// dc offset, a sine with a whole number of periods per window and some noise
+static std::vector<short> makeSignal(size_t count, double offset, double amplitude, double period, double noise)
+{
+	std::mt19937 rng(42);
+	std::normal_distribution<double> gauss(0, noise);
+	std::vector<short> samples(count);
+	for(size_t i = 0; i < count; i++) {
+		const double v = offset + amplitude * std::sin(2 * M_PI * i / period) + gauss(rng);
+		samples[i] = std::clamp<long>(std::lround(v), -32768, 32767);
+	}
+	return samples;
+}
+
+void TST_DmmStats::exact()
+{
+	const std::vector<short> samples = makeSignal(100003, -700, 2000, 37.5, 25);
+
+	long double sum = 0;
+	for(short v : samples) {
+		sum += v;
+	}
+	const long double mean = sum / samples.size();
+	long double m2 = 0;
+	for(short v : samples) {
+		m2 += (v - mean) * (v - mean);
+	}
+	const double acRms = std::sqrt(m2 / samples.size());
+
+	const DmmStats::Stats s = DmmStats::compute(samples.data(), samples.size());
+	QCOMPARE(s.count, uint64_t(samples.size()));
+	QVERIFY(std::fabs(s.mean - double(mean)) < 1e-9);
+	QVERIFY(std::fabs(s.acRms - acRms) < 1e-9);
+	QVERIFY(std::fabs(s.rms - std::sqrt(acRms * acRms + double(mean * mean))) < 1e-9);
+	QCOMPARE(s.min, double(*std::min_element(samples.begin(), samples.end())));
+	QCOMPARE(s.max, double(*std::max_element(samples.begin(), samples.end())));
+
+	DmmStats empty;
+	QCOMPARE(empty.stats().count, uint64_t(0));
+	QCOMPARE(empty.stats().acRms, 0.0);
+}
+
+void TST_DmmStats::largeOffset()
+{
+	// +/-1 around a full scale offset, one window at the maximum sample rate. A naive
+	// sum of squares in float or double loses the variance to cancellation
+	std::vector<short> samples(10000000);
+	for(size_t i = 0; i < samples.size(); i++) {
+		samples[i] = (i & 1) ? 32767 : 32765;
+	}
+
+	const DmmStats::Stats s = DmmStats::compute(samples.data(), samples.size());
+	QVERIFY(std::fabs(s.mean - 32766) < 1e-9);
+	QVERIFY(std::fabs(s.acRms - 1) < 1e-9);
+}
+
+void TST_DmmStats::chunks()
+{
+	const std::vector<short> samples = makeSignal(50000, 1234, 15000, 1000, 100);
+	const DmmStats::Stats expected = DmmStats::compute(samples.data(), samples.size());
+
+	// the flowgraph hands buffers of any size
+	std::mt19937 rng(7);
+	DmmStats stats;
+	for(size_t i = 0; i < samples.size();) {
+		const size_t n = std::min<size_t>(1 + rng() % 9000, samples.size() - i);
+		stats.process(samples.data() + i, n);
+		i += n;
+		QCOMPARE(stats.count(), uint64_t(i));
+	}
+
+	const DmmStats::Stats s = stats.stats();
+	QVERIFY(std::fabs(s.mean - expected.mean) < 1e-9);
+	QVERIFY(std::fabs(s.acRms - expected.acRms) < 1e-9);
+	QCOMPARE(s.min, expected.min);
+	QCOMPARE(s.max, expected.max);
+
+	stats.reset();
+	QCOMPARE(stats.count(), uint64_t(0));
+}
+
+void TST_DmmStats::matchesFlowgraph()
+{
+	// the Voltmeter settings: 100 ksps, 10 readouts per second
+	const size_t window = 100000 / READOUTS_PER_SECOND;
+	const size_t windows = 12;
+	const double amplitude = 1500;
+	const std::vector<short> samples = makeSignal(window * windows, 1200, amplitude, 100, 10);
+
+	const Readouts dc = runFlowgraph(samples, window, false);
+	const Readouts ac = runFlowgraph(samples, window, true);
+	QCOMPARE(dc.values.size(), windows);
+	QCOMPARE(ac.values.size(), windows);
+	QCOMPARE(dc.max.size(), windows);
+
+	for(size_t w = 0; w < windows; w++) {
+		const DmmStats::Stats s = DmmStats::compute(samples.data() + w * window, window);
+		QCOMPARE(float(s.max), dc.max[w]);
+		QCOMPARE(float(s.min), dc.min[w]);
+	}
+
+	// the filters of the flowgraph need a few windows to settle
+	const DmmStats::Stats s = DmmStats::compute(samples.data() + (windows - 1) * window, window);
+	QVERIFY2(std::fabs(s.mean - dc.values.back()) < amplitude * 5e-3,
+		 qPrintable(QString("dc %1 != %2").arg(s.mean).arg(dc.values.back())));
+	QVERIFY2(std::fabs(s.acRms - ac.values.back()) < s.acRms * 1e-2,
+		 qPrintable(QString("ac %1 != %2").arg(s.acRms).arg(ac.values.back())));
+}
+
+void TST_DmmStats::benchmark_data()
+{
+	QTest::addColumn<bool>("flowgraph");
+	QTest::addColumn<bool>("ac");
+	QTest::newRow("DC, flowgraph") << true << false;
+	QTest::newRow("AC, flowgraph") << true << true;
+	QTest::newRow("fused") << false << false;
+}
+
+void TST_DmmStats::benchmark()
+{
+	QFETCH(bool, flowgraph);
+	QFETCH(bool, ac);
+
+	// one readout of a channel at the M2K maximum sample rate
+	const size_t window = 100000000 / READOUTS_PER_SECOND;
+	const std::vector<short> samples = makeSignal(window, 1200, 1500, 100, 10);
+
+	QBENCHMARK
+	{
+		if(flowgraph) {
+			runFlowgraph(samples, window, ac);
+		} else {
+			DmmStats::compute(samples.data(), samples.size());
+		}
+	}
+}
+
+QTEST_MAIN(TST_DmmStats)
+
+#include "tst_dmmstats.moc"
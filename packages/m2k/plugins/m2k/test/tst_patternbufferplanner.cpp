@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QTest>
+
+#include <cmath>
+#include <m2k/patternbufferplanner.h>
+#include <numeric>
+#include <random>
+
+using namespace scopy::m2k;
+
+typedef PatternBufferPlanner::Request Request;
+
+class TST_PatternBufferPlanner : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void factorize();
+	void exact();
+	void exactCombinations();
+	void nonPeriodic();
+	void rateMatch();
+	void rateMatchCombinations();
+	void cost();
+};
+
+static Request periodic(uint64_t period, uint64_t granularity = 1)
+{
+	return {.period = period, .granularity = granularity, .minSize = 0};
+}
+
+// every periodic pattern wraps exactly, within the tolerance of its requested period
+static void verifyPlan(const PatternBufferPlanner &planner, const std::vector<Request> &requests,
+		       const PatternBufferPlanner::Plan &plan)
+{
+	QVERIFY(plan.exact);
+	QVERIFY(plan.size <= planner.maxSize());
+	QCOMPARE(plan.size % planner.alignment(), uint64_t(0));
+	QCOMPARE(plan.periods.size(), requests.size());
+	for(size_t i = 0; i < requests.size(); i++) {
+		QVERIFY(plan.size >= requests[i].minSize);
+		if(!requests[i].period) {
+			continue;
+		}
+		const uint64_t period = plan.periods[i];
+		QCOMPARE(plan.size % period, uint64_t(0));
+		if(period != requests[i].period) {
+			QCOMPARE(period % requests[i].granularity, uint64_t(0));
+			const double error = std::fabs(double(period) - requests[i].period) / requests[i].period;
+			QVERIFY(error <= planner.tolerance());
+			QVERIFY(error <= plan.error);
+		}
+	}
+}
+
+void TST_PatternBufferPlanner::factorize()
+{
+	typedef std::vector<std::pair<uint64_t, int>> Factors;
+	QCOMPARE(PatternBufferPlanner::factorize(1), Factors());
+	QCOMPARE(PatternBufferPlanner::factorize(360), Factors({{2, 3}, {3, 2}, {5, 1}}));
+	QCOMPARE(PatternBufferPlanner::factorize(1000003), Factors({{1000003, 1}}));
+	QCOMPARE(PatternBufferPlanner::factorize(1ULL << 40), Factors({{2, 40}}));
+
+	QCOMPARE(PatternBufferPlanner::lcm({4, 6, 10}, 1000), uint64_t(60));
+	QCOMPARE(PatternBufferPlanner::lcm({4, 0, 9}, 1000), uint64_t(36));
+	// saturated
+	QCOMPARE(PatternBufferPlanner::lcm({1009, 1013}, 1000000), uint64_t(1000001));
+}
+
+void TST_PatternBufferPlanner::exact()
+{
+	PatternBufferPlanner planner;
+	planner.setMinSize(512);
+
+	// lcm(4, 3, 5, 7) = 420, twice to cover the minimum size
+	std::vector<Request> requests = {periodic(3), periodic(5), periodic(7)};
+	PatternBufferPlanner::Plan plan = planner.plan(requests);
+	QCOMPARE(plan.size, uint64_t(840));
+	QCOMPARE(plan.periods, std::vector<uint64_t>({3, 5, 7}));
+	QCOMPARE(plan.error, 0.0);
+	verifyPlan(planner, requests, plan);
+
+	// coprime periods that don't fit: clamped, the patterns glitch at the wrap
+	requests = {periodic(1009), periodic(1013)};
+	plan = planner.plan(requests);
+	QVERIFY(!plan.exact);
+	QCOMPARE(plan.size, planner.maxSize());
+}
+
+void TST_PatternBufferPlanner::exactCombinations()
+{
+	PatternBufferPlanner planner;
+	planner.setMinSize(64);
+	planner.setMaxSize(1 << 16);
+	std::mt19937 rng(1234);
+
+	for(int n = 0; n < 500; n++) {
+		std::vector<Request> requests;
+		const int count = 1 + rng() % 4;
+		for(int i = 0; i < count; i++) {
+			requests.push_back(periodic(1 + rng() % 60));
+		}
+
+		uint64_t lcm = planner.alignment();
+		for(const Request &r : requests) {
+			lcm = std::lcm(lcm, r.period);
+		}
+		const uint64_t expected = (planner.minSize() + lcm - 1) / lcm * lcm;
+
+		const PatternBufferPlanner::Plan plan = planner.plan(requests);
+		if(expected > planner.maxSize()) {
+			QVERIFY(!plan.exact);
+			continue;
+		}
+		QCOMPARE(plan.size, expected);
+		verifyPlan(planner, requests, plan);
+	}
+}
+
+void TST_PatternBufferPlanner::nonPeriodic()
+{
+	PatternBufferPlanner planner;
+
+	// an UART frame next to a clock: the smallest multiple of the clock period that fits it
+	std::vector<Request> requests = {periodic(3), {.period = 0, .granularity = 0, .minSize = 5000}};
+	PatternBufferPlanner::Plan plan = planner.plan(requests);
+	QCOMPARE(plan.size, uint64_t(5004));
+	verifyPlan(planner, requests, plan);
+
+	// longer than the maximum: cut, but the clock still wraps on a period
+	requests[1].minSize = planner.maxSize() + 10;
+	plan = planner.plan(requests);
+	QVERIFY(!plan.exact);
+	QCOMPARE(plan.size % 12, uint64_t(0));
+	QVERIFY(plan.size > planner.maxSize() - 12);
+}
+
+void TST_PatternBufferPlanner::rateMatch()
+{
+	PatternBufferPlanner planner;
+	planner.setMinSize(512);
+	planner.setTolerance(1e-3);
+
+	// two clocks and a 4 bit counter with coprime periods - 4 * 1009 * 1013 * 16 * 7 exactly
+	std::vector<Request> requests = {periodic(1009), periodic(1013), periodic(16 * 7, 16)};
+	PatternBufferPlanner::Plan plan = planner.plan(requests);
+	verifyPlan(planner, requests, plan);
+	QVERIFY(plan.size < 1009 * 1013);
+	QVERIFY(plan.error > 0);
+
+	// an exact length is kept when it is the shortest
+	requests = {periodic(100), periodic(250)};
+	plan = planner.plan(requests);
+	QCOMPARE(plan.size, uint64_t(1000));
+	QCOMPARE(plan.error, 0.0);
+
+	// periods that can't be changed are never rate matched
+	requests = {periodic(1009, 0), periodic(1013, 0)};
+	QVERIFY(!planner.plan(requests).exact);
+}
+
+void TST_PatternBufferPlanner::rateMatchCombinations()
+{
+	PatternBufferPlanner planner;
+	planner.setMinSize(16);
+	planner.setMaxSize(1 << 12);
+	std::mt19937 rng(4321);
+
+	for(int n = 0; n < 100; n++) {
+		planner.setTolerance((1 + rng() % 50) * 1e-3);
+		std::vector<Request> requests;
+		const int count = 1 + rng() % 3;
+		for(int i = 0; i < count; i++) {
+			const uint64_t granularity = 1 << (rng() % 3);
+			requests.push_back(periodic(granularity * (20 + rng() % 200), granularity));
+		}
+
+		// brute force: the shortest length every period fits after rate matching
+		uint64_t expected = 0;
+		for(uint64_t size = 16; size <= planner.maxSize() && !expected; size += planner.alignment()) {
+			bool match = true;
+			for(const Request &r : requests) {
+				bool found = false;
+				const uint64_t from = std::floor(r.period * (1 - planner.tolerance()) / r.granularity);
+				for(uint64_t period = std::max<uint64_t>(from, 1) * r.granularity;
+				    period <= r.period * (1 + planner.tolerance()) && !found; period += r.granularity) {
+					found = size % period == 0 &&
+						std::fabs(double(period) - r.period) / r.period <= planner.tolerance();
+				}
+				match = match && found;
+			}
+			expected = match ? size : 0;
+		}
+
+		const PatternBufferPlanner::Plan plan = planner.plan(requests);
+		if(!expected) {
+			QVERIFY(!plan.exact);
+			continue;
+		}
+		QCOMPARE(plan.size, expected);
+		verifyPlan(planner, requests, plan);
+	}
+}
+
+void TST_PatternBufferPlanner::cost()
+{
+	PatternBufferPlanner planner;
+	planner.setThroughput(1e6);
+	const PatternBufferPlanner::Plan plan = planner.plan({periodic(1000)});
+	QCOMPARE(plan.bytes, plan.size * 2);
+	QCOMPARE(plan.pushTime, plan.bytes / 1e6);
+}
+
+QTEST_MAIN(TST_PatternBufferPlanner)
+
+#include "tst_patternbufferplanner.moc"
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QLoggingCategory>
+#include <QTest>
+
+#include <cstring>
+#include <m2k/patternsynth.h>
+#include <memory>
+#include <patterngenerator/patterns/patterns.hpp>
+
+using namespace scopy::m2k;
+
+class TST_PatternSynth : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void initTestCase();
+	void matchesRemap();
+	void cache();
+	void replicate();
+	void benchmark_data();
+	void benchmark();
+};
+
+#define SAMPLE_RATE 100000000
+#define NR_OF_CHANNELS 16
+
+// generates the pattern the way PatternGenerator::generateBuffer() hands it to the synth
+static void generate(Pattern *p, short *out, uint32_t sampleRate, uint32_t size, int nrOfChannels)
+{
+	p->generate_pattern(sampleRate, size, nrOfChannels);
+	memcpy(out, p->get_buffer(), size * sizeof(short));
+	p->delete_buffer();
+}
+
+static PatternSynth::Pattern makeClock(const void *id, int channel, double frequency, int duty = 50)
+{
+	auto clock = std::make_shared<ClockPattern>();
+	clock->set_frequency(frequency);
+	clock->set_duty_cycle(duty);
+	return {.id = id,
+		.key = "clock " + std::to_string(frequency) + " " + std::to_string(duty),
+		.channels = {channel},
+		.generate = [clock](short *out, uint32_t sampleRate, uint32_t size) {
+			generate(clock.get(), out, sampleRate, size, 1);
+		},
+		.period = 0};
+}
+
+static PatternSynth::Pattern makeCounter(const void *id, std::vector<int> channels, double frequency)
+{
+	auto counter = std::make_shared<BinaryCounterPattern>();
+	counter->set_frequency(frequency);
+	const int nrOfChannels = channels.size();
+	return {.id = id,
+		.key = "counter " + std::to_string(frequency),
+		.channels = channels,
+		.generate = [counter, nrOfChannels](short *out, uint32_t sampleRate, uint32_t size) {
+			generate(counter.get(), out, sampleRate, size, nrOfChannels);
+		},
+		.period = 0};
+}
+
+// what PatternGenerator::commitBuffer did - every pattern remapped one sample and one bit at a time
+static void remap(const std::vector<PatternSynth::Pattern> &patterns, uint32_t size, std::vector<uint16_t> &out,
+		  std::vector<short> &scratch)
+{
+	out.assign(size, 0);
+	scratch.resize(size);
+	for(const PatternSynth::Pattern &p : patterns) {
+		p.generate(scratch.data(), SAMPLE_RATE, size);
+		uint16_t mask = 0;
+		for(int ch : p.channels) {
+			mask |= 1 << ch;
+		}
+		const int valueMask = (1 << p.channels.size()) - 1;
+		for(uint32_t i = 0; i < size; i++) {
+			uint32_t val = scratch[i] & valueMask;
+			uint16_t bits = 0;
+			for(int b = 0; val; b++, val >>= 1) {
+				if(val & 1) {
+					bits |= 1 << p.channels[b];
+				}
+			}
+			out[i] = (out[i] & ~mask) | bits;
+		}
+	}
+}
+
+void TST_PatternSynth::initTestCase()
+{
+	// ClockPattern logs its period computation on every generation
+	QLoggingCategory::setFilterRules("default.debug=false");
+}
+
+void TST_PatternSynth::matchesRemap()
+{
+	int ids[4];
+	std::vector<PatternSynth::Pattern> patterns = {
+		makeClock(&ids[0], 3, 1e6, 30),
+		makeCounter(&ids[1], {7, 0, 12}, 5e5),
+		makeCounter(&ids[2], {15, 14, 1, 2, 4}, 3e6),
+		// channel 3 again, the last pattern wins
+		makeClock(&ids[3], 3, 2.5e6),
+	};
+
+	std::vector<uint16_t> expected;
+	std::vector<short> scratch;
+	PatternSynth synth;
+	for(uint32_t size : {4u, 100u, 4096u, 100003u}) {
+		remap(patterns, size, expected, scratch);
+		QVERIFY(synth.synthesize(patterns, SAMPLE_RATE, size));
+		QCOMPARE(synth.size(), size);
+		for(uint32_t i = 0; i < size; i++) {
+			const uint16_t v = synth.data()[i];
+			if(v != expected[i]) {
+				QFAIL(qPrintable(QString("sample %1: %2 != %3").arg(i).arg(v).arg(expected[i])));
+			}
+		}
+	}
+}
+
+void TST_PatternSynth::cache()
+{
+	int ids[3];
+	std::vector<PatternSynth::Pattern> patterns = {makeClock(&ids[0], 0, 1e6), makeClock(&ids[1], 1, 2e6),
+						       makeCounter(&ids[2], {2, 3, 4}, 1e6)};
+	PatternSynth synth;
+	QVERIFY(synth.synthesize(patterns, SAMPLE_RATE, 4096));
+	QCOMPARE(synth.generated(), 3);
+
+	// nothing changed
+	QVERIFY(!synth.synthesize(patterns, SAMPLE_RATE, 4096));
+	QCOMPARE(synth.generated(), 0);
+
+	// only the edited pattern is generated again
+	patterns[1] = makeClock(&ids[1], 1, 4e6);
+	QVERIFY(synth.synthesize(patterns, SAMPLE_RATE, 4096));
+	QCOMPARE(synth.generated(), 1);
+
+	// a new key that generates the same samples doesn't change the output
+	patterns[1].key += " same";
+	QVERIFY(!synth.synthesize(patterns, SAMPLE_RATE, 4096));
+	QCOMPARE(synth.generated(), 1);
+
+	// remapping a channel only merges again
+	patterns[0].channels = {5};
+	QVERIFY(synth.synthesize(patterns, SAMPLE_RATE, 4096));
+	QCOMPARE(synth.generated(), 0);
+	uint16_t used = 0;
+	for(uint32_t i = 0; i < 4096; i++) {
+		used |= synth.data()[i];
+	}
+	QCOMPARE(used, uint16_t(0b111110));
+
+	// a new length regenerates everything
+	QVERIFY(synth.synthesize(patterns, SAMPLE_RATE, 8192));
+	QCOMPARE(synth.generated(), 3);
+
+	// patterns without a key are always generated
+	patterns[2].key = "";
+	QVERIFY(!synth.synthesize(patterns, SAMPLE_RATE, 8192));
+	QCOMPARE(synth.generated(), 1);
+}
+
+void TST_PatternSynth::replicate()
+{
+	int ids[2];
+	std::vector<PatternSynth::Pattern> patterns = {makeClock(&ids[0], 0, 1e6, 30),
+						       makeCounter(&ids[1], {1, 2, 3, 4}, 2.5e6)};
+	const uint32_t size = 4000 * 16;
+	std::vector<uint16_t> expected;
+	std::vector<short> scratch;
+	remap(patterns, size, expected, scratch);
+
+	// one period each: 100 samples for the clock, 40 * 16 for the counter
+	patterns[0].period = 100;
+	patterns[1].period = 640;
+	PatternSynth synth;
+	QVERIFY(synth.synthesize(patterns, SAMPLE_RATE, size));
+	QVERIFY(memcmp(synth.data(), expected.data(), size * sizeof(uint16_t)) == 0);
+
+	// a period that doesn't divide the buffer is generated in full
+	patterns[0].period = 99;
+	QVERIFY(!synth.synthesize(patterns, SAMPLE_RATE, size));
+	QCOMPARE(synth.generated(), 1);
+}
+
+void TST_PatternSynth::benchmark_data()
+{
+	QTest::addColumn<bool>("cached");
+	QTest::newRow("remap every pattern") << false;
+	QTest::newRow("synth") << true;
+}
+
+void TST_PatternSynth::benchmark()
+{
+	QFETCH(bool, cached);
+
+	// 16 clocks, one per channel, 1M samples (MAX_BUFFER_SIZE). Every iteration edits one of them
+	const uint32_t size = 1024 * 1024;
+	int ids[NR_OF_CHANNELS];
+	std::vector<PatternSynth::Pattern> patterns;
+	for(int ch = 0; ch < NR_OF_CHANNELS; ch++) {
+		patterns.push_back(makeClock(&ids[ch], ch, 1e6 * (ch + 1)));
+	}
+
+	PatternSynth synth;
+	synth.synthesize(patterns, SAMPLE_RATE, size);
+	std::vector<uint16_t> out;
+	std::vector<short> scratch;
+	int duty = 10;
+
+	QBENCHMARK
+	{
+		duty = (duty % 90) + 1;
+		patterns[5] = makeClock(&ids[5], 5, 6e6, duty);
+		if(cached) {
+			synth.synthesize(patterns, SAMPLE_RATE, size);
+		} else {
+			remap(patterns, size, out, scratch);
+		}
+	}
+}
+
+QTEST_MAIN(TST_PatternSynth)
+
+#include "tst_patternsynth.moc"
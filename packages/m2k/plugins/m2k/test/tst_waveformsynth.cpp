@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 Analog Devices Inc.
+ *
+ * This file is part of Scopy
+ * (see https://www.github.com/analogdevicesinc/scopy).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QTest>
+
+#include <gnuradio/analog/sig_source.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/scopy/trapezoidal.h>
+#include <gnuradio/top_block.h>
+#include <m2k/waveformsynth.h>
+
+using namespace scopy::m2k;
+
+class TST_WaveformSynth : public QObject
+{
+	Q_OBJECT
+private Q_SLOTS:
+	void matchesFlowgraph_data();
+	void matchesFlowgraph();
+	void cachedRender();
+	void noiseSeed();
+	void benchmark_data();
+	void benchmark();
+};
+
+#define SAMPLE_RATE 75000000.0
+
+static WaveformSynth::Tone makeTone(QString shape, double frequency, double amplitude, double offset, double phase)
+{
+	WaveformSynth::Tone tone = {.shape = WaveformSynth::WS_TRAPEZOIDAL,
+				    .frequency = frequency,
+				    .amplitude = amplitude,
+				    .offset = offset,
+				    .phase = phase,
+				    .rise = 0,
+				    .high = 0,
+				    .fall = 0,
+				    .low = 0};
+	if(shape == "sine") {
+		tone.shape = WaveformSynth::WS_SINE;
+	} else if(shape == "square") {
+		tone.high = tone.low = 0.5;
+	} else if(shape == "triangle") {
+		tone.rise = tone.fall = 1;
+	} else if(shape == "saw") {
+		tone.rise = 1;
+	} else {
+		tone.rise = 0.2;
+		tone.high = 0.3;
+		tone.fall = 0.1;
+		tone.low = 0.4;
+	}
+	return tone;
+}
+
+static std::vector<float> renderFlowgraph(const WaveformSynth::Tone &tone, size_t count)
+{
+	gr::basic_block_sptr src;
+	if(tone.shape == WaveformSynth::WS_SINE) {
+		src = gr::analog::sig_source_f::make(SAMPLE_RATE, gr::analog::GR_SIN_WAVE, tone.frequency,
+						     tone.amplitude, tone.offset, tone.phase);
+	} else {
+		src = gr::scopy::trapezoidal::make(SAMPLE_RATE, tone.frequency, tone.amplitude, tone.rise, tone.high,
+						   tone.fall, tone.low, tone.offset, tone.phase);
+	}
+
+	auto top = gr::make_top_block("WaveformSynth reference");
+	auto head = gr::blocks::head::make(sizeof(float), count);
+	auto sink = gr::blocks::vector_sink_f::make();
+	top->connect(src, 0, head, 0);
+	top->connect(head, 0, sink, 0);
+	top->run();
+	return sink->data();
+}
+
+void TST_WaveformSynth::matchesFlowgraph_data()
+{
+	QTest::addColumn<QString>("shape");
+	QTest::addColumn<double>("frequency");
+	QTest::addColumn<double>("phase");
+
+	for(QString shape : {"sine", "square", "triangle", "saw", "trapezoidal"}) {
+		QTest::addRow("%s 1 kHz", qPrintable(shape)) << shape << 1000.0 << 0.0;
+		QTest::addRow("%s 1.234567 MHz, 45 deg", qPrintable(shape)) << shape << 1234567.0 << M_PI / 4;
+	}
+}
+
+void TST_WaveformSynth::matchesFlowgraph()
+{
+	QFETCH(QString, shape);
+	QFETCH(double, frequency);
+	QFETCH(double, phase);
+
+	const size_t count = 200000;
+	const double amplitude = 2.5;
+	WaveformSynth::Tone tone = makeTone(shape, frequency, amplitude, 0.25, phase);
+
+	std::vector<float> expected = renderFlowgraph(tone, count);
+	std::vector<float> out(count);
+	WaveformSynth::renderTone(out.data(), count, SAMPLE_RATE, tone);
+
+	// sines are computed by the same gr::fxpt code and must match exactly. The trapezoidal ramps are evaluated
+	// in double here and may round differently from gr::scopy::trapezoidal in the last bits
+	const float tolerance = (tone.shape == WaveformSynth::WS_SINE) ? 0 : amplitude * 1e-4;
+
+	QCOMPARE(expected.size(), count);
+	for(size_t i = 0; i < count; i++) {
+		if(std::fabs(out[i] - expected[i]) > tolerance) {
+			QFAIL(qPrintable(QString("sample %1: %2 != %3").arg(i).arg(out[i]).arg(expected[i])));
+		}
+	}
+}
+
+void TST_WaveformSynth::cachedRender()
+{
+	WaveformSynth synth;
+	synth.addTone(makeTone("sine", 1000, 1, 0, 0), WaveformSynth::WS_SET);
+	synth.addTone(makeTone("sine", 50, 0.5, 1, 0), WaveformSynth::WS_MULTIPLY);
+	synth.setOutput(2, 1.5);
+
+	const float *first = synth.render(SAMPLE_RATE, 4096).data();
+	std::vector<float> copy = synth.render(SAMPLE_RATE, 4096);
+	QCOMPARE(synth.render(SAMPLE_RATE, 4096).data(), first);
+
+	for(float v : copy) {
+		QVERIFY(std::fabs(v) <= 1.5f);
+	}
+
+	synth.clear();
+	synth.addTone(makeTone("sine", 1000, 1, 0, 0), WaveformSynth::WS_SET);
+	QVERIFY(synth.render(SAMPLE_RATE, 4096) != copy);
+}
+
+void TST_WaveformSynth::noiseSeed()
+{
+	WaveformSynth a, b;
+	a.setNoise(WaveformSynth::WS_GAUSSIAN, 0.1, 1);
+	b.setNoise(WaveformSynth::WS_GAUSSIAN, 0.1, 1);
+	std::vector<float> first = a.render(SAMPLE_RATE, 4096);
+	QVERIFY(first != b.render(SAMPLE_RATE, 4096));
+
+	// unchanged noise settings keep the buffer, another knob does not draw new noise
+	a.clear();
+	a.setNoise(WaveformSynth::WS_GAUSSIAN, 0.1, 1);
+	QCOMPARE(a.render(SAMPLE_RATE, 4096), first);
+	a.clear();
+	a.setNoise(WaveformSynth::WS_GAUSSIAN, 0.1, 1);
+	a.setOutput(2, 10);
+	std::vector<float> scaled = a.render(SAMPLE_RATE, 4096);
+	for(size_t i = 0; i < first.size(); i++) {
+		QCOMPARE(scaled[i], first[i] * 2);
+	}
+
+	a.reseed();
+	a.clear();
+	a.setNoise(WaveformSynth::WS_GAUSSIAN, 0.1, 1);
+	QVERIFY(a.render(SAMPLE_RATE, 4096) != first);
+}
+
+void TST_WaveformSynth::benchmark_data()
+{
+	QTest::addColumn<QString>("shape");
+	QTest::addColumn<bool>("flowgraph");
+
+	for(QString shape : {"sine", "triangle"}) {
+		QTest::addRow("%s, flowgraph", qPrintable(shape)) << shape << true;
+		QTest::addRow("%s, synth", qPrintable(shape)) << shape << false;
+	}
+}
+
+void TST_WaveformSynth::benchmark()
+{
+	QFETCH(QString, shape);
+	QFETCH(bool, flowgraph);
+
+	// a knob change: the whole cyclic buffer is generated again
+	const size_t count = 1000000;
+	WaveformSynth::Tone tone = makeTone(shape, 1234567, 2.5, 0, 0);
+	std::vector<float> out(count);
+
+	QBENCHMARK
+	{
+		if(flowgraph) {
+			out = renderFlowgraph(tone, count);
+		} else {
+			WaveformSynth::renderTone(out.data(), count, SAMPLE_RATE, tone);
+		}
+	}
+}
+
+QTEST_MAIN(TST_WaveformSynth)
+
+#include "tst_waveformsynth.moc"